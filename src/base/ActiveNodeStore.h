@@ -64,6 +64,18 @@ namespace Minotaur {
      */
     virtual void push(NodePtr n) = 0;
 
+    /**
+     * \brief Remove the active nodes whose lower bound is more than a
+     * cutoff, e.g. after a better solution is found.
+     *
+     * The node at the top is not removed, because it may be under
+     * processing. By default nothing is removed: such nodes are pruned when
+     * they come to the top.
+     * \param[in] cutoff Nodes with lower bound more than cutoff are removed.
+     * \param[out] removed The removed nodes are appended to it.
+     */
+    virtual void removeAbove(double, NodePtrVector &) {}
+
     /**
      * \brief Access to the best candidate for evaluating next.
      *
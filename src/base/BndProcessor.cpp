@@ -9,10 +9,12 @@
  * \brief Implement simple node-processor for branch-and-bound
  * \author Ashutosh Mahajan, IIT Bombay
  */
+#include <algorithm>
 #include <cmath> // for INFINITY
 
 #include "MinotaurConfig.h"
 #include "Brancher.h"
+#include "ConflictPool.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Handler.h"
@@ -23,6 +25,7 @@
 #include "Modification.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
+#include "Trace.h"
 #include "WarmStart.h"
 
 using namespace Minotaur;
@@ -34,6 +37,7 @@ const std::string BndProcessor::me_ = "BndProcessor: ";
 BndProcessor::BndProcessor()
   : branches_(0),
     contOnErr_(false),
+    conflicts_(0),
     cutOff_(INFINITY),
     engine_(EnginePtr()),
     engineStatus_(EngineUnknownStatus),
@@ -57,6 +61,7 @@ BndProcessor::BndProcessor (EnvPtr env, EnginePtr engine,
                             HandlerVector handlers)
   : branches_(0),
     contOnErr_(false),
+    conflicts_(0),
     engine_(engine),
     engineStatus_(EngineUnknownStatus),
     numSolutions_(0),
@@ -91,10 +96,40 @@ BndProcessor::~BndProcessor()
   if (branches_) {
     delete branches_;
   }
+  if (conflicts_) {
+    delete conflicts_;
+  }
   handlers_.clear();
 }
 
 
+void BndProcessor::addConflict_(NodePtr node, ConstSolutionPtr sol,
+                                SolutionPoolPtr s_pool)
+{
+  double best, cutoff;
+
+  if (!conflicts_) {
+    return;
+  }
+  switch (node->getStatus()) {
+   case (NodeInfeasible):
+     conflicts_->analyze(node, relaxation_, 0, INFINITY);
+     break;
+   case (NodeHitUb):
+     // same cutoff as in shouldPrune_().
+     best = s_pool->getBestSolutionValue();
+     cutoff = cutOff_;
+     if (best < INFINITY) {
+       cutoff = std::min(cutoff, best - std::max(oATol_, fabs(best)*oRTol_));
+     }
+     conflicts_->analyze(node, relaxation_, sol, cutoff);
+     break;
+   default:
+     break;
+  }
+}
+
+
 bool BndProcessor::foundNewSolution()
 {
   return (numSolutions_ > 0);
@@ -108,6 +143,17 @@ Branches BndProcessor::getBranches()
 }
 
 
+void BndProcessor::getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const
+{
+  for (HandlerConstIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+    (*h)->getGlobalBounds(lb, ub);
+  }
+  if (conflicts_) {
+    conflicts_->getGlobalBounds(lb, ub);
+  }
+}
+
+
 WarmStartPtr BndProcessor::getWarmStart()
 {
   return ws_;
@@ -159,6 +205,13 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
     branches_ = 0;
   }
 
+  // conflicts found in other nodes may prune this one or tighten bounds.
+  if (conflicts_ && node->getParent() && conflicts_->propagate(node, rel)) {
+    node->setStatus(NodeInfeasible);
+    ++stats_.inf;
+    return;
+  }
+
 #if 0
   double *svar = new double[20];
   bool xfeas = true;
@@ -224,6 +277,11 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
     // In either case we can prune. Also set lb of node.
     should_prune = shouldPrune_(node, sol->getObjValue(), s_pool);
     if (should_prune) {
+      // failures of the engine do not prove anything.
+      if (EngineError != engineStatus_ && FailedInfeas != engineStatus_ &&
+          EngineIterationLimit != engineStatus_) {
+        addConflict_(node, sol, s_pool);
+      }
       break;
     }
 
@@ -253,6 +311,7 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
       should_prune = true;
       node->setStatus(NodeInfeasible);
       stats_.inf++;
+      addConflict_(node, sol, s_pool);
       for(ModificationConstIterator miter = mods.begin(); miter != mods.end();
           ++miter) {
         delete *miter;
@@ -281,6 +340,9 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
   }
 #endif
 
+  if (conflicts_ && !node->getParent()) {
+    conflicts_->setRootBounds(relaxation_);
+  }
   return;
 }
 
@@ -411,8 +473,15 @@ bool BndProcessor::shouldPrune_(NodePtr node, double solval,
 }
 
 
+void BndProcessor::setConflictPool(ConflictPool *cp)
+{
+  conflicts_ = cp;
+}
+
+
 void BndProcessor::solveRelaxation_() 
 {
+  MNTR_TRACE_SCOPE("engine solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -433,6 +502,9 @@ void BndProcessor::writeStats(std::ostream &out) const
       << me_ << "nodes hit ub        = " << stats_.ub << std::endl 
       << me_ << "nodes with problems = " << stats_.prob << std::endl 
       ;
+  if (conflicts_) {
+    conflicts_->writeStats(out);
+  }
 }
 
 
@@ -18,6 +18,7 @@
 
 namespace Minotaur {
 
+  class ConflictPool;
   class Engine;
   class Problem;
   class Solution;
@@ -58,6 +59,9 @@ namespace Minotaur {
       // Find branches that will be used to branch at this node.
       Branches getBranches();
 
+      // Base class method.
+      void getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const;
+
       // Get warm-start information.
       WarmStartPtr getWarmStart();
 
@@ -65,6 +69,9 @@ namespace Minotaur {
       void process(NodePtr node, RelaxationPtr rel, 
                    SolutionPoolPtr s_pool);
 
+      // Base class method.
+      void setConflictPool(ConflictPool *cp);
+
       // write statistics. Base class method.
       void writeStats(std::ostream &out) const; 
 
@@ -82,6 +89,9 @@ namespace Minotaur {
        */
       bool contOnErr_;
 
+      /// Conflicts found in pruned nodes. NULL if conflicts are not used.
+      ConflictPool *conflicts_;
+
       /// If lb is greater than cutOff_, we can prune this node.
       double cutOff_;
 
@@ -118,6 +128,13 @@ namespace Minotaur {
       /// Warm-start information for start processing the children
       WarmStartPtr ws_;
 
+      /**
+       * Add a conflict from a node that is pruned as infeasible or by
+       * bound. sol is the solution of the relaxation, if any.
+       */
+      void addConflict_(NodePtr node, ConstSolutionPtr sol,
+                        SolutionPoolPtr s_pool);
+
       /**
        * Check if the solution is feasible to the original problem. 
        * In case it is feasible, we can store the solution and update the
@@ -18,6 +18,7 @@
 #include "Branch.h"
 #include "Modification.h"
 #include "Operations.h"
+#include "SlabAlloc.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -28,7 +29,8 @@ Branch::Branch()
 : pMods_(0),
   rMods_(0),
   activity_(INFINITY),
-  brCand_(0) // NULL
+  brCand_(0), // NULL
+  estimate_(-INFINITY)
 {
 
 }
@@ -58,6 +60,25 @@ Branch::~Branch()
 }
 
 
+static SlabAlloc *branchAlloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("Branch", sizeof(Branch));
+  return a;
+}
+
+
+void *Branch::operator new(size_t size)
+{
+  return branchAlloc_()->alloc(size);
+}
+
+
+void Branch::operator delete(void *p, size_t size)
+{
+  branchAlloc_()->free(p, size);
+}
+
+
 void Branch::addPMod(ModificationPtr mod) 
 {
   pMods_.push_back(mod);
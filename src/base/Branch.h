@@ -38,6 +38,12 @@ public:
   /// Destroy
   ~Branch();
 
+  /// Allocate from a SlabAlloc shared by all objects of this class.
+  static void *operator new(size_t size);
+
+  /// Return memory allocated by operator new.
+  static void operator delete(void *p, size_t size);
+
   /**
    * \brief Add a problem modification to the current vector of modifications
    * associated with this branch.
@@ -119,6 +125,15 @@ public:
   /// Return the branching candidate that was used to create this branch.
   BrCandPtr getBrCand() {return brCand_;};
 
+  /**
+   * \brief Return the estimate of the objective value of the best solution
+   * in the child created by this branch, or -INFINITY if not known.
+   */
+  double getEstimate() const { return estimate_; };
+
+  /// Set the estimate returned by getEstimate().
+  void setEstimate(double value) { estimate_ = value; };
+
   /// Write the branch to 'out'
   void write(std::ostream &out) const;
 
@@ -154,6 +169,9 @@ protected:
 
   /// Branching candidate that is used to create this branch. 
   BrCandPtr brCand_;
+
+  /// Estimate of the best solution in the child. See getEstimate().
+  double estimate_;
 };   
 }
 
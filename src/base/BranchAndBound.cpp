@@ -9,11 +9,17 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 
 #include "BranchAndBound.h"
+#include "CutManager.h"
 #include "MinotaurConfig.h"
+#include "SlabAlloc.h"
+#include "Telemetry.h"
+#include "Trace.h"
+#include "Variable.h"
 
 //#define MDBUG 1
 //#define SPEW 1
@@ -28,9 +34,11 @@ BranchAndBound::BranchAndBound()
     nodeRlxr_(0),
     options_(0),
     problem_(0),
+    restarts_(0),
     solPool_(0),
     stats_(0),
     status_(NotStarted),
+    telem_(0),
     timer_(0),
     tm_(0)
 { }
@@ -40,9 +48,11 @@ BranchAndBound::BranchAndBound(EnvPtr env, ProblemPtr p)
     nodePrcssr_(0),
     nodeRlxr_(0),
     problem_(p),
+    restarts_(0),
     solPool_(0),
     stats_(0),
-    status_(NotStarted)
+    status_(NotStarted),
+    telem_(0)
 {
   timer_ = env->getTimer();
   tm_ = (TreeManagerPtr) new TreeManager(env);
@@ -65,6 +75,9 @@ BranchAndBound::~BranchAndBound()
   if(stats_) {
     delete stats_;
   }
+  if(telem_) {
+    delete telem_;
+  }
   if(tm_) {
     delete tm_;
   }
@@ -80,6 +93,23 @@ void BranchAndBound::addPreRootHeur(HeurPtr h)
   preHeurs_.push_back(h);
 }
 
+void BranchAndBound::countFree_(RelaxationPtr rel, UInt* nvars, UInt* nints)
+{
+  VariablePtr v;
+
+  *nvars = *nints = 0;
+  for(VariableConstIterator it = rel->varsBegin(); it != rel->varsEnd();
+      ++it) {
+    v = *it;
+    if(v->getUb() - v->getLb() > 1e-6) {
+      ++(*nvars);
+      if(isInt_(v)) {
+        ++(*nints);
+      }
+    }
+  }
+}
+
 double BranchAndBound::getPerGap()
 {
   return tm_->getPerGap();
@@ -125,6 +155,12 @@ double BranchAndBound::getUb()
   return tm_->getUb();
 }
 
+bool BranchAndBound::isInt_(ConstVariablePtr v)
+{
+  return (v->getType() == Binary || v->getType() == Integer ||
+          v->getType() == ImplBin || v->getType() == ImplInt);
+}
+
 UInt BranchAndBound::numProcNodes()
 {
   return stats_->nodesProc;
@@ -146,7 +182,8 @@ NodePtr BranchAndBound::processRoot_(bool* should_prune, bool* should_dive)
   showStatusHead_();
   tm_->insertRoot(current_node);
 
-  if(options_->createRoot == true) {
+  // after a restart, the relaxation that was created first is used.
+  if(options_->createRoot == true && 0 == restarts_) {
     rel = nodeRlxr_->createRootRelaxation(current_node, solPool_, prune);
     rel->setProblem(problem_);
   } else {
@@ -164,6 +201,16 @@ NodePtr BranchAndBound::processRoot_(bool* should_prune, bool* should_dive)
 
     nodePrcssr_->processRootNode(current_node, rel, solPool_);
     ++stats_->nodesProc;
+    if(restarts_ < options_->restarts) {
+      // bounds at the root are valid in the whole tree.
+      rootLb_.clear();
+      rootUb_.clear();
+      for(VariableConstIterator it = rel->varsBegin(); it != rel->varsEnd();
+          ++it) {
+        rootLb_.push_back((*it)->getLb());
+        rootUb_.push_back((*it)->getUb());
+      }
+    }
     if(nodePrcssr_->foundNewSolution()) {
       tm_->setUb(solPool_->getBestSolutionValue());
     }
@@ -184,7 +231,9 @@ NodePtr BranchAndBound::processRoot_(bool* should_prune, bool* should_dive)
     tm_->removeActiveNode(current_node);
     *should_dive = tm_->shouldDive();
     new_node = tm_->branch(branches, current_node, ws);
-    assert((*should_dive && new_node) || (!(*should_dive) && !new_node));
+    assert(*should_dive || !new_node);
+    // the tree manager may choose not to dive, e.g. in best-estimate search.
+    *should_dive = (0 != new_node);
     if(!(*should_dive)) {
       nodeRlxr_->reset(current_node, false);
       new_node = tm_->getCandidate();
@@ -200,6 +249,41 @@ NodePtr BranchAndBound::processRoot_(bool* should_prune, bool* should_dive)
   return current_node;
 }
 
+void BranchAndBound::restart_()
+{
+  RelaxationPtr rel = nodeRlxr_->getRelaxation();
+  DoubleVector lb(rootLb_), ub(rootUb_);
+  UInt nvars0, nints0, nvars1, nints1;
+  VariablePtr v;
+
+  countFree_(rel, &nvars0, &nints0);
+  nodePrcssr_->getGlobalBounds(lb, ub);
+  // The bounds hold only for solutions better than the incumbent, so they
+  // are not applied to problem_, whose solutions are checked against its
+  // bounds.
+  for(UInt i = 0; i < lb.size() && i < rel->getNumVars(); ++i) {
+    v = rel->getVariable(i);
+    if(lb[i] > v->getLb() || ub[i] < v->getUb()) {
+      rel->changeBound(v, std::max(lb[i], v->getLb()),
+                       std::min(ub[i], v->getUb()));
+    }
+  }
+  countFree_(rel, &nvars1, &nints1);
+  ++restarts_;
+
+  logger_->msgStream(LogInfo)
+      << me_ << "restart " << restarts_ << " after " << stats_->nodesProc
+      << " nodes" << std::endl
+      << me_ << "free variables before restart = " << nvars0
+      << ", after = " << nvars1 << std::endl
+      << me_ << "free integer variables before restart = " << nints0
+      << ", after = " << nints1 << std::endl
+      << me_ << "constraints in relaxation = " << rel->getNumCons()
+      << std::endl;
+
+  tm_->restart();
+}
+
 void BranchAndBound::setLogLevel(LogLevel level)
 {
   logger_->setMaxLevel(level);
@@ -249,6 +333,39 @@ bool BranchAndBound::shouldPrune_(NodePtr node)
   return should_prune;
 }
 
+bool BranchAndBound::shouldRestart_()
+{
+  RelaxationPtr rel;
+  DoubleVector lb, ub;
+  UInt nfree = 0, nfixed = 0;
+  VariablePtr v;
+  const double etol = 1e-6;
+
+  if(restarts_ >= options_->restarts || rootLb_.empty() ||
+     stats_->nodesProc >= options_->restartNodes) {
+    return false;
+  }
+
+  rel = nodeRlxr_->getRelaxation();
+  lb = rootLb_;
+  ub = rootUb_;
+  nodePrcssr_->getGlobalBounds(lb, ub);
+  for(UInt i = 0; i < lb.size() && i < rel->getNumVars(); ++i) {
+    if(lb[i] > ub[i] + etol) {
+      // no better solution exists. The nodes will be pruned anyway.
+      return false;
+    }
+    v = rel->getVariable(i);
+    if(isInt_(v) && rootUb_[i] - rootLb_[i] > etol) {
+      ++nfree;
+      if(ub[i] - lb[i] <= etol) {
+        ++nfixed;
+      }
+    }
+  }
+  return (nfixed > 0 && nfixed >= options_->restartFrac * nfree);
+}
+
 bool BranchAndBound::shouldStop_()
 {
   bool stop_bnb = false;
@@ -307,6 +424,9 @@ void BranchAndBound::showStatusHead_()
 
 void BranchAndBound::showStatus_(bool current_uncounted, bool last_line)
 {
+  if(telem_ && (last_line || telem_->isDue())) {
+    writeTelemetry_(current_uncounted ? 1 : 0, last_line);
+  }
   if(timer_->query() - stats_->updateTime > options_->logInterval ||
      last_line == true) {
     UInt off = 0;
@@ -360,9 +480,17 @@ void BranchAndBound::solve()
   }
   stats_ = new BabStats();
 
+  if(telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
+  restarts_ = 0;
+  rootLb_.clear();
+  rootUb_.clear();
 
   // call heuristics before the root, if needed
   for(HeurVector::iterator it = preHeurs_.begin(); it != preHeurs_.end();
@@ -416,9 +544,13 @@ void BranchAndBound::solve()
 #endif
 
     should_dive = false;
-    rel =
-        nodeRlxr_->createNodeRelaxation(current_node, dived_prev, should_prune);
-    nodePrcssr_->process(current_node, rel, solPool_);
+    {
+      MNTR_TRACE_SCOPE("node");
+      TelemetryBusy busy(telem_, 0);
+      rel = nodeRlxr_->createNodeRelaxation(current_node, dived_prev,
+                                            should_prune);
+      nodePrcssr_->process(current_node, rel, solPool_);
+    }
 
     ++stats_->nodesProc;
 #if SPEW
@@ -457,8 +589,13 @@ void BranchAndBound::solve()
       }
       should_dive = tm_->shouldDive();
 
-      new_node = tm_->branch(branches, current_node, ws);
-      assert((should_dive && new_node) || (!should_dive && !new_node));
+      {
+        MNTR_TRACE_SCOPE("branch");
+        new_node = tm_->branch(branches, current_node, ws);
+      }
+      assert(should_dive || !new_node);
+      // the tree manager may choose not to dive, e.g. in best-estimate search.
+      should_dive = (0 != new_node);
       if(should_dive) {
         dived_prev = true;
       } else {
@@ -473,6 +610,13 @@ void BranchAndBound::solve()
 
     showStatus_(should_dive, false);
 
+    // restart only when the relaxation has been reset, i.e. not in a dive.
+    if(current_node && !dived_prev && shouldRestart_()) {
+      restart_();
+      should_prune = false;
+      current_node = processRoot_(&should_prune, &dived_prev);
+    }
+
     // stop if done
     if(!current_node) {
       tm_->updateLb();
@@ -519,7 +663,8 @@ void BranchAndBound::writeStats(std::ostream& out)
   out << me_ << "time taken      = " << std::fixed << std::setprecision(2)
       << stats_->timeUsed << std::endl
       << me_ << "nodes processed = " << stats_->nodesProc << std::endl
-      << me_ << "nodes created   = " << tm_->getSize() << std::endl;
+      << me_ << "nodes created   = " << tm_->getSize() << std::endl
+      << me_ << "restarts        = " << restarts_ << std::endl;
   nodePrcssr_->writeStats(out);
   nodePrcssr_->getBrancher()->writeStats(out);
   for(HeurVector::iterator it = preHeurs_.begin(); it != preHeurs_.end();
@@ -527,6 +672,26 @@ void BranchAndBound::writeStats(std::ostream& out)
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  SlabAlloc::writeStats(out);
+}
+
+void BranchAndBound::writeTelemetry_(UInt off, bool last_line)
+{
+  TelemetryRec rec;
+  CutManager *cutman = nodePrcssr_->getCutManager();
+
+  if(cutman) {
+    telem_->setCuts(0, cutman->getNumCuts());
+  }
+  rec.cpu = timer_->query();
+  rec.wall = timer_->wQuery();
+  rec.lb = tm_->getLb();
+  rec.ub = tm_->getUb();
+  rec.gap = tm_->getPerGap();
+  rec.nodesProc = stats_->nodesProc;
+  rec.nodesLeft = tm_->getActiveNodes() + off;
+  rec.sols = solPool_->getNumSolsFound();
+  telem_->write(rec, last_line);
 }
 
 double BranchAndBound::totalTime()
@@ -549,6 +714,9 @@ BabOptions::BabOptions()
   : createRoot(true),
     nodeLimit(0),
     perGapLimit(0.),
+    restartFrac(0.2),
+    restartNodes(0),
+    restarts(0),
     solLimit(0),
     timeLimit(0.)
 
@@ -561,6 +729,9 @@ BabOptions::BabOptions(EnvPtr env)
   logInterval = options->findDouble("log_interval")->getValue();
   nodeLimit = options->findInt("node_limit")->getValue();
   perGapLimit = options->findDouble("obj_gap_percent")->getValue();
+  restartFrac = options->findDouble("restart_frac")->getValue();
+  restartNodes = options->findInt("restart_nodes")->getValue();
+  restarts = options->findInt("restarts")->getValue();
   solLimit = options->findInt("sol_limit")->getValue();
   timeLimit = options->findDouble("time_limit")->getValue();
   createRoot = true;
@@ -29,6 +29,7 @@ namespace Minotaur {
 
   struct  BabOptions;
   struct  BabStats;
+  class   Telemetry;
   typedef BabOptions* BabOptionsPtr;
 
 
@@ -181,6 +182,15 @@ namespace Minotaur {
     /// The Problem that is solved using branch-and-bound.
     ProblemPtr problem_;
 
+    /// Number of restarts done in this solve.
+    UInt restarts_;
+
+    /// Lower bounds of variables of the relaxation after the root.
+    DoubleVector rootLb_;
+
+    /// Upper bounds of variables of the relaxation after the root.
+    DoubleVector rootUb_;
+
     /// The TreeManager used to manage the search tree.
     SolutionPoolPtr solPool_;
 
@@ -193,6 +203,9 @@ namespace Minotaur {
     /// The status of the branch-and-bound algorithm.
     SolveStatus status_;
 
+    /// Stream of progress for monitoring, if option telemetry_file is set.
+    Telemetry *telem_;
+
     /**
      * \brief Timer for keeping track of time.
      *
@@ -205,6 +218,18 @@ namespace Minotaur {
     /// The TreeManager used to manage the search tree.
     TreeManagerPtr tm_;
 
+    /**
+     * \brief Count the variables of the relaxation that are not fixed.
+     *
+     * \param [in] rel The relaxation.
+     * \param [out] nvars Number of variables that are not fixed.
+     * \param [out] nints Number of integer variables that are not fixed.
+     */
+    void countFree_(RelaxationPtr rel, UInt *nvars, UInt *nints);
+
+    /// Return true if the variable is binary or integer.
+    static bool isInt_(ConstVariablePtr v);
+
     /**
      * \brief Process the root node.
      *
@@ -213,9 +238,31 @@ namespace Minotaur {
      */
     NodePtr processRoot_(bool *should_prune, bool *should_dive);
 
+    /**
+     * \brief Restart the tree.
+     *
+     * This only re-roots the tree with tightened bounds. The global bounds,
+     * i.e., those at the root and those that the handlers found later, are
+     * changed in the relaxation only, since some of them come from reduced
+     * costs or the incumbent. Fixed variables stay in the relaxation and the
+     * problem is not changed. All nodes are deleted. The relaxation must
+     * have been reset. The root is then processed again by the caller.
+     * Solutions, cuts and pseudo costs are kept.
+     */
+    void restart_();
+
     /// Return True if a node can be pruned.
     bool shouldPrune_(NodePtr node);
 
+    /**
+     * \brief Return true if the tree should be restarted.
+     *
+     * It is restarted if at least the fraction restartFrac of the integer
+     * variables free at the root are fixed globally since, and fewer than
+     * restartNodes nodes have been processed.
+     */
+    bool shouldRestart_();
+
     /**
      * \brief Check whether the branch-and-bound can stop because of time
      * limit, or node limit or if solved?
@@ -231,6 +278,15 @@ namespace Minotaur {
      */
     void showStatus_(bool current_uncounted,bool last_line);
 
+    /**
+     * \brief Write a line of telemetry if it is due, or if last_line is
+     * true.
+     *
+     * \param [in] off One if the current node is not counted in the tree.
+     * \param [in] last_line True if the search has ended.
+     */
+    void writeTelemetry_(UInt off, bool last_line);
+
     void showStatusHead_();
   };
 
@@ -278,6 +334,18 @@ namespace Minotaur {
      */
     double perGapLimit;
 
+    /**
+     * \brief Fraction of integer variables, free at the root, that must be
+     * fixed globally for a restart.
+     */
+    double restartFrac;
+
+    /// Restart only while fewer than these many nodes are processed.
+    UInt restartNodes;
+
+    /// Maximum number of restarts, 0 for none.
+    UInt restarts;
+
     /// Limit on number of nodes processed.
     UInt solLimit;
 
@@ -31,6 +31,8 @@ using namespace Minotaur;
 CGraph::CGraph()
   : aNodes_(0),
     changed_(false),
+    fwdOk_(false),
+    gradOk_(false),
     hInds_(0),
     hNnz_(0),
     hOffs_(0),
@@ -185,6 +187,10 @@ void CGraph::computeBounds(double *lb, double *ub, int *error)
 
 double CGraph::eval(const double *x, int *error)
 {
+  if (isAt_(x)) {
+    return oNode_->getVal();
+  }
+  gradOk_ = false;
   for (CNodeQ::iterator it = vq_.begin(); it != vq_.end(); ++it) {
     (*it)->eval(x, error);
   }
@@ -195,6 +201,7 @@ double CGraph::eval(const double *x, int *error)
       break;
     }
   }
+  fwdOk_ = (0 == *error);
   return oNode_->getVal();
 }
 
@@ -205,9 +212,11 @@ void CGraph::evalGradient(const double *x, double *grad_f, int *error)
   if (*error > 0) {
     return;
   }
-  grad_(error);
-  if (*error > 0) {
-    return;
+  if (!gradOk_) {
+    grad_(error);
+    if (*error > 0) {
+      return;
+    }
   }
   for (CNodeQ::iterator it = vq_.begin(); it != vq_.end(); ++it) {
     grad_f[(*it)->getV()->getIndex()] += (*it)->getG();
@@ -233,8 +242,8 @@ void CGraph::evalHessian(double mult, const double *x, const LTHessStor *,
   // }
   // use2 = true;
 
-  // always eval. We do not assume that evaluations of x are already
-  // available. It creates a big mess and doesn't save much.
+  // values and gradients are reused if x has not changed since the last
+  // evaluation.
   eval(x, error);
   if (true == use2) {
     for (CNodeQ::iterator it = dq_.begin(); it != dq_.end(); ++it) {
@@ -249,7 +258,9 @@ void CGraph::evalHessian(double mult, const double *x, const LTHessStor *,
       (*it)->setH(0.0);
       (*it)->setTempI(0);
     }
-    grad_(error);
+    if (!gradOk_) {
+      grad_(error);
+    }
   }
 
   //std::cout << std::endl << " evaling hessian ";
@@ -502,9 +513,11 @@ void CGraph::fillJac(const double *x, double *values, int *error)
   if (*error > 0) {
     return;
   }
-  grad_(error);
-  if (*error > 0) {
-    return;
+  if (!gradOk_) {
+    grad_(error);
+    if (*error > 0) {
+      return;
+    }
   }
 
   for (VarNodeMap::iterator it = varNode_.begin(); it != varNode_.end();
@@ -563,6 +576,7 @@ void CGraph::finalize()
   UInt id = 0, index = 0;
   assert(oNode_);
   st.push(oNode_);
+  fwdOk_ = false;
 
   vq_.clear();
   dq_.clear();
@@ -648,6 +662,7 @@ void CGraph::finalize()
 
 void CGraph::fwdGrad_(CNode *node)
 {
+  gradOk_ = false;
   for (CNodeQ::iterator it = dq_.begin(); it != dq_.end(); ++it) {
     (*it)->setGi(0.0);
     (*it)->setG(0.0);
@@ -1100,6 +1115,7 @@ void CGraph::grad_(int *error)
   for (CNodeQ::reverse_iterator it = dq_.rbegin(); it != dq_.rend(); ++it) {
     (*it)->grad(error);
   }
+  gradOk_ = fwdOk_ && (0 == *error);
 }
 
 
@@ -1126,6 +1142,20 @@ void CGraph::getVars(VariableSet *vars)
 }
 
 
+bool CGraph::isAt_(const double *x) const
+{
+  if (!fwdOk_) {
+    return false;
+  }
+  for (CNodeQ::const_iterator it = vq_.begin(); it != vq_.end(); ++it) {
+    if ((*it)->getVal() != x[(*it)->getV()->getIndex()]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
 bool CGraph::isIdenticalTo(CGraphPtr cg)
 {
   CNodeVector::iterator it1, it2;
@@ -1321,6 +1351,7 @@ void CGraph::removeVar(VariablePtr v, double val)
     vars_.erase(v);
     varNode_.erase(it);
     changed_ = true;
+    fwdOk_ = false;
   }
 }
 
@@ -1392,6 +1423,8 @@ void CGraph::revHess2_(std::stack<CNode *> *st2, double mult, UInt vind,
 void CGraph::simplifyDq_()
 {
   UInt id = 1;
+
+  fwdOk_ = false;
   for (CNodeQ::iterator it = dq_.begin(); it != dq_.end();) {
     if (Constant == (*it)->findFType()) {
       it = dq_.erase(it);
@@ -1431,6 +1464,7 @@ void CGraph::subst(VariablePtr out, VariablePtr in, double rat)
   //std::cout << "substituting variable " << out->getName() << " by "
   //  << rat << " " << in->getName() << "\n";
   vars_.erase(out);
+  fwdOk_ = false;
 
   it = varNode_.find(out);
   nout = it->second;
@@ -1578,6 +1612,7 @@ void CGraph::subst(VariablePtr out, VariablePtr in, double rat)
 void CGraph::setOut(CNode *node)
 {
   oNode_ = node;
+  fwdOk_ = false;
 }
 
 
@@ -54,7 +54,11 @@ namespace Minotaur {
     // base class method.
     void computeBounds(double *lb, double *ub, int *error);
 
-    // Evaluate at a given array.
+    /**
+     * Evaluate at a given array. If the graph was last evaluated at the same
+     * values of its variables without error, the stored value is returned
+     * and the nodes are not visited again.
+     */
     double eval(const double *x, int *err);
 
     // Evaluate gradient at a given array.
@@ -211,6 +215,15 @@ namespace Minotaur {
 
     bool changed_;
 
+    /**
+     * True if values of all nodes are from an evaluation, without error, at
+     * the point held in the nodes of vq_.
+     */
+    bool fwdOk_;
+
+    /// True if fwdOk_ and the gradients (G) of all nodes are from grad_().
+    bool gradOk_;
+
     /// All dependent nodes, i.e. nodes with OpCode different from OpVar,
     /// OpInt and OpNum.
     CNodeQ dq_;
@@ -239,6 +252,9 @@ namespace Minotaur {
     void fwdGrad2_(std::stack<CNode *> *st2, CNode *node);
 
     void fillHessInds_(CNode *node, UIntQ *inds);
+
+    /// Return true if fwdOk_ and x has the values held in vq_.
+    bool isAt_(const double *x) const;
     void fillHessInds2_(CNode *node, UIntQ *inds);
 
     /// Recursive function to check whether CGraph represents a sum of
@@ -149,6 +149,9 @@ namespace Minotaur {
     /// \return The value of the boolean flag.
     bool getB() const { return b_; };
 
+    /// \return The constant value of an OpNum or OpInt node.
+    double getDouble() const { return d_; };
+
     /// \return The value of the gradient value.
     double getG() const { return g_; };
 
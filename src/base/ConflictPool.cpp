@@ -0,0 +1,370 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ConflictPool.cpp
+ * \brief Define the ConflictPool class that derives conflicts from pruned
+ * nodes and propagates them at other nodes.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "ConflictPool.h"
+#include "Environment.h"
+#include "Modification.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ConflictPool::me_ = "ConflictPool: ";
+
+ConflictPool::ConflictPool(EnvPtr env)
+  : eTol_(1e-6),
+    maxSize_(env->getOptions()->findInt("conflict_max_size")->getValue()),
+    maxConflicts_(env->getOptions()->findInt("conflict_pool_size")->getValue()),
+    next_(0)
+{
+  stats_.inf = 0;
+  stats_.cut = 0;
+  stats_.lits = 0;
+  stats_.nodual = 0;
+  stats_.dropped = 0;
+  stats_.pruned = 0;
+  stats_.tightened = 0;
+}
+
+
+ConflictPool::~ConflictPool()
+{
+  conflicts_.clear();
+  rootLb_.clear();
+  rootUb_.clear();
+}
+
+
+void ConflictPool::add_(const Conflict &c)
+{
+  if (0 == maxConflicts_) {
+    return;
+  }
+  if (conflicts_.size() < maxConflicts_) {
+    conflicts_.push_back(c);
+  } else {
+    conflicts_[next_] = c;
+    next_ = (next_ + 1) % maxConflicts_;
+  }
+}
+
+
+void ConflictPool::analyze(NodePtr node, RelaxationPtr rel,
+                           ConstSolutionPtr sol, double cutoff)
+{
+  Conflict c;
+  bool by_dual = false;
+
+  if (!node->getParent() || rootLb_.empty()) {
+    return;
+  }
+  by_dual = (sol && dualLits_(rel, sol, cutoff, c));
+  if (!by_dual) {
+    c.clear();
+    if (!branchLits_(node, c)) {
+      return;
+    }
+  }
+  if (c.empty()) {
+    return;
+  }
+  if (c.size() > maxSize_) {
+    ++stats_.dropped;
+    return;
+  }
+  if (by_dual) {
+    ++stats_.cut;
+  } else if (sol) {
+    ++stats_.nodual;
+  } else {
+    ++stats_.inf;
+  }
+  stats_.lits += c.size();
+  add_(c);
+}
+
+
+bool ConflictPool::branchLits_(NodePtr node, Conflict &c) const
+{
+  BranchPtr br;
+  VarBoundModPtr m;
+  VarBoundMod2Ptr m2;
+  Lit lits[2];
+  UInt nlits;
+
+  for (NodePtr n = node; n->getParent(); n = n->getParent()) {
+    br = n->getBranch();
+    if (!br || br->rModsBegin() == br->rModsEnd()) {
+      return false;
+    }
+    for (ModificationConstIterator it = br->rModsBegin();
+         it != br->rModsEnd(); ++it) {
+      m = dynamic_cast<VarBoundModPtr>(*it);
+      m2 = dynamic_cast<VarBoundMod2Ptr>(*it);
+      if (m) {
+        lits[0].var = m->getVar()->getIndex();
+        lits[0].lu = m->getLU();
+        lits[0].val = m->getNewVal();
+        nlits = 1;
+      } else if (m2) {
+        lits[0].var = lits[1].var = m2->getVar()->getIndex();
+        lits[0].lu = Lower;
+        lits[0].val = m2->getNewLb();
+        lits[1].lu = Upper;
+        lits[1].val = m2->getNewUb();
+        nlits = 2;
+      } else {
+        return false;
+      }
+      for (UInt i = 0; i < nlits; ++i) {
+        const Lit &l = lits[i];
+        bool found = false;
+        if (l.var >= rootLb_.size()) {
+          return false;
+        }
+        // bounds that hold at the root are not needed.
+        if ((Lower == l.lu && l.val <= rootLb_[l.var] + eTol_) ||
+            (Upper == l.lu && l.val >= rootUb_[l.var] - eTol_)) {
+          continue;
+        }
+        // deeper branches are seen first and are at least as tight.
+        for (Conflict::const_iterator it2 = c.begin(); it2 != c.end();
+             ++it2) {
+          if (it2->var == l.var && it2->lu == l.lu) {
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          c.push_back(l);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+
+bool ConflictPool::dualLits_(RelaxationPtr rel, ConstSolutionPtr sol,
+                             double cutoff, Conflict &c) const
+{
+  const double *x = sol->getPrimal();
+  const double *rc = sol->getDualOfVars();
+  const double slack = sol->getObjValue() - cutoff;
+  const UInt n = std::min((UInt) rootLb_.size(), rel->getNumVars());
+  std::vector<Lit> lits;
+  std::vector<std::pair<double, UInt> > loss;
+  double lb, ub, r, used;
+  Lit l;
+
+  if (!x || !rc || !(slack >= 0.0)) {
+    return false;
+  }
+
+  for (UInt j = 0; j < n; ++j) {
+    VariablePtr v = rel->getVariable(j);
+    lb = v->getLb();
+    ub = v->getUb();
+    r = fabs(rc[j]);
+    l.var = j;
+    // relaxing a bound to its root value lowers the bound from the duals
+    // by at most r times the change. The dual of a variable that is at its
+    // other bound only belongs to that bound.
+    if (lb > rootLb_[j] + eTol_) {
+      l.lu = Lower;
+      l.val = lb;
+      loss.push_back(std::make_pair(0.0, (UInt) lits.size()));
+      if (r > 0.0 && !(x[j] > lb + eTol_ && x[j] >= ub - eTol_)) {
+        loss.back().first = r*(lb - rootLb_[j]);
+      }
+      lits.push_back(l);
+    }
+    if (ub < rootUb_[j] - eTol_) {
+      l.lu = Upper;
+      l.val = ub;
+      loss.push_back(std::make_pair(0.0, (UInt) lits.size()));
+      if (r > 0.0 && !(x[j] < ub - eTol_ && x[j] <= lb + eTol_)) {
+        loss.back().first = r*(rootUb_[j] - ub);
+      }
+      lits.push_back(l);
+    }
+  }
+
+  std::sort(loss.begin(), loss.end());
+  used = 0.0;
+  for (std::vector<std::pair<double, UInt> >::const_iterator it
+       = loss.begin(); it != loss.end(); ++it) {
+    if (used + it->first <= slack) {
+      used += it->first;
+    } else {
+      c.push_back(lits[it->second]);
+    }
+  }
+  return true;
+}
+
+
+void ConflictPool::getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const
+{
+  for (std::vector<Conflict>::const_iterator it = conflicts_.begin();
+       it != conflicts_.end(); ++it) {
+    if (it->size() != 1 || (*it)[0].var >= lb.size()) {
+      continue;
+    }
+    const Lit &l = (*it)[0];
+    if (Lower == l.lu) {
+      ub[l.var] = std::min(ub[l.var], negate_(l));
+    } else {
+      lb[l.var] = std::max(lb[l.var], negate_(l));
+    }
+  }
+}
+
+
+double ConflictPool::negate_(const Lit &l) const
+{
+  bool is_int = (l.var < isInt_.size() && isInt_[l.var]);
+
+  if (Lower == l.lu) {
+    return is_int ? ceil(l.val - eTol_) - 1.0 : l.val;
+  }
+  return is_int ? floor(l.val + eTol_) + 1.0 : l.val;
+}
+
+
+bool ConflictPool::propagate(NodePtr node, RelaxationPtr rel)
+{
+  const UInt n = rel->getNumVars();
+  bool changed = true;
+  const Lit *free_lit;
+  UInt nfree;
+  VariablePtr v;
+  double val;
+  ModificationPtr mod;
+
+  // each pass tightens at least one bound. A few passes find nearly all.
+  for (UInt pass = 0; pass < 5 && changed; ++pass) {
+    changed = false;
+    for (std::vector<Conflict>::const_iterator it = conflicts_.begin();
+         it != conflicts_.end(); ++it) {
+      nfree = 0;
+      free_lit = 0;
+      for (Conflict::const_iterator it2 = it->begin(); it2 != it->end();
+           ++it2) {
+        if (it2->var >= n) {
+          nfree = 2;
+          break;
+        }
+        v = rel->getVariable(it2->var);
+        if (Lower == it2->lu) {
+          if (v->getLb() >= it2->val - eTol_) {
+            continue;
+          } else if (v->getUb() < it2->val - eTol_) {
+            nfree = 2;
+            break;
+          }
+        } else {
+          if (v->getUb() <= it2->val + eTol_) {
+            continue;
+          } else if (v->getLb() > it2->val + eTol_) {
+            nfree = 2;
+            break;
+          }
+        }
+        free_lit = &(*it2);
+        if (++nfree > 1) {
+          break;
+        }
+      }
+      if (0 == nfree) {
+        ++stats_.pruned;
+        return true;
+      } else if (1 == nfree) {
+        v = rel->getVariable(free_lit->var);
+        val = negate_(*free_lit);
+        if (Lower == free_lit->lu) {
+          if (val < v->getLb() - eTol_) {
+            ++stats_.pruned;
+            return true;
+          } else if (val < v->getUb() - eTol_) {
+            mod = (ModificationPtr) new VarBoundMod(v, Upper, val);
+            mod->applyToProblem(rel);
+            node->addRMod(mod);
+            ++stats_.tightened;
+            changed = true;
+          }
+        } else {
+          if (val > v->getUb() + eTol_) {
+            ++stats_.pruned;
+            return true;
+          } else if (val > v->getLb() + eTol_) {
+            mod = (ModificationPtr) new VarBoundMod(v, Lower, val);
+            mod->applyToProblem(rel);
+            node->addRMod(mod);
+            ++stats_.tightened;
+            changed = true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+
+void ConflictPool::setRootBounds(RelaxationPtr rel)
+{
+  VariableType t;
+
+  rootLb_.clear();
+  rootUb_.clear();
+  isInt_.clear();
+  for (VariableConstIterator it = rel->varsBegin(); it != rel->varsEnd();
+       ++it) {
+    rootLb_.push_back((*it)->getLb());
+    rootUb_.push_back((*it)->getUb());
+    t = (*it)->getType();
+    isInt_.push_back(Binary == t || Integer == t || ImplBin == t ||
+                     ImplInt == t);
+  }
+}
+
+
+void ConflictPool::writeStats(std::ostream &out) const
+{
+  UInt found = stats_.inf + stats_.cut + stats_.nodual;
+
+  out << me_ << "conflicts from infeasible nodes = " << stats_.inf
+      << std::endl
+      << me_ << "conflicts from nodes pruned by bound = " << stats_.cut
+      << std::endl
+      << me_ << "conflicts from nodes pruned by bound, without duals = "
+      << stats_.nodual << std::endl
+      << me_ << "conflicts too long = " << stats_.dropped << std::endl
+      << me_ << "average size of conflicts = " << std::fixed
+      << std::setprecision(2) << (found ? (double) stats_.lits/found : 0.0)
+      << std::endl
+      << me_ << "nodes pruned = " << stats_.pruned << std::endl
+      << me_ << "bounds tightened = " << stats_.tightened << std::endl;
+}
@@ -0,0 +1,184 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ConflictPool.h
+ * \brief Declare the ConflictPool class that derives conflicts from pruned
+ * nodes and propagates them at other nodes.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCONFLICTPOOL_H
+#define MINOTAURCONFLICTPOOL_H
+
+#include "Types.h"
+
+// Unit test, which checks the private methods.
+class ConflictPoolUT;
+
+namespace Minotaur {
+
+  class Node;
+  class Relaxation;
+  class Solution;
+  typedef Node* NodePtr;
+  typedef Relaxation* RelaxationPtr;
+  typedef const Solution* ConstSolutionPtr;
+
+  /// Statistics of conflicts.
+  struct ConflictStats {
+    UInt inf;       /// Conflicts found in infeasible nodes.
+    UInt cut;       /// Conflicts found from duals in nodes pruned by bound.
+    UInt lits;      /// Bound changes in all conflicts found.
+    UInt nodual;    /// Conflicts found from branching in nodes pruned by
+                    /// bound, when the duals could not be used.
+    UInt dropped;   /// Conflicts thrown away because they were too long.
+    UInt pruned;    /// Nodes pruned by conflicts.
+    UInt tightened; /// Bounds tightened by conflicts.
+  };
+
+  /**
+   * \brief Derive conflicts from nodes that are pruned, and propagate them
+   * at other nodes.
+   *
+   * A conflict is a set of bounds, e.g. \f$x_1 \geq 1, x_4 \leq 0, y \leq
+   * 2.5\f$, such that no solution better than the incumbent satisfies all of
+   * them. A node in which all but one of the bounds of a conflict hold must
+   * violate the remaining one, and a node in which all hold is pruned.
+   *
+   * When a node is pruned by bound and the relaxation has duals, the
+   * conflict has the bounds of the node that are tighter than those of the
+   * root. A bound is left out if the lower bound of the relaxation, less the
+   * reduced cost of the variable times the change in its bound, is still
+   * above the cutoff. Bounds with zero reduced cost are always left out, and
+   * others are left out in increasing order of this loss. The argument
+   * needs constraints of the relaxation that are valid in the whole tree,
+   * as in bnb and qg; it does not hold for relaxations that are built from
+   * the bounds of the node, as in glob. Otherwise, e.g. when a node is
+   * infeasible, the conflict has the bounds changed by branching from the
+   * root to the node.
+   *
+   * Conflicts longer than "conflict_max_size" are thrown away. At most
+   * "conflict_pool_size" conflicts are kept, and the oldest is replaced
+   * when the pool is full.
+   */
+  class ConflictPool {
+    friend class ::ConflictPoolUT;
+
+  public:
+    /// Constructor.
+    ConflictPool(EnvPtr env);
+
+    /// Destroy.
+    ~ConflictPool();
+
+    /**
+     * \brief Derive a conflict from a node that is pruned, and add it to
+     * the pool.
+     *
+     * \param[in] node The node. Nothing is done for the root.
+     * \param[in] rel Relaxation, with the bounds of the node.
+     * \param[in] sol Solution of the relaxation if the node is pruned by
+     * bound, NULL if it is infeasible.
+     * \param[in] cutoff Nodes with lower bound at or above this value are
+     * pruned.
+     */
+    void analyze(NodePtr node, RelaxationPtr rel, ConstSolutionPtr sol,
+                 double cutoff);
+
+    /**
+     * \brief Tighten lb and ub, indexed by variables of the relaxation,
+     * with conflicts that have one bound only.
+     */
+    void getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const;
+
+    /**
+     * \brief Propagate the conflicts in the bounds of a node.
+     *
+     * Bounds that are tightened are applied to rel and added to the node.
+     * \returns True if a conflict holds and the node can be pruned.
+     */
+    bool propagate(NodePtr node, RelaxationPtr rel);
+
+    /// Save the bounds of the variables of the relaxation at the root.
+    void setRootBounds(RelaxationPtr rel);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// A bound on a variable of the relaxation.
+    struct Lit {
+      UInt var;
+      BoundType lu;
+      double val;
+    };
+
+    /// A set of bounds that can not all hold.
+    typedef std::vector<Lit> Conflict;
+
+    /// Conflicts in the pool.
+    std::vector<Conflict> conflicts_;
+
+    /// Tolerance for comparing bounds.
+    const double eTol_;
+
+    /// True for integer variables of the relaxation, including binary.
+    std::vector<char> isInt_;
+
+    /// Conflicts longer than this are thrown away.
+    const UInt maxSize_;
+
+    /// Maximum number of conflicts kept.
+    const UInt maxConflicts_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Position in conflicts_ of the next conflict when the pool is full.
+    UInt next_;
+
+    /// Lower bounds of the variables at the root.
+    DoubleVector rootLb_;
+
+    /// Upper bounds of the variables at the root.
+    DoubleVector rootUb_;
+
+    /// Statistics.
+    ConflictStats stats_;
+
+    /// Add a conflict, replacing the oldest one if the pool is full.
+    void add_(const Conflict &c);
+
+    /**
+     * \brief Find the bounds changed by branching from the root to the
+     * node. Return false if a branch changes something other than a
+     * bound.
+     */
+    bool branchLits_(NodePtr node, Conflict &c) const;
+
+    /**
+     * \brief Find the bounds of the node that are needed to keep the lower
+     * bound from the duals of sol at or above the cutoff. Return false if
+     * sol has no duals.
+     */
+    bool dualLits_(RelaxationPtr rel, ConstSolutionPtr sol, double cutoff,
+                   Conflict &c) const;
+
+    /**
+     * \brief Return the bound that holds when lit is violated, of the same
+     * variable, in the other direction.
+     */
+    double negate_(const Lit &lit) const;
+
+    /// Copy constructor is not allowed.
+    ConflictPool(const ConflictPool &);
+
+    /// Copy by assignment is not allowed.
+    ConflictPool &operator=(const ConflictPool &);
+  };
+}
+#endif
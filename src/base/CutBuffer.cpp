@@ -0,0 +1,222 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file CutBuffer.cpp
+ * \brief Implement the methods of CutBuffer class.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "CutBuffer.h"
+#include "Function.h"
+#include "Problem.h"
+#include "Types.h"
+
+using namespace Minotaur;
+
+const std::string CutBuffer::me_ = "CutBuffer: ";
+
+
+CutBuffer::CutBuffer()
+  : nCuts_(0)
+{
+}
+
+
+CutBuffer::~CutBuffer()
+{
+  clear();
+}
+
+
+void CutBuffer::addCut(CutPtr c)
+{
+  push_(BufAddCut, c);
+}
+
+
+void CutBuffer::addCutToPool(CutPtr c)
+{
+  push_(BufAddToPool, c);
+}
+
+
+ConstraintPtr CutBuffer::addCut(ProblemPtr p, FunctionPtr f, double lb,
+                                double ub, bool direct_to_rel, bool never_del)
+{
+  return addNamedCut(p, f, lb, ub, direct_to_rel, never_del, "");
+}
+
+
+ConstraintPtr CutBuffer::addNamedCut(ProblemPtr p, FunctionPtr f, double lb,
+                                     double ub, bool direct_to_rel,
+                                     bool never_del, std::string name)
+{
+  BufCut b;
+  b.type = BufAddFun;
+  b.cut = 0;
+  b.p = p;
+  b.f = f;
+  b.lb = lb;
+  b.ub = ub;
+  b.directToRel = direct_to_rel;
+  b.neverDel = never_del;
+  b.name = name;
+  buf_.push_back(b);
+  ++nCuts_;
+  return ConstraintPtr();
+}
+
+
+void CutBuffer::addCuts(CutVectorIter cbeg, CutVectorIter cend)
+{
+  for (CutVectorIter it = cbeg; it != cend; ++it) {
+    addCut(*it);
+  }
+}
+
+
+void CutBuffer::clear()
+{
+  for (std::vector<BufCut>::iterator it = buf_.begin(); it != buf_.end();
+       ++it) {
+    if (it->cut) {
+      delete it->cut;
+    }
+    if (it->f) {
+      delete it->f;
+    }
+  }
+  buf_.clear();
+  nCuts_ = 0;
+}
+
+
+void CutBuffer::flush(CutManager *cutman, ProblemPtr p, ConstSolutionPtr sol,
+                      size_t *n_added)
+{
+  bool separated = false;
+  size_t n = 0;
+
+  *n_added = 0;
+  for (std::vector<BufCut>::iterator it = buf_.begin(); it != buf_.end();
+       ++it) {
+    if (!cutman) {
+      // no cut manager: the cuts go straight into the relaxation, as the
+      // handler would have added them itself.
+      if (it->cut) {
+        it->cut->applyToProblem(p);
+        delete it->cut;
+      } else if (it->f && it->name.empty()) {
+        it->p->newConstraint(it->f, it->lb, it->ub);
+      } else if (it->f) {
+        it->p->newConstraint(it->f, it->lb, it->ub, it->name);
+      }
+      continue;
+    }
+    switch (it->type) {
+    case (BufAddCut):
+      cutman->addCut(it->cut);
+      break;
+    case (BufAddToPool):
+      cutman->addCutToPool(it->cut);
+      break;
+    case (BufAddFun):
+      cutman->addCut(it->p, it->f, it->lb, it->ub, it->directToRel,
+                     it->neverDel);
+      break;
+    case (BufSeparate):
+      n = 0;
+      cutman->separate(p, sol, &separated, &n);
+      *n_added += n;
+      break;
+    default:
+      break;
+    }
+  }
+  // ownership of cuts and functions has passed on to cutman or p.
+  buf_.clear();
+  nCuts_ = 0;
+}
+
+
+size_t CutBuffer::getNumCuts() const
+{
+  return nCuts_;
+}
+
+
+size_t CutBuffer::getNumEnabledCuts() const
+{
+  return 0;
+}
+
+
+size_t CutBuffer::getNumDisabledCuts() const
+{
+  return nCuts_;
+}
+
+
+size_t CutBuffer::getNumNewCuts() const
+{
+  return nCuts_;
+}
+
+
+std::vector<ConstraintPtr> CutBuffer::getPoolCons()
+{
+  return std::vector<ConstraintPtr>();
+}
+
+
+void CutBuffer::postSolveUpdate(ConstSolutionPtr, EngineStatus)
+{
+}
+
+
+void CutBuffer::push_(BufCutType type, CutPtr c)
+{
+  BufCut b;
+  b.type = type;
+  b.cut = c;
+  b.p = 0;
+  b.f = 0;
+  b.lb = 0.0;
+  b.ub = 0.0;
+  b.directToRel = false;
+  b.neverDel = false;
+  buf_.push_back(b);
+  if (c) {
+    ++nCuts_;
+  }
+}
+
+
+void CutBuffer::separate(ProblemPtr, ConstSolutionPtr, bool *separated,
+                         size_t *n_added)
+{
+  push_(BufSeparate, 0);
+  *separated = (nCuts_ > 0);
+  *n_added = nCuts_;
+}
+
+
+void CutBuffer::write(std::ostream &out) const
+{
+  out << me_ << "cuts waiting to be flushed = " << nCuts_ << std::endl;
+}
+
+
+void CutBuffer::writeStats(std::ostream &out) const
+{
+  write(out);
+}
+
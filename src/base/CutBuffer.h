@@ -0,0 +1,150 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file CutBuffer.h
+ * \brief Declare a cut manager that only buffers cuts for later merging.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCUTBUFFER_H
+#define MINOTAURCUTBUFFER_H
+
+#include "CutManager.h"
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief A CutManager that does not touch any problem. It records all the
+   * cuts sent to it by one handler so that separation of several handlers can
+   * run concurrently. The recorded cuts are later sent to the real cut
+   * manager, one buffer at a time, by calling flush(). This keeps the order
+   * in which cuts reach the relaxation independent of the thread schedule.
+   */
+  class CutBuffer : public CutManager {
+
+  public:
+    /// Default constructor.
+    CutBuffer();
+
+    /// Destroy. Cuts that were not flushed are freed.
+    ~CutBuffer();
+
+    // Base class method.
+    void addCut(CutPtr c);
+
+    // Base class method.
+    void addCutToPool(CutPtr c);
+
+    /**
+     * Base class method. The cut is only recorded, and it is added to the
+     * relaxation when the buffer is flushed. Therefore, the returned
+     * constraint is always NULL.
+     */
+    ConstraintPtr addCut(ProblemPtr p, FunctionPtr f, double lb, double ub,
+                         bool direct_to_rel, bool never_del);
+
+    /**
+     * Base class method. Same as addCut() above. The name is kept for when
+     * the buffer is flushed without a cut manager.
+     */
+    ConstraintPtr addNamedCut(ProblemPtr p, FunctionPtr f, double lb,
+                              double ub, bool direct_to_rel, bool never_del,
+                              std::string name);
+
+    // Base class method.
+    void addCuts(CutVectorIter cbeg, CutVectorIter cend);
+
+    /// Discard all the recorded cuts without adding them anywhere.
+    void clear();
+
+    /**
+     * \brief Send all the recorded cuts to a cut manager in the order in
+     * which they were received, and empty the buffer.
+     *
+     * \param[in] cutman The cut manager that receives the cuts. If it is
+     * NULL, the cuts are added to the problems directly and recorded calls
+     * to separate() are ignored.
+     * \param[in] p The relaxation to which the cuts are added.
+     * \param[in] sol The solution that was separated.
+     * \param[out] n_added Number of cuts added to p by cutman in calls to
+     * separate() that the handler had requested.
+     */
+    void flush(CutManager *cutman, ProblemPtr p, ConstSolutionPtr sol,
+               size_t *n_added);
+
+    // Base class method.
+    size_t getNumCuts() const;
+
+    // Base class method.
+    size_t getNumEnabledCuts() const;
+
+    // Base class method.
+    size_t getNumDisabledCuts() const;
+
+    // Base class method.
+    size_t getNumNewCuts() const;
+
+    // Base class method.
+    std::vector<ConstraintPtr> getPoolCons();
+
+    // Base class method. Does nothing.
+    void postSolveUpdate(ConstSolutionPtr sol, EngineStatus e_status);
+
+    /**
+     * Base class method. Only records that separate should be called on the
+     * real cut manager at the time of flushing. separated is true and n_added
+     * is positive if some cuts are waiting in the buffer.
+     */
+    void separate(ProblemPtr p, ConstSolutionPtr sol, bool *separated,
+                  size_t *n_added);
+
+    // Base class method.
+    void write(std::ostream &out) const;
+
+    // Base class method.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// What to do with a recorded cut when flushing.
+    enum BufCutType {
+      BufAddCut,      /// Call addCut(CutPtr).
+      BufAddToPool,   /// Call addCutToPool(CutPtr).
+      BufAddFun,      /// Call addCut(ProblemPtr, FunctionPtr, ...).
+      BufSeparate     /// Call separate().
+    };
+
+    /// One entry of the buffer.
+    struct BufCut {
+      BufCutType type;
+      CutPtr cut;
+      ProblemPtr p;
+      FunctionPtr f;
+      double lb;
+      double ub;
+      bool directToRel;
+      bool neverDel;
+      std::string name;
+    };
+
+    /// Recorded calls, in order.
+    std::vector<BufCut> buf_;
+
+    /// For logging.
+    const static std::string me_;
+
+    /// Number of cuts in buf_.
+    size_t nCuts_;
+
+    /// Append an entry with the given type and cut.
+    void push_(BufCutType type, CutPtr c);
+  };
+
+  typedef CutBuffer* CutBufferPtr;
+}  //namespace Minotaur
+#endif
+
@@ -77,6 +77,17 @@ namespace Minotaur {
                                  double ub, bool direct_to_rel,
                                  bool never_del) = 0;
 
+    /**
+     * \brief Same as addCut() above, with a name for the constraint. Cut
+     * managers that do not name their constraints ignore it.
+     */
+    virtual ConstraintPtr addNamedCut(ProblemPtr p, FunctionPtr f, double lb,
+                                      double ub, bool direct_to_rel,
+                                      bool never_del, std::string)
+    {
+      return addCut(p, f, lb, ub, direct_to_rel, never_del);
+    };
+
     /**
      * \brief Add a cut to be managed by the cut manager. The cut is not added
      * to the problem by this function (See separate() for it).
@@ -0,0 +1,509 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Decomposer.cpp
+ * \brief Define the Decomposer class that splits a problem into independent
+ * components and solves them separately.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Decomposer.h"
+#include "Engine.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "NonlinearFunction.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "SOS.h"
+#include "Solution.h"
+#include "Timer.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string Decomposer::me_ = "Decomposer: ";
+
+Decomposer::Decomposer(EnvPtr env, ProblemPtr p)
+  : env_(env),
+    lb_(-INFINITY),
+    p_(p),
+    sol_(0)
+{
+  stats_.comps = 0;
+  stats_.tiny = 0;
+  stats_.largest = 0;
+  stats_.time = 0.0;
+}
+
+
+Decomposer::~Decomposer()
+{
+  if (sol_) {
+    delete sol_;
+  }
+  compVars_.clear();
+  compOf_.clear();
+  tiny_.clear();
+}
+
+
+ProblemPtr Decomposer::extract_(UInt i)
+{
+  ProblemPtr cp = (ProblemPtr) new Problem(env_);
+  VarVector nvars(p_->getNumVars(), 0);
+  VariableConstIterator vbeg;
+  ObjectivePtr o = p_->getObjective();
+  FunctionPtr f;
+  VariablePtr v;
+  VarVector svars;
+  int err = 0;
+
+  for (VarVector::iterator it = compVars_[i].begin();
+       it != compVars_[i].end(); ++it) {
+    v = *it;
+    nvars[v->getIndex()] = cp->newVariable(v->getLb(), v->getUb(),
+                                           v->getType(), v->getName(),
+                                           v->getSrcType());
+  }
+  // functions of this component refer only to variables of this component,
+  // so the null entries of nvars are never used while cloning.
+  vbeg = nvars.begin();
+
+  for (ConstraintConstIterator it = p_->consBegin(); it != p_->consEnd();
+       ++it) {
+    f = (*it)->getFunction();
+    if (!f || 0 == f->getNumVars() ||
+        compOf_[(*f->varsBegin())->getIndex()] != i) {
+      continue;
+    }
+    cp->newConstraint(f->cloneWithVars(vbeg, &err), (*it)->getLb(),
+                      (*it)->getUb(), (*it)->getName());
+    assert(0 == err);
+  }
+
+  for (int k = 0; k < 2; ++k) {
+    SOSConstIterator sbeg = (0 == k) ? p_->sos1Begin() : p_->sos2Begin();
+    SOSConstIterator send = (0 == k) ? p_->sos1End() : p_->sos2End();
+    for (SOSConstIterator it = sbeg; it != send; ++it) {
+      if ((*it)->getNz() == 0 ||
+          compOf_[(*(*it)->varsBegin())->getIndex()] != i) {
+        continue;
+      }
+      svars.clear();
+      for (VariableConstIterator vit = (*it)->varsBegin();
+           vit != (*it)->varsEnd(); ++vit) {
+        svars.push_back(nvars[(*vit)->getIndex()]);
+      }
+      cp->newSOS((*it)->getNz(), (*it)->getType(), (*it)->getWeights(), svars,
+                 (*it)->getPriority(), (*it)->getName());
+    }
+  }
+
+  if (o) {
+    LinearFunctionPtr lf = 0;
+    QuadraticFunctionPtr qf = 0;
+    NonlinearFunctionPtr nlf = 0;
+    double cb = (0 == i) ? o->getConstant() : 0.0;
+
+    f = o->getFunction();
+    if (f && f->getLinearFunction()) {
+      LinearFunctionPtr olf = f->getLinearFunction();
+      lf = (LinearFunctionPtr) new LinearFunction();
+      for (VariableGroupConstIterator it = olf->termsBegin();
+           it != olf->termsEnd(); ++it) {
+        if (compOf_[it->first->getIndex()] == i) {
+          lf->addTerm(nvars[it->first->getIndex()], it->second);
+        }
+      }
+      if (0 == lf->getNumTerms()) {
+        delete lf;
+        lf = 0;
+      }
+    }
+    if (f && f->getQuadraticFunction()) {
+      QuadraticFunctionPtr oqf = f->getQuadraticFunction();
+      qf = (QuadraticFunctionPtr) new QuadraticFunction();
+      for (VariablePairGroupConstIterator it = oqf->begin(); it != oqf->end();
+           ++it) {
+        if (compOf_[it->first.first->getIndex()] == i) {
+          qf->addTerm(nvars[it->first.first->getIndex()],
+                      nvars[it->first.second->getIndex()], it->second);
+        }
+      }
+      if (0 == qf->getNumTerms()) {
+        delete qf;
+        qf = 0;
+      }
+    }
+    if (f && f->getNonlinearFunction() &&
+        f->getNonlinearFunction()->numVars() > 0 &&
+        compOf_[(*f->getNonlinearFunction()->varsBegin())->getIndex()] == i) {
+      nlf = f->getNonlinearFunction()->cloneWithVars(vbeg, &err);
+      assert(0 == err);
+    }
+    if (lf || qf || nlf) {
+      cp->newObjective((FunctionPtr) new Function(lf, qf, nlf), cb,
+                       o->getObjectiveType());
+    } else {
+      cp->newObjective(cb, o->getObjectiveType());
+    }
+  }
+
+  cp->calculateSize();
+  cp->setNativeDer();
+  return cp;
+}
+
+
+UInt Decomposer::find_(UIntVector &par, UInt i)
+{
+  UInt r = i;
+  while (par[r] != r) {
+    r = par[r];
+  }
+  while (par[i] != r) {
+    UInt nxt = par[i];
+    par[i] = r;
+    i = nxt;
+  }
+  return r;
+}
+
+
+UInt Decomposer::findComponents()
+{
+  UInt n = p_->getNumVars();
+  UIntVector par(n), root(n, n);
+  ObjectivePtr o = p_->getObjective();
+  FunctionPtr f;
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  for (UInt i = 0; i < n; ++i) {
+    par[i] = i;
+  }
+
+  for (ConstraintConstIterator it = p_->consBegin(); it != p_->consEnd();
+       ++it) {
+    unite_(par, (*it)->getFunction(), false);
+  }
+  for (int k = 0; k < 2; ++k) {
+    SOSConstIterator sbeg = (0 == k) ? p_->sos1Begin() : p_->sos2Begin();
+    SOSConstIterator send = (0 == k) ? p_->sos1End() : p_->sos2End();
+    for (SOSConstIterator it = sbeg; it != send; ++it) {
+      if ((*it)->getNz() == 0) {
+        continue;
+      }
+      UInt r0 = find_(par, (*(*it)->varsBegin())->getIndex());
+      for (VariableConstIterator vit = (*it)->varsBegin();
+           vit != (*it)->varsEnd(); ++vit) {
+        par[find_(par, (*vit)->getIndex())] = r0;
+      }
+    }
+  }
+  f = o ? o->getFunction() : 0;
+  if (f) {
+    unite_(par, f, true);
+  }
+
+  // number components in the order of their smallest variable.
+  compVars_.clear();
+  compOf_.assign(n, 0);
+  for (UInt i = 0; i < n; ++i) {
+    UInt r = find_(par, i);
+    if (root[r] == n) {
+      root[r] = compVars_.size();
+      compVars_.push_back(VarVector());
+    }
+    compOf_[i] = root[r];
+    compVars_[root[r]].push_back(p_->getVariable(i));
+  }
+
+  tiny_.assign(compVars_.size(), true);
+  for (UInt i = 0; i < n; ++i) {
+    if (p_->getVariable(i)->getNumCons() > 0) {
+      tiny_[compOf_[i]] = false;
+    }
+  }
+  for (int k = 0; k < 2; ++k) {
+    SOSConstIterator sbeg = (0 == k) ? p_->sos1Begin() : p_->sos2Begin();
+    SOSConstIterator send = (0 == k) ? p_->sos1End() : p_->sos2End();
+    for (SOSConstIterator it = sbeg; it != send; ++it) {
+      if ((*it)->getNz() > 0) {
+        tiny_[compOf_[(*(*it)->varsBegin())->getIndex()]] = false;
+      }
+    }
+  }
+  if (f && f->getQuadraticFunction()) {
+    QuadraticFunctionPtr qf = f->getQuadraticFunction();
+    for (VarIntMapConstIterator it = qf->varsBegin(); it != qf->varsEnd();
+         ++it) {
+      tiny_[compOf_[it->first->getIndex()]] = false;
+    }
+  }
+  if (f && f->getNonlinearFunction()) {
+    NonlinearFunctionPtr nlf = f->getNonlinearFunction();
+    for (VariableSet::iterator it = nlf->varsBegin(); it != nlf->varsEnd();
+         ++it) {
+      tiny_[compOf_[(*it)->getIndex()]] = false;
+    }
+  }
+
+  stats_.comps = compVars_.size();
+  stats_.largest = 0;
+  for (UInt i = 0; i < compVars_.size(); ++i) {
+    stats_.largest = std::max(stats_.largest, (UInt)compVars_[i].size());
+  }
+  stats_.time += timer->query();
+  delete timer;
+
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << "number of components = " << stats_.comps
+      << ", largest has " << stats_.largest << " variables" << std::endl;
+  return compVars_.size();
+}
+
+
+EnvPtr Decomposer::newEnv_(UInt i)
+{
+  EnvPtr env = env_->clone();
+  OptionDBPtr options = env->getOptions();
+  StringOptionPtr tfile = options->findString("telemetry_file");
+  DoubleOptionPtr tlimit = options->findDouble("time_limit");
+
+  // components run at the same time must not write to the same file.
+  if (tfile->getValue() != "" &&
+      0 != tfile->getValue().compare(0, 5, "unix:")) {
+    std::ostringstream s;
+    s << tfile->getValue() << ".comp" << i;
+    tfile->setValue(s.str());
+  }
+  tlimit->setValue(std::max(tlimit->getValue() - env_->getTime(), 0.0));
+  return env;
+}
+
+
+SolveStatus Decomposer::solve(CompSolver solver)
+{
+  UInt nc = compVars_.size();
+  std::vector<ProblemPtr> probs(nc, 0);
+  std::vector<EnvPtr> envs(nc, 0);
+  std::vector<SolutionPtr> sols(nc, 0);
+  std::vector<SolveStatus> stat(nc, NotStarted);
+  DoubleVector lbs(nc, -INFINITY);
+  DoubleVector x(p_->getNumVars(), 0.0);
+  UIntVector order;
+  int threads = env_->getOptions()->findInt("decompose_threads")->getValue();
+  SolveStatus status = SolvedOptimal;
+  bool have_x = true;
+  Timer *timer = env_->getNewTimer();
+  int err = 0;
+
+  timer->start();
+  for (UInt i = 0; i < nc; ++i) {
+    if (tiny_[i]) {
+      stat[i] = solveTiny_(i, x, lbs[i]);
+      ++stats_.tiny;
+    } else {
+      probs[i] = extract_(i);
+      envs[i] = newEnv_(i);
+      order.push_back(i);
+    }
+  }
+
+  // largest components first, so that threads are not left waiting for one
+  // big component at the end.
+  std::stable_sort(order.begin(), order.end(), [this](UInt a, UInt b) {
+    return compVars_[a].size() > compVars_[b].size();
+  });
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << "solving " << order.size() << " components using "
+      << std::max(threads, 1) << " threads" << std::endl;
+
+#pragma omp parallel for num_threads(std::max(threads, 1)) schedule(dynamic)
+  for (UInt k = 0; k < order.size(); ++k) {
+    UInt i = order[k];
+    stat[i] = solver(envs[i], probs[i], sols[i], lbs[i]);
+  }
+
+  lb_ = 0.0;
+  for (UInt i = 0; i < nc; ++i) {
+    lb_ += lbs[i];
+    if (SolvedOptimal != stat[i] && SolvedOptimal == status) {
+      status = stat[i];
+    }
+    if (SolvedInfeasible == stat[i] || SolvedUnbounded == stat[i]) {
+      status = stat[i];
+    }
+    if (tiny_[i]) {
+      continue;
+    }
+    if (sols[i] && sols[i]->getPrimal()) {
+      const double *cx = sols[i]->getPrimal();
+      for (UInt j = 0; j < compVars_[i].size(); ++j) {
+        x[compVars_[i][j]->getIndex()] = cx[j];
+      }
+    } else {
+      have_x = false;
+    }
+    if (sols[i]) {
+      delete sols[i];
+    }
+    delete probs[i];
+    delete envs[i];
+  }
+  if (SolvedInfeasible == status || SolvedUnbounded == status) {
+    have_x = false;
+  }
+
+  if (sol_) {
+    delete sol_;
+    sol_ = 0;
+  }
+  if (have_x) {
+    sol_ = (SolutionPtr) new Solution(p_->getObjValue(&x[0], &err), x, p_);
+  }
+  stats_.time += timer->query();
+  delete timer;
+
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << "status of components = " << getSolveStatusString(status)
+      << std::endl;
+  return status;
+}
+
+
+SolveStatus Decomposer::solveContinuous(EnginePtr e, ProblemPtr p,
+                                        SolutionPtr &sol, double &lb)
+{
+  SolveStatus status = SolveError;
+  EngineStatus es;
+
+  sol = 0;
+  lb = -INFINITY;
+  e->load(p);
+  es = e->solve();
+  switch (es) {
+  case (ProvenOptimal):
+  case (ProvenLocalOptimal):
+    status = SolvedOptimal;
+    lb = e->getSolutionValue();
+    break;
+  case (ProvenInfeasible):
+  case (ProvenLocalInfeasible):
+    status = SolvedInfeasible;
+    lb = INFINITY;
+    break;
+  case (ProvenUnbounded):
+    status = SolvedUnbounded;
+    break;
+  default:
+    break;
+  }
+  if (SolvedOptimal == status && e->getSolution()) {
+    sol = (SolutionPtr) new Solution(e->getSolution());
+  }
+  e->clear();
+  return status;
+}
+
+
+SolveStatus Decomposer::solveTiny_(UInt i, DoubleVector &x, double &lb)
+{
+  ObjectivePtr o = p_->getObjective();
+  FunctionPtr f = o ? o->getFunction() : 0;
+  LinearFunctionPtr lf = f ? f->getLinearFunction() : 0;
+  VariablePtr v;
+  double c, val;
+
+  lb = (o && 0 == i) ? o->getConstant() : 0.0;
+  for (VarVector::iterator it = compVars_[i].begin();
+       it != compVars_[i].end(); ++it) {
+    v = *it;
+    c = lf ? lf->getWeight(v) : 0.0;
+    if (c > 0) {
+      val = v->getLb();
+    } else if (c < 0) {
+      val = v->getUb();
+    } else {
+      val = std::max(v->getLb(), std::min(0.0, v->getUb()));
+    }
+    if (std::isinf(val)) {
+      lb = -INFINITY;
+      return SolvedUnbounded;
+    }
+    if (v->getType() == Binary || v->getType() == Integer) {
+      val = (c > 0) ? ceil(val - 1e-6) : floor(val + 1e-6);
+      if (val < v->getLb() - 1e-6 || val > v->getUb() + 1e-6) {
+        lb = INFINITY;
+        return SolvedInfeasible;
+      }
+    }
+    x[v->getIndex()] = val;
+    lb += c * val;
+  }
+  return SolvedOptimal;
+}
+
+
+void Decomposer::unite_(UIntVector &par, FunctionPtr f, bool skip_lin)
+{
+  if (!f) {
+    return;
+  }
+  if (false == skip_lin) {
+    if (0 == f->getNumVars()) {
+      return;
+    }
+    UInt r0 = find_(par, (*f->varsBegin())->getIndex());
+    for (VarSetConstIterator it = f->varsBegin(); it != f->varsEnd(); ++it) {
+      par[find_(par, (*it)->getIndex())] = r0;
+    }
+    return;
+  }
+
+  // only quadratic terms and the nonlinear part join variables.
+  if (f->getQuadraticFunction()) {
+    QuadraticFunctionPtr qf = f->getQuadraticFunction();
+    for (VariablePairGroupConstIterator it = qf->begin(); it != qf->end();
+         ++it) {
+      par[find_(par, it->first.first->getIndex())] =
+          find_(par, it->first.second->getIndex());
+    }
+  }
+  if (f->getNonlinearFunction() && f->getNonlinearFunction()->numVars() > 0) {
+    NonlinearFunctionPtr nlf = f->getNonlinearFunction();
+    UInt r0 = find_(par, (*nlf->varsBegin())->getIndex());
+    for (VariableSet::iterator it = nlf->varsBegin(); it != nlf->varsEnd();
+         ++it) {
+      par[find_(par, (*it)->getIndex())] = r0;
+    }
+  }
+}
+
+
+void Decomposer::writeStats(std::ostream &out) const
+{
+  out << me_ << "number of components = " << stats_.comps << std::endl
+      << me_ << "components solved at bounds = " << stats_.tiny << std::endl
+      << me_ << "variables in largest component = " << stats_.largest
+      << std::endl
+      << me_ << "time used (s) = " << std::fixed << std::setprecision(2)
+      << stats_.time << std::endl;
+}
@@ -0,0 +1,167 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Decomposer.h
+ * \brief Declare the Decomposer class that splits a problem into independent
+ * components and solves them separately.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURDECOMPOSER_H
+#define MINOTAURDECOMPOSER_H
+
+#include <functional>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Engine;
+  class Solution;
+  typedef Engine* EnginePtr;
+  typedef Solution* SolutionPtr;
+
+  /// Statistics of decomposition.
+  struct DecompStats {
+    UInt comps;    /// Number of components found.
+    UInt tiny;     /// Components solved by looking at bounds only.
+    UInt largest;  /// Number of variables in the largest component.
+    double time;   /// Time spent in finding, solving and combining.
+  };
+
+  /**
+   * \brief Find connected components of the graph in which variables are
+   * nodes and two variables are adjacent if they appear together in a
+   * constraint, an SOS constraint, a quadratic term of the objective, or
+   * the nonlinear part of the objective. The linear part of the objective
+   * does not connect variables.
+   *
+   * If there are two or more components, each one is copied into a new
+   * Problem and solved by a function given by the solver, possibly in
+   * parallel. Components that have no constraints are solved here by
+   * setting each variable to its best bound. The solutions are then combined
+   * into one solution of the original problem, which can be post-solved by
+   * the Presolver as usual.
+   *
+   * Only problems whose nonlinear functions can be cloned (CGraph) should be
+   * decomposed.
+   */
+  class Decomposer {
+  public:
+    /**
+     * Function that solves one component in the given environment. It
+     * returns the status, the solution (which is then owned by the
+     * Decomposer, may be NULL) and a lower bound on the optimal value of the
+     * component.
+     */
+    typedef std::function<SolveStatus (EnvPtr, ProblemPtr, SolutionPtr &,
+                                       double &)> CompSolver;
+
+    /// Constructor for a given problem. The problem is not modified.
+    Decomposer(EnvPtr env, ProblemPtr p);
+
+    /// Destroy.
+    ~Decomposer();
+
+    /// Find components and return how many were found.
+    UInt findComponents();
+
+    /// Return the lower bound obtained by adding bounds of all components.
+    double getLb() const { return lb_; };
+
+    /// Return the number of components found by findComponents().
+    UInt getNumComponents() const { return compVars_.size(); };
+
+    /**
+     * Return the solution of the original problem combined from solutions
+     * of components, or NULL if some component has no solution. It is owned
+     * by the Decomposer.
+     */
+    SolutionPtr getSolution() const { return sol_; };
+
+    /**
+     * \brief Solve all components and combine their solutions.
+     *
+     * \param[in] solver Function called to solve each component that has
+     * constraints. It is called from as many threads as the option
+     * "decompose_threads", so it must not modify shared data. Each call gets
+     * its own copy of the environment, with its own logger, the time that is
+     * left, and its own telemetry_file.
+     *
+     * \returns SolvedOptimal if all components were solved, otherwise the
+     * status of the first component that was not solved to optimality.
+     */
+    SolveStatus solve(CompSolver solver);
+
+    /**
+     * \brief Solve a component that has no integer variables with one call
+     * to the engine. Meant to be called from the function that solves
+     * components, when the local solution found by the engine is also
+     * optimal for the component (e.g. it is an LP or convex).
+     *
+     * \param[in] e Engine. It is cleared after the solve.
+     * \param[in] p The component.
+     * \param[out] sol A new solution, if the engine found one.
+     * \param[out] lb The lower bound on the optimal value.
+     */
+    static SolveStatus solveContinuous(EnginePtr e, ProblemPtr p,
+                                       SolutionPtr &sol, double &lb);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Variables of each component, in the order of their indices.
+    std::vector<VarVector> compVars_;
+
+    /// Component of each variable.
+    UIntVector compOf_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Lower bound, sum of bounds of all components.
+    double lb_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem that is decomposed.
+    ProblemPtr p_;
+
+    /// Combined solution.
+    SolutionPtr sol_;
+
+    /// Statistics.
+    DecompStats stats_;
+
+    /**
+     * True for components that have no constraints and whose variables
+     * appear only in the linear part of the objective.
+     */
+    std::vector<bool> tiny_;
+
+    /// Create the problem for component i.
+    ProblemPtr extract_(UInt i);
+
+    /// Create the environment in which component i is solved.
+    EnvPtr newEnv_(UInt i);
+
+    /// Return the root of var i in the union-find forest, compressing paths.
+    UInt find_(UIntVector &par, UInt i);
+
+    /**
+     * Solve component i, that has no constraints, by putting variables at
+     * bounds. x is filled with values of all variables of the problem.
+     */
+    SolveStatus solveTiny_(UInt i, DoubleVector &x, double &lb);
+
+    /// Join the components of all variables of f.
+    void unite_(UIntVector &par, FunctionPtr f, bool skip_lin);
+  };
+}
+#endif
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <chrono>
 #include "mpi.h"
 #if USE_OPENMP
 #include <omp.h>
@@ -39,6 +40,7 @@
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Branch.h"
 #include "BrCand.h"
@@ -51,7 +53,7 @@
 #define TAG_Terminate 0
 #define TAG_NodeFound 1
 #define TAG_Wait 2
-#define TAG_Ub 3
+#define TAG_Ub 3 // value, time when found and point of an incumbent
 #define TAG_Lb 4
 
 using namespace Minotaur;
@@ -67,10 +69,17 @@ DistParBranchAndBound::DistParBranchAndBound()
     solPool_(0),
     stats_(0),
     status_(NotStarted),
+    telem_(0),
     timer_(0),
     tm_(0),
     proc_rank_(0),
-    num_procs_(0)
+    num_procs_(0),
+    commThread_(0),
+    commStop_(false),
+    distributed_(false),
+    commUb_(INFINITY),
+    solInPending_(false),
+    solPending_(false)
 {
 }
 
@@ -81,7 +90,14 @@ DistParBranchAndBound::DistParBranchAndBound(EnvPtr env, ProblemPtr p, UInt proc
     problem_(p),
     solPool_(0),
     stats_(0),
-    status_(NotStarted)
+    status_(NotStarted),
+    telem_(0),
+    commThread_(0),
+    commStop_(false),
+    distributed_(false),
+    commUb_(INFINITY),
+    solInPending_(false),
+    solPending_(false)
 {
   timer_ = env->getNewTimer();
   tm_ = (ParTreeManagerPtr) new ParTreeManager(env);
@@ -94,6 +110,11 @@ DistParBranchAndBound::DistParBranchAndBound(EnvPtr env, ProblemPtr p, UInt proc
 
 DistParBranchAndBound::~DistParBranchAndBound()
 {
+  stopComm_();
+  for (UInt i = 0; i < sendReqs_.size(); ++i) {
+    delete sendReqs_[i].second;
+  }
+  sendReqs_.clear();
   problem_ = 0;
   env_ = 0;
   nodeRlxr_ = 0;
@@ -107,6 +128,9 @@ DistParBranchAndBound::~DistParBranchAndBound()
   if (stats_) {
     delete stats_;
   }
+  if (telem_) {
+    delete telem_;
+  }
   if (timer_) {
     delete timer_;
   }
@@ -1197,9 +1221,9 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   double last_log_time_lb = wallTimeStart;
   double last_log_time_status = wallTimeStart;
   double last_log_time_ub = wallTimeStart;
-  double log_freq_ub = 5; // create an options for this later
-  double log_freq_lb = 5; // create an options for this later
-  double log_freq_status = 5; // create an options for this later
+  double log_freq_ub = options_->ubInterval;
+  double log_freq_lb = options_->lbInterval;
+  double log_freq_status = options_->statusInterval;
   bool *should_dive = new bool[numThreads];
   bool *dived_prev = new bool[numThreads];
   bool *should_prune = new bool[numThreads];
@@ -1256,6 +1280,11 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   }
   stats_ = new DistParBabStats();
 
+  if (telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_, numThreads, proc_rank_);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
@@ -1331,6 +1360,9 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   if (nodePrcssr[0]->getBrancher()->getName() == "ParReliabilityBrancher") {
     isParRel = true;
   }
+  if (shouldRun) {
+    startComm_(proc_running);
+  }
 
   //bool notRampedUp = true;
   UInt i=0; // thread id
@@ -1356,10 +1388,16 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
           updateProcsRunningStatus_(proc_running);
           last_log_time_status = getWallTime();
         }
-        if (getWallTime() - last_log_time_ub > log_freq_ub && (!shouldDistribute)) {
+        if (!commThread_ && !shouldDistribute &&
+            getWallTime() - last_log_time_ub > log_freq_ub) {
           checkUbUpdates_(proc_running);
+          flushIncumbent_(proc_running);
+          reapSends_(false);
           last_log_time_ub = getWallTime();
         }
+        if (commThread_) {
+          takeIncumbents_();
+        }
       } 
       if (current_node[i]) {
 #pragma omp critical (treeManager)
@@ -1408,6 +1446,7 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
             shouldDistribute = false;
             proc_running.resize(num_procs_, 1);
             proc_lb.resize(num_procs_, INFINITY);
+            distributed_.store(true);
           }
         } 
       }
@@ -1442,9 +1481,13 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
             }
           }
         }
-        nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
-                               initialized[i], timesUp, timesDown,
-                               pseudoUp, pseudoDown, stats_->nodesProc);
+        {
+          TelemetryBusy busy(telem_, i);
+          nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
+                                 initialized[i], timesUp, timesDown,
+                                 pseudoUp, pseudoDown, stats_->nodesProc);
+        }
+        updateTelemetry_(i, nodePrcssr[i]);
 #pragma omp critical (stats)
         {
           ++stats_->nodesProc;
@@ -1460,12 +1503,10 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
 
 #pragma omp critical (treeManager)
           {
-            std::cout << "shouldDistribute "<< shouldDistribute << "\n";
-            // Send updated ub to all
-            std::cout << " Sol value " << solPool_->getBestSolutionValue() << " tm best ub " << tm_->getUb() << "\n"; 
-            if (num_procs_ > 1 && solPool_->getBestSolutionValue() < tm_->getUb() && !shouldDistribute) {
-              std::cout << " Found a solution, value " << tm_->getUb() << "\n"; 
-              sendUbToOtherProcs_(solPool_->getBestSolutionValue(), proc_running);
+            // Send updated ub and solution to all
+            if (num_procs_ > 1 &&
+                solPool_->getBestSolutionValue() < tm_->getUb()) {
+              postIncumbent_();
             }
             tm_->setUb(solPool_->getBestSolutionValue());
           }
@@ -1590,6 +1631,8 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
         }
       }
+      writeTelemetry_(nodeCountTh[i],
+                      shouldDistribute ? treeLbTh[i] : globalBestLb, false);
       // Regular tree status logs (check MPI-thread binding and remove
       // critical accordingly)
       if (i==0 && getWallTime() - last_log_time_lb > log_freq_lb) {
@@ -1673,7 +1716,8 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
     }
 #endif
   }   //parallel region ends
-
+  stopComm_();
+  takeIncumbents_();
 
   if (status_ == SolvedOptimal) {
     tm_->setLb(tm_->getUb());
@@ -1737,6 +1781,8 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
       //}
       if (getWallTime() - last_log_time_ub > log_freq_ub) {
         checkUbUpdates_(proc_running);
+        flushIncumbent_(proc_running);
+        reapSends_(false);
         last_log_time_ub = getWallTime();
       }
     } else {
@@ -1778,6 +1824,9 @@ void DistParBranchAndBound::solveMasterProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   //  logger_->msgStream(LogExtraInfo) << me_ << "nodes processed by thread "
   //    << k << " = " << nodesProcTh[k] << std::endl;
   //}
+  reapSends_(true);
+  writeCommStats_(logger_->msgStream(LogExtraInfo));
+  writeTelemetry_(0, tm_->getLb(), true);
   stats_->timeUsed = timer_->query();
   timer_->stop();
 
@@ -1839,9 +1888,8 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   double last_log_time_ub = wallTimeStart;
   double last_log_time_lb = wallTimeStart;
   //double last_log_time_status = wallTimeStart;
-  double log_freq_ub = 5; // create an options for this later
-  double log_freq_lb = 5; // create an options for this later
-  //double log_freq_status = 5; // create an options for this later
+  double log_freq_ub = options_->ubInterval;
+  double log_freq_lb = options_->lbInterval;
   bool *should_dive = new bool[numThreads];
   bool *dived_prev = new bool[numThreads];
   bool *should_prune = new bool[numThreads];
@@ -1857,7 +1905,7 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   UInt *nodeCountTh = new UInt[numThreads];
   UInt *nodesProcTh = new UInt[numThreads];
   UInt numVars = 0;
-  MPI_Request termination_req, lb_req, ub_req;
+  MPI_Request termination_req;
   int termination_status = 0;
   //double tree_lb;
   std::vector<int> proc_running;
@@ -1940,6 +1988,11 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   }
   stats_ = new DistParBabStats();
 
+  if (telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_, numThreads, proc_rank_);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
@@ -2000,6 +2053,9 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   if (nodePrcssr[0]->getBrancher()->getName() == "ParReliabilityBrancher") {
     isParRel = true;
   }
+  if (shouldRun) {
+    startComm_(proc_running);
+  }
 
   //bool notRampedUp = true;
   UInt i=0; // thread id
@@ -2023,26 +2079,21 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
         std::cout << "Proc " << proc_rank_ << " entered while." << "\n";
         checkPrint = false;
       }
-      // check MPI-thread binding
-      //if (i == 0) {
-        //if (getWallTime() - last_log_time_status > log_freq_status) {
-        //  updateProcsRunningStatus_();
-        //  last_log_time_status = getWallTime();
-        //}
-        if (getWallTime() - last_log_time_ub > log_freq_ub) {
+      // without a communication thread, only thread 0 calls MPI.
+      if (i == 0) {
+        if (commThread_) {
+          takeIncumbents_();
+        } else if (getWallTime() - last_log_time_ub > log_freq_ub) {
           checkUbUpdates_(proc_running);
+          flushIncumbent_(proc_running);
+          reapSends_(false);
           last_log_time_ub = getWallTime();
         }
         if (getWallTime() - last_log_time_lb > log_freq_lb) {
-          //tree_lb = tm_->getLb();
-          if (tm_->getLb() < INFINITY) {
-            double lower_bound = tm_->getLb() ;
-            std::cout <<"Proc " << proc_rank_ << " sent lb: treeLb "<< lower_bound << "\n";
-            MPI_Isend(&lower_bound, 1, MPI_DOUBLE, 0, TAG_Lb, MPI_COMM_WORLD, &lb_req);
-          }
+          sendLb_();
           last_log_time_lb = getWallTime();
         }
-      //}
+      }
       if (current_node[i]) {
 #pragma omp critical (treeManager)
         {
@@ -2108,9 +2159,13 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
             }
           }
         }
-        nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
-                               initialized[i], timesUp, timesDown,
-                               pseudoUp, pseudoDown, stats_->nodesProc);
+        {
+          TelemetryBusy busy(telem_, i);
+          nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
+                                 initialized[i], timesUp, timesDown,
+                                 pseudoUp, pseudoDown, stats_->nodesProc);
+        }
+        updateTelemetry_(i, nodePrcssr[i]);
 #pragma omp critical (stats)
         {
           ++stats_->nodesProc;
@@ -2126,12 +2181,9 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
 
 #pragma omp critical (treeManager)
           {
-            // Send updated ub to all
+            // Send updated ub and solution to process 0
             if (solPool_->getBestSolutionValue() < tm_->getUb()) {
-              double tree_ub = solPool_->getBestSolutionValue();
-              MPI_Isend(&tree_ub, 1, MPI_DOUBLE, 0, TAG_Ub, MPI_COMM_WORLD, &ub_req);
-              std::cout << "\nUB update: Proc " << proc_rank_ << " sent ub " << tree_ub << " to Proc " << 0 << "\n";
-              //sendUbToMaster_(solPool_->getBestSolutionValue());
+              postIncumbent_();
             }
             tm_->setUb(solPool_->getBestSolutionValue());
           }
@@ -2256,6 +2308,7 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
         }
       }
+      writeTelemetry_(nodeCountTh[i], treeLbTh[i], false);
 
 //      if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
 //#pragma omp critical (treeManager)
@@ -2313,6 +2366,9 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
     }
 #endif
   }   //parallel region ends
+  stopComm_();
+  takeIncumbents_();
+  flushIncumbent_(proc_running);
   
   std::cout << "Parallel region exit for proc " << proc_rank_ << "\n";
   // Termination message
@@ -2344,6 +2400,9 @@ void DistParBranchAndBound::solveWorkerProc_(ParNodeIncRelaxerPtr parNodeRlxr[],
   //MPI_Send(&termination_status, 1, MPI_INT, 0, TAG_Terminate, MPI_COMM_WORLD);
   std::cout << "\nProc " << proc_rank_ << " sent status to Proc 0 " << termination_status << "\n";
 
+  reapSends_(true);
+  writeCommStats_(logger_->msgStream(LogExtraInfo));
+  writeTelemetry_(0, tm_->getLb(), true);
   stats_->timeUsed = timer_->query();
   timer_->stop();
 
@@ -2454,6 +2513,10 @@ void DistParBranchAndBound::updateProcsRunningStatus_(std::vector<int>& proc_run
       }
     } 
   }
+  if (commThread_) {
+    std::lock_guard<std::mutex> lock(commMutex_);
+    procRunning_ = proc_running;
+  }
 //  MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &is_msg, &mpi_status);
 //  if (is_msg == false) {
 //    return;
@@ -2491,6 +2554,7 @@ void DistParBranchAndBound::checkLbUpdatesFromOtherProcs_(double& globalBestLb,
         MPI_Recv(&value, 1, MPI_DOUBLE, mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
         std::cout << " Proc " << proc_rank_  << " received " << value << " in checkLbUpdatesFromOtherProcs_ " << "\n";
         proc_lb[i] = value;
+        ++stats_->lbRecv;
         //globalBestLb = std::min(globalBestLb, value);
         std::cout <<"From checkLbUpdates_: globalBestLb and value "<< globalBestLb << " " << value << "\n";
       } else {
@@ -2506,81 +2570,269 @@ void DistParBranchAndBound::checkLbUpdatesFromOtherProcs_(double& globalBestLb,
 
 void DistParBranchAndBound::checkUbUpdates_(const std::vector<int>& proc_running)
 {
-  double value;
-  int flag;
+  int flag, count;
   MPI_Status mpi_status;
-  //MPI_Request req;
-  std::vector<MPI_Request> requests;  // To store MPI_Request objects
-  //MPI_Request request;
+  double stale;
+  bool relay;
+  const bool in_comm = commThread_ &&
+    std::this_thread::get_id() == commThread_->get_id();
+
+  while (true) {
+    MPI_Iprobe(MPI_ANY_SOURCE, TAG_Ub, MPI_COMM_WORLD, &flag, &mpi_status);
+    if (!flag) {
+      break;
+    }
+    MPI_Get_count(&mpi_status, MPI_DOUBLE, &count);
+    DoubleVector msg(count > 2 ? count : 2, INFINITY);
+    MPI_Recv(msg.data(), count, MPI_DOUBLE, mpi_status.MPI_SOURCE, TAG_Ub,
+             MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    ++stats_->solsRecv;
+    stats_->solBytesRecv += count*sizeof(double);
+    stale = getWallTime() - msg[1];
+    stats_->staleSum += stale;
+    stats_->staleMax = std::max(stats_->staleMax, stale);
+    if (in_comm) {
+      // the tree and the pool are left to thread 0.
+      std::lock_guard<std::mutex> lock(commMutex_);
+      relay = msg[0] < commUb_;
+      commUb_ = std::min(commUb_, msg[0]);
+      solIn_.push_back(msg);
+      solInPending_.store(true);
+    } else {
+      relay = useIncumbent_(msg);
+    }
+    if (relay && proc_rank_ == 0) {
+      // relay it to processes other than the one that found it.
+      for (int j = 1; j < num_procs_; ++j) {
+        if (j != mpi_status.MPI_SOURCE && proc_running[j]) {
+          isend_(new DoubleVector(msg), j, TAG_Ub);
+          ++stats_->solsSent;
+          stats_->solBytesSent += msg.size()*sizeof(double);
+        }
+      }
+    }
+  }
+}
 
-  if (proc_rank_ == 0) {
-    for (int i = 1; i < num_procs_; ++i) {
-      MPI_Iprobe(i, TAG_Ub, MPI_COMM_WORLD, &flag, &mpi_status);
-      if (flag) {
-        //MPI_Irecv(&value, 1, MPI_DOUBLE, mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, MPI_COMM_WORLD, &request);
-        MPI_Recv(&value, 1, MPI_DOUBLE, mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-        std::cout << "\nUB update: Proc " << proc_rank_ << " received ub " << value << " from Proc " << i << "\n";
-        if (value < tm_->getUb()) {
-          for (int j = 1; j < num_procs_; ++j) {
-            if (j != i && proc_running[j]) {
-              MPI_Request req;
-              MPI_Isend(&value, 1, MPI_DOUBLE, j, TAG_Ub, MPI_COMM_WORLD, &req);
-              requests.push_back(req);  // Store the request
-              std::cout << "\nUB update: Proc " << proc_rank_ << " sent ub " << value << " to Proc " << j << " of value " << value << "\n";
-            }
-          }
-    // Wait for all non-blocking sends to complete
-          if (!requests.empty()) {
-            MPI_Waitall(requests.size(), requests.data(),
-            MPI_STATUSES_IGNORE);
-          }
 
-#pragma omp critical (treeManager)
-          {
-            tm_->setUb(value); 
-          }      
-        }
-      } else {
-        break;
-      } 
+void DistParBranchAndBound::commLoop_()
+{
+  // poll at most every millisecond so that the thread does not take a core
+  // away from the search.
+  std::chrono::microseconds nap((long)(1e6*std::max(options_->ubInterval,
+                                                    1e-3)));
+  std::vector<int> proc_running;
+
+  while (!commStop_.load()) {
+    if (proc_rank_ > 0 || distributed_.load()) {
+      {
+        std::lock_guard<std::mutex> lock(commMutex_);
+        proc_running = procRunning_;
+      }
+      checkUbUpdates_(proc_running);
+      flushIncumbent_(proc_running);
     }
-  } else {
-    while (true) {
-      MPI_Iprobe(0, TAG_Ub, MPI_COMM_WORLD, &flag, &mpi_status);
-      if (flag) {
-        //MPI_Irecv(&value, 1, MPI_DOUBLE, mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, MPI_COMM_WORLD, &request);
-        MPI_Recv(&value, 1, MPI_DOUBLE, mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-        std::cout << "\nUB update: Proc " << proc_rank_ << " received ub " << value << " from Proc 0" << "\n";
-        if (value < tm_->getUb()) {
-#pragma omp critical (treeManager)
-          {
-            tm_->setUb(value);       
-          }
-        }
-      } else {
-        break;
-      } 
+    reapSends_(false);
+    std::this_thread::sleep_for(nap);
+  }
+}
+
+
+void DistParBranchAndBound::flushIncumbent_(const std::vector<int>& proc_running)
+{
+  DoubleVector msg;
 
+  if (proc_rank_ == 0 && !distributed_.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(commMutex_);
+    if (solPending_) {
+      msg.swap(solOut_);
+      solPending_ = false;
     }
   }
-  return;
+  if (msg.empty()) {
+    return;
+  }
+  for (int j = 0; j < num_procs_; ++j) {
+    if (j == proc_rank_ || (proc_rank_ == 0 && !proc_running[j]) ||
+        (proc_rank_ > 0 && j > 0)) {
+      continue;
+    }
+    isend_(new DoubleVector(msg), j, TAG_Ub);
+    ++stats_->solsSent;
+    stats_->solBytesSent += msg.size()*sizeof(double);
+  }
 }
 
 
-void DistParBranchAndBound::sendUbToOtherProcs_(double val, const std::vector<int>& proc_running)
+void DistParBranchAndBound::isend_(DoubleVector *buf, int dest, int tag)
 {
   MPI_Request req;
-  if (proc_running.empty()) {
-    std::cout << "\n EMPTY!!\n";
+
+  MPI_Isend(buf->data(), buf->size(), MPI_DOUBLE, dest, tag, MPI_COMM_WORLD,
+            &req);
+  std::lock_guard<std::mutex> lock(commMutex_);
+  sendReqs_.push_back(std::make_pair(req, buf));
+}
+
+
+void DistParBranchAndBound::postIncumbent_()
+{
+  UInt n = problem_->getNumVars();
+  SolutionPtr sol;
+  const double *x;
+  DoubleVector out;
+
+#pragma omp critical (solPool)
+  {
+    sol = solPool_->getBestSolution();
+    if (sol) {
+      x = sol->getPrimal();
+      out.resize(n+2);
+      out[0] = sol->getObjValue();
+      out[1] = getWallTime();
+      std::copy(x, x+n, out.begin()+2);
+    }
   }
-  for (int i = 1; i < num_procs_; ++i) {
-    std::cout << " inside sendUb: proc running " << i << " " << proc_running[i] << "\n";
-    if (proc_running[i]) {
-      std::cout << "\nUB update: Proc " << proc_rank_ << " sent ub " << val << " to Proc " << i << "\n";
-      MPI_Isend(&val, 1, MPI_DOUBLE, i, TAG_Ub, MPI_COMM_WORLD, &req);
+  if (!out.empty()) {
+    std::lock_guard<std::mutex> lock(commMutex_);
+    solOut_.swap(out);
+    solPending_ = true;
+    commUb_ = std::min(commUb_, solOut_[0]);
+  }
+}
+
+
+void DistParBranchAndBound::reapSends_(bool last)
+{
+  int done;
+  UInt k = 0;
+  std::lock_guard<std::mutex> lock(commMutex_);
+
+  for (UInt i = 0; i < sendReqs_.size(); ++i) {
+    MPI_Test(&(sendReqs_[i].first), &done, MPI_STATUS_IGNORE);
+    if (!done && last) {
+      // the receiver has stopped.
+      MPI_Cancel(&(sendReqs_[i].first));
+      MPI_Wait(&(sendReqs_[i].first), MPI_STATUS_IGNORE);
+      done = 1;
+    }
+    if (done) {
+      delete sendReqs_[i].second;
+    } else {
+      sendReqs_[k] = sendReqs_[i];
+      ++k;
     }
   }
-  return;
+  sendReqs_.resize(k);
+}
+
+
+void DistParBranchAndBound::sendLb_()
+{
+  double lb = tm_->getLb();
+
+  if (lb < INFINITY) {
+    isend_(new DoubleVector(1, lb), 0, TAG_Lb);
+    ++stats_->lbSent;
+  }
+}
+
+
+void DistParBranchAndBound::startComm_(const std::vector<int> &proc_running)
+{
+  int provided = MPI_THREAD_SINGLE;
+
+  if (num_procs_ < 2 || !options_->commThread || commThread_) {
+    return;
+  }
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_MULTIPLE) {
+    logger_->msgStream(LogInfo) << me_ << "MPI does not allow calls from "
+      << "many threads. Bounds and incumbents are exchanged by thread 0."
+      << std::endl;
+    return;
+  }
+  procRunning_ = proc_running;
+  commStop_.store(false);
+  commThread_ = new std::thread(&DistParBranchAndBound::commLoop_, this);
+}
+
+
+void DistParBranchAndBound::stopComm_()
+{
+  if (commThread_) {
+    commStop_.store(true);
+    commThread_->join();
+    delete commThread_;
+    commThread_ = 0;
+  }
+}
+
+
+void DistParBranchAndBound::takeIncumbents_()
+{
+  std::vector<DoubleVector> msgs;
+
+  if (!solInPending_.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(commMutex_);
+    msgs.swap(solIn_);
+    solInPending_.store(false);
+  }
+  for (UInt i = 0; i < msgs.size(); ++i) {
+    useIncumbent_(msgs[i]);
+  }
+}
+
+
+bool DistParBranchAndBound::useIncumbent_(const DoubleVector &msg)
+{
+  bool used = false;
+
+  if (msg[0] >= tm_->getUb()) {
+    return false;
+  }
+  // local heuristics may start from it.
+  if (msg.size() == problem_->getNumVars()+2) {
+#pragma omp critical (solPool)
+    solPool_->addSolution(&(msg[2]), msg[0]);
+  }
+#pragma omp critical (treeManager)
+  {
+    if (msg[0] < tm_->getUb()) {
+      tm_->setUb(msg[0]);
+      used = true;
+    }
+  }
+  if (used) {
+    ++stats_->solsUsed;
+  }
+  return used;
+}
+
+
+void DistParBranchAndBound::writeCommStats_(std::ostream &out)
+{
+  if (num_procs_ < 2) {
+    return;
+  }
+  out << me_ << "lower bounds sent      = " << stats_->lbSent << std::endl
+    << me_ << "lower bounds received  = " << stats_->lbRecv << std::endl
+    << me_ << "incumbents sent        = " << stats_->solsSent << std::endl
+    << me_ << "incumbents received    = " << stats_->solsRecv << std::endl
+    << me_ << "incumbents used        = " << stats_->solsUsed << std::endl
+    << me_ << "incumbent bytes sent   = " << stats_->solBytesSent << std::endl
+    << me_ << "incumbent bytes recvd  = " << stats_->solBytesRecv << std::endl
+    << me_ << "mean incumbent delay   = " << std::fixed
+    << std::setprecision(4)
+    << (stats_->solsRecv > 0 ? stats_->staleSum/stats_->solsRecv : 0.0)
+    << std::endl
+    << me_ << "max incumbent delay    = " << stats_->staleMax << std::endl;
 }
 
 
@@ -2678,6 +2930,46 @@ void DistParBranchAndBound::getStartingNode_(bool *shouldWait, bool *shouldRun,
   //return;
 }
 
+void DistParBranchAndBound::updateTelemetry_(UInt i,
+                                             ParPCBProcessorPtr prcssr)
+{
+  CutManager *cutman;
+
+  if (telem_->isOn()) {
+    cutman = prcssr->getCutManager();
+    if (cutman) {
+      telem_->setCuts(i, cutman->getNumCuts());
+    }
+  }
+}
+
+
+void DistParBranchAndBound::writeTelemetry_(UInt in_process, double treeLb,
+                                            bool last_line)
+{
+  TelemetryRec rec;
+
+  if (!last_line && !telem_->isDue()) {
+    return;
+  }
+  // take a snapshot under the locks that guard the tree and the counters.
+  // The line itself is written without them.
+  rec.cpu = timer_->query();
+  rec.wall = timer_->wQuery();
+  rec.lb = treeLb;
+#pragma omp critical (treeManager)
+  {
+    rec.ub = tm_->getUb();
+    rec.gap = tm_->getPerGapPar(treeLb);
+    rec.nodesLeft = tm_->getActiveNodes() + in_process;
+  }
+#pragma omp critical (stats)
+  rec.nodesProc = stats_->nodesProc;
+  rec.sols = solPool_->getNumSolsFound();
+  telem_->write(rec, last_line);
+}
+
+
 void DistParBranchAndBound::writeStats(std::ostream &out)
 {
   out << me_ << "time taken      = " << std::fixed << std::setprecision(2)
@@ -2690,6 +2982,7 @@ void DistParBranchAndBound::writeStats(std::ostream &out)
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  writeCommStats_(out);
 }
 
 void DistParBranchAndBound::writeParStats(std::ostream &out, ParPCBProcessorPtr nodePrcssr[])
@@ -2705,6 +2998,7 @@ void DistParBranchAndBound::writeParStats(std::ostream &out, ParPCBProcessorPtr
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  writeCommStats_(out);
 }
 
 double DistParBranchAndBound::totalTime()
@@ -2719,7 +3013,16 @@ double DistParBranchAndBound::totalTime()
   DistParBabStats::DistParBabStats()
 :nodesProc(0),
   timeUsed(0),
-  updateTime(0)
+  updateTime(0),
+  lbSent(0),
+  lbRecv(0),
+  solsSent(0),
+  solsRecv(0),
+  solsUsed(0),
+  solBytesSent(0),
+  solBytesRecv(0),
+  staleSum(0.0),
+  staleMax(0.0)
 {
 }
 
@@ -2731,8 +3034,11 @@ double DistParBranchAndBound::totalTime()
   nodeLimit(0),
   perGapLimit(0.),
   solLimit(0),
-  timeLimit(0.)
-
+  timeLimit(0.),
+  commThread(true),
+  lbInterval(1.),
+  statusInterval(5.),
+  ubInterval(0.)
 {
 }
 
@@ -2746,6 +3052,10 @@ DistParBabOptions::DistParBabOptions(EnvPtr env)
   perGapLimit = options->findDouble("obj_gap_percent")->getValue();
   solLimit    = options->findInt("sol_limit")->getValue();
   timeLimit   = options->findDouble("time_limit")->getValue();
+  commThread  = options->findBool("dist_comm_thread")->getValue();
+  lbInterval  = options->findDouble("dist_lb_interval")->getValue();
+  statusInterval = options->findDouble("dist_status_interval")->getValue();
+  ubInterval  = options->findDouble("dist_ub_interval")->getValue();
   createRoot  = true;
 }
 
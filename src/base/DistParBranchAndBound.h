@@ -14,7 +14,11 @@
 #define MINOTAURDISTPARBRANCHANDBOUND_H
 
 #include "Types.h"
+#include "mpi.h"
+#include <atomic>
+#include <mutex>
 #include <sys/time.h>
+#include <thread>
 
 namespace Minotaur {
 
@@ -29,6 +33,7 @@ namespace Minotaur {
   class   Problem;
   class   Solution;
   class   SolutionPool;
+  class   Telemetry;
   class   WarmStart;
   class   Timer;
   typedef Engine* EnginePtr;
@@ -235,7 +240,6 @@ namespace Minotaur {
     void getBoundChanges_(NodePtr node, std::vector<double>& bound_changes);
 
     void updateProcsRunningStatus_(std::vector<int>& proc_running);
-    void checkUbUpdates_(const std::vector<int>& proc_running);
     void checkLbUpdatesFromOtherProcs_(double& globalBestLB, std::vector<double>& proc_lb);
     //void checkLbUpdatesFromOtherProcs_(double& globalBestLB, const std::vector<int>& proc_running);
     void distributeNodes_();
@@ -272,6 +276,9 @@ namespace Minotaur {
     /// The status of the branch-and-bound algorithm.
     SolveStatus status_;
 
+    /// Stream of progress for monitoring, if option telemetry_file is set.
+    Telemetry *telem_;
+
     /**
      * \brief Timer for keeping track of time.
      *
@@ -290,6 +297,53 @@ namespace Minotaur {
     /// Number of processors for MPI
     int num_procs_;
 
+    /// The communication thread, or NULL.
+    std::thread *commThread_;
+
+    /// Tells the communication thread to stop.
+    std::atomic<bool> commStop_;
+
+    /**
+     * \brief True once process 0 has distributed nodes and incumbents can be
+     * sent to other processes.
+     */
+    std::atomic<bool> distributed_;
+
+    /**
+     * \brief Guards what the communication thread shares with the threads
+     * of the search: commUb_, procRunning_, sendReqs_, solIn_, solOut_ and
+     * solPending_. It is a std::mutex and not an OpenMP critical section
+     * because the communication thread is not an OpenMP thread.
+     */
+    std::mutex commMutex_;
+
+    /// Best value of incumbents received or posted, for deciding relays.
+    double commUb_;
+
+    /**
+     * \brief Running status of other processes, copied by thread 0 for the
+     * communication thread.
+     */
+    std::vector<int> procRunning_;
+
+    /// Incumbents received by the communication thread, not yet used.
+    std::vector<DoubleVector> solIn_;
+
+    /// True if solIn_ may not be empty.
+    std::atomic<bool> solInPending_;
+
+    /// Sends that may not have completed, and their buffers.
+    std::vector<std::pair<MPI_Request, DoubleVector *> > sendReqs_;
+
+    /**
+     * \brief Incumbent to be sent: value, time when it was found and the
+     * point. Guarded by commMutex_.
+     */
+    DoubleVector solOut_;
+
+    /// True if solOut_ has not been sent yet.
+    bool solPending_;
+
     double best_tree_lb;
 
 
@@ -319,7 +373,67 @@ namespace Minotaur {
                          NodePtr &node);
 
 
-    void sendUbToOtherProcs_(double val, const std::vector<int>& proc_running);
+    /**
+     * \brief Receive incumbents sent by other processes and use the ones
+     * that are better than ours. Process 0 also relays them to the other
+     * running processes. The communication thread only queues them for
+     * takeIncumbents_().
+     */
+    void checkUbUpdates_(const std::vector<int>& proc_running);
+
+    /**
+     * \brief Thread that exchanges incumbents with other processes. Lower
+     * bounds are still sent by thread 0.
+     */
+    void commLoop_();
+
+    /**
+     * \brief Send the incumbent posted by postIncumbent_(), if any. Process 0
+     * sends it to all running processes, others to process 0.
+     */
+    void flushIncumbent_(const std::vector<int>& proc_running);
+
+    /**
+     * \brief Send buf to process dest without waiting. buf is owned and
+     * freed after the send completes.
+     */
+    void isend_(DoubleVector *buf, int dest, int tag);
+
+    /**
+     * \brief Copy the best solution of the pool so that it is sent to other
+     * processes. Called by the thread that found it. Does not call MPI.
+     */
+    void postIncumbent_();
+
+    /**
+     * \brief Free buffers of sends that have completed. If last is true,
+     * cancel the ones that have not.
+     */
+    void reapSends_(bool last);
+
+    /// Send the lower bound of this tree to process 0.
+    void sendLb_();
+
+    /// Start the communication thread, if options and MPI allow it.
+    void startComm_(const std::vector<int> &proc_running);
+
+    /// Stop the communication thread, if running.
+    void stopComm_();
+
+    /**
+     * \brief Use the incumbents queued by the communication thread. Called
+     * by thread 0 of the search.
+     */
+    void takeIncumbents_();
+
+    /**
+     * \brief Use a received incumbent msg = (value, time, x) if it is better
+     * than ours. Return true if it was used.
+     */
+    bool useIncumbent_(const DoubleVector &msg);
+
+    /// Write statistics of messages exchanged with other processes.
+    void writeCommStats_(std::ostream &out);
 
     /// Return True if a node can be pruned.
     bool shouldPrune_(NodePtr node);
@@ -355,6 +469,19 @@ namespace Minotaur {
      */
     void showParStatus_(UInt current_uncounted, double treeLb,
                         double wallStartTime);
+
+    /// Record the number of cuts of thread i after it processed a node.
+    void updateTelemetry_(UInt i, ParPCBProcessorPtr prcssr);
+
+    /**
+     * \brief Write a line of telemetry of this process if it is due, or if
+     * last_line is true. Does not take the lock on the tree.
+     *
+     * \param [in] in_process Number of nodes being processed by threads.
+     * \param [in] treeLb Lower bound of the tree.
+     * \param [in] last_line True if the search has ended.
+     */
+    void writeTelemetry_(UInt in_process, double treeLb, bool last_line);
   };
 
   /// Statistics about the branch-and-bound.
@@ -371,6 +498,28 @@ namespace Minotaur {
 
     /// Time of the last log display.
     double updateTime;
+
+    /// Lower bounds sent to and received from other processes.
+    UInt lbSent;
+    UInt lbRecv;
+
+    /// Incumbents sent to and received from other processes.
+    UInt solsSent;
+    UInt solsRecv;
+
+    /// Received incumbents that were better than ours.
+    UInt solsUsed;
+
+    /// Bytes of incumbents sent and received.
+    size_t solBytesSent;
+    size_t solBytesRecv;
+
+    /**
+     * \brief Sum and maximum of seconds between finding an incumbent and
+     * receiving it here. Exact only if clocks of the hosts agree.
+     */
+    double staleSum;
+    double staleMax;
   };
 
 
@@ -406,6 +555,18 @@ namespace Minotaur {
 
     /// Time limit in seconds for the branch-and-bound.
     double timeLimit;
+
+    /// Use a separate thread for exchanging bounds and incumbents.
+    bool commThread;
+
+    /// Seconds between lower bounds sent to process 0.
+    double lbInterval;
+
+    /// Seconds between checks of running status of other processes.
+    double statusInterval;
+
+    /// Seconds between checks for incumbents of other processes.
+    double ubInterval;
   };
 
   typedef DistParBranchAndBound* DistParBranchAndBoundPtr;
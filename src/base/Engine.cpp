@@ -23,6 +23,15 @@ Engine::~Engine()
 }
 
 
+void Engine::changeBounds(const VarVector &vars, const double *lb,
+                          const double *ub)
+{
+  for (UInt i=0; i<vars.size(); ++i) {
+    changeBound(vars[i], lb[i], ub[i]);
+  }
+}
+
+
 std::string Engine::getStatusString()
 {
   switch (status_) {
@@ -55,6 +55,19 @@ namespace Minotaur {
     virtual void changeBound(VariablePtr var, double new_lb, double new_ub) 
       = 0;
 
+    /**
+     * \brief Change both bounds of many variables at once.
+     *
+     * \param [in] vars The variables.
+     * \param [in] lb New lower bounds, lb[i] is for vars[i].
+     * \param [in] ub New upper bounds, ub[i] is for vars[i].
+     *
+     * The default calls changeBound() for each variable. Engines that can
+     * take all the bounds in one call should override it.
+     */
+    virtual void changeBounds(const VarVector &vars, const double *lb,
+                              const double *ub);
+
     /**
      * \brief Change the linear function, and the bounds of a constraint.
      * \param [in] c Original constraint that is to be changed.
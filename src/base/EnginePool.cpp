@@ -0,0 +1,268 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file EnginePool.cpp
+ * \brief Define the EnginePool class that keeps engines loaded with a
+ * problem for reuse by heuristics and handlers.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cassert>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Engine.h"
+#include "EnginePool.h"
+#include "Environment.h"
+#include "Function.h"
+#include "Logger.h"
+#include "Objective.h"
+#include "Problem.h"
+#include "Variable.h"
+
+//#define SPEW 1
+
+using namespace Minotaur;
+
+const std::string EnginePool::me_ = "EnginePool: ";
+
+EnginePool::EnginePool(EnvPtr env)
+  : logger_(env->getLogger())
+{
+  stats_.acquired = 0;
+  stats_.bndDelta = 0;
+  stats_.loads = 0;
+  stats_.objDelta = 0;
+  stats_.reused = 0;
+}
+
+
+EnginePool::~EnginePool()
+{
+  for (std::vector<Entry *>::iterator it = entries_.begin();
+       it != entries_.end(); ++it) {
+    clear_(*it);
+    delete (*it)->e;
+    delete *it;
+  }
+  entries_.clear();
+}
+
+
+EnginePtr EnginePool::acquire(ProblemPtr p, EnginePtr e)
+{
+  Entry *own = find_(e);
+  Entry *ent = 0;
+
+  ++(stats_.acquired);
+  if (!own) {
+    own = new Entry();
+    own->e = e;
+    own->p = 0;
+    own->busy = false;
+    own->objVer = 0;
+    own->structVer = 0;
+    entries_.push_back(own);
+  }
+  assert(!own->busy);
+
+  // prefer the engine of the caller, then any free engine of its kind.
+  if (isWarm_(own, p)) {
+    ent = own;
+  } else {
+    for (std::vector<Entry *>::iterator it = entries_.begin();
+         it != entries_.end(); ++it) {
+      if (!(*it)->busy && (*it)->e->getName() == e->getName() &&
+          isWarm_(*it, p)) {
+        ent = *it;
+        break;
+      }
+    }
+  }
+
+  if (ent) {
+    attach_(ent);
+    ++(stats_.reused);
+  } else {
+    ent = own;
+    clear_(ent);
+    ent->e->load(p);
+    ent->p = p;
+    ++(stats_.loads);
+  }
+  ent->busy = true;
+#if SPEW
+  logger_->msgStream(LogDebug) << me_ << ent->e->getName()
+                               << ((ent == own) ? " own" : " other")
+                               << " engine for problem " << p << std::endl;
+#endif
+  return ent->e;
+}
+
+
+void EnginePool::attach_(Entry *ent)
+{
+  ProblemPtr p = ent->p;
+  VarVector vars;
+  DoubleVector lb, ub;
+  ObjectivePtr obj;
+  VariablePtr v;
+  ConstraintPtr c;
+  UInt i;
+
+  if (p->getEngine() != ent->e) {
+    p->setEngine(ent->e);
+  }
+
+  for (i = 0; i < p->getNumVars(); ++i) {
+    v = p->getVariable(i);
+    if (v->getLb() != ent->vlb[i] || v->getUb() != ent->vub[i]) {
+      vars.push_back(v);
+      lb.push_back(v->getLb());
+      ub.push_back(v->getUb());
+    }
+  }
+  if (!vars.empty()) {
+    ent->e->changeBounds(vars, &lb[0], &ub[0]);
+    stats_.bndDelta += vars.size();
+  }
+
+  for (i = 0; i < p->getNumCons(); ++i) {
+    c = p->getConstraint(i);
+    if (c->getLb() != ent->clb[i]) {
+      ent->e->changeBound(c, Lower, c->getLb());
+      ++(stats_.bndDelta);
+    }
+    if (c->getUb() != ent->cub[i]) {
+      ent->e->changeBound(c, Upper, c->getUb());
+      ++(stats_.bndDelta);
+    }
+  }
+
+  if (p->getObjVersion() != ent->objVer) {
+    obj = p->getObjective();
+    ent->e->changeObj(obj ? obj->getFunction() : FunctionPtr(),
+                      obj ? obj->getConstant() : 0.0);
+    ++(stats_.objDelta);
+  }
+}
+
+
+void EnginePool::clear_(Entry *ent)
+{
+  Engine *cur;
+
+  if (!ent->p) {
+    return;
+  }
+  // Engines unset the engine of their problem in clear(). If the problem
+  // has moved on to another engine, keep that one.
+  cur = ent->p->getEngine();
+  ent->e->clear();
+  if (cur != ent->e) {
+    ent->p->setEngine(cur);
+  }
+  ent->p = 0;
+}
+
+
+EnginePool::Entry *EnginePool::find_(EnginePtr e)
+{
+  for (std::vector<Entry *>::iterator it = entries_.begin();
+       it != entries_.end(); ++it) {
+    if ((*it)->e == e) {
+      return *it;
+    }
+  }
+  return 0;
+}
+
+
+bool EnginePool::isWarm_(Entry *ent, ProblemPtr p)
+{
+  return (ent->p == p && ent->structVer == p->getStructVersion() &&
+          ent->vlb.size() == p->getNumVars() &&
+          ent->clb.size() == p->getNumCons());
+}
+
+
+void EnginePool::reload(EnginePtr e)
+{
+  Entry *ent = find_(e);
+  ProblemPtr p;
+
+  assert(ent && ent->busy && ent->p);
+  p = ent->p;
+  clear_(ent);
+  e->load(p);
+  ent->p = p;
+  ++(stats_.loads);
+}
+
+
+void EnginePool::release(EnginePtr e)
+{
+  Entry *ent = find_(e);
+  ProblemPtr p;
+  UInt i;
+
+  assert(ent && ent->busy);
+  ent->busy = false;
+  p = ent->p;
+  if (!p) {
+    return;
+  }
+  if (p->getEngine() != e) {
+    // the caller loaded something else, or another engine took p.
+    clear_(ent);
+    return;
+  }
+
+  ent->objVer = p->getObjVersion();
+  ent->structVer = p->getStructVersion();
+  ent->vlb.resize(p->getNumVars());
+  ent->vub.resize(p->getNumVars());
+  for (i = 0; i < p->getNumVars(); ++i) {
+    ent->vlb[i] = p->getVariable(i)->getLb();
+    ent->vub[i] = p->getVariable(i)->getUb();
+  }
+  ent->clb.resize(p->getNumCons());
+  ent->cub.resize(p->getNumCons());
+  for (i = 0; i < p->getNumCons(); ++i) {
+    ent->clb[i] = p->getConstraint(i)->getLb();
+    ent->cub[i] = p->getConstraint(i)->getUb();
+  }
+
+  // detach without clearing, so that the engine keeps its data.
+  p->unsetEngine();
+}
+
+
+void EnginePool::remove(ProblemPtr p)
+{
+  for (std::vector<Entry *>::iterator it = entries_.begin();
+       it != entries_.end(); ++it) {
+    if ((*it)->p == p) {
+      clear_(*it);
+    }
+  }
+}
+
+
+void EnginePool::writeStats(std::ostream &out) const
+{
+  out << me_ << "engines in pool            = " << entries_.size() << std::endl
+      << me_ << "engines acquired           = " << stats_.acquired
+      << std::endl
+      << me_ << "loads                      = " << stats_.loads << std::endl
+      << me_ << "loads avoided              = " << stats_.reused << std::endl
+      << me_ << "bound changes on reuse     = " << stats_.bndDelta
+      << std::endl
+      << me_ << "objective changes on reuse = " << stats_.objDelta
+      << std::endl;
+}
@@ -0,0 +1,137 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file EnginePool.h
+ * \brief Declare the EnginePool class that keeps engines loaded with a
+ * problem for reuse by heuristics and handlers.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURENGINEPOOL_H
+#define MINOTAURENGINEPOOL_H
+
+#include <vector>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /// Statistics of the engine pool.
+  struct EnginePoolStats {
+    UInt acquired;  /// Calls to acquire().
+    UInt bndDelta;  /// Bounds of variables and constraints applied on reuse.
+    UInt loads;     /// Calls to Engine::load() made by the pool.
+    UInt objDelta;  /// Objectives applied on reuse.
+    UInt reused;    /// Calls where an engine was reused without a load.
+  };
+
+
+  /**
+   * \brief Keep engines loaded with a problem so that heuristics and
+   * handlers that solve the same problem do not load it each time.
+   *
+   * Loading a problem in an NLP engine is expensive: the engine sets up its
+   * interface, the sparsity of the Jacobian and the Hessian and its options.
+   * A user of the pool calls acquire() with the problem and its own engine
+   * instead of loading the problem itself, and release() when it is done.
+   * The pool takes over the engine given to acquire() and may return
+   * another engine of the same kind (same getName()) that was released
+   * earlier with the same problem. If the structure of the problem
+   * (Problem::getStructVersion()) has not changed since, only the changes
+   * in the bounds of variables and constraints and in the objective are
+   * passed to the engine. Otherwise the problem is loaded again.
+   *
+   * A released engine is detached from its problem without being cleared,
+   * so that other engines can be loaded with the problem in the meantime.
+   *
+   * The pool is not thread safe: each thread must have its own pool. The
+   * pool must be deleted, or remove() called, before a problem loaded in
+   * it is deleted.
+   */
+  class EnginePool {
+  public:
+    /// Constructor.
+    EnginePool(EnvPtr env);
+
+    /// Destroy. Deletes all engines given to the pool.
+    ~EnginePool();
+
+    /**
+     * \brief Get an engine loaded with a problem.
+     *
+     * \param[in] p The problem.
+     * \param[in] e The engine of the caller. The pool now owns it and the
+     * caller must not delete it. It may be an engine returned by an earlier
+     * call.
+     * \return An engine of the same kind as e, loaded with p, and attached
+     * to p so that later changes in p are passed to it. It is either e or a
+     * free engine of the pool.
+     */
+    EnginePtr acquire(ProblemPtr p, EnginePtr e);
+
+    /**
+     * \brief Load the problem of an engine returned by acquire() again,
+     * e.g. to reset its starting point after an error.
+     */
+    void reload(EnginePtr e);
+
+    /// Give back an engine returned by acquire(). It stays loaded.
+    void release(EnginePtr e);
+
+    /// Clear all engines loaded with p. Call before deleting p.
+    void remove(ProblemPtr p);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// An engine in the pool and the state of its problem at release.
+    struct Entry {
+      EnginePtr e;        /// The engine.
+      ProblemPtr p;       /// Problem loaded in e, or NULL.
+      bool busy;          /// True from acquire() to release().
+      UInt objVer;        /// Objective version of p at release.
+      UInt structVer;     /// Structure version of p at release.
+      DoubleVector vlb;   /// Lower bounds of variables at release.
+      DoubleVector vub;   /// Upper bounds of variables at release.
+      DoubleVector clb;   /// Lower bounds of constraints at release.
+      DoubleVector cub;   /// Upper bounds of constraints at release.
+    };
+
+    /// All engines given to the pool.
+    std::vector<Entry *> entries_;
+
+    /// Log manager.
+    LoggerPtr logger_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Statistics.
+    EnginePoolStats stats_;
+
+    /// Attach a warm engine to its problem and pass the changes since release.
+    void attach_(Entry *ent);
+
+    /// Clear the engine of ent without unsetting another engine of its problem.
+    void clear_(Entry *ent);
+
+    /// Return the entry of e, or NULL.
+    Entry *find_(EnginePtr e);
+
+    /// Return true if the engine of ent can be used for p without a load.
+    bool isWarm_(Entry *ent, ProblemPtr p);
+
+    /// Copy constructor is not allowed.
+    EnginePool(const EnginePool &);
+
+    /// Copy by assignment is not allowed.
+    EnginePool &operator=(const EnginePool &);
+  };
+  typedef EnginePool *EnginePoolPtr;
+}
+#endif
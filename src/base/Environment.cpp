@@ -23,6 +23,7 @@
 #include "Operations.h"
 #include "Option.h"
 #include "Timer.h"
+#include "Trace.h"
 #include "Version.h"
 
 using namespace Minotaur;
@@ -30,6 +31,7 @@ using namespace Minotaur;
 const std::string Environment::me_ = "Environment: ";
 
 Environment::Environment()
+  : ownTrace_(false)
 {
   timerFac_ = new TimerFactory();
   timer_ = timerFac_->getTimer();
@@ -41,12 +43,71 @@ Environment::Environment()
 
 Environment::~Environment()
 {
+  if(ownTrace_) {
+    Tracer::stop();
+  }
   delete logger_;
   delete options_;
   delete timer_;
   delete timerFac_;
 }
 
+EnvPtr Environment::clone()
+{
+  EnvPtr env = (EnvPtr) new Environment();
+  OptionDBPtr o = env->getOptions();
+
+  env->setLogLevel(getLogLevel());
+  for(BoolOptionSetIter it = options_->boolBegin(); it != options_->boolEnd();
+      ++it) {
+    BoolOptionPtr b = o->findBool((*it)->getName());
+    if(b) {
+      b->setValue((*it)->getValue());
+    } else {
+      o->insert((BoolOptionPtr) new Option<bool>((*it)->getName(),
+                (*it)->getDesc(), (*it)->isKnown(), (*it)->getValue()));
+    }
+  }
+  for(IntOptionSetIter it = options_->intBegin(); it != options_->intEnd();
+      ++it) {
+    IntOptionPtr i = o->findInt((*it)->getName());
+    if(i) {
+      i->setValue((*it)->getValue());
+    } else {
+      o->insert((IntOptionPtr) new Option<int>((*it)->getName(),
+                (*it)->getDesc(), (*it)->isKnown(), (*it)->getValue()));
+    }
+  }
+  for(DoubleOptionSetIter it = options_->dblBegin(); it != options_->dblEnd();
+      ++it) {
+    DoubleOptionPtr d = o->findDouble((*it)->getName());
+    if(d) {
+      d->setValue((*it)->getValue());
+    } else {
+      o->insert((DoubleOptionPtr) new Option<double>((*it)->getName(),
+                (*it)->getDesc(), (*it)->isKnown(), (*it)->getValue()));
+    }
+  }
+  for(StringOptionSetIter it = options_->strBegin(); it != options_->strEnd();
+      ++it) {
+    StringOptionPtr s = o->findString((*it)->getName());
+    if(s) {
+      s->setValue((*it)->getValue());
+    } else {
+      o->insert((StringOptionPtr) new Option<std::string>((*it)->getName(),
+                (*it)->getDesc(), (*it)->isKnown(), (*it)->getValue()));
+    }
+  }
+  for(FlagOptionSetIter it = options_->flagBegin(); it != options_->flagEnd();
+      ++it) {
+    FlagOptionPtr f = o->findFlag((*it)->getName());
+    if(f) {
+      f->setValue((*it)->getValue());
+    }
+  }
+  return env;
+}
+
 void Environment::createDefaultOptions_()
 {
   BoolOptionPtr b_option;
@@ -100,6 +161,29 @@ void Environment::createDefaultOptions_()
       "presolve", "Should presolve be used: <0/1>", true, true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "probe",
+      "Fix each binary variable to 0 and 1 after presolve, and propagate, to "
+      "find fixings, implications and cliques, using as many threads as the "
+      "option threads. Implications and cliques are then propagated at each "
+      "node: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "conflicts",
+      "Derive conflicts from nodes pruned as infeasible or by bound, and "
+      "propagate them at other nodes, in bnb and qg: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "decompose",
+      "Solve independent components of the presolved problem separately, "
+      "using decompose_threads threads: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "separability", "Should separability be used: <0/1>", true, false);
   options_->insert(b_option);
@@ -208,6 +292,13 @@ void Environment::createDefaultOptions_()
       "FPump", "Use feasibility pump heuristic for MINLP: <0/1>", true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "engine_pool",
+      "Let heuristics reuse engines already loaded with the problem instead "
+      "of loading it again: <0/1>",
+      true, true);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "modify_rel_only",
       "If true, apply all modifications to relaxation only  <0/1>", true, true);
@@ -225,6 +316,14 @@ void Environment::createDefaultOptions_()
       true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "ml_lazy_hull",
+      "Relax multilinear terms with McCormick rows and separate facets of "
+      "the convex hull of each group, instead of adding the extreme-point "
+      "formulation: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "use_native_cgraph",
       "If true, use Minotaur's computational graph to evaluate nonlinear "
@@ -305,6 +404,20 @@ void Environment::createDefaultOptions_()
       false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "root_sep_pipeline",
+      "At the root, let handlers that allow it separate the point of one "
+      "round while the next round is solved, if sep_threads > 1 (threads > "
+      "1 in the parallel solvers): <0/1>",
+      true, true);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "dist_comm_thread",
+      "Exchange incumbents in distributed branch-and-bound from "
+      "a separate thread if MPI allows it: <0/1>", true, true);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "divheurLP", "Use LP dives in parallel diving heuristic for MINLP: <0/1>",
       true, false);
@@ -356,6 +469,45 @@ void Environment::createDefaultOptions_()
       true, 1000000000);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>(
+      "plunge_max_open",
+      "In best-estimate search, always plunge when more nodes than this are "
+      "open, to limit the memory used by the tree: >0", true, 100000);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "decompose_threads",
+      "Number of threads for solving components when decompose is on. More "
+      "than one only if the LP/QP/NLP engines are thread-safe, e.g. IPOPT with "
+      "MA97 but not with MUMPS: >=1",
+      true, 1);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "conflict_max_size",
+      "Conflicts with more bounds than this are thrown away: >=0", true, 20);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "conflict_pool_size",
+      "Maximum number of conflicts kept, the oldest are replaced: >=0", true,
+      10000);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "restart_nodes",
+      "Restart the tree only while fewer than these many nodes have been "
+      "processed: >=0", true, 500);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "restarts",
+      "Maximum number of restarts of the tree after many integer variables "
+      "are fixed globally. A restart only re-roots the tree with the "
+      "tightened bounds in the relaxation; variables are not removed and "
+      "the problem is not changed. 0 for no restarts: >=0", true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>(
       "sol_limit", "Limit on the number of solutions found: >0", true,
       1000000000);
@@ -439,6 +591,19 @@ void Environment::createDefaultOptions_()
       "threads", "Number of threads to be used ", true, 1);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>(
+      "sep_threads",
+      "Number of threads for calling separation routines of handlers that "
+      "allow it at each node: >=1",
+      true, 1);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "trace_buffer",
+      "Number of events kept per thread when trace_file is given: >0", true,
+      65536);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>(
       "msbnb_scheme_id", "Initial point generation scheme for MsProcessor: 1-5",
       true, 5);
@@ -457,6 +622,12 @@ void Environment::createDefaultOptions_()
       true, 10000);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>(
+      "cbc_pool_size",
+      "Maximum number of solutions kept by Cbc after each solve: >=1",
+      true, 10);
+  options_->insert(i_option);
+
   // Initial workspace option for FilterSQP engine
   i_option = (IntOptionPtr) new Option<int>(
       "filter_mxws", "Extra workspace for Filter-SQP", true, 0);
@@ -485,6 +656,19 @@ void Environment::createDefaultOptions_()
       0.00001);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "probe_time",
+      "Time in seconds after which probing stops, 0 for no limit: >=0", true,
+      10.0);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "presolve_handler_time",
+      "Time in seconds after which presolve of a handler is not called "
+      "again; a call in progress is not interrupted, 0 for no limit: >=0",
+      true, 0.0);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>(
       "time_limit", "Limit on time in branch-and-bound in seconds: >0", true,
       1e20);
@@ -500,6 +684,31 @@ void Environment::createDefaultOptions_()
       "Display interval in seconds for branch-and-bound status: >0", true, 5.);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "telemetry_interval",
+      "Interval in seconds between lines written to telemetry_file: >=0",
+      true, 1.);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "dist_lb_interval",
+      "Interval in seconds between lower bounds sent to the master in "
+      "distributed branch-and-bound: >=0", true, 1.);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "dist_status_interval",
+      "Interval in seconds between status checks in distributed "
+      "branch-and-bound: >=0", true, 5.);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "dist_ub_interval",
+      "Interval in seconds between checks for incumbents from other "
+      "processes in distributed branch-and-bound, 0 for every node: >=0",
+      true, 0.);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>(
       "int_tol", "Tolerance for checking integrality", true, 1e-6);
   options_->insert(d_option);
@@ -553,6 +762,19 @@ void Environment::createDefaultOptions_()
       "Stop if the objective gap percent falls below this level", true, 0.0);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "plunge_quot",
+      "In best-estimate search, plunge into a child if its estimate is within "
+      "this fraction of the gap between the lower bound and the incumbent",
+      true, 0.25);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "restart_frac",
+      "Restart the tree when this fraction of the integer variables that are "
+      "free at the root get fixed globally: (0,1]", true, 0.2);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>(
       "root_linScheme1",
       "Percentage violation allowed at root node for generating extra "
@@ -617,6 +839,13 @@ void Environment::createDefaultOptions_()
       "OsiClp");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "load_presolved",
+      "File with a presolved problem saved by save_presolved. If given, "
+      "presolve is skipped and the problem in this file is solved",
+      true, "");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>(
       "milp_engine", "Engine for solving milp: Cbc, None", true, "Cbc");
   options_->insert(s_option);
@@ -643,6 +872,13 @@ void Environment::createDefaultOptions_()
       "bqpd");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "save_presolved",
+      "File for saving the presolved problem, to be loaded in later runs "
+      "with load_presolved",
+      true, "");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>(
       "tb_rule",
       "Tie breaking rule for node selection in branch-and-bound: twoChild, "
@@ -651,7 +887,28 @@ void Environment::createDefaultOptions_()
   options_->insert(s_option);
 
   s_option = (StringOptionPtr) new Option<std::string>(
-      "tree_search", "Strategy for tree search: dfs, bfs, BthenD", true,
+      "telemetry_file",
+      "File for writing progress of the tree search while running, or "
+      "unix:<path> for a UNIX domain socket",
+      true, "");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "telemetry_format",
+      "Format of lines written to telemetry_file: json, csv", true, "json");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "trace_file",
+      "File for writing a chrome trace of timed events. Needs Minotaur built "
+      "with TRACE_FLAG. Send SIGUSR1 to write it while running",
+      true, "");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "tree_search",
+      "Strategy for tree search: dfs, bfs, bthend, bestest (best estimate "
+      "with plunging)", true,
       "bthend");
   options_->insert(s_option);
 
@@ -1024,6 +1281,7 @@ void Environment::readOptions(int argc, char** argv)
         << me_ << "No filename provided as input." << std::endl;
   }
 #endif
+  startTrace_();
 }
 
 
@@ -1085,3 +1343,22 @@ void Environment::setLogLevel(LogLevel l)
   logger_->setMaxLevel(l);
 }
 
+void Environment::startTrace_()
+{
+  std::string fname = options_->findString("trace_file")->getValue();
+
+  if(fname == "" || Tracer::isOn()) {
+    return;
+  }
+#if defined(MNTR_TRACE) && MNTR_TRACE
+  int cap = options_->findInt("trace_buffer")->getValue();
+  Tracer::start(fname, cap > 0 ? cap : 1);
+  ownTrace_ = true;
+  logger_->msgStream(LogInfo) << me_ << "writing trace to " << fname
+                              << std::endl;
+#else
+  logger_->msgStream(LogInfo) << me_ << "ignoring trace_file: Minotaur was "
+                              << "built without TRACE_FLAG." << std::endl;
+#endif
+}
+
@@ -33,6 +33,13 @@ namespace Minotaur {
       /// Destroy.
       ~Environment();
 
+      /**
+       * \brief Create a new environment with the same option values and log
+       * level, but with its own logger and timer. A trace started by this
+       * environment is not stopped when the new one is destroyed.
+       */
+      Environment* clone();
+
       /// Get the logger that is setup for the whole environment.
       LoggerPtr getLogger() const;
 
@@ -97,6 +104,9 @@ namespace Minotaur {
       /// Logger that is used for the whole environment.
       LoggerPtr logger_;
 
+      /// True if this environment started the trace and should stop it.
+      bool ownTrace_;
+
       /// For log:
       static const std::string me_;
 
@@ -157,6 +167,9 @@ namespace Minotaur {
        * substring.
        */
       std::string separateEqualToArg_(std::string &name);
+
+      /// Start recording a trace if the option trace_file is set.
+      void startTrace_();
   };
 }
 #endif
@@ -16,6 +16,7 @@
 #include "MinotaurConfig.h"
 #include "Constraint.h"
 #include "Engine.h"
+#include "EnginePool.h"
 #include "Environment.h"
 #include "FeasibilityPump.h"
 #include "Function.h"
@@ -41,11 +42,13 @@ using namespace Minotaur;
 const std::string FeasibilityPump::me_ = "Feasibility Pump: ";
 
 FeasibilityPump::FeasibilityPump(EnvPtr env, ProblemPtr p, EnginePtr e)
-  : e_(e),
+  : cloneE_(0),
+    e_(e),
     env_(env),
     intTol_(1e-6),
     nToFlip_(2),
     p_(p),
+    pool_(0),
     stats_(NULL)
 {
   // initialize the random vector for hashing
@@ -83,11 +86,13 @@ FeasibilityPump::FeasibilityPump(EnvPtr env, ProblemPtr p, EnginePtr e)
 
 FeasibilityPump::FeasibilityPump(EnvPtr env, ProblemPtr p, EnginePtr nlpe,
                                  EnginePtr)
-  : e_(nlpe),
+  : cloneE_(0),
+    e_(nlpe),
     env_(env),
     intTol_(1e-6),
     nToFlip_(2),
     p_(p),
+    pool_(0),
     stats_(NULL)
 {
   // initialize the random vector for hashing
@@ -189,17 +194,25 @@ void FeasibilityPump::convertSol_(SolutionPoolPtr s_pool,
   double *UB_copy = new double[numvars];
   int err = 0;
 
+  VarVector bins;
+  DoubleVector vals;
+
   saveBounds_(LB_copy, UB_copy, numvars);
   // fix bounds for binary variables
   for (VariableConstIterator v_iter = p_->varsBegin();
        v_iter != p_->varsEnd(); ++v_iter, ++i) {
     if ((*v_iter)->getType() == Binary) {
-      p_->changeBoundByInd(i, x[i], x[i]);
+      bins.push_back(*v_iter);
+      vals.push_back(x[i]);
     }
   }
-  //solve the original problem with modified bounds
-  e_->clear();
-  e_->load(p_);
+  p_->changeBounds(bins, vals.data(), vals.data());
+  //solve the original problem with modified bounds. With a pool, p_ is
+  //still loaded in e_ and the new bounds have been passed to it.
+  if (!pool_) {
+    e_->clear();
+    e_->load(p_);
+  }
   e_->solve();
   ++(stats_->numNLPs);
   x = e_->getSolution()->getPrimal();
@@ -276,14 +289,24 @@ void FeasibilityPump::implementFP_(const double *x, SolutionPoolPtr s_pool)
   UInt max_cycle = 300;
   UInt min_flip = 3;
   ProblemPtr prob = p_->clone(env_);
+  EnginePtr e = e_;
 
-  e_->load(prob);
+  // keep p_ loaded in e_ and solve the clone with another engine.
+  if (pool_) {
+    if (!cloneE_) {
+      cloneE_ = e_->emptyCopy();
+    }
+    cloneE_ = pool_->acquire(prob, cloneE_);
+    e = cloneE_;
+  } else {
+    e_->load(prob);
+  }
   while (cont_FP && stats_->numNLPs < max_iter &&
          stats_->numCycles < max_cycle) {
     constructObj_(prob, 0);
-    e_->solve();
+    e->solve();
     ++(stats_->numNLPs);
-    sol = e_->getSolution();
+    sol = e->getSolution();
 #if SPEW
     prob->write(logger_->msgStream(LogDebug2));
     sol->write(logger_->msgStream(LogDebug2));
@@ -305,6 +328,11 @@ void FeasibilityPump::implementFP_(const double *x, SolutionPoolPtr s_pool)
     // make solution to the original problem and then add to sol pool
     convertSol_(s_pool, sol);
   }
+  if (pool_) {
+    pool_->release(cloneE_);
+    pool_->remove(prob);
+    delete prob;
+  }
 }
 
 
@@ -376,23 +404,15 @@ void FeasibilityPump::perturb_(double hash_val, UInt n_to_flip)
 
 
 void FeasibilityPump::restoreBounds_(double *LB_copy, double *UB_copy,
-                                     UInt vars)
+                                     UInt)
 {
-  for (UInt i = 0; i < vars; ++i, ++LB_copy, ++UB_copy) {
-    p_->changeBoundByInd(i, Lower, *LB_copy);
-    p_->changeBoundByInd(i, Upper, *UB_copy);
-  }
+  p_->changeBounds(LB_copy, UB_copy);
 }
 
 
-void FeasibilityPump::saveBounds_(double *LB_copy, double *UB_copy, UInt vars)
+void FeasibilityPump::saveBounds_(double *LB_copy, double *UB_copy, UInt)
 {
-  VariablePtr variable;
-  for (UInt i = 0; i < vars; ++i, ++LB_copy, ++UB_copy) {
-    variable = p_->getVariable(i);
-    *LB_copy = variable->getLb();
-    *UB_copy = variable->getUb();
-  }
+  p_->getBounds(LB_copy, UB_copy);
 }
 
 
@@ -443,12 +463,19 @@ void FeasibilityPump::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
     logger_->msgStream(LogInfo) << me_ << "Skipping" << std::endl;
     return;
   }
-  e_->load(p_);
+  if (pool_) {
+    e_ = pool_->acquire(p_, e_);
+  } else {
+    e_->load(p_);
+  }
   timer_->start();
   status = e_->solve();
 
   if (status != ProvenOptimal && status != ProvenLocalOptimal &&
       status != ProvenFailedCQFeas && status != FailedFeas) {
+    if (pool_) {
+      pool_->release(e_);
+    }
     return;
   }
 
@@ -458,7 +485,9 @@ void FeasibilityPump::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
   p_->write(logger_->msgStream(LogDebug2));
   sol->write(logger_->msgStream(LogDebug2));
 #endif
-  e_->clear();
+  if (!pool_) {
+    e_->clear();
+  }
   logger_->msgStream(LogInfo) << me_ << "Starting" << std::endl;
   // now implement the FP heuristic
   if (isFrac_(x)) {
@@ -473,6 +502,9 @@ void FeasibilityPump::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
 #endif
     s_pool->addSolution(sol);
   }
+  if (pool_) {
+    pool_->release(e_);
+  }
 
   logger_->msgStream(LogInfo) << me_ << "Over" << std::endl;
   stats_->time = timer_->query();
@@ -17,6 +17,7 @@
 
 namespace Minotaur {
   class Engine;
+  class EnginePool;
   class Problem;
 
   /// statistics for Feasibility Pump heuristic
@@ -52,6 +53,12 @@ namespace Minotaur {
     /// default destructor
     virtual ~FeasibilityPump();
 
+    /**
+     * \brief Get the engines from a pool instead of loading the problem
+     * and its clone in one engine in turn. The pool then owns the engines.
+     */
+    void setEnginePool(EnginePool *pool) { pool_ = pool; };
+
     /// call to the heuristic
     void solve(NodePtr node, RelaxationPtr rel, SolutionPoolPtr s_pool);
 
@@ -66,6 +73,9 @@ namespace Minotaur {
     /// Binary/integer variables present in the problem
     VarVector bins_;
 
+    /// Engine for the cloned problem when a pool is used, or NULL.
+    EnginePtr cloneE_;
+
     /// Pointer to the engine to be used to solve the problem
     EnginePtr e_;
 
@@ -87,6 +97,9 @@ namespace Minotaur {
     /// Pointer to the problem being solved
     ProblemPtr p_;
 
+    /// Pool that gives the engines, if any.
+    EnginePool *pool_;
+
     /// A random vector for inner product with the solution
     DoubleVector random_;
 
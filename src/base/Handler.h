@@ -144,6 +144,16 @@ public:
   virtual ModificationPtr getBrMod(BrCandPtr cand, DoubleVector& x,
                                    RelaxationPtr rel, BranchDirection dir) = 0;
 
+  /**
+   * \brief Tighten bounds with those found by the handler that are valid
+   * in the whole tree, e.g. from the reduced costs of the root.
+   *
+   * \param[in,out] lb Lower bounds of variables of the relaxation, indexed
+   * by their index.
+   * \param[in,out] ub Upper bounds, indexed the same way.
+   */
+  virtual void getGlobalBounds(DoubleVector&, DoubleVector&) const {};
+
   /// Return the name of the handler.
   virtual std::string getName() const = 0;
 
@@ -175,6 +185,23 @@ public:
   virtual bool isFeasible(ConstSolutionPtr sol, RelaxationPtr rel,
                           bool& should_prune, double& inf_meas) = 0;
 
+  /**
+   * \brief Return true if separate() of this handler may run concurrently
+   * with that of other handlers.
+   *
+   * A handler can return true only if its separate() reads the relaxation
+   * and the solution but does not modify them, does not use any engine that
+   * is shared, and sends all its cuts through the given CutManager. The
+   * node processor may then call separate() from a different thread with a
+   * CutManager that buffers the cuts. At the root, it may also be called
+   * while the engine solves the relaxation, with a point from an earlier
+   * round. By default, a handler needs exclusive access.
+   */
+  virtual bool isSepThreadSafe() const
+  {
+    return false;
+  }
+
   /**
    * \brief Return true if this handler is needed for the problem.
    *
@@ -205,6 +232,23 @@ public:
   virtual SolveStatus presolve(PreModQ* pre_mods, bool* changed,
                                Solution** sol) = 0;
 
+  /**
+   * \brief Tell the handler what changed in the problem since its last
+   * presolve.
+   *
+   * Called by the Presolver just before each call to presolve(). The handler
+   * may restrict its next presolve() to the given variables and
+   * constraints, and to those connected to them. The default implementation
+   * ignores this information.
+   * \param[in] all True if the whole problem must be looked at, e.g. in the
+   * first call.
+   * \param[in] vars Variables that were added or whose bounds, type or
+   * number of constraints changed.
+   * \param[in] cons Constraints that were added or whose bounds or number
+   * of variables changed.
+   */
+  virtual void setPresolveDirty(bool, const VarSet&, const ConstrSet&) {};
+
   /**
    * \brief Presolve the problem and its relaxation at a node.
    *
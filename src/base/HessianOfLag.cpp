@@ -30,7 +30,9 @@ using namespace Minotaur;
 HessianOfLag::HessianOfLag()
 : etol_(1e-12),
   obj_(FunctionPtr()),
-  p_(0)  // NULL
+  p_(0),  // NULL
+  nlVer_(0),
+  objVer_(0)
 {
   stor_.nz = 0;
   stor_.nlVars = 0;
@@ -44,11 +46,10 @@ HessianOfLag::HessianOfLag()
 HessianOfLag::HessianOfLag(Problem *p)
 : etol_(1e-12),
   obj_(FunctionPtr()),
-  p_(p) // NULL
+  p_(p), // NULL
+  nlVer_(0),
+  objVer_(0)
 {
-  if (p_->getObjective()) {
-    obj_ = p_->getObjective()->getFunction();
-  }
   stor_.nz = 0;
   stor_.nlVars = 0;
   stor_.rows = 0;
@@ -127,6 +128,11 @@ void HessianOfLag::setupRowCol()
   UInt *cols;
   UInt i;
 
+  nlVer_ = p_->getNlStructVersion();
+  objVer_ = p_->getObjVersion();
+  obj_ = (p_->getObjective()) ? p_->getObjective()->getFunction()
+                              : FunctionPtr();
+
   // remember, we need lower triangle.
   if (stor_.cols) {
     delete [] stor_.cols;
@@ -202,6 +208,14 @@ void HessianOfLag::setupRowCol()
 }
 
 
+void HessianOfLag::update()
+{
+  if (nlVer_ != p_->getNlStructVersion() || objVer_ != p_->getObjVersion()) {
+    setupRowCol();
+  }
+}
+
+
 void HessianOfLag::write(std::ostream &out) const
 {
   std::string me = "HessOfLag: ";
@@ -95,6 +95,17 @@ namespace Minotaur {
 
       virtual void setupRowCol();
 
+      /**
+       * \brief Set up the rows and columns again only if the objective or
+       * the nonlinear functions of the problem have changed since the last
+       * call to setupRowCol(). Adding or deleting linear constraints keeps
+       * the current structure.
+       */
+      virtual void update();
+
+      /// Return the problem of this hessian, or NULL.
+      Problem* getProblem() const { return p_; };
+
       virtual void write(std::ostream &out) const;
 
     private:
@@ -122,6 +133,12 @@ namespace Minotaur {
       Problem *p_;
       LTHessStor stor_;
 
+      /// Problem::getNlStructVersion() when the structure was set up.
+      UInt nlVer_;
+
+      /// Problem::getObjVersion() when the structure was set up.
+      UInt objVer_;
+
   };
 
   typedef HessianOfLag* HessianOfLagPtr;
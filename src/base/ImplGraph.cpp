@@ -0,0 +1,94 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ImplGraph.cpp
+ * \brief Define the ImplGraph class that stores implications and cliques
+ * among binary variables.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+
+#include "MinotaurConfig.h"
+#include "ImplGraph.h"
+
+using namespace Minotaur;
+
+ImplGraph::ImplGraph(UInt n)
+  : impls_(2*n),
+    litCliques_(2*n)
+{
+}
+
+
+ImplGraph::~ImplGraph()
+{
+  cliques_.clear();
+  impls_.clear();
+  litCliques_.clear();
+}
+
+
+void ImplGraph::addClique(const UIntVector &lits)
+{
+  if (lits.size() < 2) {
+    return;
+  }
+  for (UIntVector::const_iterator it = lits.begin(); it != lits.end(); ++it) {
+    litCliques_[*it].push_back(cliques_.size());
+  }
+  cliques_.push_back(lits);
+}
+
+
+void ImplGraph::addImpl(UInt i, bool v, UInt j, bool w)
+{
+  impls_[lit(i, v)].push_back(lit(j, w));
+  impls_[lit(j, !w)].push_back(lit(i, !v));
+}
+
+
+void ImplGraph::finalize()
+{
+  for (std::vector<UIntVector>::iterator it = impls_.begin();
+       it != impls_.end(); ++it) {
+    std::sort(it->begin(), it->end());
+    it->erase(std::unique(it->begin(), it->end()), it->end());
+  }
+}
+
+
+UInt ImplGraph::getNumImpls() const
+{
+  UInt n = 0;
+
+  for (std::vector<UIntVector>::const_iterator it = impls_.begin();
+       it != impls_.end(); ++it) {
+    n += it->size();
+  }
+  return n;
+}
+
+
+void ImplGraph::write(std::ostream &out) const
+{
+  for (UInt l = 0; l < impls_.size(); ++l) {
+    for (UIntVector::const_iterator it = impls_[l].begin();
+         it != impls_[l].end(); ++it) {
+      out << "x" << litVar(l) << " = " << litVal(l) << " => x"
+          << litVar(*it) << " = " << litVal(*it) << std::endl;
+    }
+  }
+  for (UInt i = 0; i < cliques_.size(); ++i) {
+    out << "clique " << i << ":";
+    for (UIntVector::const_iterator it = cliques_[i].begin();
+         it != cliques_[i].end(); ++it) {
+      out << " " << (litVal(*it) ? "" : "~") << "x" << litVar(*it);
+    }
+    out << std::endl;
+  }
+}
@@ -0,0 +1,115 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ImplGraph.h
+ * \brief Declare the ImplGraph class that stores implications and cliques
+ * among binary variables.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURIMPLGRAPH_H
+#define MINOTAURIMPLGRAPH_H
+
+#include <iostream>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Store implications and cliques among binary variables of a
+   * problem.
+   *
+   * A literal is a binary variable fixed to zero or one. It is stored as
+   * the UInt 2*i+v, where i is the index of the variable in the problem and
+   * v is the value. An implication \f$x_i = v \Rightarrow x_j = w\f$ is
+   * stored as an arc from literal (i,v) to literal (j,w), together with its
+   * contrapositive \f$x_j = 1-w \Rightarrow x_i = 1-v\f$. A clique is a set
+   * of literals at most one of which can be true, e.g. from a constraint
+   * \f$x_1 + x_2 + (1-x_3) \leq 1\f$.
+   *
+   * The graph is filled by the Prober and can be read by cut generators,
+   * node propagation and heuristics. Indices of variables are those of the
+   * problem when the graph was filled; it must be discarded if variables
+   * are deleted after that.
+   */
+  class ImplGraph {
+  public:
+    /// Constructor for a problem with n variables.
+    ImplGraph(UInt n);
+
+    /// Destroy.
+    ~ImplGraph();
+
+    /**
+     * \brief Add a clique.
+     *
+     * \param[in] lits Literals at most one of which can be true. Cliques
+     * with fewer than two literals are ignored.
+     */
+    void addClique(const UIntVector &lits);
+
+    /**
+     * \brief Add the implication \f$x_i = v \Rightarrow x_j = w\f$ and its
+     * contrapositive. Duplicates are removed by finalize().
+     */
+    void addImpl(UInt i, bool v, UInt j, bool w);
+
+    /**
+     * \brief Sort the implications of each literal and remove duplicates.
+     * Called after all implications are added.
+     */
+    void finalize();
+
+    /// Return the literals of the i-th clique.
+    const UIntVector & getClique(UInt i) const { return cliques_[i]; };
+
+    /// Return the indices of the cliques that contain a literal.
+    const UIntVector & getCliquesOf(UInt lit) const { return litCliques_[lit]; };
+
+    /// Return the literals implied by a literal.
+    const UIntVector & getImpls(UInt lit) const { return impls_[lit]; };
+
+    /// Return the number of cliques.
+    UInt getNumCliques() const { return cliques_.size(); };
+
+    /// Return the number of implications, counting each contrapositive.
+    UInt getNumImpls() const;
+
+    /// Return the number of variables of the problem.
+    UInt getNumVars() const { return impls_.size()/2; };
+
+    /// Return the literal of variable i fixed to v.
+    static UInt lit(UInt i, bool v) { return 2*i + (v ? 1 : 0); };
+
+    /// Return the index of the variable of a literal.
+    static UInt litVar(UInt lit) { return lit/2; };
+
+    /// Return the value of the variable of a literal.
+    static bool litVal(UInt lit) { return (lit%2 == 1); };
+
+    /// Write the implications and cliques.
+    void write(std::ostream &out) const;
+
+  private:
+    /// Literals of each clique.
+    std::vector<UIntVector> cliques_;
+
+    /// Literals implied by each literal.
+    std::vector<UIntVector> impls_;
+
+    /// Cliques that contain each literal.
+    std::vector<UIntVector> litCliques_;
+
+    /// Copy constructor is not allowed.
+    ImplGraph(const ImplGraph &);
+
+    /// Copy by assignment is not allowed.
+    ImplGraph &operator=(const ImplGraph &);
+  };
+}
+#endif
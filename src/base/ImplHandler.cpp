@@ -0,0 +1,133 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ImplHandler.cpp
+ * \brief Define the ImplHandler class that propagates implications and
+ * cliques among binary variables at each node.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "ImplGraph.h"
+#include "ImplHandler.h"
+#include "Relaxation.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ImplHandler::me_ = "ImplHandler: ";
+
+ImplHandler::ImplHandler(EnvPtr, const ImplGraph *graph)
+  : eTol_(1e-6),
+    graph_(graph)
+{
+  stats_.fixed = 0;
+  stats_.inf = 0;
+}
+
+
+ImplHandler::~ImplHandler()
+{
+  graph_ = 0;
+}
+
+
+bool ImplHandler::fix_(RelaxationPtr rel, UInt lit, ModVector &r_mods,
+                       UIntVector &lits)
+{
+  UInt i = ImplGraph::litVar(lit);
+  double val = ImplGraph::litVal(lit) ? 1.0 : 0.0;
+  VariablePtr v;
+  ModificationPtr mod;
+
+  if (i >= rel->getNumVars()) {
+    return true;
+  }
+  v = rel->getVariable(i);
+  if (v->getLb() > val + eTol_ || v->getUb() < val - eTol_) {
+    return false;
+  }
+  if (v->getUb() - v->getLb() > eTol_) {
+    mod = (ModificationPtr) new VarBoundMod2(v, val, val);
+    mod->applyToProblem(rel);
+    r_mods.push_back(mod);
+    lits.push_back(lit);
+    ++stats_.fixed;
+  }
+  return true;
+}
+
+
+std::string ImplHandler::getName() const
+{
+  return "ImplHandler (implications and cliques of binary variables)";
+}
+
+
+bool ImplHandler::presolveNode(RelaxationPtr rel, NodePtr, SolutionPoolPtr,
+                               ModVector &, ModVector &r_mods)
+{
+  const UInt n = std::min(graph_->getNumVars(), rel->getNumVars());
+  UIntVector lits;
+  VariablePtr v;
+  UInt l, m;
+
+  for (UInt i = 0; i < n; ++i) {
+    v = rel->getVariable(i);
+    if (v->getUb() - v->getLb() > eTol_) {
+      continue;
+    }
+    if (fabs(v->getLb()) < eTol_) {
+      l = ImplGraph::lit(i, false);
+    } else if (fabs(v->getLb() - 1.0) < eTol_) {
+      l = ImplGraph::lit(i, true);
+    } else {
+      continue;
+    }
+    if (!graph_->getImpls(l).empty() || !graph_->getCliquesOf(l).empty()) {
+      lits.push_back(l);
+    }
+  }
+
+  // lits grows as variables are fixed.
+  for (UInt q = 0; q < lits.size(); ++q) {
+    l = lits[q];
+    const UIntVector &impls = graph_->getImpls(l);
+    for (UInt k = 0; k < impls.size(); ++k) {
+      if (!fix_(rel, impls[k], r_mods, lits)) {
+        ++stats_.inf;
+        return true;
+      }
+    }
+    const UIntVector &cls = graph_->getCliquesOf(l);
+    for (UInt c = 0; c < cls.size(); ++c) {
+      const UIntVector &clique = graph_->getClique(cls[c]);
+      for (UInt k = 0; k < clique.size(); ++k) {
+        m = clique[k];
+        if (m != l && !fix_(rel, ImplGraph::lit(ImplGraph::litVar(m),
+                                                !ImplGraph::litVal(m)),
+                            r_mods, lits)) {
+          ++stats_.inf;
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+
+void ImplHandler::writeStats(std::ostream &out) const
+{
+  out << me_ << "binary variables fixed = " << stats_.fixed << std::endl
+      << me_ << "nodes infeasible       = " << stats_.inf << std::endl;
+}
@@ -0,0 +1,138 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file ImplHandler.h
+ * \brief Declare the ImplHandler class that propagates implications and
+ * cliques among binary variables at each node.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURIMPLHANDLER_H
+#define MINOTAURIMPLHANDLER_H
+
+#include "Handler.h"
+
+namespace Minotaur {
+
+  class ImplGraph;
+
+  /// Statistics of propagation of implications and cliques.
+  struct ImplStats {
+    UInt fixed;     /// Binary variables fixed.
+    UInt inf;       /// Nodes found infeasible.
+  };
+
+  /**
+   * \brief Handler that fixes binary variables at each node with the
+   * implications and cliques found by the Prober.
+   *
+   * When a binary variable is fixed in a node, each literal it implies is
+   * fixed too, and so is the complement of each other literal of a clique
+   * that contains it. Variables fixed in this way are propagated in turn.
+   * The node is infeasible if a literal must hold but its variable is fixed
+   * to the other value.
+   *
+   * The indices of variables in the graph are those of the problem when it
+   * was probed, and must be the indices of the same variables in the
+   * relaxation. The graph is not owned by the handler.
+   */
+  class ImplHandler : public Handler {
+  public:
+    /// Constructor.
+    ImplHandler(EnvPtr env, const ImplGraph *graph);
+
+    /// Destroy.
+    ~ImplHandler();
+
+    /// Does nothing.
+    Branches getBranches(BrCandPtr, DoubleVector &, RelaxationPtr,
+                         SolutionPoolPtr)
+    { return Branches(); };
+
+    /// Does nothing.
+    void getBranchingCandidates(RelaxationPtr, const DoubleVector &,
+                                ModVector &, BrVarCandSet &, BrCandVector &,
+                                bool &) {};
+
+    /// Does nothing.
+    ModificationPtr getBrMod(BrCandPtr, DoubleVector &, RelaxationPtr,
+                             BranchDirection)
+    { return ModificationPtr(); };
+
+    // Base class method.
+    std::string getName() const;
+
+    /// Always true. The implications are valid, not needed for feasibility.
+    bool isFeasible(ConstSolutionPtr, RelaxationPtr, bool &, double &)
+    { return true; };
+
+    /// Does nothing.
+    SolveStatus presolve(PreModQ *, bool *, Solution **)
+    { return Finished; };
+
+    /// Base class method. Fix binary variables implied by those fixed.
+    bool presolveNode(RelaxationPtr rel, NodePtr node, SolutionPoolPtr s_pool,
+                      ModVector &p_mods, ModVector &r_mods);
+
+    /// Does nothing.
+    void postsolveGetX(const double *, UInt, DoubleVector *) {};
+
+    /// Does nothing.
+    void relaxInitFull(RelaxationPtr, SolutionPool *, bool *) {};
+
+    /// Does nothing.
+    void relaxInitInc(RelaxationPtr, SolutionPool *, bool *) {};
+
+    /// Does nothing.
+    void relaxNodeFull(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void relaxNodeInc(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void separate(ConstSolutionPtr, NodePtr, RelaxationPtr, CutManager *,
+                  SolutionPoolPtr, ModVector &, ModVector &, bool *,
+                  SeparationStatus *) {};
+
+    // Base class method.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Tolerance for checking if a variable is fixed.
+    const double eTol_;
+
+    /// Implications and cliques.
+    const ImplGraph *graph_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Statistics.
+    ImplStats stats_;
+
+    /**
+     * \brief Make a literal hold in rel.
+     *
+     * \param[in] rel The relaxation.
+     * \param[in] lit The literal.
+     * \param[out] r_mods The modification is appended if the variable is
+     * fixed.
+     * \param[out] lits The literal is appended if the variable is fixed.
+     * \returns False if the variable is fixed to the other value.
+     */
+    bool fix_(RelaxationPtr rel, UInt lit, ModVector &r_mods,
+              UIntVector &lits);
+
+    /// Copy constructor is not allowed.
+    ImplHandler(const ImplHandler &);
+
+    /// Copy by assignment is not allowed.
+    ImplHandler &operator=(const ImplHandler &);
+  };
+  typedef ImplHandler* ImplHandlerPtr;
+}
+#endif
@@ -63,6 +63,9 @@ public:
 
   bool isNeeded();
 
+  /// separate() does nothing, so it can run with other handlers.
+  bool isSepThreadSafe() const { return true; };
+
   /// Does nothing.
   void postsolveGetX(const double *, UInt, DoubleVector *) {};
 
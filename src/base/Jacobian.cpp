@@ -23,15 +23,10 @@ Jacobian::Jacobian()
 
 
 Jacobian::Jacobian(const std::vector<ConstraintPtr> & cons, const UInt)
+  : cons_(&cons),
+    nz_(0)
 {
-  ConstraintConstIterator c_iter;
-
-  nz_ = 0;
-  cons_ = &cons;
-  for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter) {
-    nz_ += (*c_iter)->getFunction()->getNumVars();
-    (*c_iter)->getFunction()->prepJac();
-  }
+  update(true);
 }
 
 
@@ -72,20 +67,38 @@ void Jacobian::fillRowColIndices(UInt *iRow, UInt *jCol)
 void Jacobian::fillRowColValues(const double *x, double *values, int *error)
 {
   ConstraintConstIterator c_iter;
-  UInt nz_cnt = 0;
-  FunctionPtr f;
+  UInt r_cnt = 0;
 
   *error = 0;
   std::fill(values, values+nz_, 0.0);
-  for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter) {
-    f = (*c_iter)->getFunction();
-    f->fillJac(x, values+nz_cnt, error);
-    nz_cnt += f->getNumVars();
+  for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter, ++r_cnt) {
+    (*c_iter)->getFunction()->fillJac(x, values+offs_[r_cnt], error);
     if (*error != 0) {
       return;
     }
   }
-  assert(nz_cnt==nz_);
+  assert(offs_.size()==r_cnt+1);
+}
+
+
+void Jacobian::update(bool nlChanged)
+{
+  ConstraintConstIterator c_iter;
+  FunctionPtr f;
+  UInt r_cnt = 0;
+
+  nz_ = 0;
+  offs_.resize(cons_->size()+1);
+  for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter, ++r_cnt) {
+    f = (*c_iter)->getFunction();
+    offs_[r_cnt] = nz_;
+    nz_ += f->getNumVars();
+    if (nlChanged || (!f->getQuadraticFunction() &&
+                      !f->getNonlinearFunction())) {
+      f->prepJac();
+    }
+  }
+  offs_[r_cnt] = nz_;
 }
 
 
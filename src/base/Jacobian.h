@@ -96,6 +96,20 @@ namespace Minotaur {
       virtual void fillColRowValues(const double *, double *, int *)
       { assert(!"implement me!");}
          
+      /**
+       * \brief Update the offsets of the rows after constraints were added,
+       * deleted or changed.
+       *
+       * \param[in] nlChanged If false, the nonlinear functions have not
+       * changed since the last call (see Problem::getNlStructVersion()) and
+       * their derivatives are not prepared again. Linear functions are
+       * always prepared, which is cheap when they have not changed.
+       */
+      void update(bool nlChanged);
+
+      /// Return the vector of constraints of this jacobian.
+      const std::vector<ConstraintPtr> * getCons() const { return cons_; };
+
       void write(std::ostream &out) const;
 
     private:
@@ -108,6 +122,9 @@ namespace Minotaur {
       /// Number of nonzeros
       UInt nz_;
 
+      /// Position of the first nonzero of each row. Has one entry more.
+      UIntVector offs_;
+
   };
   typedef Jacobian* JacobianPtr;
 }
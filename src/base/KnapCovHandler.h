@@ -123,6 +123,9 @@ namespace Minotaur {
     // Write name.
     std::string getName() const;
 
+    /// Cover cuts only read the relaxation and go through the cut manager.
+    bool isSepThreadSafe() const { return true; };
+
     /// Show statistics.
     void writeStats(std::ostream &) const;
 
@@ -20,6 +20,7 @@
 #include "LinConMod.h"
 #include "LinearFunction.h"
 #include "Problem.h"
+#include "SlabAlloc.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -52,6 +53,25 @@ LinConMod::~LinConMod()
 }
 
 
+static SlabAlloc *linConModAlloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("LinConMod", sizeof(LinConMod));
+  return a;
+}
+
+
+void *LinConMod::operator new(size_t size)
+{
+  return linConModAlloc_()->alloc(size);
+}
+
+
+void LinConMod::operator delete(void *p, size_t size)
+{
+  linConModAlloc_()->free(p, size);
+}
+
+
 void LinConMod::applyToProblem(ProblemPtr problem) 
 {
   LinearFunctionPtr lf = newLf_->clone();
@@ -43,6 +43,12 @@ public:
   /// Destroy.
   ~LinConMod();
 
+  /// Allocate from a SlabAlloc shared by all objects of this class.
+  static void *operator new(size_t size);
+
+  /// Return memory allocated by operator new.
+  static void operator delete(void *p, size_t size);
+
   /// Apply it to the problem.
   void applyToProblem(ProblemPtr problem);
 
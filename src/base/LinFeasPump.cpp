@@ -16,6 +16,7 @@
 
 #include "MinotaurConfig.h"
 #include "Engine.h"
+#include "EnginePool.h"
 #include "Variable.h"
 #include "Environment.h"
 #include "Logger.h"
@@ -347,7 +348,14 @@ void LinFeasPump::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
 
   logger_->msgStream(LogInfo) << me_ << "starting" << std::endl;
   timer_->start();
+  // convertSol_() expects p_ to stay loaded in e_ when there is a pool.
+  if (pool_) {
+    e_ = pool_->acquire(p_, e_);
+  }
   implementFP_(x, s_pool); 
+  if (pool_) {
+    pool_->release(e_);
+  }
   logger_->msgStream(LogInfo) << me_ << "over" << std::endl;
   stats_->time = timer_->query();
   timer_->stop();
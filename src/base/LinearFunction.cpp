@@ -95,6 +95,16 @@ void LinearFunction::addTerm(ConstVariablePtr var, const double a)
 }
 
 
+void LinearFunction::appendTerm(ConstVariablePtr var, const double a)
+{
+  if (fabs(a) > tol_) {
+    // the hint makes insertion constant time if var is the largest.
+    terms_.insert(terms_.end(), std::make_pair(var, a));
+    hasChanged_ = true;
+  }
+}
+
+
 LinearFunctionPtr LinearFunction::clone() const
 {
    LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
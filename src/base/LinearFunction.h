@@ -62,6 +62,13 @@ namespace Minotaur {
      */
     void addTerm(ConstVariablePtr var, const double a);
 
+    /**
+     * Same as addTerm(), but faster when var comes after all the variables
+     * already in this function, e.g. when the function is built column by
+     * column. It is correct, but not faster, otherwise.
+     */
+    void appendTerm(ConstVariablePtr var, const double a);
+
     /**
      * Removes all terms from the function
      */
@@ -54,6 +54,7 @@ LinearHandler::LinearHandler()
     problem_(ProblemPtr()),
     logger_(LoggerPtr()),
     intTol_(1e-6),
+    presAll_(true),
     eTol_(1e-8),
     infty_(1e20),
     pStats_(0),
@@ -66,6 +67,7 @@ LinearHandler::LinearHandler(EnvPtr env, ProblemPtr problem)
   : env_(env),
     problem_(problem),
     intTol_(1e-6),
+    presAll_(true),
     eTol_(1e-8),
     infty_(1e20),
     pStats_(0),
@@ -247,11 +249,14 @@ SolveStatus LinearHandler::presolve(PreModQ* pre_mods, bool* changed0,
   // constraint specific. Even if one constraint is changed, all constraints
   // are checked for duplicacy.
 
-  chkDupRows_ = true;
+  chkDupRows_ = presAll_ || !presCons_.empty();
   for(ConstraintConstIterator c_iter = problem_->consBegin();
       c_iter != problem_->consEnd(); ++c_iter) {
-    (*c_iter)->setBFlag(true);
+    (*c_iter)->setBFlag(presAll_ || presCons_.count(*c_iter) > 0);
   }
+  // next call looks at everything unless told otherwise.
+  presCons_.clear();
+  presAll_ = true;
 
   while(changed == true && pStats_->iters < pOpts_->maxIters) {
     //problem_->write(std::cout);
@@ -321,6 +326,22 @@ SolveStatus LinearHandler::presolve(PreModQ* pre_mods, bool* changed0,
   return Finished;
 }
 
+void LinearHandler::setPresolveDirty(bool all, const VarSet& vars,
+                                     const ConstrSet& cons)
+{
+  presAll_ = all;
+  presCons_ = cons;
+  if(true == all) {
+    return;
+  }
+  for(VarSet::const_iterator it = vars.begin(); it != vars.end(); ++it) {
+    for(ConstrSet::iterator cit = (*it)->consBegin(); cit != (*it)->consEnd();
+        ++cit) {
+      presCons_.insert(*cit);
+    }
+  }
+}
+
 SolveStatus LinearHandler::checkBounds_(ProblemPtr p)
 {
   VariablePtr v;
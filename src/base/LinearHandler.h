@@ -94,6 +94,12 @@ public:
     return true;
   }
 
+  /// separate() does nothing, so it can run with other handlers.
+  bool isSepThreadSafe() const
+  {
+    return true;
+  }
+
   /**
    * Generate valid cuts using linear constraints.
    */
@@ -124,6 +130,14 @@ public:
   virtual SolveStatus presolve(PreModQ* pre_mods, bool* changed,
                                Solution** sol);
 
+  /**
+   * Implement Handler::setPresolveDirty(). The next presolve() tightens
+   * bounds from the given constraints and constraints of the given
+   * variables only, and checks for duplicate rows only if some constraint
+   * changed.
+   */
+  void setPresolveDirty(bool all, const VarSet& vars, const ConstrSet& cons);
+
   // Implement Handler::presolveNode().
   virtual bool presolveNode(RelaxationPtr p, NodePtr node,
                             SolutionPoolPtr s_pool, ModVector& p_mods,
@@ -192,6 +206,15 @@ protected:
   /// If true, dupRows_ is run in presolve
   bool chkDupRows_;
 
+  /**
+   * Constraints that changed since the last presolve, or that have a
+   * variable that changed. Set by setPresolveDirty().
+   */
+  ConstrSet presCons_;
+
+  /// If true, the next presolve looks at all constraints.
+  bool presAll_;
+
   /// Tolerance.
   const double eTol_;
 
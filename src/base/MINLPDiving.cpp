@@ -18,6 +18,7 @@
 #include "MinotaurConfig.h"
 #include "Constraint.h"
 #include "Engine.h"
+#include "EnginePool.h"
 #include "Environment.h"
 #include "Function.h"
 #include "LinearHandler.h"
@@ -44,6 +45,7 @@ MINLPDiving::MINLPDiving(EnvPtr env, ProblemPtr p, EnginePtr e)
   env_(env), 
   gradientObj_(NULL),
   intTol_(1e-5),
+  pool_(0),
   lh_(0),
   maxNLP_(100),
   maxSol_(2), 
@@ -321,8 +323,13 @@ void MINLPDiving::implementDive_(int i, const double* x, SolutionPoolPtr s_pool)
     ++(stats_->numNLPs[i/8]);
     ++(stats_->totalNLPs);
     if (EngineError == status) {
-      e_->clear();  // reset the starting point
-      e_->load(p_);
+      // reset the starting point
+      if (pool_) {
+        pool_->reload(e_);
+      } else {
+        e_->clear();
+        e_->load(p_);
+      }
       ++(stats_->errors[i/8]);
     }
     if (status == ProvenLocalOptimal || status == ProvenOptimal 
@@ -558,12 +565,9 @@ UInt MINLPDiving::ReducedCost_(UInt numfrac, const double* x,
 }
 
 
-void MINLPDiving::restoreBounds_(double* LB_copy, double* UB_copy, UInt vars)
+void MINLPDiving::restoreBounds_(double* LB_copy, double* UB_copy, UInt)
 {
-  for (UInt i=0; i<vars; ++i, ++LB_copy, ++UB_copy) {
-    p_->changeBoundByInd(i, Lower, *LB_copy);
-    p_->changeBoundByInd(i, Upper, *UB_copy);
-  }
+  p_->changeBounds(LB_copy, UB_copy);
 }
 
 
@@ -594,14 +598,9 @@ double MINLPDiving::rounding_(double value, Direction d)
 }
 
 
-void MINLPDiving::saveBounds_(double* LB_copy, double* UB_copy, UInt vars)
+void MINLPDiving::saveBounds_(double* LB_copy, double* UB_copy, UInt)
 {
-  VariablePtr variable;
-  for (UInt i=0; i<vars; ++i, ++LB_copy, ++UB_copy) {
-    variable = p_->getVariable(i);
-    *LB_copy = variable->getLb();
-    *UB_copy = variable->getUb();
-  }
+  p_->getBounds(LB_copy, UB_copy);
 }
 
 
@@ -693,8 +692,12 @@ void MINLPDiving::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
   root_copy          = new double[numvars];
   LB_copy            = new double[numvars];
   UB_copy            = new double[numvars];
-  e_->clear();
-  e_->load(p_);
+  if (pool_) {
+    e_ = pool_->acquire(p_, e_);
+  } else {
+    e_->clear();
+    e_->load(p_);
+  }
   e_->setIterationLimit(7000); // try to run for a loooong time.
   status             = e_->solve();
   sol                = e_->getSolution();
@@ -733,6 +736,9 @@ void MINLPDiving::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
     } // loop over methods ends here
   }
   e_->resetIterationLimit();
+  if (pool_) {
+    pool_->release(e_);
+  }
   logger_->msgStream(LogInfo) << me_ << "Over" << std::endl;
   if (root_x){
     delete [] root_x;
@@ -22,6 +22,7 @@
 
  namespace Minotaur {
    class Engine;
+   class EnginePool;
    class LinearHandler;
    class Problem;
    class Solution;
@@ -87,6 +88,12 @@
      /// default destructor
      ~MINLPDiving();
 
+     /**
+      * \brief Get the engine from a pool at each call instead of loading
+      * the problem in it. The pool then owns the engine.
+      */
+     void setEnginePool(EnginePool *pool) { pool_ = pool; };
+
      /// call to heuristic
      void solve(NodePtr node, RelaxationPtr rel, SolutionPoolPtr s_pool); 
 
@@ -118,6 +125,9 @@
      /// We only store mods of one node only.
      ModVector lastNodeMods_;
 
+     /// Pool that gives the engine, if any.
+     EnginePool *pool_;
+
      /// Linear Handler for presolving.
      LinearHandler *lh_;
 
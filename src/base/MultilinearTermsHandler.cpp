@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 
 #include "Branch.h"
@@ -21,6 +22,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "LinearFunction.h"
+#include "LinConMod.h"
 #include "LinMods.h"
 #include "Logger.h"
 #include "MultilinearTermsHandler.h"
@@ -30,6 +32,7 @@
 #include "Problem.h"
 #include "Relaxation.h"
 #include "Solution.h"
+#include "Timer.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -47,7 +50,12 @@ MultilinearTermsHandler::MultilinearTermsHandler(EnvPtr env, ProblemPtr problem)
   augmentCoverFactor_ = env_->getOptions()->findDouble("ml_cover_augmentation_factor")->getValue();
 
   initialTermCoverSize_ = 0;
-
+  lazyHull_ = env_->getOptions()->findBool("ml_lazy_hull")->getValue();
+  nInitRows_ = 0;
+  nInitVars_ = 0;
+  maxCachedFacets_ = 64;
+  memset(&sStats_, 0, sizeof(SepaStats));
+  timer_ = env_->getTimer();
 }
 
 
@@ -195,6 +203,10 @@ ModificationPtr MultilinearTermsHandler::getBrMod(BrCandPtr cand, DoubleVector &
 
   VarBoundModPtr vmod = (VarBoundModPtr) new VarBoundMod(v, lu, branching_value);
   linmods->insert(vmod);
+  if (lazyHull_) {
+    // McCormick rows are changed in relaxNodeInc, facets are separated.
+    return linmods;
+  }
   
   
   // This chunk of code changes the
@@ -420,6 +432,37 @@ MultilinearTermsHandler::relaxInitInc(RelaxationPtr relaxation, SolutionPool *,
   //exit(1);
 #endif
 
+  UInt nrows = relaxation->getNumCons();
+  UInt nvars = relaxation->getNumVars();
+  ModVector mods;  // Not used in initialization
+
+  if (lazyHull_) {
+    gVars_.resize(groups_.size());
+    gTerms_.resize(groups_.size());
+    facets_.resize(groups_.size());
+    facetRows_.resize(groups_.size());
+    for (UInt gix = 0; gix < groups_.size(); ++gix) {
+      SetOfVars &vg = groups_[gix];
+      gVars_[gix].assign(vg.begin(), vg.end());
+      for (ConstTermIterator it = termsR_.begin(); it != termsR_.end(); ++it) {
+        SetOfVars const &jt = it->second;
+        if (std::includes(vg.begin(), vg.end(), jt.begin(), jt.end())) {
+          UIntVector pos;
+          for (SetOfVars::const_iterator jt_it = jt.begin();
+               jt_it != jt.end(); ++jt_it) {
+            pos.push_back(std::find(gVars_[gix].begin(), gVars_[gix].end(),
+                                    *jt_it) - gVars_[gix].begin());
+          }
+          gTerms_[gix].push_back(std::make_pair(it->first, pos));
+        }
+      }
+    }
+    handleMcRows_(relaxation, relaxInit_Call, mods);
+    nInitRows_ = relaxation->getNumCons() - nrows;
+    nInitVars_ = relaxation->getNumVars() - nvars;
+    return;
+  }
+
   /* This chunk of code creates the (powerset) representation 
    * of the extreme points in the groups, adds the lambda variables,
    * and adds the convexity constraints
@@ -454,9 +497,10 @@ MultilinearTermsHandler::relaxInitInc(RelaxationPtr relaxation, SolutionPool *,
   }  
 
 
-  ModVector mods;  // Not used in initialization
   handleXDefConstraints_(relaxation, relaxInit_Call, mods);
   handleZDefConstraints_(relaxation, relaxInit_Call, mods);
+  nInitRows_ = relaxation->getNumCons() - nrows;
+  nInitVars_ = relaxation->getNumVars() - nvars;
 
 
 #if defined(DEBUG_MULTILINEARTERMS_HANDLER)
@@ -481,8 +525,12 @@ MultilinearTermsHandler::relaxNodeInc(NodePtr node,
 #endif
 
   ModVector mods;
-  handleXDefConstraints_(relaxation, relaxNodeInc_Call, mods);
-  handleZDefConstraints_(relaxation, relaxNodeInc_Call, mods);
+  if (lazyHull_) {
+    handleMcRows_(relaxation, relaxNodeInc_Call, mods);
+  } else {
+    handleXDefConstraints_(relaxation, relaxNodeInc_Call, mods);
+    handleZDefConstraints_(relaxation, relaxNodeInc_Call, mods);
+  }
   
   ModificationConstIterator it;
   for (it = mods.begin(); it != mods.end(); ++it) {
@@ -609,6 +657,402 @@ MultilinearTermsHandler::handleZDefConstraints_(RelaxationPtr relaxation, Handle
 
 }
 
+// In lazy mode, the only rows added initially are the McCormick inequalities
+// of terms with two variables and the bounds of z_t for longer terms.
+void
+MultilinearTermsHandler::handleMcRows_(RelaxationPtr relaxation,
+                                       HandleCallingFunction wherefrom,
+                                       ModVector &mods)
+{
+  for (ConstTermIterator it = termsR_.begin(); it != termsR_.end(); ++it) {
+    ConstVariablePtr zt = it->first;
+    SetOfVars const &jt = it->second;
+    std::vector<LinearFunctionPtr> lfs;
+    DoubleVector lbs, ubs;
+
+    if (jt.size() == 2) {
+      ConstVariablePtr x1 = *(jt.begin());
+      ConstVariablePtr x2 = *(jt.rbegin());
+      double l1 = x1->getLb(), u1 = x1->getUb();
+      double l2 = x2->getLb(), u2 = x2->getUb();
+      // (a2 x1 + a1 x2 - z) compared with a1 a2 for each corner (a1, a2).
+      double a1[4] = {l1, u1, l1, u1};
+      double a2[4] = {l2, u2, u2, l2};
+      for (UInt i = 0; i < 4; ++i) {
+        LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+        lf->addTerm(zt, -1.0);
+        if (fabs(a1[i]) < INFINITY && fabs(a2[i]) < INFINITY) {
+          lf->addTerm(x1, a2[i]);
+          lf->addTerm(x2, a1[i]);
+          lbs.push_back(i < 2 ? -INFINITY : a1[i] * a2[i]);
+          ubs.push_back(i < 2 ? a1[i] * a2[i] : INFINITY);
+        } else {
+          lbs.push_back(-INFINITY);
+          ubs.push_back(INFINITY);
+        }
+        lfs.push_back(lf);
+      }
+    } else {
+      double zlb = INFINITY, zub = -INFINITY;
+      UInt n = jt.size();
+      for (UInt mask = 0; mask < (1U << n) && zub < INFINITY; ++mask) {
+        double prodval = 1.0;
+        UInt k = 0;
+        for (SetOfVars::const_iterator jt_it = jt.begin(); jt_it != jt.end();
+             ++jt_it, ++k) {
+          prodval *= ((mask >> k) & 1) ? (*jt_it)->getUb() : (*jt_it)->getLb();
+        }
+        if (std::isnan(prodval) || fabs(prodval) >= INFINITY) {
+          zlb = -INFINITY;
+          zub = INFINITY;
+        } else {
+          zlb = std::min(zlb, prodval);
+          zub = std::max(zub, prodval);
+        }
+      }
+      LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+      lf->addTerm(zt, 1.0);
+      lfs.push_back(lf);
+      lbs.push_back(zlb);
+      ubs.push_back(zub);
+    }
+
+    std::vector<ConstraintPtr> &rows = mcRows_[zt];
+    for (UInt i = 0; i < lfs.size(); ++i) {
+      if (wherefrom == relaxInit_Call) {
+        FunctionPtr f = (FunctionPtr) new Function(lfs[i]);
+        rows.push_back(relaxation->newConstraint(f, lbs[i], ubs[i]));
+      } else {
+        ConstraintPtr c = rows[i];
+        LinConModPtr lcmod = (LinConModPtr) new LinConMod(c, lfs[i]->clone(),
+                                                          lbs[i], ubs[i]);
+        relaxation->changeConstraint(c, lfs[i], lbs[i], ubs[i]);
+        mods.push_back(lcmod);
+      }
+    }
+  }
+}
+
+
+bool MultilinearTermsHandler::hullFacet_(UInt gix, const double *x,
+                                         HullFacet &f)
+{
+  // The point and the extreme points are scaled to the unit box. The
+  // distance of the point from the hull,
+  //   min 1'(s+ + s-)  s.t.  sum_k lambda_k (chi^k, 1) + s+ - s- = (x, 1),
+  // is found with a dense primal simplex starting from the slacks. Its
+  // dual (pi, pi0) gives  pi'(chi, z) + pi0 <= 0  for every extreme point.
+  std::vector<ConstVariablePtr> &vars = gVars_[gix];
+  std::vector<std::pair<ConstVariablePtr, UIntVector> > &terms = gTerms_[gix];
+  const UInt n = vars.size();
+  const UInt nt = terms.size();
+  const UInt m = n + nt + 1;
+  const UInt np = 1U << n;
+  const UInt ncols = np + 2 * m;
+  DoubleVector off(m - 1), sc(m - 1), b(m), a(m * ncols, 0.0), y(m);
+  DoubleVector vals(n);
+  UIntVector basis(m);
+  double obj, maxv, viol;
+  UInt iters = 0;
+
+  f.lb.resize(n);
+  f.ub.resize(n);
+  for (UInt i = 0; i < n; ++i) {
+    f.lb[i] = vars[i]->getLb();
+    f.ub[i] = vars[i]->getUb();
+    if (f.lb[i] <= -INFINITY || f.ub[i] >= INFINITY) {
+      return false;
+    }
+    off[i] = f.lb[i];
+    sc[i] = (f.ub[i] - f.lb[i] > eTol_) ? f.ub[i] - f.lb[i] : 1.0;
+  }
+
+  // columns of the extreme points.
+  for (UInt t = 0; t < nt; ++t) {
+    off[n + t] = INFINITY;
+    sc[n + t] = -INFINITY;
+  }
+  for (UInt k = 0; k < np; ++k) {
+    for (UInt i = 0; i < n; ++i) {
+      vals[i] = ((k >> i) & 1) ? f.ub[i] : f.lb[i];
+      a[i * ncols + k] = vals[i];
+    }
+    for (UInt t = 0; t < nt; ++t) {
+      double prodval = 1.0;
+      for (UIntVector::iterator p = terms[t].second.begin();
+           p != terms[t].second.end(); ++p) {
+        prodval *= vals[*p];
+      }
+      a[(n + t) * ncols + k] = prodval;
+      off[n + t] = std::min(off[n + t], prodval);
+      sc[n + t] = std::max(sc[n + t], prodval);
+    }
+    a[(m - 1) * ncols + k] = 1.0;
+  }
+  for (UInt t = 0; t < nt; ++t) {
+    sc[n + t] = (sc[n + t] - off[n + t] > eTol_) ? sc[n + t] - off[n + t] :
+      1.0;
+  }
+  for (UInt i = 0; i + 1 < m; ++i) {
+    for (UInt k = 0; k < np; ++k) {
+      a[i * ncols + k] = (a[i * ncols + k] - off[i]) / sc[i];
+    }
+    b[i] = ((i < n ? x[vars[i]->getIndex()] :
+             x[terms[i - n].first->getIndex()]) - off[i]) / sc[i];
+  }
+  b[m - 1] = 1.0;
+
+  // slacks, and the starting basis.
+  for (UInt i = 0; i < m; ++i) {
+    double sgn = (b[i] < 0.0) ? -1.0 : 1.0;
+    a[i * ncols + np + i] = 1.0;
+    a[i * ncols + np + m + i] = -1.0;
+    for (UInt j = 0; j < ncols; ++j) {
+      a[i * ncols + j] *= sgn;
+    }
+    b[i] *= sgn;
+    basis[i] = (sgn > 0.0) ? np + i : np + m + i;
+  }
+
+  ++sStats_.lps;
+  DoubleVector rc(ncols);
+  while (true) {
+    UInt enter = ncols, leave = m;
+    double best = -1e-10, ratio = INFINITY;
+    for (UInt j = 0; j < ncols; ++j) {
+      rc[j] = (j < np) ? 0.0 : 1.0;
+      for (UInt i = 0; i < m; ++i) {
+        if (basis[i] >= np) {
+          rc[j] -= a[i * ncols + j];
+        }
+      }
+      // Dantzig's rule, then Bland's rule to avoid cycling.
+      if (rc[j] < best) {
+        enter = j;
+        if (iters > 10 * ncols) {
+          break;
+        }
+        best = rc[j];
+      }
+    }
+    if (enter == ncols || iters > 50 * ncols) {
+      break;
+    }
+    for (UInt i = 0; i < m; ++i) {
+      double aij = a[i * ncols + enter];
+      if (aij > 1e-9 && (b[i] / aij < ratio - 1e-12 ||
+                         (b[i] / aij < ratio + 1e-12 && leave < m &&
+                          basis[i] < basis[leave]))) {
+        ratio = b[i] / aij;
+        leave = i;
+      }
+    }
+    if (leave == m) {
+      break;
+    }
+    double piv = a[leave * ncols + enter];
+    for (UInt j = 0; j < ncols; ++j) {
+      a[leave * ncols + j] /= piv;
+    }
+    b[leave] /= piv;
+    for (UInt i = 0; i < m; ++i) {
+      double fac = a[i * ncols + enter];
+      if (i != leave && fac != 0.0) {
+        for (UInt j = 0; j < ncols; ++j) {
+          a[i * ncols + j] -= fac * a[leave * ncols + j];
+        }
+        b[i] -= fac * b[leave];
+      }
+    }
+    basis[leave] = enter;
+    ++iters;
+  }
+
+  obj = 0.0;
+  for (UInt i = 0; i < m; ++i) {
+    if (basis[i] >= np) {
+      obj += b[i];
+    }
+  }
+  if (obj <= eTol_) {
+    return false;
+  }
+
+  // duals of the rows, from the reduced costs of s+.
+  for (UInt i = 0; i < m; ++i) {
+    y[i] = 1.0 - rc[np + i];
+  }
+  // make sure the cut is valid at all extreme points despite round-off.
+  maxv = -INFINITY;
+  for (UInt k = 0; k < np; ++k) {
+    double v = y[m - 1];
+    for (UInt i = 0; i < n; ++i) {
+      vals[i] = ((k >> i) & 1) ? f.ub[i] : f.lb[i];
+      v += y[i] * (vals[i] - off[i]) / sc[i];
+    }
+    for (UInt t = 0; t < nt; ++t) {
+      double prodval = 1.0;
+      for (UIntVector::iterator p = terms[t].second.begin();
+           p != terms[t].second.end(); ++p) {
+        prodval *= vals[*p];
+      }
+      v += y[n + t] * (prodval - off[n + t]) / sc[n + t];
+    }
+    maxv = std::max(maxv, v);
+  }
+  if (maxv > 0.0) {
+    y[m - 1] -= maxv;
+  }
+
+  // back to the original space.
+  f.coef.resize(m - 1);
+  f.rhs = -y[m - 1];
+  viol = -f.rhs;
+  for (UInt i = 0; i + 1 < m; ++i) {
+    double xi = (i < n) ? x[vars[i]->getIndex()] :
+      x[terms[i - n].first->getIndex()];
+    f.coef[i] = y[i] / sc[i];
+    f.rhs += y[i] * off[i] / sc[i];
+    viol += y[i] * (xi - off[i]) / sc[i];
+  }
+  return viol > eTol_;
+}
+
+
+void MultilinearTermsHandler::addFacet_(UInt gix, const HullFacet &f,
+                                        RelaxationPtr rel, ModVector &mods)
+{
+  std::vector<ConstraintPtr> &rows = facetRows_[gix];
+  std::vector<ConstVariablePtr> &vars = gVars_[gix];
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  ConstraintPtr c = ConstraintPtr();
+  UInt n = vars.size();
+
+  for (UInt i = 0; i < f.coef.size(); ++i) {
+    lf->incTerm(i < n ? vars[i] : gTerms_[gix][i - n].first, f.coef[i]);
+  }
+  for (UInt i = 0; i < rows.size(); ++i) {
+    if (rows[i]->getUb() >= INFINITY) {
+      c = rows[i];
+      break;
+    }
+  }
+  if (!c) {
+    // a new row is free at all other nodes.
+    FunctionPtr fn = (FunctionPtr) new Function(lf->clone());
+    c = rel->newConstraint(fn, -INFINITY, INFINITY);
+    rows.push_back(c);
+    ++sStats_.rows;
+  }
+  LinConModPtr lcmod = (LinConModPtr) new LinConMod(c, lf->clone(),
+                                                    -INFINITY, f.rhs);
+  rel->changeConstraint(c, lf, -INFINITY, f.rhs);
+  mods.push_back(lcmod);
+  ++sStats_.cuts;
+}
+
+
+void MultilinearTermsHandler::separate(ConstSolutionPtr sol, NodePtr,
+                                       RelaxationPtr rel, CutManager *,
+                                       SolutionPoolPtr, ModVector &,
+                                       ModVector &r_mods, bool *,
+                                       SeparationStatus *status)
+{
+  const double *x = sol->getPrimal();
+  double stime;
+
+  if (!lazyHull_) {
+    return;
+  }
+  stime = timer_->query();
+  ++sStats_.iters;
+  for (UInt gix = 0; gix < groups_.size(); ++gix) {
+    std::vector<ConstVariablePtr> &vars = gVars_[gix];
+    std::vector<std::pair<ConstVariablePtr, UIntVector> > &terms =
+      gTerms_[gix];
+    std::deque<HullFacet> &cache = facets_[gix];
+    const HullFacet *found = 0;
+    HullFacet f;
+    bool vio = false;
+
+    // a point on the graph of all terms is in the hull.
+    for (UInt t = 0; t < terms.size() && !vio; ++t) {
+      double prodval = 1.0;
+      for (UIntVector::iterator p = terms[t].second.begin();
+           p != terms[t].second.end(); ++p) {
+        prodval *= x[vars[*p]->getIndex()];
+      }
+      vio = fabs(x[terms[t].first->getIndex()] - prodval) > eTol_;
+    }
+    if (!vio) {
+      continue;
+    }
+
+    // facets found at other nodes are valid if their box contains this one.
+    for (std::deque<HullFacet>::iterator it = cache.begin();
+         it != cache.end() && !found; ++it) {
+      bool valid = true;
+      double act = 0.0;
+      for (UInt i = 0; i < vars.size() && valid; ++i) {
+        valid = it->lb[i] <= vars[i]->getLb() + eTol_ &&
+                it->ub[i] >= vars[i]->getUb() - eTol_;
+      }
+      if (valid) {
+        for (UInt i = 0; i < it->coef.size(); ++i) {
+          act += it->coef[i] * (i < vars.size() ? x[vars[i]->getIndex()] :
+                                x[terms[i - vars.size()].first->getIndex()]);
+        }
+        if (act - it->rhs > eTol_ * std::max(1.0, fabs(it->rhs))) {
+          found = &(*it);
+          ++sStats_.reused;
+        }
+      }
+    }
+    if (!found && hullFacet_(gix, x, f)) {
+      if (cache.size() >= maxCachedFacets_) {
+        cache.pop_front();
+      }
+      cache.push_back(f);
+      found = &(cache.back());
+    }
+    if (found) {
+      addFacet_(gix, *found, rel, r_mods);
+      *status = SepaResolve;
+    }
+  }
+  sStats_.time += timer_->query() - stime;
+}
+
+
+void MultilinearTermsHandler::writeStats(std::ostream &out) const
+{
+  std::string me = "MultilinearTermsHandler: ";
+  out << me << "Relaxation of multilinear terms:" << std::endl
+      << me << "Formulation                    = "
+      << (lazyHull_ ? "McCormick + hull facets" : "extreme points")
+      << std::endl
+      << me << "Number of groups               = " << groups_.size()
+      << std::endl
+      << me << "Rows in initial relaxation     = " << nInitRows_ << std::endl
+      << me << "Variables in initial relaxation = " << nInitVars_
+      << std::endl;
+  if (lazyHull_) {
+    out << me << "Number of calls to separate    = " << sStats_.iters
+        << std::endl
+        << me << "Separation LPs solved          = " << sStats_.lps
+        << std::endl
+        << me << "Hull facets added              = " << sStats_.cuts
+        << std::endl
+        << me << "Facets reused from cache       = " << sStats_.reused
+        << std::endl
+        << me << "Rows created for facets        = " << sStats_.rows
+        << std::endl
+        << me << "Time taken in separation       = " << sStats_.time
+        << std::endl;
+  }
+}
+
+
 bool MultilinearTermsHandler::allVarsBinary_(SetOfVars const &s) const
 {
   bool allbinary = true;
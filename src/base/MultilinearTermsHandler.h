@@ -13,6 +13,7 @@
 #define MINOTAURMULTILINEARTERMSHANDLER_H
 
 #include <algorithm>
+#include <deque>
 
 #include "Handler.h"
 #include "LPEngine.h"
@@ -20,6 +21,7 @@
 
 namespace Minotaur {
 
+class Timer;
 
 // These should maybe go in Terms.h and be public -- they seem pretty generic
 typedef std::set<ConstVariablePtr> SetOfVars;
@@ -146,10 +148,13 @@ public:
   void relaxNodeInc(NodePtr n, RelaxationPtr r , bool *is_inf);
 
     
-  /// Can not return any cuts for this case.
-  void separate(ConstSolutionPtr, NodePtr , RelaxationPtr , CutManager *, 
-                SolutionPoolPtr, ModVector &, ModVector &, bool *,
-                SeparationStatus *) {};
+  /**
+   * Separate facets of the convex hull of a group if option ml_lazy_hull is
+   * set. Otherwise there is nothing to separate.
+   */
+  void separate(ConstSolutionPtr sol, NodePtr node, RelaxationPtr rel,
+                CutManager *cutman, SolutionPoolPtr s_pool, ModVector &p_mods,
+                ModVector &r_mods, bool *sol_found, SeparationStatus *status);
     
   virtual ModificationPtr getBrMod(BrCandPtr , DoubleVector &, 
                                    RelaxationPtr , BranchDirection );
@@ -168,6 +173,9 @@ public:
     
   // Write name
   std::string getName() const { return std::string("Multilinear Term Handler"); }
+
+  // Write statistics on the size of the relaxation and separation.
+  void writeStats(std::ostream &out) const;
     
 protected:
 
@@ -236,6 +244,53 @@ private:
 
   // Hypergraph for termcover
   HypergraphPtr H_;
+
+  // True if convex hull facets are separated instead of adding the lambda
+  // formulation (option ml_lazy_hull).
+  bool lazyHull_;
+
+  // A facet  coef' (x_{V_g}, z_{T_g}) <= rhs  of the convex hull of group g
+  // when x_{V_g} is in [lb, ub]. It stays valid for every sub-box, so that it
+  // can be used again at other nodes.
+  struct HullFacet {
+    DoubleVector coef;
+    double rhs;
+    DoubleVector lb;
+    DoubleVector ub;
+  };
+
+  // Facets found for each group. The oldest are dropped when there are
+  // more than maxCachedFacets_.
+  std::vector<std::deque<HullFacet> > facets_;
+  UInt maxCachedFacets_;
+
+  // Rows of the relaxation that hold facets of each group. A row with an
+  // infinite upper bound is not used at the current node.
+  std::vector<std::vector<ConstraintPtr> > facetRows_;
+
+  // Variables of each group in the order used in HullFacet, and the terms
+  // z_t with J_t in the group, J_t as positions in that order.
+  std::vector<std::vector<ConstVariablePtr> > gVars_;
+  std::vector<std::vector<std::pair<ConstVariablePtr, UIntVector> > > gTerms_;
+
+  // McCormick rows of a term with two variables (four rows), or the bounds
+  // of z_t for longer terms (one row). Updated at every node.
+  std::map<ConstVariablePtr, std::vector<ConstraintPtr> > mcRows_;
+
+  // Rows and variables added to the initial relaxation.
+  UInt nInitRows_;
+  UInt nInitVars_;
+
+  struct SepaStats {
+    UInt iters;   // Number of calls to separate.
+    UInt lps;     // Number of separation LPs solved.
+    UInt cuts;    // Number of facets added to the relaxation.
+    UInt reused;  // Number of facets taken from the cache.
+    UInt rows;    // Number of rows created for facets.
+    double time;  // Time taken in separation.
+  } sStats_;
+
+  const Timer *timer_;
          
 public:
   typedef TermContainer::const_iterator ConstTermIterator;
@@ -257,6 +312,20 @@ private:
   BranchPtr doBranch_(BranchDirection UpOrDown, ConstVariablePtr v, 
                       double bvalue);
 
+  // Put a facet of group gix into a free row of the relaxation.
+  void addFacet_(UInt gix, const HullFacet &f, RelaxationPtr rel,
+                 ModVector &mods);
+
+  // Add the McCormick rows in lazy mode, or change them to the bounds at
+  // the current node.
+  void handleMcRows_(RelaxationPtr rel, HandleCallingFunction wherefrom,
+                     ModVector &mods);
+
+  // Find a facet of the convex hull of group gix that cuts off x, by
+  // minimizing the distance of x from the hull. Returns false if x is in
+  // the hull or the box is not finite.
+  bool hullFacet_(UInt gix, const double *x, HullFacet &f);
+
   // A greedy dense term covering heuristic
   void greedyDenseHeuristic_();
 
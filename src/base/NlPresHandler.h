@@ -121,6 +121,9 @@ public:
   // Write name
   std::string getName() const;
 
+  /// separate() does nothing, so it can run with other handlers.
+  bool isSepThreadSafe() const { return true; };
+
   void simplePresolve(ProblemPtr p, SolutionPoolPtr s_pool,
                       ModVector &t_mods, SolveStatus &status);
   /**
@@ -0,0 +1,848 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2008 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file NlReader.cpp
+ * \brief Read an nl file without ASL
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "NlReader.h"
+#include "Objective.h"
+#include "Problem.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string NlReader::me_ = "NlReader: ";
+
+namespace {
+  /// Read the numbers on the line starting at p, up to a comment or the end
+  /// of the line. p is moved to the start of the next line.
+  void lineNums(const char *&p, const char *end, DoubleVector &nums)
+  {
+    double d;
+
+    nums.clear();
+    while (p < end && '\n' != *p) {
+      if (' ' == *p || '\t' == *p || '\r' == *p) {
+        ++p;
+      } else if ('#' == *p) {
+        p = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (!p) {
+          p = end;
+        }
+      } else {
+        std::from_chars_result r = std::from_chars(p, end, d);
+        if (r.ptr == p) {
+          break;
+        }
+        nums.push_back(d);
+        p = r.ptr;
+      }
+    }
+    while (p < end && '\n' != *p) {
+      ++p;
+    }
+    if (p < end) {
+      ++p;
+    }
+  }
+
+  /// Entry i of the header line, 0 if the line is shorter.
+  int hval(const DoubleVector &nums, UInt i)
+  {
+    return (i < nums.size()) ? (int)nums[i] : 0;
+  }
+}
+
+
+NlReader::NlReader(EnvPtr env)
+  : binary_(false),
+    cur_(0),
+    end_(0),
+    env_(env),
+    nCons_(0),
+    nObjs_(0),
+    nVars_(0),
+    sense_(Minimize)
+{
+}
+
+
+NlReader::~NlReader()
+{
+  clear_();
+}
+
+
+void NlReader::addFuns_(ProblemPtr p, const std::vector<std::string> &cnames,
+                        const std::string &oname)
+{
+  DoubleVector x(nVars_, 0.0), grad(nVars_, 0.0);
+  LinearFunctionPtr lf;
+  CGraph *cg;
+  FunctionPtr f;
+  std::string name;
+  double c;
+  int err = 0;
+
+  for (int i = 0; i <= nCons_; ++i) {
+    if (i == nCons_ && 0 == nObjs_) {
+      break;
+    }
+    lf = lfs_[i];
+    cg = cgs_[i];
+    c = consts_[i];
+    if (cg) {
+      cg->finalize();
+      // AMPL may write a linear or constant expression, e.g. when it could
+      // not simplify it. Move it to the linear part and the constant.
+      if (Linear == cg->getType() || Constant == cg->getType()) {
+        if (!lf) {
+          lf = new LinearFunction();
+        }
+        if (Linear == cg->getType()) {
+          cg->evalGradient(&x[0], &grad[0], &err);
+          for (int j = 0; j < nVars_; ++j) {
+            if (grad[j] != 0.0) {
+              lf->incTerm(vars_[j], grad[j]);
+              grad[j] = 0.0;
+            }
+          }
+        }
+        c += cg->eval(&x[0], &err);
+        delete cg;
+        cg = 0;
+      }
+    }
+    if (lf && 0 == lf->getNumTerms()) {
+      delete lf;
+      lf = 0;
+    }
+    f = new Function(lf, 0, cg);
+    lfs_[i] = 0;
+    cgs_[i] = 0;
+    if (i < nCons_) {
+      if ((UInt)i < cnames.size()) {
+        name = cnames[i];
+      } else {
+        name = "_scon[" + std::to_string(i + 1) + "]";
+      }
+      p->newConstraint(f, cLb_[i] - c, cUb_[i] - c, name);
+    } else {
+      p->newObjective(f, c, sense_, oname);
+    }
+  }
+  if (0 == nObjs_) {
+    p->newObjective(0.0, Minimize);
+  }
+}
+
+
+int NlReader::body_(UInt i)
+{
+  const char *start = cur_;
+  CGraph *cg;
+  CNode *n;
+  double d;
+  char c;
+  int err = 0;
+
+  // most linear constraints have body "n0", for which no graph is needed.
+  if (!key_(c)) {
+    return 1;
+  }
+  if ('n' == c) {
+    if (!readNum_(d)) {
+      return 1;
+    }
+    consts_[i] += d;
+    return 0;
+  }
+  cur_ = start;
+
+  if (cgs_[i]) {
+    delete cgs_[i];
+  }
+  cg = new CGraph();
+  cgs_[i] = cg;
+  n = expr_(cg, err);
+  if (0 == err) {
+    cg->setOut(n);
+  }
+  return err;
+}
+
+
+int NlReader::bounds_(UInt n, double *lb, double *ub)
+{
+  double d;
+  char c;
+
+  for (UInt i = 0; i < n; ++i) {
+    if (!key_(c)) {
+      return 1;
+    }
+    switch (c) {
+    case '0':
+      if (!readNum_(lb[i]) || !readNum_(ub[i])) {
+        return 1;
+      }
+      break;
+    case '1':
+      lb[i] = -INFINITY;
+      if (!readNum_(ub[i])) {
+        return 1;
+      }
+      break;
+    case '2':
+      ub[i] = INFINITY;
+      if (!readNum_(lb[i])) {
+        return 1;
+      }
+      break;
+    case '3':
+      lb[i] = -INFINITY;
+      ub[i] = INFINITY;
+      break;
+    case '4':
+      if (!readNum_(d)) {
+        return 1;
+      }
+      lb[i] = ub[i] = d;
+      break;
+    case '5':
+      return unsupported_("complementarity constraints");
+    default:
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+void NlReader::clear_()
+{
+  for (UInt i = 0; i < cgs_.size(); ++i) {
+    delete cgs_[i];
+  }
+  for (UInt i = 0; i < lfs_.size(); ++i) {
+    delete lfs_[i];
+  }
+  cgs_.clear();
+  lfs_.clear();
+  consts_.clear();
+  cLb_.clear();
+  cUb_.clear();
+  vars_.clear();
+}
+
+
+// The opcodes and their mapping to CNode follow AMPLInterface::getCGraph_().
+// The operator o5 (power) is split by the arguments the way ASL does.
+CNode *NlReader::expr_(CGraph *cg, int &err)
+{
+  CNode *l = 0, *r = 0;
+  OpCode op;
+  long long k;
+  double d;
+  char c;
+
+  if (!key_(c)) {
+    err = 1;
+    return 0;
+  }
+  switch (c) {
+  case 'n':
+    if (!readNum_(d)) {
+      err = 1;
+      return 0;
+    }
+    return cg->newNode(d);
+  case 's':
+  case 'l':
+    if (binary_) {
+      err = unsupported_("integer constants in binary files");
+      return 0;
+    }
+    if (!readNum_(d)) {
+      err = 1;
+      return 0;
+    }
+    return cg->newNode(d);
+  case 'v':
+    if (!readInt_(k) || k < 0) {
+      err = 1;
+      return 0;
+    }
+    if (k >= nVars_) {
+      err = unsupported_("defined variables");
+      return 0;
+    }
+    return cg->newNode(vars_[k]);
+  case 'o':
+    break;
+  case 'f':
+    err = unsupported_("imported functions");
+    return 0;
+  case 'h':
+    err = unsupported_("string arguments");
+    return 0;
+  default:
+    err = 1;
+    return 0;
+  }
+
+  if (!readInt_(k)) {
+    err = 1;
+    return 0;
+  }
+
+  // n-ary sum
+  if (54 == k) {
+    long long nc;
+    std::vector<CNode *> childr;
+    if (!readInt_(nc) || nc < 0) {
+      err = 1;
+      return 0;
+    }
+    childr.reserve(nc);
+    for (long long i = 0; i < nc; ++i) {
+      childr.push_back(expr_(cg, err));
+      if (err) {
+        return 0;
+      }
+    }
+    return cg->newNode(OpSumList, childr.data(), childr.size());
+  }
+
+  // binary operators
+  if ((k >= 0 && k <= 3) || 5 == k || 55 == k) {
+    l = expr_(cg, err);
+    if (0 == err) {
+      r = expr_(cg, err);
+    }
+    if (err) {
+      return 0;
+    }
+    switch (k) {
+    case 0:
+      return cg->newNode(OpPlus, l, r);
+    case 1:
+      return cg->newNode(OpMinus, l, r);
+    case 2:
+      return cg->newNode(OpMult, l, r);
+    case 3:
+      return cg->newNode(OpDiv, l, r);
+    case 55:
+      return cg->newNode(OpIntDiv, l, r);
+    default:
+      break;
+    }
+    // power, as ASL converts OPPOW into OP1POW, OP2POW or OPCPOW.
+    if (OpNum == r->getOp()) {
+      if (2.0 == r->getVal()) {
+        return cg->newNode(OpSqr, l, 0);
+      }
+      return cg->newNode(OpPowK, l, r);
+    } else if (OpNum == l->getOp()) {
+      return cg->newNode(OpCPow, l, r);
+    }
+    err = unsupported_("power with variable base and exponent");
+    return 0;
+  }
+
+  // unary operators
+  switch (k) {
+  case 13: op = OpFloor; break;
+  case 14: op = OpCeil; break;
+  case 15: op = OpAbs; break;
+  case 16: op = OpUMinus; break;
+  case 37: op = OpTanh; break;
+  case 38: op = OpTan; break;
+  case 39: op = OpSqrt; break;
+  case 40: op = OpSinh; break;
+  case 41: op = OpSin; break;
+  case 42: op = OpLog10; break;
+  case 43: op = OpLog; break;
+  case 44: op = OpExp; break;
+  case 45: op = OpCosh; break;
+  case 46: op = OpCos; break;
+  case 47: op = OpAtanh; break;
+  case 49: op = OpAtan; break;
+  case 50: op = OpAsinh; break;
+  case 51: op = OpAsin; break;
+  case 52: op = OpAcosh; break;
+  case 53: op = OpAcos; break;
+  default:
+    err = unsupported_("operator o" + std::to_string(k));
+    return 0;
+  }
+  l = expr_(cg, err);
+  if (err) {
+    return 0;
+  }
+  return cg->newNode(op, l, 0);
+}
+
+
+int NlReader::header_(ProblemPtr p, const std::vector<std::string> &vnames)
+{
+  DoubleVector h[10];
+  VariableType vtype;
+  int nlvb, nlvbi, nlvc, nlvci, nlvo, nlvoi, nbv, niv;
+  std::string name;
+
+  if (end_ - cur_ < 2 || ('g' != *cur_ && 'b' != *cur_)) {
+    env_->getLogger()->errStream() << me_ << "not an nl file" << std::endl;
+    return 1;
+  }
+  binary_ = ('b' == *cur_);
+  ++cur_;
+  for (UInt i = 0; i < 10; ++i) {
+    lineNums(cur_, end_, h[i]);
+  }
+  if (cur_ >= end_ && h[9].empty()) {
+    env_->getLogger()->errStream() << me_ << "header of nl file is short"
+                                   << std::endl;
+    return 1;
+  }
+
+  nVars_ = hval(h[1], 0);
+  nCons_ = hval(h[1], 1);
+  nObjs_ = hval(h[1], 2);
+  if (hval(h[1], 5) > 0) {
+    return unsupported_("logical constraints");
+  }
+  if (hval(h[2], 2) > 0 || hval(h[2], 3) > 0) {
+    return unsupported_("complementarity constraints");
+  }
+  if (hval(h[3], 0) > 0 || hval(h[3], 1) > 0 || hval(h[5], 0) > 0) {
+    return unsupported_("network constraints");
+  }
+  if (hval(h[5], 1) > 0) {
+    return unsupported_("imported functions");
+  }
+  if (nObjs_ > 1) {
+    return unsupported_("more than one objective");
+  }
+  for (UInt i = 0; i < 5; ++i) {
+    if (hval(h[9], i) > 0) {
+      return unsupported_("defined variables");
+    }
+  }
+  if (binary_) {
+    // ASL: 1 for IEEE little-endian, 2 for IEEE big-endian
+    const int one = 1;
+    int native = (1 == *reinterpret_cast<const char *>(&one)) ? 1 : 2;
+    if (hval(h[5], 2) != 0 && hval(h[5], 2) != native) {
+      return unsupported_("binary file of other byte order");
+    }
+  }
+
+  // see AMPLInterface::addVariablesFromASL_() for the order of variables.
+  nlvc = hval(h[4], 0);
+  nlvo = hval(h[4], 1);
+  nlvb = hval(h[4], 2);
+  nbv = hval(h[6], 0);
+  niv = hval(h[6], 1);
+  nlvbi = hval(h[6], 2);
+  nlvci = hval(h[6], 3);
+  nlvoi = hval(h[6], 4);
+
+  vars_.reserve(nVars_);
+  for (int i = 0; i < nVars_; ++i) {
+    if ((i >= nlvb - nlvbi && i < nlvb) || (i >= nlvc - nlvci && i < nlvc) ||
+        (nlvo > nlvc && i >= nlvo - nlvoi && i < nlvo) ||
+        i >= nVars_ - (niv + nbv)) {
+      vtype = Integer;
+    } else {
+      vtype = Continuous;
+    }
+    if ((UInt)i < vnames.size()) {
+      name = vnames[i];
+    } else {
+      name = "_svar[" + std::to_string(i + 1) + "]";
+    }
+    vars_.push_back(p->newVariable(-INFINITY, INFINITY, vtype, name));
+  }
+  x0_.assign(nVars_, 0.0);
+  cLb_.assign(nCons_, -INFINITY);
+  cUb_.assign(nCons_, INFINITY);
+  cgs_.assign(nCons_ + 1, 0);
+  lfs_.assign(nCons_ + 1, 0);
+  consts_.assign(nCons_ + 1, 0.0);
+  return 0;
+}
+
+
+bool NlReader::key_(char &c)
+{
+  if (!binary_) {
+    skipSpace_();
+  }
+  if (cur_ >= end_) {
+    return false;
+  }
+  c = *cur_;
+  ++cur_;
+  return true;
+}
+
+
+int NlReader::linear_(LinearFunctionPtr lf, long n)
+{
+  long long j;
+  double a;
+
+  for (long i = 0; i < n; ++i) {
+    if (!readInt_(j) || !readNum_(a) || j < 0 || j >= nVars_) {
+      return 1;
+    }
+    // indices are sorted in files written by AMPL, so appending is constant
+    // time. Zero coefficients of nonlinear variables are skipped.
+    lf->appendTerm(vars_[j], a);
+  }
+  return 0;
+}
+
+
+void NlReader::names_(std::string fname, std::vector<std::string> &names)
+{
+  std::ifstream fs(fname.c_str());
+  std::string line;
+
+  names.clear();
+  while (fs.good() && std::getline(fs, line)) {
+    if (!line.empty() && '\r' == line[line.size() - 1]) {
+      line.resize(line.size() - 1);
+    }
+    names.push_back(line);
+  }
+}
+
+
+ProblemPtr NlReader::readInstance(std::string fname, int &err)
+{
+  std::string fbuf;  // contents of the file if it could not be mapped
+  std::string stub;
+  std::vector<std::string> vnames, rnames;
+  void *mapped = MAP_FAILED;
+  size_t fsize = 0;
+  struct stat st;
+  ProblemPtr p;
+  std::string oname;
+  double tstrt = env_->getTime();
+  int fd = -1;
+
+  clear_();
+  why_.clear();
+  sense_ = Minimize;
+
+  // ASL accepts the stub with or without the .nl suffix.
+  if (fname.size() > 3 && 0 == fname.compare(fname.size() - 3, 3, ".nl")) {
+    stub = fname.substr(0, fname.size() - 3);
+  } else {
+    stub = fname;
+    fd = open((fname + ".nl").c_str(), O_RDONLY);
+  }
+  if (fd < 0) {
+    fd = open(fname.c_str(), O_RDONLY);
+  }
+  if (fd < 0 || 0 != fstat(fd, &st)) {
+    env_->getLogger()->errStream() << me_ << "could not open file " << fname
+                                   << " for reading" << std::endl;
+    if (fd >= 0) {
+      close(fd);
+    }
+    err = 1;
+    return 0;
+  }
+
+  fsize = st.st_size;
+  if (fsize > 0) {
+    mapped = mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  if (MAP_FAILED != mapped) {
+    madvise(mapped, fsize, MADV_SEQUENTIAL);
+    cur_ = static_cast<const char *>(mapped);
+  } else {
+    std::ifstream fs(fname.c_str(), std::ios::binary);
+    fbuf.assign(std::istreambuf_iterator<char>(fs),
+                std::istreambuf_iterator<char>());
+    cur_ = fbuf.data();
+    fsize = fbuf.size();
+  }
+  close(fd);
+  end_ = cur_ + fsize;
+
+  names_(stub + ".col", vnames);
+  names_(stub + ".row", rnames);
+
+  p = new Problem(env_);
+  err = header_(p, vnames);
+  if (0 == err) {
+    err = segments_(p);
+  }
+  if (MAP_FAILED != mapped) {
+    munmap(mapped, st.st_size);
+  }
+  cur_ = end_ = 0;
+
+  if (0 == err) {
+    if ((UInt)nCons_ < rnames.size()) {
+      oname = rnames[nCons_];
+    } else {
+      oname = "_sobj[1]";
+    }
+    addFuns_(p, rnames, oname);
+    env_->getLogger()->msgStream(LogExtraInfo)
+        << me_ << "read " << fsize / 1048576.0 << " MB in "
+        << env_->getTime() - tstrt << " seconds" << std::endl;
+  } else {
+    if (1 == err) {
+      env_->getLogger()->errStream() << me_ << "error in reading file "
+                                     << fname << std::endl;
+    }
+    delete p;
+    p = 0;
+  }
+  clear_();
+  return p;
+}
+
+
+bool NlReader::readInt_(long long &i)
+{
+  if (binary_) {
+    int j;
+    if (end_ - cur_ < (long)sizeof(int)) {
+      return false;
+    }
+    memcpy(&j, cur_, sizeof(int));
+    cur_ += sizeof(int);
+    i = j;
+    return true;
+  }
+  skipSpace_();
+  std::from_chars_result r = std::from_chars(cur_, end_, i);
+  if (r.ptr == cur_) {
+    return false;
+  }
+  cur_ = r.ptr;
+  return true;
+}
+
+
+bool NlReader::readNum_(double &d)
+{
+  if (binary_) {
+    if (end_ - cur_ < (long)sizeof(double)) {
+      return false;
+    }
+    memcpy(&d, cur_, sizeof(double));
+    cur_ += sizeof(double);
+    return true;
+  }
+  skipSpace_();
+  std::from_chars_result r = std::from_chars(cur_, end_, d);
+  if (r.ptr == cur_) {
+    return false;
+  }
+  cur_ = r.ptr;
+  return true;
+}
+
+
+bool NlReader::readWord_(std::string &s)
+{
+  const char *b;
+
+  if (binary_) {
+    long long len;
+    if (!readInt_(len) || len < 0 || end_ - cur_ < len) {
+      return false;
+    }
+    s.assign(cur_, len);
+    cur_ += len;
+    return true;
+  }
+  while (cur_ < end_ && (' ' == *cur_ || '\t' == *cur_)) {
+    ++cur_;
+  }
+  b = cur_;
+  while (cur_ < end_ && ' ' != *cur_ && '\t' != *cur_ && '\r' != *cur_ &&
+         '\n' != *cur_ && '#' != *cur_) {
+    ++cur_;
+  }
+  s.assign(b, cur_ - b);
+  return !s.empty();
+}
+
+
+int NlReader::segments_(ProblemPtr p)
+{
+  long long i, n;
+  double d;
+  char c;
+  int err = 0;
+
+  while (0 == err && key_(c)) {
+    switch (c) {
+    case 'C':
+      if (!readInt_(i) || i < 0 || i >= nCons_) {
+        return 1;
+      }
+      err = body_(i);
+      break;
+    case 'O':
+      if (!readInt_(i) || !readInt_(n) || i != 0 || i >= nObjs_) {
+        return 1;
+      }
+      sense_ = (0 == n) ? Minimize : Maximize;
+      err = body_(nCons_);
+      break;
+    case 'r':
+      err = bounds_(nCons_, cLb_.data(), cUb_.data());
+      break;
+    case 'b':
+      {
+        DoubleVector lb(nVars_), ub(nVars_);
+        err = bounds_(nVars_, lb.data(), ub.data());
+        for (int j = 0; 0 == err && j < nVars_; ++j) {
+          p->changeBound(vars_[j], lb[j], ub[j]);
+        }
+      }
+      break;
+    case 'x':
+    case 'd':
+      if (!readInt_(n)) {
+        return 1;
+      }
+      for (long long j = 0; j < n; ++j) {
+        if (!readInt_(i) || !readNum_(d)) {
+          return 1;
+        }
+        if ('x' == c && i >= 0 && i < nVars_) {
+          x0_[i] = d;
+        }
+      }
+      break;
+    case 'k':
+    case 'K':
+      // cumulative counts of Jacobian nonzeros in columns. Not needed.
+      if ('K' == c && binary_) {
+        return unsupported_("64 bit column counts");
+      }
+      if (!readInt_(n)) {
+        return 1;
+      }
+      for (long long j = 0; j < n; ++j) {
+        if (!readInt_(i)) {
+          return 1;
+        }
+      }
+      break;
+    case 'J':
+    case 'G':
+      if (!readInt_(i) || !readInt_(n) || i < 0 ||
+          i >= ('J' == c ? nCons_ : nObjs_)) {
+        return 1;
+      }
+      if ('G' == c) {
+        i = nCons_;
+      }
+      if (!lfs_[i]) {
+        lfs_[i] = new LinearFunction();
+      }
+      err = linear_(lfs_[i], n);
+      break;
+    case 'S':
+      err = suffix_();
+      break;
+    case 'F':
+      return unsupported_("imported functions");
+    case 'L':
+      return unsupported_("logical constraints");
+    case 'V':
+      return unsupported_("defined variables");
+    default:
+      env_->getLogger()->errStream() << me_ << "unknown segment " << c
+                                     << std::endl;
+      return 1;
+    }
+  }
+  return err;
+}
+
+
+void NlReader::skipSpace_()
+{
+  while (cur_ < end_) {
+    if (' ' == *cur_ || '\t' == *cur_ || '\r' == *cur_ || '\n' == *cur_) {
+      ++cur_;
+    } else if ('#' == *cur_) {
+      cur_ = static_cast<const char *>(memchr(cur_, '\n', end_ - cur_));
+      if (!cur_) {
+        cur_ = end_;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+
+int NlReader::suffix_()
+{
+  long long kind, n, i;
+  double d;
+  std::string name;
+
+  if (!readInt_(kind) || !readInt_(n) || !readWord_(name)) {
+    return 1;
+  }
+  // SOS constraints are made from these suffixes by ASL (suf_sos).
+  if ("sos" == name || "sosno" == name || "ref" == name ||
+      "sosref" == name) {
+    return unsupported_("SOS constraints");
+  }
+  for (long long j = 0; j < n; ++j) {
+    if (!readInt_(i)) {
+      return 1;
+    }
+    if ((kind & 4) ? !readNum_(d) : !readInt_(i)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+int NlReader::unsupported_(const std::string &why)
+{
+  why_ = why;
+  return 2;
+}
+
@@ -0,0 +1,157 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2008 - 2025 The Minotaur Team.
+//
+
+
+/**
+ * \file NlReader.h
+ * \brief Declare class NlReader for reading nl files without ASL
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURNLREADER_H
+#define MINOTAURNLREADER_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+class CGraph;
+class CNode;
+class LinearFunction;
+typedef LinearFunction* LinearFunctionPtr;
+
+/**
+ * \brief Reads a problem from a text or binary .nl file in one pass.
+ *
+ * The file is mapped into memory and variables, linear functions and
+ * computational graphs (CGraph) of nonlinear functions are created while it
+ * is parsed. No intermediate ASL structures are created. Only the features
+ * that Minotaur can evaluate natively are read: defined variables (common
+ * expressions), imported functions, logical and complementarity
+ * constraints, SOS suffixes, network constraints and operators that
+ * AMPLInterface::getCGraph_ does not map to a CNode are not. When one of
+ * these is found, reading stops with error code 2 and the caller can read
+ * the file with ASL instead.
+ */
+class NlReader {
+public:
+  /// Default constructor
+  NlReader(EnvPtr env);
+
+  /// Destroy
+  ~NlReader();
+
+  /// Initial point from the 'x' segment. Zero for variables not listed.
+  const DoubleVector & getInitialPoint() const { return x0_; };
+
+  /// Why the last file could not be read (empty if it was read).
+  const std::string & getReason() const { return why_; };
+
+  /**
+   * \brief Read a .nl file and return the problem.
+   *
+   * \param [in] fname Name of the file. If it does not end in ".nl", then
+   * fname.nl is tried first. Names of variables and constraints are read
+   * from the .col and .row files, if present.
+   * \param [out] err 0 if the problem was read, 1 if the file could not be
+   * opened or is malformed, 2 if it uses a feature that is not supported
+   * (see getReason()).
+   * \return The problem, or NULL if err is not 0.
+   */
+  ProblemPtr readInstance(std::string fname, int &err);
+
+private:
+  /// True if the segments of the file are binary.
+  bool binary_;
+
+  /// Position in the file being read, and its end.
+  const char *cur_, *end_;
+
+  /// Environment.
+  EnvPtr env_;
+
+  /// Counts from the header of the file.
+  int nCons_, nObjs_, nVars_;
+
+  /// Lower and upper bounds of constraints, from the 'r' segment.
+  DoubleVector cLb_, cUb_;
+
+  /// Computational graphs of constraints and the objective (last entry).
+  std::vector<CGraph *> cgs_;
+
+  /// Constant terms of constraints and the objective (last entry).
+  DoubleVector consts_;
+
+  /// Linear parts of constraints and the objective (last entry).
+  std::vector<LinearFunctionPtr> lfs_;
+
+  /// For logging
+  static const std::string me_;
+
+  /// Sense of the objective, from the 'O' segment.
+  ObjectiveType sense_;
+
+  /// Variables of the problem being read.
+  VarVector vars_;
+
+  /// Reason why the file is not supported.
+  std::string why_;
+
+  /// Initial point.
+  DoubleVector x0_;
+
+  /// Create constraints and the objective in p after the file is read.
+  void addFuns_(ProblemPtr p, const std::vector<std::string> &cnames,
+                const std::string &oname);
+
+  /// Read a constraint or objective body into entry i.
+  int body_(UInt i);
+
+  /// Read the bounds of n constraints or variables, type first.
+  int bounds_(UInt n, double *lb, double *ub);
+
+  /// Free whatever has not been put into a problem.
+  void clear_();
+
+  /// Read an expression and return its root node in cg.
+  CNode *expr_(CGraph *cg, int &err);
+
+  /// Read the header and create variables in p.
+  int header_(ProblemPtr p, const std::vector<std::string> &vnames);
+
+  /// Read the next segment or expression key.
+  bool key_(char &c);
+
+  /// Read n pairs of (index, coefficient) into lf.
+  int linear_(LinearFunctionPtr lf, long n);
+
+  /// Read names from a .col or .row file, if it exists.
+  void names_(std::string fname, std::vector<std::string> &names);
+
+  /// Read an integer.
+  bool readInt_(long long &i);
+
+  /// Read a real number.
+  bool readNum_(double &d);
+
+  /// Read the name of a suffix.
+  bool readWord_(std::string &s);
+
+  /// Read all segments after the header. Bounds of variables are set in p.
+  int segments_(ProblemPtr p);
+
+  /// Skip blanks, new lines and comments in a text file.
+  void skipSpace_();
+
+  /// Skip a suffix segment, or report it as unsupported.
+  int suffix_();
+
+  /// Stop reading because the file has a feature that is not supported.
+  int unsupported_(const std::string &why);
+};
+}
+#endif
+
@@ -22,6 +22,7 @@
 #include "Modification.h"
 #include "Node.h"
 #include "Relaxation.h"
+#include "SlabAlloc.h"
 #include "WarmStart.h"
 
 using namespace Minotaur;
@@ -30,6 +31,7 @@ using namespace std;
 Node::Node()
   : branch_(0),
     depth_(0),
+    estimate_(-INFINITY),
     id_(0),
     lb_(-INFINITY),
     pMods_(0), 
@@ -47,6 +49,7 @@ Node::Node()
 Node::Node(NodePtr parentNode, BranchPtr branch)
   : branch_(branch),
     depth_(0),
+    estimate_(-INFINITY),
     id_(0),
     pMods_(0), 
     rMods_(0), 
@@ -84,6 +87,25 @@ Node::~Node()
 }
 
 
+static SlabAlloc *nodeAlloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("Node", sizeof(Node));
+  return a;
+}
+
+
+void *Node::operator new(size_t size)
+{
+  return nodeAlloc_()->alloc(size);
+}
+
+
+void Node::operator delete(void *p, size_t size)
+{
+  nodeAlloc_()->free(p, size);
+}
+
+
 void Node::addChild(NodePtr childNode)
 {
   children_.push_back(childNode);
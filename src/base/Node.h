@@ -66,6 +66,12 @@ namespace Minotaur {
     /// Default destructor.
     virtual ~Node();
 
+    /// Allocate from a SlabAlloc shared by all objects of this class.
+    static void *operator new(size_t size);
+
+    /// Return memory allocated by operator new.
+    static void operator delete(void *p, size_t size);
+
     /// Add a child node.
     void addChild(NodePtr childNode);
 
@@ -137,6 +143,12 @@ namespace Minotaur {
     /// Return the depth of the node in the tree.
     UInt getDepth() const { return depth_; }
 
+    /**
+     * Return the estimate of the objective value of the best solution in
+     * the subtree of this node, or -INFINITY if not known.
+     */
+    double getEstimate() const { return estimate_; }
+
     /// Return the ID of this node.
     UInt getId() const { return id_; }
 
@@ -250,6 +262,9 @@ namespace Minotaur {
       lastStrBranched_ = lstStrnBrnchd;
     }
 
+    /// Set the estimate returned by getEstimate().
+    void setEstimate(double value) { estimate_ = value; }
+
     /// Set a lower bound for the relaxation at this node.
     void setLb(double value);
 
@@ -345,6 +360,9 @@ namespace Minotaur {
     /// Depth in the tree. Also tells how many predecessors.
     UInt depth_;
 
+    /// Estimate of the best solution in the subtree. See getEstimate().
+    double estimate_;
+
     /// Id of this node.
     UInt id_;
 
@@ -12,153 +12,227 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iostream>
 
 #include "MinotaurConfig.h"
 #include "Node.h"
 #include "NodeHeap.h"
 
-namespace Minotaur {
-   bool valueGreaterThan(ConstNodePtr n1, ConstNodePtr n2) 
-   {
-      if (n1->getLb() > n2->getLb() + 1e-6) { 
-        return true;
-      } else if (n1->getLb() < n2->getLb() - 1e-6) {
-        return false;
-      } 
-
-      if (n1->getTbScore() > n2->getTbScore() + 1e-6) {
-        return true;
-      } else if (n1->getTbScore() < n2->getTbScore() - 1e-6) {
-        return false;
-      } 
-
-      if (n1->getDepth() < n2->getDepth()) {
-        return false;
-      } else if (n1->getDepth() > n2->getDepth()) {
-        return true;
-      }
-
-      return (n1->getId() < n2->getId());
-   }
-
-   bool depthGreaterThan(ConstNodePtr n1, ConstNodePtr n2)
-   {
-      return (n1->getDepth() > n2->getDepth());
-   }
-}
-
 using namespace Minotaur;
 
 
+NodeHeap::NodeHeap(Type type)
+  : maxDepth_(0),
+    type_(type)
+{
+}
+
+
 NodeHeap::~NodeHeap()
 {
-  nodes_.clear();
+  ents_.clear();
+  free_.clear();
+  heap_.clear();
+  byLb_.clear();
+  depthCnt_.clear();
 }
 
 
-void NodeHeap::pop()
+bool NodeHeap::below_(UInt i, UInt j) const
+{
+  const Entry &e1 = ents_[i];
+  const Entry &e2 = ents_[j];
+
+  if (Depth == type_) {
+    return (e1.depth > e2.depth);
+  }
+
+  if (Estimate == type_) {
+    if (e1.est > e2.est + 1e-6) {
+      return true;
+    } else if (e1.est < e2.est - 1e-6) {
+      return false;
+    }
+  }
+
+  if (e1.lb > e2.lb + 1e-6) {
+    return true;
+  } else if (e1.lb < e2.lb - 1e-6) {
+    return false;
+  }
+
+  if (e1.tb > e2.tb + 1e-6) {
+    return true;
+  } else if (e1.tb < e2.tb - 1e-6) {
+    return false;
+  }
+
+  if (e1.depth < e2.depth) {
+    return false;
+  } else if (e1.depth > e2.depth) {
+    return true;
+  }
+
+  return (e1.id < e2.id);
+}
+
+
+void NodeHeap::down_(UInt pos)
+{
+  UInt n = heap_.size();
+  UInt c, e;
+
+  e = heap_[pos];
+  while (2*pos+1 < n) {
+    c = 2*pos+1;
+    if (c+1 < n && below_(heap_[c], heap_[c+1])) {
+      ++c;
+    }
+    if (!below_(e, heap_[c])) {
+      break;
+    }
+    heap_[pos] = heap_[c];
+    ents_[heap_[pos]].pos = pos;
+    pos = c;
+  }
+  heap_[pos] = e;
+  ents_[e].pos = pos;
+}
+
+
+void NodeHeap::erase_(UInt pos)
 {
-  // std::cout << "popping out node " << nodes_.front()->getId() << std::endl;
-  switch(type_) {
-  case (Value):
-    pop_heap(nodes_.begin(), nodes_.end(), valueGreaterThan);
-    break;
-  case (Depth):
-    pop_heap(nodes_.begin(), nodes_.end(), depthGreaterThan);
-    break;
-  default:
-    assert(0);
-  }
-  nodes_.pop_back();
+  UInt e = heap_[pos];
+  UInt last = heap_.back();
+  Entry &ent = ents_[e];
+
+  heap_.pop_back();
+  if (pos < heap_.size()) {
+    heap_[pos] = last;
+    ents_[last].pos = pos;
+    up_(pos);
+    down_(ents_[last].pos);
+  }
+
+  byLb_.erase(std::make_pair(ent.lb, e));
+  --(depthCnt_[ent.depth]);
+  while (maxDepth_ > 0 && 0 == depthCnt_[maxDepth_]) {
+    --maxDepth_;
+  }
+  ent.n = 0;
+  free_.push_back(e);
 }
 
 
 double NodeHeap::getBestLB() const
 {
-   double retval = INFINITY;
-   if (nodes_.size() > 0) {
-      if (type_ == Value) {
-         retval = nodes_.front()->getLb();
-      } else {
-        std::vector<NodePtr>::const_iterator it = min_element(nodes_.begin(), 
-             nodes_.end(), valueGreaterThan);
-         retval = (*it)->getLb();
-      }
-   }
-   return retval;
+  if (byLb_.empty()) {
+    return INFINITY;
+  }
+  return byLb_.begin()->first;
 }
 
 
 UInt NodeHeap::getDeepestLevel() const
 {
-   UInt retval = 0;
-   if (nodes_.size() > 0) {
-      if (type_ == Depth) {
-         retval = nodes_.front()->getDepth();
-      }
-      else {
-        std::vector<NodePtr>::const_iterator it = max_element(nodes_.begin(), 
-             nodes_.end(), depthGreaterThan);
-         retval = (*it)->getDepth();
-      }
-   }
-   return retval;
+  return maxDepth_;
 }
 
 
-void NodeHeap::write(std::ostream &) const
+void NodeHeap::pop()
 {
-   //for(std::vector<NodePtr>::const_iterator it = nodes_.begin();
-   //    it != nodes_.end(); it++) {
-   //   ConstNodePtr n = *it;
-   //   //o << (*n) << endl;
-   //}
+  erase_(0);
 }
 
 
 void NodeHeap::push(NodePtr n)
 {
-  // std::cout << "inserting node " << n->getId() << std::endl;
-  nodes_.push_back(n);
-  switch(type_) {
-  case (Value):
-    push_heap(nodes_.begin(), nodes_.end(), valueGreaterThan);
-    break;
-  case (Depth):
-    push_heap(nodes_.begin(), nodes_.end(), depthGreaterThan);
-    break;
-  default:
-    assert(0);
+  UInt e;
+
+  if (free_.empty()) {
+    e = ents_.size();
+    ents_.push_back(Entry());
+  } else {
+    e = free_.back();
+    free_.pop_back();
+  }
+
+  Entry &ent = ents_[e];
+  ent.lb = n->getLb();
+  ent.est = std::max(n->getEstimate(), ent.lb);
+  ent.tb = n->getTbScore();
+  ent.depth = n->getDepth();
+  ent.id = n->getId();
+  ent.n = n;
+
+  byLb_.insert(std::make_pair(ent.lb, e));
+  if (depthCnt_.size() <= ent.depth) {
+    depthCnt_.resize(ent.depth+1, 0);
+  }
+  ++(depthCnt_[ent.depth]);
+  if (ent.depth > maxDepth_) {
+    maxDepth_ = ent.depth;
   }
+
+  heap_.push_back(e);
+  up_(heap_.size()-1);
 }
 
 
-void NodeHeap::setType(Type type)
+void NodeHeap::removeAbove(double cutoff, NodePtrVector &removed)
 {
-  if (type == type_) return;
-  //XXX Could probably do this fancier
-
-  switch(type_) {
-  case (Value):
-    make_heap(nodes_.begin(), nodes_.end(), valueGreaterThan);
-    break;
-  case (Depth):
-    make_heap(nodes_.begin(), nodes_.end(), depthGreaterThan);
-    break;
-  default:
-    assert(0);
+  UIntVector ents;
+  UInt top = heap_.empty() ? 0 : heap_.front();
+
+  for (std::set<std::pair<double, UInt> >::reverse_iterator it =
+       byLb_.rbegin(); it != byLb_.rend() && it->first > cutoff; ++it) {
+    if (it->second != top) {
+      ents.push_back(it->second);
+    }
+  }
+  for (UIntVector::iterator it = ents.begin(); it != ents.end(); ++it) {
+    removed.push_back(ents_[*it].n);
+    erase_(ents_[*it].pos);
   }
 }
 
 
-NodePtrIterator NodeHeap::nodesBegin() 
+void NodeHeap::setType(Type type)
 {
-  return nodes_.begin();
+  if (type == type_) {
+    return;
+  }
+  type_ = type;
+  for (UInt i = heap_.size()/2; i > 0; --i) {
+    down_(i-1);
+  }
 }
 
 
-NodePtrIterator NodeHeap::nodesEnd() 
+void NodeHeap::up_(UInt pos)
 {
-  return nodes_.end();
+  UInt e = heap_[pos];
+  UInt p;
+
+  while (pos > 0) {
+    p = (pos-1)/2;
+    if (!below_(heap_[p], e)) {
+      break;
+    }
+    heap_[pos] = heap_[p];
+    ents_[heap_[pos]].pos = pos;
+    pos = p;
+  }
+  heap_[pos] = e;
+  ents_[e].pos = pos;
 }
 
+
+void NodeHeap::write(std::ostream &out) const
+{
+  for (UIntVector::const_iterator it = heap_.begin(); it != heap_.end();
+       ++it) {
+    out << "node " << ents_[*it].id << " lb = " << ents_[*it].lb
+        << " depth = " << ents_[*it].depth << std::endl;
+  }
+}
@@ -15,6 +15,8 @@
 #ifndef MINOTAURNODEHEAP_H
 #define MINOTAURNODEHEAP_H
 
+#include <set>
+
 #include "Types.h"
 #include "ActiveNodeStore.h"
 
@@ -31,6 +33,15 @@ namespace Minotaur {
    * In order to create a heap, we need to have criteria for comparing nodes.
    * These criteria are determined by the parameter for
    * node-selection-strategy: best bound, best estimate, etc
+   *
+   * The heap holds small entries with the bound, estimate, score, depth and
+   * id of
+   * each node, taken when the node is pushed, so that comparisons do not
+   * read the nodes. Besides the heap, the entries are indexed by their
+   * bound and counted by their depth. Thus getBestLB() and
+   * getDeepestLevel() do not scan the nodes whatever the ordering, and
+   * removeAbove() removes the nodes above a cutoff in time proportional to
+   * their number.
    */
   class NodeHeap : public ActiveNodeStore {
 
@@ -39,14 +50,12 @@ namespace Minotaur {
     enum Type
     {
       Value,
-      Depth
+      Depth,
+      Estimate
     };
 
     /// Constructor.
-    NodeHeap(Type type)
-      : type_(type)
-    {
-    }
+    NodeHeap(Type type);
 
     /// Destroy.
     virtual ~NodeHeap();
@@ -55,13 +64,9 @@ namespace Minotaur {
      * Return true if there are no active nodes in the heap, otherwise
      * return false.
      */
-    virtual bool isEmpty() const { return nodes_.empty(); }
+    virtual bool isEmpty() const { return heap_.empty(); }
 
-    /**
-     * Find the minimum lower bound of all the active nodes in the heap.
-     * If the heap is ordered by best bound, then the root has the
-     * minimum value.
-     */
+    /// Find the minimum lower bound of all the active nodes in the heap.
     virtual double getBestLB() const;
 
     /// Find the maximum depth of all active nodes.
@@ -70,6 +75,9 @@ namespace Minotaur {
     /// Remove the best node from the heap.
     virtual void pop();
 
+    // base class method.
+    virtual void removeAbove(double cutoff, NodePtrVector &removed);
+
     /**
      * Write in order the node ID and the criteria used to order the
      * heap, e.g. bound value and depth.
@@ -83,23 +91,55 @@ namespace Minotaur {
     virtual void setType(Type type);
 
     /// Get access to the best node in this heap.
-    virtual NodePtr top() const { return (nodes_.front()); }
+    virtual NodePtr top() const { return ents_[heap_.front()].n; }
 
     /// Get the number of active nodes in the heap.
-    virtual size_t getSize() const { return (nodes_.size()); }
+    virtual size_t getSize() const { return heap_.size(); }
 
-    /// Get iterator to the first node in the heap.
-    NodePtrIterator nodesBegin();
+  private:
+    /// A node in the heap and the keys used to order it.
+    struct Entry {
+      double lb;       /// Lower bound of the node when pushed.
+      double est;      /// Estimate of the node when pushed.
+      double tb;       /// Tie-breaking score of the node when pushed.
+      UInt depth;      /// Depth of the node.
+      UInt id;         /// ID of the node.
+      UInt pos;        /// Position of this entry in heap_.
+      NodePtr n;       /// The node, NULL if the entry is free.
+    };
 
-    /// Get iterator to the last node in the heap.
-    NodePtrIterator nodesEnd();
+    /// Entries of nodes in the heap and free entries.
+    std::vector<Entry> ents_;
 
-  private:
-    /// Vector of active nodes.
-    NodePtrVector nodes_;
+    /// Indices of free entries in ents_.
+    UIntVector free_;
+
+    /// The heap: indices of entries in ents_.
+    UIntVector heap_;
+
+    /// Entries ordered by lower bound.
+    std::set<std::pair<double, UInt> > byLb_;
+
+    /// Number of nodes at each depth.
+    UIntVector depthCnt_;
+
+    /// Maximum depth with a nonzero count, or 0.
+    UInt maxDepth_;
 
     /// The type of criteria used to order the heap.
     Type type_;
+
+    /// Return true if entry i should be below entry j in the heap.
+    bool below_(UInt i, UInt j) const;
+
+    /// Move the entry at position pos down to its place in the heap.
+    void down_(UInt pos);
+
+    /// Remove the entry at position pos of the heap.
+    void erase_(UInt pos);
+
+    /// Move the entry at position pos up to its place in the heap.
+    void up_(UInt pos);
   };
   typedef NodeHeap *NodeHeapPtr;
 }  //namespace Minotaur
@@ -23,6 +23,7 @@ namespace Minotaur {
   class Relaxation;
   class SolutionPool;
   class WarmStart;
+  class ConflictPool;
   class CutManager;
   typedef Brancher* BrancherPtr;
   typedef Relaxation* RelaxationPtr;
@@ -86,6 +87,15 @@ namespace Minotaur {
       /// Return brancher.
       virtual BrancherPtr getBrancher() { return brancher_;};
 
+      /**
+       * Tighten lb and ub, indexed by variables of the relaxation, with
+       * bounds that the handlers found to be valid in the whole tree.
+       */
+      virtual void getGlobalBounds(DoubleVector &, DoubleVector &) const {};
+
+      /// Return the cut manager, or NULL if cuts are not managed.
+      virtual CutManager* getCutManager() { return 0; };
+
       /// Write statistics to a given output stream
       virtual void writeStats(std::ostream &) const {};
 
@@ -93,6 +103,12 @@ namespace Minotaur {
       virtual void writeStats() const {};
 
       virtual void setCutManager(CutManager *) {};
+
+      /**
+       * Set the pool of conflicts found in pruned nodes. Processors that
+       * use it, BndProcessor and PCBProcessor, delete it when destroyed.
+       */
+      virtual void setConflictPool(ConflictPool *) {};
     protected:
       /// What brancher is used for this processor
       BrancherPtr brancher_;
@@ -10,9 +10,12 @@
  * or NLP relaxations.
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
+#include <algorithm>
 #include <cmath> // for INFINITY
 
 #include "Brancher.h"
+#include "ConflictPool.h"
+#include "CutBuffer.h"
 #include "CutMan2.h"
 #include "Engine.h"
 #include "Environment.h"
@@ -26,6 +29,7 @@
 #include "PCBProcessor.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
+#include "Trace.h"
 #include "WarmStart.h"
 
 using namespace Minotaur;
@@ -37,6 +41,7 @@ const std::string PCBProcessor::me_ = "PCBProcessor: ";
 PCBProcessor::PCBProcessor(EnvPtr env, EnginePtr engine, HandlerVector handlers)
   : branches_(0),
     contOnErr_(false),
+    conflicts_(0),
     cutMan_(0),
     env_(env),
     infHand_(0),
@@ -48,6 +53,9 @@ PCBProcessor::PCBProcessor(EnvPtr env, EnginePtr engine, HandlerVector handlers)
   cutOff_ = env->getOptions()->findDouble("obj_cut_off")->getValue();
   engine_ = engine;
   handlers_ = handlers;
+  for(HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+    handNames_.push_back(Tracer::intern((*h)->getName()));
+  }
   logger_ = env->getLogger();
   presFreq_ = env->getOptions()->findInt("pres_freq")->getValue();
   stats_.bra = 0;
@@ -57,6 +65,26 @@ PCBProcessor::PCBProcessor(EnvPtr env, EnginePtr engine, HandlerVector handlers)
   stats_.proc = 0;
   stats_.ub = 0;
   stats_.tol_err = 0;
+  stats_.parsep = 0;
+  stats_.pipesep = 0;
+
+  pipeSep_ = env->getOptions()->findBool("root_sep_pipeline")->getValue();
+  sepThreads_ = env->getOptions()->findInt("sep_threads")->getValue();
+  if(sepThreads_ > 1) {
+    UInt n_safe = 0;
+    for(HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+      if((*h)->isSepThreadSafe()) {
+        ++n_safe;
+      }
+    }
+    // nothing to gain unless at least two handlers can run together, or
+    // one can run while the root relaxation is resolved.
+    if(n_safe > 1 || (pipeSep_ && n_safe > 0)) {
+      for(HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+        sepBufs_.push_back((*h)->isSepThreadSafe() ? new CutBuffer() : 0);
+      }
+    }
+  }
 }
 
 PCBProcessor::~PCBProcessor()
@@ -73,14 +101,59 @@ PCBProcessor::~PCBProcessor()
   if(branches_) {
     delete branches_;
   }
+  if(conflicts_) {
+    delete conflicts_;
+  }
+  for(std::vector<CutBuffer*>::iterator it = sepBufs_.begin();
+      it != sepBufs_.end(); ++it) {
+    if(*it) {
+      delete *it;
+    }
+  }
+  sepBufs_.clear();
   handlers_.clear();
 }
 
+void PCBProcessor::addConflict_(NodePtr node, ConstSolutionPtr sol,
+                                SolutionPoolPtr s_pool)
+{
+  double best, cutoff;
+
+  if(!conflicts_) {
+    return;
+  }
+  switch(node->getStatus()) {
+  case(NodeInfeasible):
+    conflicts_->analyze(node, relaxation_, 0, INFINITY);
+    break;
+  case(NodeHitUb):
+    // same cutoff as in shouldPrune_().
+    best = s_pool->getBestSolutionValue();
+    cutoff = cutOff_;
+    if(best < INFINITY) {
+      cutoff = std::min(cutoff, best - std::max(oATol_, fabs(best) * oRTol_));
+    }
+    conflicts_->analyze(node, relaxation_, sol, cutoff);
+    break;
+  default:
+    break;
+  }
+}
+
 void PCBProcessor::addHeur(HeurPtr h)
 {
   heurs_.push_back(h);
 }
 
+void PCBProcessor::clearMods_(ModVector& mods)
+{
+  for(ModificationConstIterator m_iter = mods.begin(); m_iter != mods.end();
+      ++m_iter) {
+    delete *m_iter;
+  }
+  mods.clear();
+}
+
 bool PCBProcessor::foundNewSolution()
 {
   return (numSolutions_ > 0);
@@ -92,6 +165,16 @@ Branches PCBProcessor::getBranches()
   return branches_;
 }
 
+void PCBProcessor::getGlobalBounds(DoubleVector& lb, DoubleVector& ub) const
+{
+  for(HandlerConstIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+    (*h)->getGlobalBounds(lb, ub);
+  }
+  if(conflicts_) {
+    conflicts_->getGlobalBounds(lb, ub);
+  }
+}
+
 WarmStartPtr PCBProcessor::getWarmStart()
 {
   return ws_;
@@ -147,6 +230,7 @@ bool PCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool)
   if(presFreq_ < 1 || node->getId() % presFreq_ != 0) {
     return false;
   }
+  MNTR_TRACE_SCOPE("presolveNode");
   // TODO: make this more sophisticated: loop several times until no more
   // changes are possible.
   for(it = 0; it < max_iter && true == cont; ++it) {
@@ -173,6 +257,7 @@ bool PCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool)
   if(is_inf) {
     node->setStatus(NodeInfeasible);
     ++stats_.inf;
+    addConflict_(node, 0, s_pool);
   }
 
   return is_inf;
@@ -188,10 +273,14 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
   bool debug_feas;
   BrancherStatus br_status;
   ConstSolutionPtr sol;
+  SolutionPtr pipe_sol = 0;
   ModVector mods;
   SeparationStatus sep_status = SepaContinue;
+  SeparationStatus pipe_status;
   int iter = 0, error;
   int parid=(node->getId()==0)?-1:node->getParent()->getId();
+  const bool pipe = pipeSep_ && !sepBufs_.empty() &&
+                    !node->getParent();
 
   ++stats_.proc;
   relaxation_ = rel;
@@ -214,6 +303,15 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
     }
   } 
 
+  // conflicts found in other nodes may prune this one or tighten bounds.
+  if(conflicts_ && node->getParent() &&
+     conflicts_->propagate(node, relaxation_)) {
+    node->setStatus(NodeInfeasible);
+    ++stats_.inf;
+    node->removeWarmStart();
+    return;
+  }
+
   // presolve
   should_prune = presolveNode_(node, s_pool);
   if(should_prune) {
@@ -246,13 +344,31 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
 #endif
     engine_->setDualObjLimit(s_pool->getBestSolutionValue());
 
-    solveRelaxation_();
+    pipe_status = SepaContinue;
+    if(pipe_sol) {
+      pipeSolve_(pipe_sol, node, s_pool, &pipe_status);
+      delete pipe_sol;
+      pipe_sol = 0;
+    } else {
+      solveRelaxation_();
+    }
     sol = engine_->getSolution();
+    if(pipe_status == SepaPrune) {
+      node->setStatus(NodeInfeasible);
+      stats_.inf++;
+      addConflict_(node, 0, s_pool);
+      break;
+    }
 
     // check if the relaxation is infeasible or if the cost is too high.
     // In either case we can prune. Also set lb of node.
     should_prune = shouldPrune_(node, sol->getObjValue(), s_pool);
     if(should_prune) {
+      // failures of the engine do not prove anything.
+      if(EngineError != engineStatus_ && FailedInfeas != engineStatus_ &&
+         EngineIterationLimit != engineStatus_) {
+        addConflict_(node, sol, s_pool);
+      }
       if (debug_feas) {
         logger_->msgStream(LogDebug) << me_
           << "node is pruned even though debug solution was feasible initially"
@@ -294,7 +410,25 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
           logger_->msgStream(LogDebug) << me_ << "debug solution is cut before separate_\n";
         }
       }
-      separate_(sol, node, s_pool, &sep_status);
+      if(pipe) {
+        // handlers that need exclusive access separate now. If the
+        // relaxation is to be resolved anyway, the others separate this
+        // point while it is being resolved.
+        SepRound r;
+        mergeSep_(sol, node, s_pool, r, false, true, &sep_status);
+        if(sep_status == SepaContinue && pipe_status == SepaResolve) {
+          // cuts of the last round were added after this solve.
+          sep_status = SepaResolve;
+        }
+        if(sep_status == SepaResolve) {
+          pipe_sol = new Solution(sol);
+        } else if(sep_status == SepaContinue) {
+          sepBuffered_(sol, node, s_pool, r, false);
+          mergeSep_(sol, node, s_pool, r, true, false, &sep_status);
+        }
+      } else {
+        separate_(sol, node, s_pool, &sep_status);
+      }
       if (debug_feas) {
         if (false==relaxation_->isDebugSolFeas(0.000001, 0.000001)) {
           logger_->msgStream(LogDebug) << me_ << "separation routine has cut "
@@ -308,6 +442,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
       node->setStatus(NodeInfeasible);
       should_resolve = false;
       stats_.inf++;
+      addConflict_(node, 0, s_pool);
       break;
     } else if(sep_status == SepaResolve) {
       should_resolve = true;
@@ -324,6 +459,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
         should_prune = true;
         node->setStatus(NodeInfeasible);
         stats_.inf++;
+        addConflict_(node, 0, s_pool);
         for(ModificationConstIterator miter = mods.begin(); miter != mods.end();
             ++miter) {
           delete *miter;
@@ -395,11 +531,109 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
   }
   if(!node->getParent()) {
     removeCuts_(sol);
+    if(conflicts_) {
+      conflicts_->setRootBounds(relaxation_);
+    }
   }
   node->removeWarmStart();
   return;
 }
 
+void PCBProcessor::mergeSep_(ConstSolutionPtr sol, NodePtr node,
+                             SolutionPoolPtr s_pool, SepRound& r, bool bufs,
+                             bool excl, SeparationStatus* status)
+{
+  const int n = handlers_.size();
+  bool sol_found;
+  size_t n_added;
+  int i;
+
+  if(r.st.size() != (size_t)n) {
+    r.st.assign(n, SepaContinue);
+    r.pMods.assign(n, ModVector());
+    r.rMods.assign(n, ModVector());
+    r.found.assign(n, 0);
+  }
+
+  *status = SepaContinue;
+  sol_found = false;
+  for(i = 0; i < n; ++i) {
+    if((sepBufs_[i] && !bufs) || (!sepBufs_[i] && !excl)) {
+      continue;
+    }
+    if(SepaPrune == *status) {
+      // node will be pruned. Throw away what the remaining handlers found.
+      if(sepBufs_[i]) {
+        sepBufs_[i]->clear();
+        clearMods_(r.pMods[i]);
+        clearMods_(r.rMods[i]);
+      }
+      continue;
+    }
+    if(sepBufs_[i]) {
+      if(SepaPrune == r.st[i]) {
+        sepBufs_[i]->clear();
+      } else {
+        sepBufs_[i]->flush(cutMan_, relaxation_, sol, &n_added);
+      }
+    } else {
+      MNTR_TRACE_SCOPE2("separate", handNames_[i]);
+      bool t_found = false;
+      handlers_[i]->separate(sol, node, relaxation_, cutMan_, s_pool,
+                             r.pMods[i], r.rMods[i], &t_found, &r.st[i]);
+      r.found[i] = t_found;
+    }
+    if(r.found[i]) {
+      sol_found = true;
+    }
+    if(r.st[i] == SepaPrune) {
+      // stop here: the mods of the pruning handler are not applied either.
+      *status = SepaPrune;
+      clearMods_(r.pMods[i]);
+      clearMods_(r.rMods[i]);
+      continue;
+    } else if(r.st[i] == SepaResolve) {
+      *status = SepaResolve;
+    }
+    for(ModificationConstIterator m_iter = r.pMods[i].begin();
+        m_iter != r.pMods[i].end(); ++m_iter) {
+      node->addPMod(*m_iter);
+    }
+    for(ModificationConstIterator m_iter = r.rMods[i].begin();
+        m_iter != r.rMods[i].end(); ++m_iter) {
+      node->addRMod(*m_iter);
+    }
+  }
+  if(true == sol_found) {
+    ++numSolutions_;
+  }
+}
+
+void PCBProcessor::parSeparate_(ConstSolutionPtr sol, NodePtr node,
+                                SolutionPoolPtr s_pool,
+                                SeparationStatus* status)
+{
+  SepRound r;
+
+  ++stats_.parsep;
+  sepBuffered_(sol, node, s_pool, r, false);
+
+  // merge in the order of handlers. Handlers that need exclusive access
+  // separate now.
+  mergeSep_(sol, node, s_pool, r, true, true, status);
+}
+
+void PCBProcessor::pipeSolve_(ConstSolutionPtr sol, NodePtr node,
+                              SolutionPoolPtr s_pool,
+                              SeparationStatus* status)
+{
+  SepRound r;
+
+  ++stats_.pipesep;
+  sepBuffered_(sol, node, s_pool, r, true);
+  mergeSep_(sol, node, s_pool, r, true, false, status);
+}
+
 void PCBProcessor::removeCuts_(ConstSolutionPtr sol)
 {
   HandlerIterator h;
@@ -418,9 +652,15 @@ void PCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node,
   ModVector p_mods; // Mods that are applied to the problem
   ModVector r_mods; // Mods that are applied to the relaxation.
 
+  if(!sepBufs_.empty()) {
+    parSeparate_(sol, node, s_pool, status);
+    return;
+  }
+
   *status = SepaContinue;
   sol_found = false;
   for(h = handlers_.begin(); h != handlers_.end(); ++h) {
+    MNTR_TRACE_SCOPE2("separate", handNames_[h - handlers_.begin()]);
     (*h)->separate(sol, node, relaxation_, cutMan_, s_pool, p_mods, r_mods,
                    &sol_found, &st);
     if(st == SepaPrune) {
@@ -445,6 +685,43 @@ void PCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node,
   }
 }
 
+void PCBProcessor::sepBuffered_(ConstSolutionPtr sol, NodePtr node,
+                                SolutionPoolPtr s_pool, SepRound& r,
+                                bool solve)
+{
+  const int n = handlers_.size();
+
+  r.st.assign(n, SepaContinue);
+  r.pMods.assign(n, ModVector());
+  r.rMods.assign(n, ModVector());
+  r.found.assign(n, 0);
+
+#pragma omp parallel num_threads(sepThreads_)
+#pragma omp single
+  {
+    for(int i = 0; i < n; ++i) {
+      if(sepBufs_[i]) {
+#pragma omp task firstprivate(i)
+        {
+          MNTR_TRACE_SCOPE2("separate", handNames_[i]);
+          bool t_found = false;
+          handlers_[i]->separate(sol, node, relaxation_, sepBufs_[i], s_pool,
+                                 r.pMods[i], r.rMods[i], &t_found, &r.st[i]);
+          r.found[i] = t_found;
+        }
+      }
+    }
+    if(solve) {
+      solveRelaxation_();
+    }
+  }
+}
+
+void PCBProcessor::setConflictPool(ConflictPool* cp)
+{
+  conflicts_ = cp;
+}
+
 void PCBProcessor::setCutManager(CutManager* cutman)
 {
   cutMan_ = cutman;
@@ -572,6 +849,7 @@ void PCBProcessor::solveRelaxation_()
   logger_->msgStream(LogDebug1) << me_ << "solving relaxation. Time = "
     << env_->getTime() << std::endl;
 #endif
+  MNTR_TRACE_SCOPE("engine solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -624,7 +902,14 @@ void PCBProcessor::writeStats(std::ostream& out) const
       << me_ << "nodes with problems                   = " << stats_.prob
       << std::endl
       << me_ << "nodes for which fixNodeErr was called = " << stats_.tol_err
+      << std::endl
+      << me_ << "separation rounds run in parallel     = " << stats_.parsep
+      << std::endl
+      << me_ << "separation rounds run during resolve  = " << stats_.pipesep
       << std::endl;
+  if(conflicts_) {
+    conflicts_->writeStats(out);
+  }
 }
 
 void PCBProcessor::writeStats() const
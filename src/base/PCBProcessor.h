@@ -20,6 +20,8 @@
 namespace Minotaur
 {
 
+class ConflictPool;
+class CutBuffer;
 class CutManager;
 //class Problem;
 
@@ -31,6 +33,8 @@ struct NodeStats {
   UInt proc;    /// Number of nodes processed
   UInt ub;      /// Number of nodes pruned because of bound
   UInt tol_err; /// Number of nodes for which fixNodeErr was called
+  UInt parsep;  /// Number of separation rounds run in parallel
+  UInt pipesep; /// Number of separation rounds run during a resolve
 };
 
 /**
@@ -63,12 +67,21 @@ public:
   // Find branches that will be used to branch at this node.
   Branches getBranches();
 
+  // Return the cut manager used with this processor.
+  CutManager* getCutManager() { return cutMan_; };
+
+  // Base class method.
+  void getGlobalBounds(DoubleVector& lb, DoubleVector& ub) const;
+
   // Get warm-start information.
   WarmStartPtr getWarmStart();
 
   // Implement NodeProcessor::process().
   void process(NodePtr node, RelaxationPtr rel, SolutionPoolPtr s_pool);
 
+  // Base class method.
+  void setConflictPool(ConflictPool* cp);
+
   void setCutManager(CutManager* cutman);
 
   // write statistics. Base class method.
@@ -87,6 +100,9 @@ private:
        */
   bool contOnErr_;
 
+  /// Conflicts found in pruned nodes. NULL if conflicts are not used.
+  ConflictPool* conflicts_;
+
   /// The cut manager.
   CutManager* cutMan_;
 
@@ -105,12 +121,21 @@ private:
   /// All the handlers that are used for this processor
   HandlerVector handlers_;
 
+  /// Names of handlers_, kept for tracing.
+  std::vector<const char*> handNames_;
+
   /// Heuristics that can be called at each node.
   HeurVector heurs_;
 
   /// The handler which reports the infeasibility of a node.
   HandlerPtr infHand_;
 
+  /**
+   * If true, at the root, handlers in sepBufs_ separate the point of one
+   * round while the relaxation of the next round is solved.
+   */
+  bool pipeSep_;
+
   /// Log
   LoggerPtr logger_;
 
@@ -133,12 +158,37 @@ private:
   /// Relaxation that is processed by this processor.
   RelaxationPtr relaxation_;
 
+  /// One buffer of cuts for each handler in handlers_. Empty unless
+  /// separation is done in parallel.
+  std::vector<CutBuffer*> sepBufs_;
+
+  /// Number of threads used for calling separate() of handlers.
+  int sepThreads_;
+
+  /// Results of separate() of each handler, before they are merged.
+  struct SepRound {
+    std::vector<SeparationStatus> st;
+    std::vector<ModVector> pMods;
+    std::vector<ModVector> rMods;
+    std::vector<int> found;
+  };
+
   /// Statistics
   NodeStats stats_;
 
   /// Warm-start information for start processing the children
   WarmStartPtr ws_;
 
+  /**
+   * Add a conflict from a node that is pruned as infeasible or by bound. sol
+   * is the solution of the relaxation, if any.
+   */
+  void addConflict_(NodePtr node, ConstSolutionPtr sol,
+                    SolutionPoolPtr s_pool);
+
+  /// Delete the modifications in mods and empty it.
+  void clearMods_(ModVector& mods);
+
   /**
        * Check if the solution is feasible to the original problem. 
        * In case it is feasible, we can store the solution and update the
@@ -177,6 +227,42 @@ private:
   void separate_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
                  SeparationStatus* status);
 
+  /**
+   * Same as separate_(), but the handlers whose separate() is thread safe
+   * are called concurrently, each with its own buffer of cuts. The buffers
+   * are then sent to the cut manager in the order of handlers_. The other
+   * handlers are called in that order as well, so that the cuts reach the
+   * relaxation in the same order irrespective of the number of threads.
+   */
+  void parSeparate_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                    SeparationStatus* status);
+
+  /**
+   * Merge the results of separation in the order of handlers_. Buffers are
+   * flushed if bufs is true. Handlers that need exclusive access separate
+   * now if excl is true. Mods are added to the node. Merging stops at the
+   * first handler that prunes the node: its mods and the remaining results
+   * are thrown away.
+   */
+  void mergeSep_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                 SepRound& r, bool bufs, bool excl, SeparationStatus* status);
+
+  /**
+   * Solve the relaxation while the handlers in sepBufs_ separate sol, which
+   * must not be owned by the engine. The cuts are added to the relaxation
+   * after the solve. The LP solution is therefore stale if status is
+   * SepaResolve.
+   */
+  void pipeSolve_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                  SeparationStatus* status);
+
+  /**
+   * Call separate() of the handlers in sepBufs_ on their own threads. If
+   * solve is true, the relaxation is solved on another thread meanwhile.
+   */
+  void sepBuffered_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                    SepRound& r, bool solve);
+
   // Implement NodeProcessor::tightenBounds_()
   virtual void tightenBounds_(NodePtr node, SolutionPoolPtr s_pool,
                               ConstSolutionPtr sol, SeparationStatus* status);
@@ -25,6 +25,7 @@
 #include "Modification.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
+#include "Trace.h"
 
 using namespace Minotaur;
 
@@ -367,6 +368,7 @@ bool ParBndProcessor::shouldPrune_(NodePtr node, double solval,
 
 void ParBndProcessor::solveRelaxation_() 
 {
+  MNTR_TRACE_SCOPE("engine solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -36,7 +36,9 @@
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
+#include "Telemetry.h"
 #include "Timer.h"
+#include "Trace.h"
 #include "Branch.h"
 #include "BrCand.h"
 #include "BrVarCand.h"
@@ -58,6 +60,7 @@ ParBranchAndBound::ParBranchAndBound()
     solPool_(0),
     stats_(0),
     status_(NotStarted),
+    telem_(0),
     timer_(0),
     tm_(0)
 {
@@ -71,7 +74,8 @@ ParBranchAndBound::ParBranchAndBound(EnvPtr env, ProblemPtr p)
     problem_(p),
     solPool_(0),
     stats_(0),
-    status_(NotStarted)
+    status_(NotStarted),
+    telem_(0)
 {
   timer_ = env->getNewTimer();
   tm_ = (ParTreeManagerPtr) new ParTreeManager(env);
@@ -95,6 +99,9 @@ ParBranchAndBound::~ParBranchAndBound()
   if (stats_) {
     delete stats_;
   }
+  if (telem_) {
+    delete telem_;
+  }
   if (timer_) {
     delete timer_;
   }
@@ -110,6 +117,12 @@ void ParBranchAndBound::addPreRootHeur(HeurPtr h)
 }
 
 
+void ParBranchAndBound::addConcHeur(HeurPtr h)
+{
+  concHeurs_.push_back(h);
+}
+
+
 double ParBranchAndBound::getPerGap() 
 { 
   return tm_->getPerGap(); 
@@ -272,7 +285,9 @@ void ParBranchAndBound::processRoot_(bool *should_prune, bool *should_dive,
   NodePtr new_node = NodePtr(); // NULL
   RelaxationPtr rel;
   bool prune = *should_prune;
+  bool heur_sol;
   Branches branches;
+  std::vector<SolutionPoolPtr> pools(concHeurs_.size());
 #if SPEW
   logger_->msgStream(LogDebug) << me_ << "creating root node" << 
     std::endl;
@@ -291,9 +306,34 @@ void ParBranchAndBound::processRoot_(bool *should_prune, bool *should_dive,
   logger_->msgStream(LogDebug) << me_ << "processing root node" << 
     std::endl;
 #endif
-  nodePrcssr0->processRootNode(current_node, rel, solPool_);
+  // the other threads are idle until the tree search starts. They run the
+  // concurrent heuristics and the separation tasks of the node processor.
+  for (UInt i = 0; i < concHeurs_.size(); ++i) {
+    pools[i] = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
+    if (solPool_->getBestSolution()) {
+      pools[i]->addSolution(solPool_->getBestSolution());
+    }
+  }
+#pragma omp parallel
+#pragma omp single
+  {
+    for (UInt i = 0; i < concHeurs_.size(); ++i) {
+#pragma omp task firstprivate(i)
+      concHeurs_[i]->solve(NodePtr(), RelaxationPtr(), pools[i]);
+    }
+    nodePrcssr0->processRootNode(current_node, rel, solPool_);
+  }
   ++stats_->nodesProc;
-  if (nodePrcssr0->foundNewSolution()) {
+  heur_sol = false;
+  for (UInt i = 0; i < concHeurs_.size(); ++i) {
+    if (pools[i]->getBestSolutionValue() <
+        solPool_->getBestSolutionValue()) {
+      solPool_->addSolution(pools[i]->getBestSolution());
+      heur_sol = true;
+    }
+    delete pools[i];
+  }
+  if (nodePrcssr0->foundNewSolution() || heur_sol) {
     tm_->setUb(solPool_->getBestSolutionValue());
   }
 
@@ -638,6 +678,11 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   }
   stats_ = new ParBabStats();
 
+  if (telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_, numThreads);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
@@ -720,11 +765,14 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
         }
       } else {
-#pragma omp critical (treeManager)
         {
-          current_node[i] = tm_->getCandidate();
-          if (current_node[i]) {
-            tm_->removeActiveNode(current_node[i]);
+          MNTR_TRACE_SCOPE("tree lock");
+#pragma omp critical (treeManager)
+          {
+            current_node[i] = tm_->getCandidate();
+            if (current_node[i]) {
+              tm_->removeActiveNode(current_node[i]);
+            }
           }
         }
         if (current_node[i]) {
@@ -768,9 +816,14 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
             }
           }
         }
-        nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
-                               initialized[i], timesUp, timesDown,
-                               pseudoUp, pseudoDown, stats_->nodesProc);
+        {
+          MNTR_TRACE_SCOPE("node");
+          TelemetryBusy busy(telem_, i);
+          nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
+                                 initialized[i], timesUp, timesDown,
+                                 pseudoUp, pseudoDown, stats_->nodesProc);
+        }
+        updateTelemetry_(i, nodePrcssr[i]);
 #pragma omp critical (stats)
         {
           ++stats_->nodesProc;
@@ -804,20 +857,23 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
 #pragma omp critical (current_node)
           current_node[i] = NodePtr();
-#pragma omp critical (treeManager)
           {
-            new_node[i] = tm_->getCandidate();
-            if (new_node[i]) {
-              //getting and removing node must be in the same critical
-              //block otherwise some other thread might take the same node
-              tm_->removeActiveNode(new_node[i]);
-              nodesProcTh[i]++;
+            MNTR_TRACE_SCOPE("tree lock");
+#pragma omp critical (treeManager)
+            {
+              new_node[i] = tm_->getCandidate();
+              if (new_node[i]) {
+                //getting and removing node must be in the same critical
+                //block otherwise some other thread might take the same node
+                tm_->removeActiveNode(new_node[i]);
+                nodesProcTh[i]++;
 #if SPEW
 #pragma omp critical (logger)
-              logger_->msgStream(LogDebug) << me_ << "get node "
-                << new_node[i]->getId() << " (prune) thread "
-                << omp_get_thread_num() << std::endl;
+                logger_->msgStream(LogDebug) << me_ << "get node "
+                  << new_node[i]->getId() << " (prune) thread "
+                  << omp_get_thread_num() << std::endl;
 #endif
+              }
             }
           }
           dived_prev[i] = false;
@@ -839,6 +895,7 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
 #pragma omp critical (treeManager)
           {
+            MNTR_TRACE_SCOPE("branch");
 #pragma omp critical (current_node)
             new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
@@ -854,21 +911,24 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
             dived_prev[i] = true;
           } else {
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
             {
-              new_node[i] = tm_->getCandidate(); // Can be NULL. The
-              // branches that were created could have large lb and tm
-              // might have eliminated them.
-              if (new_node[i]) {
-                tm_->removeActiveNode(new_node[i]);
+              MNTR_TRACE_SCOPE("tree lock");
+#pragma omp critical (treeManager)
+              {
+                new_node[i] = tm_->getCandidate(); // Can be NULL. The
+                // branches that were created could have large lb and tm
+                // might have eliminated them.
+                if (new_node[i]) {
+                  tm_->removeActiveNode(new_node[i]);
 #if SPEW
 #pragma omp critical (logger)
-                logger_->msgStream(LogDebug) << me_ << "get/remove node "
-                  << new_node[i]->getId() << " thread "
-                  << omp_get_thread_num() << std::endl;
+                  logger_->msgStream(LogDebug) << me_ << "get/remove node "
+                    << new_node[i]->getId() << " thread "
+                    << omp_get_thread_num() << std::endl;
 #endif
+                }
+                dived_prev[i] = false;
               }
-              dived_prev[i] = false;
             }
           }
         }
@@ -912,6 +972,7 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
       {
         showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
       }
+      writeTelemetry_(nodeCountTh[i], treeLbTh[i], false);
       if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
 #pragma omp critical (treeManager)
         {
@@ -975,6 +1036,7 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
       << k << " = " << nodesProcTh[k] << std::endl;
   }
 
+  writeTelemetry_(0, tm_->getLb(), true);
   stats_->timeUsed = timer_->query();
   timer_->stop();
 
@@ -1075,6 +1137,11 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   }
   stats_ = new ParBabStats();
 
+  if (telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_, numThreads);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
@@ -1215,9 +1282,13 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
               }
             }
           }
-          nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
-                                 initialized[i], timesUp, timesDown,
-                                 pseudoUp, pseudoDown, stats_->nodesProc);
+          {
+            TelemetryBusy busy(telem_, i);
+            nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
+                                   initialized[i], timesUp, timesDown,
+                                   pseudoUp, pseudoDown, stats_->nodesProc);
+          }
+          updateTelemetry_(i, nodePrcssr[i]);
           nodesProcTh[i] += 1;
 #pragma omp critical (stats)
           {
@@ -1354,6 +1425,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         {
           showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
         }
+        writeTelemetry_(nodeCountTh[i], treeLbTh[i], false);
         if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
 #pragma omp critical (treeManager)
           {
@@ -1387,6 +1459,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         }
 
         showParStatus_(nodeCount, treeLb, wallTimeStart, 0);
+        writeTelemetry_(nodeCount, treeLb, false);
 
         // update stopping conditions
         if (nodeCount == 0) {
@@ -1451,6 +1524,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   //}
   solPool_->writeStats(logger_->msgStream(LogExtraInfo));
 
+  writeTelemetry_(0, tm_->getLb(), true);
   stats_->timeUsed = timer_->query();
   timer_->stop();
 
@@ -1546,6 +1620,11 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
   }
   stats_ = new ParBabStats();
 
+  if (telem_) {
+    delete telem_;
+  }
+  telem_ = new Telemetry(env_, numThreads);
+
   // initialize solution pool
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
@@ -1662,9 +1741,13 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             << (int)current_node[i]->getTbScore() << " thread "
             << omp_get_thread_num() << std::endl;
 #endif
-          nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
+          {
+            TelemetryBusy busy(telem_, i);
+            nodePrcssr[i]->process(current_node[i], rel[i], solPool_,
                                    initialized[i], timesUp, timesDown,
                                    pseudoUp, pseudoDown, stats_->nodesProc);
+          }
+          updateTelemetry_(i, nodePrcssr[i]);
 #pragma omp critical (stats)
           ++stats_->nodesProc;
         } //if current_node[i]
@@ -1798,6 +1881,7 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
           treeLb = minNodeLb;
         }
         showParStatus_(nodeCount, treeLb, wallTimeStart, 0);
+        writeTelemetry_(nodeCount, treeLb, false);
 
         // update stopping conditions for par
         if (nodeCount == 0 && !(tm_->anyActiveNodesLeft())) {
@@ -1837,6 +1921,7 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
     << me_ << "nodes created   = " << tm_->getSize() << std::endl
     << me_ << "iterations = " << iterCount << std::endl;
 
+  writeTelemetry_(0, tm_->getLb(), true);
   stats_->timeUsed = timer_->query();
   timer_->stop();
 
@@ -1871,6 +1956,45 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
 }
 
 
+void ParBranchAndBound::updateTelemetry_(UInt i, ParPCBProcessorPtr prcssr)
+{
+  CutManager *cutman;
+
+  if (telem_->isOn()) {
+    cutman = prcssr->getCutManager();
+    if (cutman) {
+      telem_->setCuts(i, cutman->getNumCuts());
+    }
+  }
+}
+
+
+void ParBranchAndBound::writeTelemetry_(UInt in_process, double treeLb,
+                                        bool last_line)
+{
+  TelemetryRec rec;
+
+  if (!last_line && !telem_->isDue()) {
+    return;
+  }
+  // take a snapshot under the locks that guard the tree and the counters.
+  // The line itself is written without them.
+  rec.cpu = timer_->query();
+  rec.wall = timer_->wQuery();
+  rec.lb = treeLb;
+#pragma omp critical (treeManager)
+  {
+    rec.ub = tm_->getUb();
+    rec.gap = tm_->getPerGapPar(treeLb);
+    rec.nodesLeft = tm_->getActiveNodes() + in_process;
+  }
+#pragma omp critical (stats)
+  rec.nodesProc = stats_->nodesProc;
+  rec.sols = solPool_->getNumSolsFound();
+  telem_->write(rec, last_line);
+}
+
+
 void ParBranchAndBound::writeStats(std::ostream &out)
 {
   out << me_ << "time taken      = " << std::fixed << std::setprecision(2)
@@ -1882,6 +2006,10 @@ void ParBranchAndBound::writeStats(std::ostream &out)
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
     (*it)->writeStats(out);
   }
+  for (HeurVector::iterator it=concHeurs_.begin(); it!=concHeurs_.end();
+       ++it) {
+    (*it)->writeStats(out);
+  }
   solPool_->writeStats(out);
 }
 
@@ -1897,6 +2025,10 @@ void ParBranchAndBound::writeParStats(std::ostream &out, ParPCBProcessorPtr node
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
     (*it)->writeStats(out);
   }
+  for (HeurVector::iterator it=concHeurs_.begin(); it!=concHeurs_.end();
+       ++it) {
+    (*it)->writeStats(out);
+  }
   solPool_->writeStats(out);
 }
 
@@ -29,6 +29,7 @@ namespace Minotaur {
   class   Problem;
   class   Solution;
   class   SolutionPool;
+  class   Telemetry;
   class   WarmStart;
   class   Timer;
   typedef Engine* EnginePtr;
@@ -65,6 +66,17 @@ namespace Minotaur {
      */
     void addPreRootHeur(HeurPtr h);
 
+    /**
+     * \brief Add a heuristic that is called while the root node is
+     * processed, on a thread that would otherwise be idle.
+     *
+     * \param [in] h The heuristic. Its solve() gets a NULL node and
+     * relaxation and a solution pool of its own, whose best solution is
+     * added to the pool of the solver after the root. It must not share any
+     * data with the relaxation or the handlers of thread 0.
+     */
+    void addConcHeur(HeurPtr h);
+
     /**
      * \brief Return the percentage gap between the lower and upper bounds. 
      * 
@@ -263,6 +275,9 @@ namespace Minotaur {
      */
     HeurVector preHeurs_;
 
+    /// Heuristics that are called while the root node is processed.
+    HeurVector concHeurs_;
+
     /// The Problem that is solved using branch-and-bound.
     ProblemPtr problem_;
 
@@ -278,6 +293,9 @@ namespace Minotaur {
     /// The status of the branch-and-bound algorithm.
     SolveStatus status_;
 
+    /// Stream of progress for monitoring, if option telemetry_file is set.
+    Telemetry *telem_;
+
     /**
      * \brief Timer for keeping track of time.
      *
@@ -353,6 +371,19 @@ namespace Minotaur {
      */
     void showParStatus_(UInt current_uncounted, double treeLb,
                         double wallStartTime, UInt threadId);
+
+    /// Record the number of cuts of thread i after it processed a node.
+    void updateTelemetry_(UInt i, ParPCBProcessorPtr prcssr);
+
+    /**
+     * \brief Write a line of telemetry if it is due, or if last_line is
+     * true. Does not take the lock on the tree.
+     *
+     * \param [in] in_process Number of nodes being processed by threads.
+     * \param [in] treeLb Lower bound of the tree.
+     * \param [in] last_line True if the search has ended.
+     */
+    void writeTelemetry_(UInt in_process, double treeLb, bool last_line);
   };
 
   /// Statistics about the branch-and-bound.
@@ -183,6 +183,16 @@ void ParCutMan::addCut(CutPtr c)
 }
 
 
+ConstraintPtr ParCutMan::addCut(ProblemPtr p, FunctionPtr f, double lb,
+                                double ub, bool, bool never_del)
+{
+  CutPtr cut = (CutPtr) new Cut(p, f, lb, ub, never_del, false);
+
+  addCutToPool(cut);
+  return cut->getConstraint();
+}
+
+
 void ParCutMan::addCuts(CutVectorIter cbeg, CutVectorIter cend)
 {
   for (CutVectorIter it = cbeg; it != cend; ++it) {
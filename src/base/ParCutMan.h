@@ -48,10 +48,12 @@ namespace Minotaur {
 
     std::vector<ConstraintPtr> getPoolCons();
 
-    ConstraintPtr addCut(ProblemPtr, FunctionPtr, double, double, bool, bool)
-    {
-      return ConstraintPtr();
-    };
+    /**
+     * Base class method. The cut is added to p at once, and is also kept in
+     * the pool so that other threads can copy it.
+     */
+    ConstraintPtr addCut(ProblemPtr p, FunctionPtr f, double lb, double ub,
+                         bool direct_to_rel, bool never_del);
 
     // Base class method.
     void addCuts(CutVectorIter cbeg, CutVectorIter cend);
@@ -729,12 +729,9 @@ UInt ParMINLPDiving::ReducedCost_(UInt numfrac, const double* x, Direction d,
 }
 
 
-void ParMINLPDiving::restoreBounds_(double* LB_copy, double* UB_copy, UInt vars, ProblemPtr p)
+void ParMINLPDiving::restoreBounds_(double* LB_copy, double* UB_copy, UInt, ProblemPtr p)
 {
-  for (UInt i=0; i<vars; ++i, ++LB_copy, ++UB_copy) {
-    p->changeBoundByInd(i, Lower, *LB_copy);
-    p->changeBoundByInd(i, Upper, *UB_copy);
-  }
+  p->changeBounds(LB_copy, UB_copy);
 }
 
 
@@ -765,14 +762,9 @@ double ParMINLPDiving::rounding_(double value, Direction d)
 }
 
 
-void ParMINLPDiving::saveBounds_(double* LB_copy, double* UB_copy, UInt vars)
+void ParMINLPDiving::saveBounds_(double* LB_copy, double* UB_copy, UInt)
 {
-  VariablePtr variable;
-  for (UInt i=0; i<vars; ++i, ++LB_copy, ++UB_copy) {
-    variable = p_->getVariable(i);
-    *LB_copy = variable->getLb();
-    *UB_copy = variable->getUb();
-  }
+  p_->getBounds(LB_copy, UB_copy);
 }
 
 
@@ -16,6 +16,7 @@
 #include "MinotaurConfig.h"
 #include "Brancher.h"
 #include "Constraint.h"
+#include "CutBuffer.h"
 #include "CutManager.h"
 #include "Engine.h"
 #include "Environment.h"
@@ -30,8 +31,10 @@
 #include "ParCutMan.h"
 #include "Modification.h"
 #include "Relaxation.h"
+#include "Solution.h"
 #include "SolutionPool.h"
 #include "ParTreeManager.h"
+#include "Trace.h"
 #include "WarmStart.h"
 
 using namespace Minotaur;
@@ -84,9 +87,28 @@ ParPCBProcessor::ParPCBProcessor (EnvPtr env, EnginePtr engine,
   stats_.bra = 0;
   stats_.inf = 0;
   stats_.opt = 0;
+  stats_.pipesep = 0;
   stats_.prob = 0;
   stats_.proc = 0;
   stats_.ub = 0;
+
+  // only thread 0 processes the root, and the other threads are idle until
+  // the tree search starts.
+  pipeSep_ = env->getOptions()->findBool("root_sep_pipeline")->getValue() &&
+             env->getOptions()->findInt("threads")->getValue() > 1;
+  if (pipeSep_) {
+    UInt n_safe = 0;
+    for (HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+      if ((*h)->isSepThreadSafe()) {
+        ++n_safe;
+      }
+    }
+    if (n_safe > 0) {
+      for (HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+        sepBufs_.push_back((*h)->isSepThreadSafe() ? new CutBuffer() : 0);
+      }
+    }
+  }
 }
 
 
@@ -107,6 +129,13 @@ ParPCBProcessor::~ParPCBProcessor()
   if (branches_) {
     delete branches_;
   }
+  for (std::vector<CutBuffer*>::iterator it = sepBufs_.begin();
+       it != sepBufs_.end(); ++it) {
+    if (*it) {
+      delete *it;
+    }
+  }
+  sepBufs_.clear();
   handlers_.clear();
 }
 
@@ -191,6 +220,7 @@ bool ParPCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool)
   if (presFreq_ < 1 || checkForPresolve) {
     return false;
   } 
+  MNTR_TRACE_SCOPE("presolveNode");
   // TODO: make this more sophisticated: loop several times until no more
   // changes are possible.
   for (it=0; it<max_iter && true==cont; ++it) {
@@ -243,9 +273,15 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
   bool should_resolve;
   BrancherStatus br_status;
   ConstSolutionPtr sol;
+  SolutionPtr pipe_sol = 0;
   ModVector mods;
   SeparationStatus sep_status = SepaContinue;
+  SeparationStatus pipe_status;
   int iter = 0;
+  // the root is processed in a parallel region in which the other threads
+  // wait for tasks.
+  const bool pipe = !sepBufs_.empty() && !node->getParent() &&
+                    omp_get_num_threads() > 1;
 
   ++stats_.proc;
   relaxation_ = rel;
@@ -280,8 +316,20 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
     logger_->msgStream(LogDebug) << me_ << "iteration " << iter << std::endl;
 #endif
 
-    solveRelaxation_();
+    pipe_status = SepaContinue;
+    if (pipe_sol) {
+      pipeSolve_(pipe_sol, node, s_pool, &pipe_status);
+      delete pipe_sol;
+      pipe_sol = 0;
+    } else {
+      solveRelaxation_();
+    }
     sol = engine_->getSolution();
+    if (pipe_status == SepaPrune) {
+      node->setStatus(NodeInfeasible);
+      stats_.inf++;
+      break;
+    }
 
     // check if the relaxation is infeasible or if the cost is too high.
     // In either case we can prune. Also set lb of node.
@@ -312,7 +360,25 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
     // the node can not be pruned because of infeasibility or high cost.
     // continue processing.
     tightenBounds_();
-    separate_(sol, node, s_pool, &sep_status);
+    if (pipe) {
+      // handlers that need exclusive access separate now. If the
+      // relaxation is to be resolved anyway, the others separate this
+      // point while it is being resolved.
+      SepRound r;
+      mergeSep_(sol, node, s_pool, r, false, true, &sep_status);
+      if (sep_status == SepaContinue && pipe_status == SepaResolve) {
+        // cuts of the last round were added after this solve.
+        sep_status = SepaResolve;
+      }
+      if (sep_status == SepaResolve) {
+        pipe_sol = new Solution(sol);
+      } else if (sep_status == SepaContinue) {
+        sepBuffered_(sol, node, s_pool, r, false);
+        mergeSep_(sol, node, s_pool, r, true, false, &sep_status);
+      }
+    } else {
+      separate_(sol, node, s_pool, &sep_status);
+    }
 
     if (sep_status == SepaPrune) {
       node->setStatus(NodeInfeasible);
@@ -378,6 +444,119 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
   return;
 }
 
+void ParPCBProcessor::mergeSep_(ConstSolutionPtr sol, NodePtr node,
+                                SolutionPoolPtr s_pool, SepRound& r, bool bufs,
+                                bool excl, SeparationStatus* status)
+{
+  const int n = handlers_.size();
+  bool sol_found;
+  size_t n_added;
+  int i;
+
+  if (r.st.size() != (size_t)n) {
+    r.st.assign(n, SepaContinue);
+    r.pMods.assign(n, ModVector());
+    r.rMods.assign(n, ModVector());
+    r.found.assign(n, 0);
+  }
+
+  *status = SepaContinue;
+  sol_found = false;
+  for (i = 0; i < n; ++i) {
+    if ((sepBufs_[i] && !bufs) || (!sepBufs_[i] && !excl)) {
+      continue;
+    }
+    if (SepaPrune == *status) {
+      // node will be pruned. Throw away what the remaining handlers found.
+      if (sepBufs_[i]) {
+        sepBufs_[i]->clear();
+        for (ModificationConstIterator m_iter = r.pMods[i].begin();
+             m_iter != r.pMods[i].end(); ++m_iter) {
+          delete *m_iter;
+        }
+        for (ModificationConstIterator m_iter = r.rMods[i].begin();
+             m_iter != r.rMods[i].end(); ++m_iter) {
+          delete *m_iter;
+        }
+      }
+      continue;
+    }
+    if (sepBufs_[i]) {
+      sepBufs_[i]->flush(cutMan_, relaxation_, sol, &n_added);
+    } else {
+      MNTR_TRACE_SCOPE("separate");
+      bool t_found = false;
+      handlers_[i]->separate(sol, node, relaxation_, cutMan_, s_pool,
+                             r.pMods[i], r.rMods[i], &t_found, &r.st[i]);
+      r.found[i] = t_found;
+    }
+    if (r.found[i]) {
+      sol_found = true;
+    }
+    if (r.st[i] == SepaPrune) {
+      *status = SepaPrune;
+    } else if (r.st[i] == SepaResolve) {
+      *status = SepaResolve;
+    }
+    for (ModificationConstIterator m_iter = r.pMods[i].begin();
+         m_iter != r.pMods[i].end(); ++m_iter) {
+      node->addPMod(*m_iter);
+    }
+    for (ModificationConstIterator m_iter = r.rMods[i].begin();
+         m_iter != r.rMods[i].end(); ++m_iter) {
+      node->addRMod(*m_iter);
+    }
+  }
+  if (true == sol_found) {
+    ++numSolutions_;
+  }
+}
+
+
+void ParPCBProcessor::pipeSolve_(ConstSolutionPtr sol, NodePtr node,
+                                 SolutionPoolPtr s_pool,
+                                 SeparationStatus* status)
+{
+  SepRound r;
+
+  ++stats_.pipesep;
+  sepBuffered_(sol, node, s_pool, r, true);
+  mergeSep_(sol, node, s_pool, r, true, false, status);
+}
+
+
+void ParPCBProcessor::sepBuffered_(ConstSolutionPtr sol, NodePtr node,
+                                   SolutionPoolPtr s_pool, SepRound& r,
+                                   bool solve)
+{
+  const int n = handlers_.size();
+  SepRound *rp = &r;
+
+  r.st.assign(n, SepaContinue);
+  r.pMods.assign(n, ModVector());
+  r.rMods.assign(n, ModVector());
+  r.found.assign(n, 0);
+
+  for (int i = 0; i < n; ++i) {
+    if (sepBufs_[i]) {
+#pragma omp task firstprivate(i, rp, sol, node, s_pool)
+      {
+        MNTR_TRACE_SCOPE("separate");
+        bool t_found = false;
+        handlers_[i]->separate(sol, node, relaxation_, sepBufs_[i], s_pool,
+                               rp->pMods[i], rp->rMods[i], &t_found,
+                               &rp->st[i]);
+        rp->found[i] = t_found;
+      }
+    }
+  }
+  if (solve) {
+    solveRelaxation_();
+  }
+#pragma omp taskwait
+}
+
+
 void ParPCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node, 
                             SolutionPoolPtr s_pool, SeparationStatus *status) 
 {
@@ -391,6 +570,7 @@ void ParPCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node,
   *status = SepaContinue;
   sol_found = false;
   for (h = handlers_.begin(); h != handlers_.end(); ++h) {
+    MNTR_TRACE_SCOPE("separate");
     (*h)->separate(sol, node, relaxation_, cutMan_, s_pool, p_mods, r_mods,
                    &sol_found, &st);
     if (st == SepaPrune) {
@@ -557,6 +737,7 @@ bool ParPCBProcessor::shouldPrune_(NodePtr node, double solval,
 
 void ParPCBProcessor::solveRelaxation_() 
 {
+  MNTR_TRACE_SCOPE("engine solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -582,7 +763,8 @@ void ParPCBProcessor::writeStats(std::ostream &out) const
       << me_ << "nodes optimal       = " << stats_.opt << std::endl 
       << me_ << "nodes hit ub        = " << stats_.ub << std::endl 
       << me_ << "nodes with problems = " << stats_.prob << std::endl 
-      ;
+      << me_ << "separation rounds run during resolve = " << stats_.pipesep
+      << std::endl;
 }
 
 
@@ -24,6 +24,7 @@ namespace Minotaur {
 
   //class Engine;
   //class Problem;
+  class CutBuffer;
   class Solution;
   typedef const Solution* ConstSolutionPtr;
 
@@ -31,6 +32,7 @@ namespace Minotaur {
     UInt bra;    /// Number of times relaxation became infeasible
     UInt inf;    /// Number of times relaxation became infeasible
     UInt opt;    /// Number of times relaxation gave optimal feasible solution
+    UInt pipesep; /// Number of separation rounds run during a resolve
     UInt prob;   /// Number of times problem ocurred in solving
     UInt proc;   /// Number of nodes processed
     UInt ub;     /// Number of nodes pruned because of bound
@@ -131,6 +133,13 @@ namespace Minotaur {
     /// Heuristics that can be called at each node.
     HeurVector heurs_;
 
+    /**
+     * If true, at the root, handlers in sepBufs_ separate the point of one
+     * round while the relaxation of the next round is solved, on the
+     * threads that are idle until the tree search starts.
+     */
+    bool pipeSep_;
+
     /// Log
     LoggerPtr logger_;
 
@@ -147,6 +156,18 @@ namespace Minotaur {
     /// Relaxation that is processed by this processor.
     RelaxationPtr relaxation_;
 
+    /// One buffer of cuts for each handler in handlers_. Empty unless the
+    /// root is pipelined.
+    std::vector<CutBuffer*> sepBufs_;
+
+    /// Results of separate() of each handler, before they are merged.
+    struct SepRound {
+      std::vector<SeparationStatus> st;
+      std::vector<ModVector> pMods;
+      std::vector<ModVector> rMods;
+      std::vector<int> found;
+    };
+
     /// Statistics
     ParNodeStats stats_;
 
@@ -168,9 +189,34 @@ namespace Minotaur {
     virtual bool isFeasible_(NodePtr node, ConstSolutionPtr sol, 
                              SolutionPoolPtr s_pool, bool &should_prune);
 
+    /**
+     * Merge the results of separation in the order of handlers_. Buffers
+     * are flushed if bufs is true. Handlers that need exclusive access
+     * separate now if excl is true. Mods are added to the node, and if the
+     * node is to be pruned, the remaining results are thrown away.
+     */
+    void mergeSep_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                   SepRound& r, bool bufs, bool excl, SeparationStatus* status);
+
+    /**
+     * Solve the relaxation while the handlers in sepBufs_ separate sol,
+     * which must not be owned by the engine. The cuts are added to the
+     * relaxation after the solve.
+     */
+    void pipeSolve_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                    SeparationStatus* status);
+
     /// Presolve a node.
     virtual bool presolveNode_(NodePtr node, SolutionPoolPtr s_pool);
 
+    /**
+     * Call separate() of the handlers in sepBufs_ as OpenMP tasks of the
+     * enclosing parallel region. If solve is true, the relaxation is solved
+     * on this thread meanwhile.
+     */
+    void sepBuffered_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool,
+                      SepRound& r, bool solve);
+
 
     /// Solve the relaxation.
     virtual void solveRelaxation_();
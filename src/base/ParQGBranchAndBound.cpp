@@ -115,6 +115,12 @@ void ParQGBranchAndBound::addPreRootHeur(HeurPtr h)
 }
 
 
+void ParQGBranchAndBound::addConcHeur(HeurPtr h)
+{
+  concHeurs_.push_back(h);
+}
+
+
 double ParQGBranchAndBound::getPerGap() 
 { 
   return tm_->getPerGap(); 
@@ -177,7 +183,9 @@ NodePtr ParQGBranchAndBound::processRoot_(bool *should_prune, bool *should_dive,
   NodePtr new_node = NodePtr(); // NULL
   RelaxationPtr rel;
   bool prune = *should_prune;
+  bool heur_sol;
   Branches branches;
+  std::vector<SolutionPoolPtr> pools(concHeurs_.size());
 #if SPEW
   logger_->msgStream(LogDebug) << me_ << "creating root node" << 
     std::endl;
@@ -196,9 +204,34 @@ NodePtr ParQGBranchAndBound::processRoot_(bool *should_prune, bool *should_dive,
   logger_->msgStream(LogDebug) << me_ << "processing root node" << 
     std::endl;
 #endif
-  nodePrcssr0->processRootNode(current_node, rel, solPool_);
+  // the other threads are idle until the tree search starts. They run the
+  // concurrent heuristics and the separation tasks of the node processor.
+  for (UInt i = 0; i < concHeurs_.size(); ++i) {
+    pools[i] = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
+    if (solPool_->getBestSolution()) {
+      pools[i]->addSolution(solPool_->getBestSolution());
+    }
+  }
+#pragma omp parallel
+#pragma omp single
+  {
+    for (UInt i = 0; i < concHeurs_.size(); ++i) {
+#pragma omp task firstprivate(i)
+      concHeurs_[i]->solve(NodePtr(), RelaxationPtr(), pools[i]);
+    }
+    nodePrcssr0->processRootNode(current_node, rel, solPool_);
+  }
   ++stats_->nodesProc;
-  if (nodePrcssr0->foundNewSolution()) {
+  heur_sol = false;
+  for (UInt i = 0; i < concHeurs_.size(); ++i) {
+    if (pools[i]->getBestSolutionValue() <
+        solPool_->getBestSolutionValue()) {
+      solPool_->addSolution(pools[i]->getBestSolution());
+      heur_sol = true;
+    }
+    delete pools[i];
+  }
+  if (nodePrcssr0->foundNewSolution() || heur_sol) {
     tm_->setUb(solPool_->getBestSolutionValue());
   }
 
@@ -1775,6 +1808,10 @@ void ParQGBranchAndBound::writeStats(std::ostream &out)
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
     (*it)->writeStats(out);
   }
+  for (HeurVector::iterator it=concHeurs_.begin(); it!=concHeurs_.end();
+       ++it) {
+    (*it)->writeStats(out);
+  }
   solPool_->writeStats(out);
 }
 
@@ -1790,6 +1827,10 @@ void ParQGBranchAndBound::writeParStats(std::ostream &out, ParPCBProcessorPtr no
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
     (*it)->writeStats(out);
   }
+  for (HeurVector::iterator it=concHeurs_.begin(); it!=concHeurs_.end();
+       ++it) {
+    (*it)->writeStats(out);
+  }
   solPool_->writeStats(out);
 }
 
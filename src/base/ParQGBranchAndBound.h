@@ -65,6 +65,17 @@ namespace Minotaur {
      */
     void addPreRootHeur(HeurPtr h);
 
+    /**
+     * \brief Add a heuristic that is called while the root node is
+     * processed, on a thread that would otherwise be idle.
+     *
+     * \param [in] h The heuristic. Its solve() gets a NULL node and
+     * relaxation and a solution pool of its own, whose best solution is
+     * added to the pool of the solver after the root. It must not share any
+     * data with the relaxation or the handlers of thread 0.
+     */
+    void addConcHeur(HeurPtr h);
+
     /**
      * \brief Return the percentage gap between the lower and upper bounds. 
      * 
@@ -240,6 +251,9 @@ namespace Minotaur {
      */
     HeurVector preHeurs_;
 
+    /// Heuristics that are called while the root node is processed.
+    HeurVector concHeurs_;
+
     /// The Problem that is solved using branch-and-bound.
     ProblemPtr problem_;
 
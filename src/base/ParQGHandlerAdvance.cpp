@@ -516,8 +516,6 @@ void ParQGHandlerAdvance::objCutAtLpSol_(const double *lpx, CutManager * cutman,
     FunctionPtr f;
     LinearFunctionPtr lf;
     double c, lpvio, act;
-    ConstraintPtr newcon;
-    std::stringstream sstm;
     ObjectivePtr o = minlp_->getObjective();
 
     act = o->eval(lpx, &error);
@@ -546,12 +544,7 @@ void ParQGHandlerAdvance::objCutAtLpSol_(const double *lpx, CutManager * cutman,
               *status = SepaResolve;
               lf->addTerm(objVar_, -1.0);
               f = (FunctionPtr) new Function(lf);
-              sstm << "_qgObjCut_Thr_" << omp_get_thread_num() << "_" << stats_->cuts;
-              newcon = rel_->newConstraint(f, -INFINITY, -1.0*c, sstm.str());
-              CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
-                                            -1.0*c, false,false);
-              cut->setCons(newcon);
-              cutman->addCutToPool(cut);
+              cutman->addCut(rel_, f, -INFINITY, -1.0*c, true, false);
             } else {
               delete lf;
               lf = 0;
@@ -572,8 +565,6 @@ void ParQGHandlerAdvance::addCut_(const double *nlpx, const double *lpx,
                         SeparationStatus *status)
 {
   int error=0;
-  ConstraintPtr newcon;
-  std::stringstream sstm;
   double c, lpvio, act, cUb;
   FunctionPtr f = con->getFunction();
   LinearFunctionPtr lf = LinearFunctionPtr();
@@ -587,14 +578,9 @@ void ParQGHandlerAdvance::addCut_(const double *nlpx, const double *lpx,
       if ((lpvio>solAbsTol_) &&
           ((cUb-c)==0 || (lpvio>fabs(cUb-c)*solRelTol_))) {
         ++(stats_->cuts);
-        sstm << "_qgCut_Thr_" << omp_get_thread_num() << "_" << stats_->cuts;
         *status = SepaResolve;
         f = (FunctionPtr) new Function(lf);
-        newcon = rel_->newConstraint(f, -INFINITY, cUb-c, sstm.str());
-        CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
-                                      cUb-c, false,false);
-        cut->setCons(newcon);
-        cutman->addCutToPool(cut);
+        cutman->addCut(rel_, f, -INFINITY, cUb-c, true, false);
         return;
       } else {
         delete lf;
@@ -616,8 +602,6 @@ void ParQGHandlerAdvance::cutToObj_(const double *nlpx, const double *lpx,
     int error=0;
     FunctionPtr f;
     double c, vio, act;
-    ConstraintPtr newcon;
-    std::stringstream sstm;
     ObjectivePtr o = minlp_->getObjective();
 
     act = o->eval(lpx, &error);
@@ -635,15 +619,10 @@ void ParQGHandlerAdvance::cutToObj_(const double *nlpx, const double *lpx,
             if ((vio > solAbsTol_) && ((relobj_ - c == 0)
                                      || (vio > fabs(relobj_ - c)*solRelTol_))) {
               ++(stats_->cuts);
-              sstm << "_qgObjCut_Thr_" << omp_get_thread_num() << "_" << stats_->cuts;
               lf->addTerm(objVar_, -1.0);
               *status = SepaResolve;
               f = (FunctionPtr) new Function(lf);
-              newcon = rel_->newConstraint(f, -INFINITY, -1.0*c, sstm.str());
-              CutPtr cut = (CutPtr) new Cut(rel_->getNumVars(),f, -INFINITY,
-                                            -1.0*c, false,false);
-              cut->setCons(newcon);
-              cutman->addCutToPool(cut);
+              cutman->addCut(rel_, f, -INFINITY, -1.0*c, true, false);
             } else {
               delete lf;
               lf = 0;
@@ -1098,8 +1077,7 @@ void ParQGHandlerAdvance::genLin_(const double *x, std::vector<UInt > vioCons,
   FunctionPtr f;
   double c, cUb, act;
   LinearFunctionPtr lf;
-  std::stringstream sstm;
-  ConstraintPtr con, newcon;
+  ConstraintPtr con;
 
   for (UInt i = 0; i < vioCons.size(); ++i) {
     error = 0;
@@ -1113,13 +1091,7 @@ void ParQGHandlerAdvance::genLin_(const double *x, std::vector<UInt > vioCons,
         ++(stats_->cuts);
         cUb = con->getUb();
         f = (FunctionPtr) new Function(lf);
-        sstm << "_qgCut_Thr_" << omp_get_thread_num() << "_" << stats_->cuts;
-        newcon = rel_->newConstraint(f, -INFINITY, cUb-c, sstm.str());
-        CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
-                                      cUb-c, false,false);
-        cut->setCons(newcon);
-        cutman->addCutToPool(cut);
-        sstm.str("");
+        cutman->addCut(rel_, f, -INFINITY, cUb-c, true, false);
       } 
     }
   }
@@ -1353,8 +1325,6 @@ bool ParQGHandlerAdvance::isIntFeas_(const double* x)
 void ParQGHandlerAdvance::ECPTypeCut_(const double *lpx, CutManager *cutman, ConstraintPtr con, double act)
 {
   int error = 0;
-  std::stringstream sstm;
-  ConstraintPtr newcon;
   LinearFunctionPtr lf = 0;
   
   double c, cUb, lpvio;
@@ -1368,13 +1338,8 @@ void ParQGHandlerAdvance::ECPTypeCut_(const double *lpx, CutManager *cutman, Con
     if ((lpvio > solAbsTol_) && ((cUb-c)==0 ||
                              (lpvio>fabs(cUb-c)*solRelTol_))) {
       ++(stats_->cuts);
-      sstm << "_qgCut_Thr_" << omp_get_thread_num() << "_" << stats_->cuts;
       f = (FunctionPtr) new Function(lf);
-      newcon = rel_->newConstraint(f, -INFINITY, cUb-c, sstm.str());
-      CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
-                                    cUb-c, false,false);
-      cut->setCons(newcon);
-      cutman->addCutToPool(cut);
+      cutman->addCut(rel_, f, -INFINITY, cUb-c, true, false);
       return;
     } else {
       delete lf;
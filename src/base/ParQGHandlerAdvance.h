@@ -173,9 +173,16 @@ public:
 
   // Base class method. Check if x is feasible. x has to satisfy integrality
   // and also nonlinear constraints.
-  bool isFeasible(ConstSolutionPtr sol, RelaxationPtr relaxation, 
+  bool isFeasible(ConstSolutionPtr sol, RelaxationPtr relaxation,
                   bool & should_prune, double &inf_meas);
 
+  /**
+   * Base class method. separate() only changes its own problem and NLP
+   * engine, the node and the solution pool, and sends its cuts through the
+   * cut manager.
+   */
+  bool isSepThreadSafe() const { return true; };
+
   /// Does nothing.
   SolveStatus presolve(PreModQ *, bool *, Solution **) {return Finished;};
 
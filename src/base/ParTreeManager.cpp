@@ -42,6 +42,9 @@ ParTreeManager::ParTreeManager(EnvPtr env)
     searchType_ = BestFirst;
   } else if ("bthend"==s) {
     searchType_ = BestThenDive;
+  } else if ("bestest"==s) {
+    // plunging is done only by the serial TreeManager.
+    searchType_ = BestFirst;
   } else {
      assert (!"search strategy must be defined!");
   }
@@ -64,6 +64,9 @@ namespace Minotaur {
   /// Returns name of the handler.
   std::string getName() const;
 
+  /// separate() does nothing, so it can run with other handlers.
+  bool isSepThreadSafe() const { return true; };
+
     /// Does nothing.
   SolveStatus presolve(PreModQ *, bool *, Solution **sol) {return Finished;};
 
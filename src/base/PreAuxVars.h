@@ -36,6 +36,12 @@ public:
   /// Return the number of additions.
   UInt getSize();
 
+  /// Iterators for the new variables, in the order they were inserted.
+  std::deque<VariablePtr>::const_iterator varsBegin() const
+  { return vars_.begin(); };
+  std::deque<VariablePtr>::const_iterator varsEnd() const
+  { return vars_.end(); };
+
 private:
   std::deque<VariablePtr> vars_;
 
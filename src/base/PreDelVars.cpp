@@ -24,6 +24,10 @@ PreDelVars::PreDelVars()
 PreDelVars::~PreDelVars()
 {
   vars_.clear();
+  for (VarVector::iterator it=own_.begin(); it!=own_.end(); ++it) {
+    delete *it;
+  }
+  own_.clear();
 }
 
 
@@ -33,6 +37,14 @@ void PreDelVars::insert(VariablePtr v)
 }
 
 
+void PreDelVars::insert(UInt index, double val)
+{
+  VariablePtr v = new Variable(0, index, val, val, Continuous, "");
+  own_.push_back(v);
+  vars_.push_front(v);
+}
+
+
 void PreDelVars::postsolveGetX(const DoubleVector &x, DoubleVector *newx)
 {
   UInt n = x.size()+vars_.size();
@@ -30,10 +30,24 @@ namespace Minotaur {
       /// Add a new variable to the list.
       void insert(VariablePtr v);
 
+      /**
+       * Add a variable that had the given index and was fixed to val when
+       * it was deleted. Used when a saved problem is loaded (see Snapshot).
+       * The variable is created and owned by this object.
+       */
+      void insert(UInt index, double val);
+
       /// Restore x.
       void postsolveGetX(const DoubleVector &x, DoubleVector *newx);
 
+      /// Iterators for the deleted variables, last deleted first.
+      VarQueueConstIter varsBegin() const { return vars_.begin(); };
+      VarQueueConstIter varsEnd() const { return vars_.end(); };
+
     private:
+      /// Variables created by insert(index, val).
+      VarVector own_;
+
       /// A queue of variables deleted.
       VarQueue vars_;
 
@@ -10,6 +10,8 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <cmath>
+
 #include "MinotaurConfig.h"
 #include "PreSubstVars.h"
 
@@ -28,6 +30,10 @@ PreSubstVars::~PreSubstVars()
     delete (*it);
   }
   vars_.clear();
+  for (VarVector::iterator it=own_.begin(); it!=own_.end(); ++it) {
+    delete *it;
+  }
+  own_.clear();
 }
 
 
@@ -41,6 +47,17 @@ void PreSubstVars::insert(VariablePtr vout, VariablePtr vin, double rat)
 }
 
 
+void PreSubstVars::insert(UInt vout_ind, UInt vin_ind, double rat)
+{
+  PreSubstVarData *data = new PreSubstVarData();
+  data->vout = new Variable(0, vout_ind, -INFINITY, INFINITY, Continuous, "");
+  data->vinInd = vin_ind;
+  data->rat = rat;
+  own_.push_back(data->vout);
+  vars_.push_front(data);
+}
+
+
 void PreSubstVars::postsolveGetX(const DoubleVector &x, DoubleVector *newx)
 {
   // always called after PreDelVars::postsolveGetX(), so don't worry about
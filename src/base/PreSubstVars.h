@@ -36,6 +36,19 @@ public:
   /// Substitute variable 'vin' by variable 'vout'.
   void insert(VariablePtr vout, VariablePtr vin, double rat = 1.0);
 
+  /**
+   * Add a substitution by indices of the variables. Used when a saved
+   * problem is loaded (see Snapshot). A variable with index vout_ind is
+   * created and owned by this object.
+   */
+  void insert(UInt vout_ind, UInt vin_ind, double rat);
+
+  /// Iterators for the substitutions, last one first.
+  std::deque<PreSubstVarData*>::const_iterator begin() const
+  { return vars_.begin(); };
+  std::deque<PreSubstVarData*>::const_iterator end() const
+  { return vars_.end(); };
+
   /// Restore x.
   void postsolveGetX(const DoubleVector &x, DoubleVector *newx);
 
@@ -43,6 +56,9 @@ public:
   UInt getSize();
 
 private:
+  /// Variables created by insert(vout_ind, vin_ind, rat).
+  VarVector own_;
+
   std::deque<PreSubstVarData*> vars_;
 
 };
@@ -8,6 +8,7 @@
  * \brief Define Presolver class for presolving.
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
+#include <algorithm>
 #include <iomanip>
 #include <cmath>
 
@@ -25,6 +26,7 @@
 #include "Presolver.h"
 #include "Problem.h"
 #include "Solution.h"
+#include "Timer.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -32,24 +34,28 @@ using namespace Minotaur;
 const std::string Presolver::me_ = "Presolver: ";
 
 Presolver::Presolver ()
- : env_(0),
+ : allStamp_(0),
+   env_(0),
    eTol_(1e-8),
    handlers_(0),
    intTol_(1e-6),
    logger_(0),
    problem_(ProblemPtr()),
    sol_(0),
+   stamp_(0),
    status_(NotStarted)
 {
 }
 
 
 Presolver::Presolver(ProblemPtr problem, EnvPtr env, HandlerVector handlers)
-  : eTol_(1e-8),
+  : allStamp_(0),
+    eTol_(1e-8),
     handlers_(handlers),
     intTol_(1e-6),
     problem_(problem),
     sol_(0),
+    stamp_(0),
     status_(NotStarted)
 {
   env_ = env;
@@ -91,31 +97,101 @@ void Presolver::standardize()
 SolveStatus Presolver::solve()
 {
   SolveStatus h_status;
-  bool changed = true;
+  bool changed;
+  bool rchanged = true;
   bool stop = false;
+  bool all;
   status_ = Started;
   int iters = 0;
-  int subiters = 0;
-  int n_hand = handlers_.size();
-  int last_ch_subiter = -10000;
-
+  UInt n_hand = handlers_.size();
+  UInt reds;
+  UIntVector order(n_hand), last(n_hand, 0);
+  VarSet dvars;
+  ConstrSet dcons;
+  double tbudget = env_->getOptions()->findDouble("presolve_handler_time")->
+    getValue();
+  Timer *timer = env_->getNewTimer();
+  double t;
+  HandlerPtr h;
 
   env_->getLogger()->msgStream(LogInfo) << me_ << "Presolving ... "
     << std::endl;
-  // call all handlers.
-  while (true==changed && false==stop && iters<5) {
+  hStats_.assign(n_hand, PresHandStats());
+  for (UInt i=0; i<n_hand; ++i) {
+    order[i] = i;
+    hStats_[i].calls = hStats_[i].skips = hStats_[i].reds = 0;
+    hStats_[i].time = 0.0;
+  }
+  stamp_ = 0;
+  allStamp_ = 0;
+  vRec_.clear();
+  cRec_.clear();
+  findChanges_();
+
+  // call handlers in rounds.
+  while (true==rchanged && false==stop && iters<5) {
     logger_->msgStream(LogDebug) << me_ << "major iteration " << iters << std::endl;
-    for (HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+    rchanged = false;
+    if (iters>0) {
+      // most reductions per second first. Handlers that have not reduced
+      // anything yet, including those never called, go to the back in their
+      // old order.
+      std::stable_sort(order.begin(), order.end(),
+                       [this](UInt a, UInt b) {
+                         return hStats_[a].reds/std::max(hStats_[a].time, 1e-4)
+                           > hStats_[b].reds/std::max(hStats_[b].time, 1e-4);
+                       });
+    }
+    for (UIntVector::iterator it = order.begin(); it != order.end(); ++it) {
+      PresHandStats &hs = hStats_[*it];
+      h = handlers_[*it];
+      if (tbudget>0 && hs.time>tbudget) {
+        ++hs.skips;
+        continue;
+      }
+      all = (0 == hs.calls) || getDirty_(last[*it], dvars, dcons);
+      if (false == all && dvars.empty() && dcons.empty()) {
+        ++hs.skips;
+        continue;
+      }
+      h->setPresolveDirty(all, dvars, dcons);
+      dvars.clear();
+      dcons.clear();
+
+      // the handler must see its own reductions in later rounds, so it is
+      // clean only up to the stamp before its call.
+      last[*it] = stamp_;
       changed = false;
-      h_status = (*h)->presolve(&mods_, &changed, &sol_);
+      timer->start();
+      h_status = h->presolve(&mods_, &changed, &sol_);
+      t = timer->query();
+      timer->stop();
+      ++stamp_;
+      reds = findChanges_();
+      if (true==changed) {
+        // the handler may also have changed what we cannot see, e.g.
+        // coefficients, even if some bounds changed too. Others must look at
+        // everything again.
+        allStamp_ = stamp_;
+        if (0==reds) {
+          reds = 1;
+        }
+      }
+      ++hs.calls;
+      hs.time += t;
+      hs.reds += reds;
+      if (reds>0) {
+        rchanged = true;
+      }
+
       if (h_status == SolvedOptimal) {
-        logger_->msgStream(LogDebug) << me_ << "handler " << (*h)->getName()
+        logger_->msgStream(LogDebug) << me_ << "handler " << h->getName()
                                      << " found an optimal solution "
                                      << std::endl;
         status_ = SolvedOptimal;
         stop = true;
         if (!sol_) {
-          logger_->errStream() << me_ << " but " << (*h)->getName()
+          logger_->errStream() << me_ << " but " << h->getName()
                                       << " did not return a solution"
                                       << std::endl;
           status_ = SolveError;
@@ -126,17 +202,10 @@ SolveStatus Presolver::solve()
         stop = true;
         break;
       }
-      if (changed) {
-        last_ch_subiter = subiters;
-      }
-      if (subiters>n_hand-2 && subiters-last_ch_subiter>n_hand-2) {
-        stop = true;
-        break;
-      }
-      ++subiters;
     }
     ++iters;
   }
+  delete timer;
    if (Started == status_) {
     status_ = Finished;
   }
@@ -156,6 +225,9 @@ SolveStatus Presolver::solve()
        ++it) {
     (*it)->writeStats(logger_->msgStream(LogExtraInfo));
   }
+  writeHandStats_(logger_->msgStream(LogExtraInfo));
+  vRec_.clear();
+  cRec_.clear();
   problem_->calculateSize(true);
 
   logger_->msgStream(LogDebug) << me_ << "Modifying debug solution."
@@ -185,6 +257,132 @@ SolveStatus Presolver::solve()
 }
 
 
+UInt Presolver::findChanges_()
+{
+  UInt changes = 0;
+  UInt seen = 0;
+  VariablePtr v;
+  ConstraintPtr c;
+  std::unordered_map<UInt, PresRec>::iterator rit;
+  PresRec rec;
+
+  // seen is the same for all records touched in this scan.
+  seen = stamp_ + 1;
+  rec.seen = seen;
+  rec.stamp = stamp_;
+  for (VariableConstIterator it=problem_->varsBegin();
+       it!=problem_->varsEnd(); ++it) {
+    v = *it;
+    rit = vRec_.find(v->getId());
+    if (rit == vRec_.end()) {
+      rec.lb = v->getLb();
+      rec.ub = v->getUb();
+      rec.n = v->getNumCons();
+      rec.type = v->getType();
+      vRec_[v->getId()] = rec;
+      ++changes;
+    } else {
+      PresRec &r = rit->second;
+      r.seen = seen;
+      if (r.lb != v->getLb() || r.ub != v->getUb() ||
+          r.n != v->getNumCons() || r.type != v->getType()) {
+        r.lb = v->getLb();
+        r.ub = v->getUb();
+        r.n = v->getNumCons();
+        r.type = v->getType();
+        r.stamp = stamp_;
+        ++changes;
+      }
+    }
+  }
+  for (ConstraintConstIterator it=problem_->consBegin();
+       it!=problem_->consEnd(); ++it) {
+    c = *it;
+    rit = cRec_.find(c->getId());
+    if (rit == cRec_.end()) {
+      rec.lb = c->getLb();
+      rec.ub = c->getUb();
+      rec.n = c->getFunction() ? c->getFunction()->getNumVars() : 0;
+      rec.type = 0;
+      cRec_[c->getId()] = rec;
+      ++changes;
+    } else {
+      PresRec &r = rit->second;
+      UInt n = c->getFunction() ? c->getFunction()->getNumVars() : 0;
+      r.seen = seen;
+      if (r.lb != c->getLb() || r.ub != c->getUb() || r.n != n) {
+        r.lb = c->getLb();
+        r.ub = c->getUb();
+        r.n = n;
+        r.stamp = stamp_;
+        ++changes;
+      }
+    }
+  }
+
+  // deleted ones. Their neighbours have changed sizes and are caught above.
+  if (vRec_.size() > problem_->getNumVars()) {
+    for (rit=vRec_.begin(); rit!=vRec_.end(); ) {
+      if (rit->second.seen != seen) {
+        rit = vRec_.erase(rit);
+        ++changes;
+      } else {
+        ++rit;
+      }
+    }
+  }
+  if (cRec_.size() > problem_->getNumCons()) {
+    for (rit=cRec_.begin(); rit!=cRec_.end(); ) {
+      if (rit->second.seen != seen) {
+        rit = cRec_.erase(rit);
+        ++changes;
+      } else {
+        ++rit;
+      }
+    }
+  }
+  return (0 == stamp_) ? 0 : changes;
+}
+
+
+bool Presolver::getDirty_(UInt since, VarSet &vars, ConstrSet &cons)
+{
+  std::unordered_map<UInt, PresRec>::iterator rit;
+
+  if (allStamp_ > since) {
+    return true;
+  }
+  for (VariableConstIterator it=problem_->varsBegin();
+       it!=problem_->varsEnd(); ++it) {
+    rit = vRec_.find((*it)->getId());
+    if (rit != vRec_.end() && rit->second.stamp > since) {
+      vars.insert(*it);
+    }
+  }
+  for (ConstraintConstIterator it=problem_->consBegin();
+       it!=problem_->consEnd(); ++it) {
+    rit = cRec_.find((*it)->getId());
+    if (rit != cRec_.end() && rit->second.stamp > since) {
+      cons.insert(*it);
+    }
+  }
+  return false;
+}
+
+
+void Presolver::writeHandStats_(std::ostream &out) const
+{
+  for (UInt i=0; i<hStats_.size(); ++i) {
+    out << me_ << handlers_[i]->getName()
+        << ": calls = " << hStats_[i].calls
+        << ", skipped = " << hStats_[i].skips
+        << ", reductions = " << hStats_[i].reds
+        << ", time (s) = " << std::fixed << std::setprecision(2)
+        << hStats_[i].time << std::endl;
+  }
+}
+
+
 void Presolver::removeEmptyObj_()
 {
   ObjectivePtr oPtr = problem_->getObjective();
@@ -288,6 +486,12 @@ void Presolver::getX(const double *x, DoubleVector *newx)
 }
 
 
+void Presolver::addMods(const PreModQ &mods)
+{
+  mods_.insert(mods_.end(), mods.begin(), mods.end());
+}
+
+
 SolutionPtr Presolver::getPostSol(SolutionPtr s)
 {
   DoubleVector  *newx = 0;
@@ -12,6 +12,8 @@
 #ifndef MINOTAURPRESOLVER_H
 #define MINOTAURPRESOLVER_H
 
+#include <unordered_map>
+
 #include "Types.h"
 
 namespace Minotaur {
@@ -25,6 +27,14 @@ namespace Minotaur {
   typedef PreModQ::reverse_iterator PreModQRIter;
   typedef PreModQ::const_iterator PreModQConstIter;
 
+  /// Statistics of one handler in Presolver::solve().
+  struct PresHandStats {
+    UInt calls;   /// Number of calls to presolve() of the handler.
+    UInt skips;   /// Calls skipped because nothing changed since last call.
+    UInt reds;    /// Changes in bounds, types and sizes made in its calls.
+    double time;  /// Time spent in presolve() of the handler.
+  };
+
    /**
     * A Presolver is used to modify a problem such that it becomes simplified
     * or easier to solve. A Presolver, in its default form, will create a copy
@@ -64,6 +74,16 @@ namespace Minotaur {
      */
     virtual void standardize();
 
+    /**
+     * Call presolve() of handlers in rounds, until a round makes no change
+     * or five rounds are done. Before each call, the handler is told which
+     * variables and constraints changed since its previous call, and a
+     * handler is skipped if nothing changed. In each round after the first,
+     * handlers that made more reductions per second in the past are called
+     * first. A handler whose total time exceeds the option
+     * presolve_handler_time is not called again. The budget is checked
+     * only before a call, so a handler may overrun it by its last call.
+     */
     virtual SolveStatus solve();
 
     /// Search and remove any duplicate rows and columns from the problem.
@@ -81,7 +101,32 @@ namespace Minotaur {
      */
     SolutionPtr getPostSol(SolutionPtr s);
 
+    /// Return the modifications that are undone in post-solve.
+    const PreModQ & getMods() const { return mods_; };
+
+    /**
+     * Append modifications that are undone in post-solve, e.g. those of a
+     * saved problem that is loaded. They are owned by the presolver after
+     * this call.
+     */
+    void addMods(const PreModQ &mods);
+
   protected:
+    /// Bounds and sizes of a variable or constraint when last seen.
+    struct PresRec {
+      double lb;
+      double ub;
+      UInt n;      /// Number of constraints or variables.
+      int type;    /// Type of variable.
+      UInt seen;   /// Counter of the scan in which it was last seen.
+      UInt stamp;  /// Counter of the handler call that last changed it.
+    };
+
+    /// Counter of handler calls after which all of the problem is dirty.
+    UInt allStamp_;
+
+    /// Records of constraints, keyed by their ids.
+    std::unordered_map<UInt, PresRec> cRec_;
 
     /// Environment.
     EnvPtr env_;
@@ -113,12 +158,38 @@ namespace Minotaur {
     /// Pointer to optimal solution, if one found
     SolutionPtr sol_;
 
+    /// Statistics of each handler, in the order of handlers_.
+    std::vector<PresHandStats> hStats_;
+
+    /// Counter of handler calls in solve().
+    UInt stamp_;
+
     /// Status.
     SolveStatus status_;
 
+    /// Records of variables, keyed by their ids.
+    std::unordered_map<UInt, PresRec> vRec_;
+
+    /**
+     * Find variables and constraints that were added, deleted or changed
+     * since the last call, and record the current stamp_ in them. Return
+     * the number of changes found.
+     */
+    UInt findChanges_();
+
+    /**
+     * Fill vars and cons with variables and constraints changed after the
+     * given stamp. Return true if the whole problem should be treated as
+     * changed.
+     */
+    bool getDirty_(UInt since, VarSet &vars, ConstrSet &cons);
+
     /// Remove objective function, if it is zero or constant.
     void removeEmptyObj_();
 
+    /// Write time, calls and reductions of each handler.
+    void writeHandStats_(std::ostream &out) const;
+
     /// convert to minimization problem.
     void minimizify_();
 
@@ -0,0 +1,574 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Prober.cpp
+ * \brief Define the Prober class that fixes each binary variable to zero
+ * and one in turn and propagates the bounds.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "ImplGraph.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "NonlinearFunction.h"
+#include "Option.h"
+#include "Problem.h"
+#include "Prober.h"
+#include "QuadraticFunction.h"
+#include "Timer.h"
+#include "Variable.h"
+
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace Minotaur;
+
+const std::string Prober::me_ = "Prober: ";
+
+Prober::Prober(EnvPtr env, ProblemPtr p)
+  : batchSize_(64),
+    env_(env),
+    eTol_(1e-6),
+    graph_(0),
+    p_(p),
+    propLimit_(10000)
+{
+  stats_.probes = 0;
+  stats_.fixed = 0;
+  stats_.tightened = 0;
+  stats_.impls = 0;
+  stats_.cliques = 0;
+  stats_.time = 0.0;
+}
+
+
+Prober::~Prober()
+{
+  if (graph_) {
+    delete graph_;
+  }
+  cols_.clear();
+  rows_.clear();
+}
+
+
+bool Prober::apply_(UInt j, const ProbeRes *res, UIntVector &changed)
+{
+  std::vector<BndChg>::const_iterator it0, it1;
+  UInt k;
+
+  if (res[0].inf && res[1].inf) {
+    return true;
+  }
+
+  if (res[0].inf || res[1].inf) {
+    // the other value holds, and so does everything it implies.
+    const ProbeRes &r = res[res[0].inf ? 1 : 0];
+    double val = res[0].inf ? 1.0 : 0.0;
+
+    if (tighten_(j, val, val)) {
+      changed.push_back(j);
+      ++stats_.fixed;
+    }
+    for (it0 = r.chgs.begin(); it0 != r.chgs.end(); ++it0) {
+      if (tighten_(it0->var, it0->lb, it0->ub)) {
+        changed.push_back(it0->var);
+      }
+    }
+    for (UIntVector::const_iterator it = changed.begin(); it != changed.end();
+         ++it) {
+      if (lb_[*it] > ub_[*it] + eTol_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  for (UInt v = 0; v < 2; ++v) {
+    for (it0 = res[v].chgs.begin(); it0 != res[v].chgs.end(); ++it0) {
+      k = it0->var;
+      if (isBin_[k] && it0->ub - it0->lb < eTol_ && ub_[k] - lb_[k] > eTol_) {
+        graph_->addImpl(j, (1 == v), k, (it0->lb > 0.5));
+      }
+    }
+  }
+
+  // a bound implied by both values is valid. Both lists are sorted.
+  it0 = res[0].chgs.begin();
+  it1 = res[1].chgs.begin();
+  while (it0 != res[0].chgs.end() && it1 != res[1].chgs.end()) {
+    if (it0->var < it1->var) {
+      ++it0;
+    } else if (it1->var < it0->var) {
+      ++it1;
+    } else {
+      if (tighten_(it0->var, std::min(it0->lb, it1->lb),
+                   std::max(it0->ub, it1->ub))) {
+        changed.push_back(it0->var);
+        ++stats_.tightened;
+      }
+      ++it0;
+      ++it1;
+    }
+  }
+  return false;
+}
+
+
+void Prober::findCliques_()
+{
+  std::vector<std::pair<double, UInt> > wlits;
+  UIntVector lits;
+  double rhs, a, sign;
+  UInt m;
+  bool all_bin;
+
+  for (std::vector<Row>::const_iterator r = rows_.begin(); r != rows_.end();
+       ++r) {
+    if (r->terms.size() < 2) {
+      continue;
+    }
+    all_bin = true;
+    for (UInt i = 0; i < r->terms.size() && all_bin; ++i) {
+      all_bin = isBin_[r->terms[i].first];
+    }
+    if (!all_bin) {
+      continue;
+    }
+
+    // write each side as sum w_i y_i <= rhs, with w_i > 0 and y_i a
+    // variable or its complement.
+    for (UInt side = 0; side < 2; ++side) {
+      sign = (0 == side) ? 1.0 : -1.0;
+      rhs = (0 == side) ? r->ub : -r->lb;
+      if (rhs >= INFINITY) {
+        continue;
+      }
+      wlits.clear();
+      for (UInt i = 0; i < r->terms.size(); ++i) {
+        a = sign*r->terms[i].second;
+        if (a > 0) {
+          wlits.push_back(std::make_pair(a, ImplGraph::lit(r->terms[i].first,
+                                                           true)));
+        } else if (a < 0) {
+          rhs -= a;
+          wlits.push_back(std::make_pair(-a, ImplGraph::lit(r->terms[i].first,
+                                                            false)));
+        }
+      }
+      if (wlits.size() < 2 || rhs < 0) {
+        continue;
+      }
+
+      // the literals with the largest weights, any two of which exceed rhs.
+      std::sort(wlits.begin(), wlits.end(),
+                std::greater<std::pair<double, UInt> >());
+      m = 1;
+      while (m < wlits.size() &&
+             wlits[m-1].first + wlits[m].first > rhs + eTol_) {
+        ++m;
+      }
+      if (m >= 2 && wlits[0].first <= rhs + eTol_) {
+        lits.clear();
+        for (UInt i = 0; i < m; ++i) {
+          lits.push_back(wlits[i].second);
+        }
+        graph_->addClique(lits);
+      }
+    }
+  }
+  stats_.cliques = graph_->getNumCliques();
+}
+
+
+void Prober::probe_(UInt j, double val, Scratch &s, ProbeRes &res) const
+{
+  BndChg chg;
+  UInt q = 0;
+
+  res.inf = false;
+  res.chgs.clear();
+  s.queue.clear();
+  s.tlist.clear();
+
+  if (!setBnd_(j, val, val, s)) {
+    res.inf = true;
+  }
+  for (; q < s.queue.size() && q < propLimit_ && !res.inf; ++q) {
+    s.inQ[s.queue[q]] = 0;
+    if (!propRow_(s.queue[q], s)) {
+      res.inf = true;
+    }
+  }
+  for (; q < s.queue.size(); ++q) {
+    s.inQ[s.queue[q]] = 0;
+  }
+
+  // record the bounds and restore them.
+  std::sort(s.tlist.begin(), s.tlist.end());
+  for (UIntVector::const_iterator it = s.tlist.begin(); it != s.tlist.end();
+       ++it) {
+    if (!res.inf && *it != j) {
+      chg.var = *it;
+      chg.lb = s.lb[*it];
+      chg.ub = s.ub[*it];
+      res.chgs.push_back(chg);
+    }
+    s.lb[*it] = lb_[*it];
+    s.ub[*it] = ub_[*it];
+    s.touched[*it] = 0;
+  }
+}
+
+
+bool Prober::propRow_(UInt r, Scratch &s) const
+{
+  const Row &row = rows_[r];
+  double minact = 0.0, maxact = 0.0;
+  double lo, hi, a, nl, nu;
+  UInt nminf = 0, nmaxf = 0, k;
+
+  for (UInt i = 0; i < row.terms.size(); ++i) {
+    k = row.terms[i].first;
+    a = row.terms[i].second;
+    lo = (a > 0) ? a*s.lb[k] : a*s.ub[k];
+    hi = (a > 0) ? a*s.ub[k] : a*s.lb[k];
+    if (lo <= -INFINITY) {
+      ++nminf;
+    } else {
+      minact += lo;
+    }
+    if (hi >= INFINITY) {
+      ++nmaxf;
+    } else {
+      maxact += hi;
+    }
+  }
+
+  if (0 == nminf && minact > row.ub + eTol_*std::max(1.0, fabs(row.ub))) {
+    return false;
+  }
+  if (0 == nmaxf && maxact < row.lb - eTol_*std::max(1.0, fabs(row.lb))) {
+    return false;
+  }
+  if (nminf > 1 && nmaxf > 1) {
+    return true;
+  }
+
+  for (UInt i = 0; i < row.terms.size(); ++i) {
+    k = row.terms[i].first;
+    a = row.terms[i].second;
+    lo = (a > 0) ? a*s.lb[k] : a*s.ub[k];
+    hi = (a > 0) ? a*s.ub[k] : a*s.lb[k];
+    nl = -INFINITY;
+    nu = INFINITY;
+
+    // a*x <= ub - (least activity of the other terms).
+    if (row.ub < INFINITY && (0 == nminf || (1 == nminf && lo <= -INFINITY))) {
+      if (a > 0) {
+        nu = (row.ub - (0 == nminf ? minact - lo : minact))/a;
+      } else {
+        nl = (row.ub - (0 == nminf ? minact - lo : minact))/a;
+      }
+    }
+    // a*x >= lb - (largest activity of the other terms).
+    if (row.lb > -INFINITY && (0 == nmaxf || (1 == nmaxf && hi >= INFINITY))) {
+      if (a > 0) {
+        nl = (row.lb - (0 == nmaxf ? maxact - hi : maxact))/a;
+      } else {
+        nu = (row.lb - (0 == nmaxf ? maxact - hi : maxact))/a;
+      }
+    }
+
+    if (isInt_[k]) {
+      nl = ceil(nl - eTol_);
+      nu = floor(nu + eTol_);
+    } else {
+      // ignore small changes of continuous variables, so that propagation
+      // does not go on and on.
+      if (s.lb[k] > -INFINITY &&
+          nl < s.lb[k] + 1e-3*std::max(1.0, fabs(s.lb[k]))) {
+        nl = -INFINITY;
+      }
+      if (s.ub[k] < INFINITY &&
+          nu > s.ub[k] - 1e-3*std::max(1.0, fabs(s.ub[k]))) {
+        nu = INFINITY;
+      }
+    }
+    if ((nl > s.lb[k] || nu < s.ub[k]) && !setBnd_(k, nl, nu, s)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool Prober::setBnd_(UInt k, double lb, double ub, Scratch &s) const
+{
+  if (lb > s.ub[k] + eTol_*std::max(1.0, fabs(s.ub[k])) ||
+      ub < s.lb[k] - eTol_*std::max(1.0, fabs(s.lb[k]))) {
+    return false;
+  }
+  lb = std::max(lb, s.lb[k]);
+  ub = std::min(ub, s.ub[k]);
+  if (lb > ub) {
+    lb = ub = (lb > s.ub[k]) ? s.ub[k] : s.lb[k];
+  }
+  if (lb <= s.lb[k] && ub >= s.ub[k]) {
+    return true;
+  }
+  s.lb[k] = lb;
+  s.ub[k] = ub;
+  if (!s.touched[k]) {
+    s.touched[k] = 1;
+    s.tlist.push_back(k);
+  }
+  for (UIntVector::const_iterator it = cols_[k].begin(); it != cols_[k].end();
+       ++it) {
+    if (!s.inQ[*it]) {
+      s.inQ[*it] = 1;
+      s.queue.push_back(*it);
+    }
+  }
+  return true;
+}
+
+
+void Prober::setupRows_()
+{
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+  QuadraticFunctionPtr qf;
+  NonlinearFunctionPtr nlf;
+  double l, u, l2, u2;
+  int err;
+
+  cols_.assign(p_->getNumVars(), UIntVector());
+  rows_.clear();
+  for (ConstraintConstIterator it = p_->consBegin(); it != p_->consEnd();
+       ++it) {
+    c = *it;
+    lf = c->getLinearFunction();
+    qf = c->getQuadraticFunction();
+    nlf = c->getNonlinearFunction();
+    if (!lf || 0 == lf->getNumTerms()) {
+      continue;
+    }
+
+    // range of the quadratic and nonlinear parts at the bounds.
+    l = u = 0.0;
+    err = 0;
+    if (qf) {
+      qf->computeBounds(&l2, &u2);
+      l += l2;
+      u += u2;
+    }
+    if (nlf) {
+      nlf->computeBounds(&l2, &u2, &err);
+      if (err) {
+        continue;
+      }
+      l += l2;
+      u += u2;
+    }
+    if (std::isnan(l)) {
+      l = -INFINITY;
+    }
+    if (std::isnan(u)) {
+      u = INFINITY;
+    }
+
+    Row row;
+    row.lb = (c->getLb() <= -INFINITY || u >= INFINITY) ? -INFINITY
+                                                         : c->getLb() - u;
+    row.ub = (c->getUb() >= INFINITY || l <= -INFINITY) ? INFINITY
+                                                        : c->getUb() - l;
+    if (row.lb <= -INFINITY && row.ub >= INFINITY) {
+      continue;
+    }
+    for (VariableGroupConstIterator t = lf->termsBegin(); t != lf->termsEnd();
+         ++t) {
+      row.terms.push_back(std::make_pair(t->first->getIndex(), t->second));
+      cols_[t->first->getIndex()].push_back(rows_.size());
+    }
+    rows_.push_back(row);
+  }
+}
+
+
+SolveStatus Prober::solve()
+{
+  Timer *timer = env_->getNewTimer();
+  double tlimit = env_->getOptions()->findDouble("probe_time")->getValue();
+  int threads = env_->getOptions()->findInt("threads")->getValue();
+  UInt n = p_->getNumVars();
+  UInt batch, b, e;
+  UIntVector order, changed;
+  std::vector<Scratch> scr;
+  std::vector<ProbeRes> res;
+  std::vector<char> probed;
+  SolveStatus status = Finished;
+  VariablePtr v;
+
+  timer->start();
+  threads = std::max(threads, 1);
+  if (graph_) {
+    delete graph_;
+  }
+  graph_ = new ImplGraph(n);
+  lb_.resize(n);
+  ub_.resize(n);
+  isBin_.assign(n, 0);
+  isInt_.assign(n, 0);
+  for (VariableConstIterator it = p_->varsBegin(); it != p_->varsEnd(); ++it) {
+    v = *it;
+    lb_[v->getIndex()] = v->getLb();
+    ub_[v->getIndex()] = v->getUb();
+    if (v->getType() == Binary || v->getType() == Integer ||
+        v->getType() == ImplBin || v->getType() == ImplInt) {
+      isInt_[v->getIndex()] = 1;
+      if (v->getLb() > -eTol_ && v->getUb() < 1.0 + eTol_) {
+        isBin_[v->getIndex()] = 1;
+      }
+    }
+  }
+  setupRows_();
+  findCliques_();
+
+  for (UInt j = 0; j < n; ++j) {
+    if (isBin_[j] && ub_[j] - lb_[j] > eTol_ && !cols_[j].empty()) {
+      order.push_back(j);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [this](UInt a, UInt c) {
+    return cols_[a].size() > cols_[c].size();
+  });
+
+  scr.resize(threads);
+  for (std::vector<Scratch>::iterator s = scr.begin(); s != scr.end(); ++s) {
+    s->lb = lb_;
+    s->ub = ub_;
+    s->inQ.assign(rows_.size(), 0);
+    s->touched.assign(n, 0);
+  }
+  batch = batchSize_;
+  res.resize(2*batch);
+  probed.resize(batch);
+
+  for (b = 0; b < order.size() && Finished == status; b += batch) {
+    if (tlimit > 0 && timer->query() > tlimit) {
+      env_->getLogger()->msgStream(LogInfo)
+          << me_ << "time limit reached after probing " << b << " of "
+          << order.size() << " variables" << std::endl;
+      break;
+    }
+    e = std::min((UInt) order.size(), b + batch);
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+    for (UInt k = b; k < e; ++k) {
+#if USE_OPENMP
+      Scratch &s = scr[omp_get_thread_num()];
+#else
+      Scratch &s = scr[0];
+#endif
+      UInt j = order[k];
+
+      // lb_ and ub_ are changed only between batches.
+      probed[k-b] = (ub_[j] - lb_[j] > eTol_);
+      if (probed[k-b]) {
+        probe_(j, 0.0, s, res[2*(k-b)]);
+        probe_(j, 1.0, s, res[2*(k-b)+1]);
+      }
+    }
+
+    changed.clear();
+    for (UInt k = b; k < e; ++k) {
+      if (!probed[k-b]) {
+        continue;
+      }
+      ++stats_.probes;
+      if (apply_(order[k], &res[2*(k-b)], changed)) {
+        env_->getLogger()->msgStream(LogInfo)
+            << me_ << "both values of "
+            << p_->getVariable(order[k])->getName() << " are infeasible"
+            << std::endl;
+        status = SolvedInfeasible;
+        break;
+      }
+    }
+    for (std::vector<Scratch>::iterator s = scr.begin(); s != scr.end();
+         ++s) {
+      for (UIntVector::const_iterator it = changed.begin();
+           it != changed.end(); ++it) {
+        s->lb[*it] = lb_[*it];
+        s->ub[*it] = ub_[*it];
+      }
+    }
+  }
+  graph_->finalize();
+  stats_.impls = graph_->getNumImpls();
+
+  if (Finished == status) {
+    for (VariableConstIterator it = p_->varsBegin(); it != p_->varsEnd();
+         ++it) {
+      v = *it;
+      if (lb_[v->getIndex()] > v->getLb() || ub_[v->getIndex()] < v->getUb()) {
+        p_->changeBound(v, std::max(lb_[v->getIndex()], v->getLb()),
+                        std::min(ub_[v->getIndex()], v->getUb()));
+      }
+    }
+  }
+
+  stats_.time = timer->query();
+  delete timer;
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << "probed " << stats_.probes << " variables, fixed "
+      << stats_.fixed << ", implications " << stats_.impls << ", cliques "
+      << stats_.cliques << std::endl;
+  return status;
+}
+
+
+bool Prober::tighten_(UInt k, double lb, double ub)
+{
+  bool changed = false;
+
+  if (lb > lb_[k]) {
+    lb_[k] = lb;
+    changed = true;
+  }
+  if (ub < ub_[k]) {
+    ub_[k] = ub;
+    changed = true;
+  }
+  if (changed && lb_[k] > ub_[k] && lb_[k] <= ub_[k] + eTol_) {
+    lb_[k] = ub_[k];
+  }
+  return changed;
+}
+
+
+void Prober::writeStats(std::ostream &out) const
+{
+  out << me_ << "variables probed = " << stats_.probes << std::endl
+      << me_ << "variables fixed = " << stats_.fixed << std::endl
+      << me_ << "bounds tightened = " << stats_.tightened << std::endl
+      << me_ << "implications = " << stats_.impls << std::endl
+      << me_ << "cliques = " << stats_.cliques << std::endl
+      << me_ << "time used (s) = " << std::fixed << std::setprecision(2)
+      << stats_.time << std::endl;
+}
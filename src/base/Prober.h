@@ -0,0 +1,201 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Prober.h
+ * \brief Declare the Prober class that fixes each binary variable to zero
+ * and one in turn and propagates the bounds.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROBER_H
+#define MINOTAURPROBER_H
+
+#include "Types.h"
+
+// Unit test, which checks the private methods.
+class ProberUT;
+
+namespace Minotaur {
+
+  class ImplGraph;
+
+  /// Statistics of probing.
+  struct ProbeStats {
+    UInt probes;     /// Binary variables probed.
+    UInt fixed;      /// Binary variables fixed, since a value was infeasible.
+    UInt tightened;  /// Bounds tightened, since both values imply them.
+    UInt impls;      /// Implications among binary variables.
+    UInt cliques;    /// Cliques found in constraints.
+    double time;     /// Time spent in probing.
+  };
+
+  /**
+   * \brief Probe binary variables of a problem and record what is learnt in
+   * an ImplGraph.
+   *
+   * Each binary variable is fixed to zero and then to one, and the bounds
+   * are propagated through the constraints. If one value makes the problem
+   * infeasible, the variable is fixed to the other value. If both values
+   * imply a bound on another variable, the weaker of the two is valid and
+   * the bound is tightened. Binary variables fixed by one value give
+   * implications. Constraints in which any two binary variables (or their
+   * complements) can not both be one give cliques.
+   *
+   * Bounds are propagated through the linear part of each constraint. The
+   * quadratic and nonlinear parts are replaced by their range at the bounds
+   * before probing, so that nonlinear constraints also tighten the bounds of
+   * their linear variables. Probes read only the bounds kept by the Prober,
+   * so they run in parallel, in batches of fixed size, in as many threads
+   * as the option "threads". What is found in a batch is applied after the
+   * batch, in the order of the variables, so that the result does not
+   * depend on the number of threads. Variables that appear in more
+   * constraints are probed first, and probing stops after "probe_time"
+   * seconds. The implications and cliques are propagated at each node by
+   * ImplHandler.
+   */
+  class Prober {
+    friend class ::ProberUT;
+
+  public:
+    /// Constructor for a given problem.
+    Prober(EnvPtr env, ProblemPtr p);
+
+    /// Destroy.
+    ~Prober();
+
+    /// Return the graph of implications and cliques. It is owned by Prober.
+    ImplGraph *getGraph() const { return graph_; };
+
+    /**
+     * \brief Probe and change the bounds of the problem.
+     *
+     * \returns SolvedInfeasible if both values of a variable are infeasible,
+     * otherwise Finished.
+     */
+    SolveStatus solve();
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Bounds of a variable at the end of a probe.
+    struct BndChg {
+      UInt var;
+      double lb;
+      double ub;
+    };
+
+    /// Result of fixing one variable to one value.
+    struct ProbeRes {
+      bool inf;                   /// True if the value is infeasible.
+      std::vector<BndChg> chgs;   /// Bounds changed, sorted by variable.
+    };
+
+    /// Linear part of a constraint and the bounds on it.
+    struct Row {
+      std::vector<std::pair<UInt, double> > terms;
+      double lb;
+      double ub;
+    };
+
+    /// Bounds and queue used by one thread.
+    struct Scratch {
+      DoubleVector lb;
+      DoubleVector ub;
+      std::vector<char> inQ;      /// True for rows in the queue.
+      std::vector<char> touched;  /// True for variables changed in a probe.
+      UIntVector queue;
+      UIntVector tlist;           /// Variables changed in a probe.
+    };
+
+    /**
+     * Number of variables probed before their results are applied. It does
+     * not depend on the number of threads, so neither does the result.
+     */
+    const UInt batchSize_;
+
+    /// Rows of each variable.
+    std::vector<UIntVector> cols_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Tolerance for feasibility.
+    const double eTol_;
+
+    /// Graph of implications and cliques.
+    ImplGraph *graph_;
+
+    /// True for binary variables.
+    std::vector<char> isBin_;
+
+    /// True for integer variables, including binary.
+    std::vector<char> isInt_;
+
+    /// Lower bounds of the variables, tightened by probing.
+    DoubleVector lb_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem that is probed.
+    ProblemPtr p_;
+
+    /// Maximum number of rows propagated in one probe.
+    const UInt propLimit_;
+
+    /// Constraints, as rows.
+    std::vector<Row> rows_;
+
+    /// Statistics.
+    ProbeStats stats_;
+
+    /// Upper bounds of the variables, tightened by probing.
+    DoubleVector ub_;
+
+    /**
+     * \brief Apply the results of probing variable j.
+     *
+     * \param[in] j Index of the variable.
+     * \param[in] res Results of fixing it to zero and to one.
+     * \param[out] changed Variables whose bounds are changed.
+     * \returns True if both values are infeasible.
+     */
+    bool apply_(UInt j, const ProbeRes *res, UIntVector &changed);
+
+    /// Find cliques in constraints with binary variables only.
+    void findCliques_();
+
+    /**
+     * \brief Fix variable j to val in the bounds of s and propagate.
+     * The bounds of s are restored before returning.
+     */
+    void probe_(UInt j, double val, Scratch &s, ProbeRes &res) const;
+
+    /**
+     * \brief Propagate row r in the bounds of s. Return false if the row
+     * can not be satisfied.
+     */
+    bool propRow_(UInt r, Scratch &s) const;
+
+    /// Set the bound of variable k in s. Return false if it is infeasible.
+    bool setBnd_(UInt k, double lb, double ub, Scratch &s) const;
+
+    /// Create rows_ and cols_ from the constraints.
+    void setupRows_();
+
+    /// Tighten the bounds of variable k in lb_ and ub_.
+    bool tighten_(UInt k, double lb, double ub);
+
+    /// Copy constructor is not allowed.
+    Prober(const Prober &);
+
+    /// Copy by assignment is not allowed.
+    Prober &operator=(const Prober &);
+  };
+}
+#endif
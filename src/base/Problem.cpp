@@ -26,9 +26,11 @@ Problem::Problem(EnvPtr env)
   : cons_(0),
     consModed_(false),
     debugSol_(0),
+    derVer_(0),
     engine_(0),
     hessian_(0),
     jacobian_(0),
+    linVer_(0),
     nativeDer_(false),
     nextCId_(0),
     nextSId_(0),
@@ -36,7 +38,9 @@ Problem::Problem(EnvPtr env)
     numDCons_(0),
     numDVars_(0),
     obj_(0),
+    objVer_(0),
     size_(0),
+    structVer_(0),
     vars_(0),
     varsModed_(false)
 
@@ -96,6 +100,7 @@ Problem::~Problem()
 
 void Problem::addToObj(LinearFunctionPtr lf)
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot change objective after loading problem to engine\n"));
   if (obj_) {
@@ -108,6 +113,7 @@ void Problem::addToObj(LinearFunctionPtr lf)
 
 void Problem::addToObj(double c)
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot change objective after loading problem to engine\n"));
   if (obj_) {
@@ -120,6 +126,8 @@ void Problem::addToObj(double c)
 
 void Problem::addToCons(ConstraintPtr cons, double c)
 {
+  ++structVer_;
+  ++linVer_;
   cons->add_(c);
 }
 
@@ -223,6 +231,39 @@ void Problem::changeBound(ConstraintPtr con, double new_lb, double new_ub)
   consModed_ = true;
 }
 
+void Problem::changeBounds(const double *lb, const double *ub)
+{
+  VarVector vars;
+  DoubleVector nlb, nub;
+
+  for (VariableConstIterator it = vars_.begin(); it != vars_.end(); ++it, ++lb,
+       ++ub) {
+    if ((*it)->getLb() != *lb || (*it)->getUb() != *ub) {
+      vars.push_back(*it);
+      nlb.push_back(*lb);
+      nub.push_back(*ub);
+    }
+  }
+  if (!vars.empty()) {
+    changeBounds(vars, &nlb[0], &nub[0]);
+  }
+}
+
+void Problem::changeBounds(const VarVector &vars, const double *lb,
+                           const double *ub)
+{
+  for (UInt i = 0; i < vars.size(); ++i) {
+    assert(vars[i] == vars_[vars[i]->getIndex()] ||
+           !"Problem: Bound of variable that is not in problem can't be "
+           "changed.");
+    vars[i]->setLb_(lb[i]);
+    vars[i]->setUb_(ub[i]);
+  }
+  if (engine_ && !vars.empty()) {
+    engine_->changeBounds(vars, lb, ub);
+  }
+}
+
 void Problem::changeBound(ConstraintPtr con, BoundType lu, double new_val)
 {
 
@@ -243,6 +284,7 @@ void Problem::changeBound(ConstraintPtr con, BoundType lu, double new_val)
 
 void Problem::changeConstraint(ConstraintPtr con, NonlinearFunctionPtr nlf)
 {
+  ++structVer_;
   // simply replacing lf is sufficient to take care of jacobian and hessian as
   // well.
 
@@ -273,12 +315,16 @@ void Problem::changeConstraint(ConstraintPtr con, NonlinearFunctionPtr nlf)
 void Problem::changeConstraint(ConstraintPtr con, LinearFunctionPtr lf,
                                double lb, double ub)
 {
+  ++structVer_;
   // simply replacing lf is sufficient to take care of jacobian and hessian as
   // well.
 
   FunctionPtr f = con->getFunction();
 
   assert(f);
+  if (isLinear_(f)) {
+    ++linVer_;
+  }
   assert(con == getConstraint(con->getIndex()));
 
   // It is important to apply changes to engine first. Some engines use the
@@ -304,6 +350,7 @@ void Problem::changeConstraint(ConstraintPtr con, LinearFunctionPtr lf,
 
 void Problem::changeObj(FunctionPtr f, double cb)
 {
+  ++objVer_;
   std::string name = (obj_) ? obj_->getName() : "obj";
   if (engine_) {
     engine_->changeObj(f, cb);
@@ -1358,6 +1405,7 @@ ProblemPtr Problem::shuffle(bool varshuff, bool conshuff, EnvPtr env)
 
 void Problem::cg2qf()
 {
+  ++structVer_;
   ConstraintPtr c;
   FunctionPtr f;
 
@@ -1620,10 +1668,12 @@ void Problem::countVarTypes_()
 void Problem::delMarkedCons()
 {
   if (numDCons_ > 0) {
+    ++structVer_;
     ConstraintPtr c;
     UInt i;
     std::vector<ConstraintPtr> copycons;
     std::vector<ConstraintPtr> delcons;
+    bool lin = true;
 
     for (ConstraintIterator it = cons_.begin(); it != cons_.end(); ++it) {
       c = *it;
@@ -1633,6 +1683,15 @@ void Problem::delMarkedCons()
         copycons.push_back(c);
       }
     }
+    for (ConstraintIterator it = delcons.begin(); it != delcons.end(); ++it) {
+      if (!isLinear_((*it)->getFunction())) {
+        lin = false;
+        break;
+      }
+    }
+    if (lin) {
+      ++linVer_;
+    }
 
     if (engine_) {
       engine_->removeCons(delcons);
@@ -1666,6 +1725,7 @@ void Problem::delMarkedVars(bool keep)
   assert(engine_ == 0 ||
          (!"Cannot delete variables after loading problem to engine\n"));
   if (numDVars_ > 0) {
+    ++structVer_;
     VariablePtr v = 0;
     UInt i = 0;
     std::vector<VariablePtr> copyvars;
@@ -1798,6 +1858,15 @@ void Problem::findVarFunTypes_()
 #endif
 }
 
+void Problem::getBounds(double *lb, double *ub) const
+{
+  for (VariableConstIterator it = vars_.begin(); it != vars_.end(); ++it, ++lb,
+       ++ub) {
+    *lb = (*it)->getLb();
+    *ub = (*it)->getUb();
+  }
+}
+
 ConstraintPtr Problem::getConstraint(UInt index) const
 {
   return cons_[index];
@@ -1808,6 +1877,34 @@ DoubleVector* Problem::getDebugSol() const
   return debugSol_;
 }
 
+const double* Problem::getEvalPoint(const double* x, bool new_x, bool clip)
+{
+  UInt n = vars_.size();
+  VariablePtr v;
+
+  if (!clip || 0 == n) {
+    return x;
+  }
+  // the solver's new_x is only about its own last call. Another caller may
+  // have used the buffer since then.
+  if (new_x || evalIn_.size() != n ||
+      false == std::equal(evalIn_.begin(), evalIn_.end(), x)) {
+    evalIn_.assign(x, x + n);
+    evalX_.resize(n);
+    for (UInt i = 0; i < n; ++i) {
+      v = vars_[i];
+      if (x[i] < v->getLb()) {
+        evalX_[i] = v->getLb();
+      } else if (x[i] > v->getUb()) {
+        evalX_[i] = v->getUb();
+      } else {
+        evalX_[i] = x[i];
+      }
+    }
+  }
+  return &evalX_[0];
+}
+
 HessianOfLagPtr Problem::getHessian() const
 {
   return hessian_;
@@ -1966,6 +2063,12 @@ bool Problem::isLinear()
   return false;
 }
 
+bool Problem::isLinear_(ConstFunctionPtr f)
+{
+  return (!f ||
+          (!f->getQuadraticFunction() && !f->getNonlinearFunction()));
+}
+
 bool Problem::isMarkedDel(ConstConstraintPtr con)
 {
   return (con->getState() == DeletedCons);
@@ -2040,6 +2143,7 @@ void Problem::markDelete(VariablePtr var)
 
 void Problem::negateObj()
 {
+  ++objVer_;
   if (engine_) {
     engine_->negateObj();
   }
@@ -2053,6 +2157,8 @@ void Problem::negateObj()
 
 VariablePtr Problem::newBinaryVariable()
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          ("Cannot add variables after loading problem to engine\n"));
   VariablePtr v;
@@ -2066,6 +2172,8 @@ VariablePtr Problem::newBinaryVariable()
 
 VariablePtr Problem::newBinaryVariable(std::string name)
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          (!"Cannot add variables after loading problem to engine\n"));
   VariablePtr v = newVariable(0.0, 1.0, Binary, name);
@@ -2075,6 +2183,10 @@ VariablePtr Problem::newBinaryVariable(std::string name)
 ConstraintPtr Problem::newConstraint(FunctionPtr f, double lb, double ub,
                                      std::string name)
 {
+  ++structVer_;
+  if (isLinear_(f)) {
+    ++linVer_;
+  }
   ConstraintPtr c =
       (ConstraintPtr) new Constraint(nextCId_, cons_.size(), f, lb, ub, name);
   ++nextCId_;
@@ -2093,6 +2205,10 @@ ConstraintPtr Problem::newConstraint(FunctionPtr f, double lb, double ub,
 
 ConstraintPtr Problem::newConstraint(FunctionPtr funPtr, double lb, double ub)
 {
+  ++structVer_;
+  if (isLinear_(funPtr)) {
+    ++linVer_;
+  }
   // set a name and call newConstraint above.
   std::stringstream name_stream;
   std::string name;
@@ -2115,6 +2231,7 @@ ConstraintPtr Problem::newConstraint(FunctionPtr funPtr, double lb, double ub)
 ObjectivePtr Problem::newObjective(FunctionPtr f, double cb,
                                    ObjectiveType otyp)
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot add objective after loading problem to engine\n"));
   // XXX: set name.
@@ -2130,6 +2247,7 @@ ObjectivePtr Problem::newObjective(FunctionPtr f, double cb,
 
 ObjectivePtr Problem::newObjective(double cb, ObjectiveType otyp)
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot add objective after loading problem to engine\n"));
   if (obj_) {
@@ -2144,6 +2262,7 @@ ObjectivePtr Problem::newObjective(double cb, ObjectiveType otyp)
 ObjectivePtr Problem::newObjective(FunctionPtr f, double cb,
                                    ObjectiveType otyp, std::string name)
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot add objective after loading problem to engine\n"));
 
@@ -2159,6 +2278,7 @@ ObjectivePtr Problem::newObjective(FunctionPtr f, double cb,
 SOSPtr Problem::newSOS(int n, SOSType type, const double* weights,
                        const VarVector& vars, int priority, std::string name)
 {
+  ++structVer_;
   SOSPtr sos = new SOS(n, type, weights, vars, nextSId_, priority, name);
   ++nextSId_;
   if (SOS1 == type) {
@@ -2172,6 +2292,7 @@ SOSPtr Problem::newSOS(int n, SOSType type, const double* weights,
 SOSPtr Problem::newSOS(int n, SOSType type, const double* weights,
                        const VarVector& vars, int priority)
 {
+  ++structVer_;
   std::string name;
   std::stringstream name_stream;
   if (SOS1 == type) {
@@ -2188,6 +2309,8 @@ SOSPtr Problem::newSOS(int n, SOSType type, const double* weights,
 
 VariablePtr Problem::newVariable(VarSrcType stype)
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          (!"Cannot add variables after loading problem to engine\n"));
   VariablePtr v;
@@ -2202,6 +2325,8 @@ VariablePtr Problem::newVariable(VarSrcType stype)
 VariablePtr Problem::newVariable(double lb, double ub, VariableType vtype,
                                  VarSrcType stype)
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          (!"Cannot add variables after loading problem to engine\n"));
   VariablePtr v;
@@ -2216,6 +2341,8 @@ VariablePtr Problem::newVariable(double lb, double ub, VariableType vtype,
 VariablePtr Problem::newVariable(double lb, double ub, VariableType vtype,
                                  std::string name, VarSrcType stype)
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          (!"Cannot add variables after loading problem to engine\n"));
   VariablePtr v = new Variable(nextVId_, vars_.size(), lb, ub, vtype, name);
@@ -2229,6 +2356,8 @@ VariablePtr Problem::newVariable(double lb, double ub, VariableType vtype,
 void Problem::newVariables(VariableConstIterator v_begin,
                            VariableConstIterator v_end, VarSrcType stype)
 {
+  ++structVer_;
+  ++linVer_;
   assert(engine_ == 0 ||
          (!"Cannot add variables after loading problem to engine\n"));
   VariableConstIterator v_iter;
@@ -2241,6 +2370,8 @@ void Problem::newVariables(VariableConstIterator v_begin,
 
 void Problem::objToCons()
 {
+  ++structVer_;
+  ++objVer_;
   std::string name = "eta";
   if (!obj_) {
     assert(!"No objective function in the problem!");
@@ -2290,6 +2421,7 @@ void Problem::prepareForSolve()
 
 void Problem::removeObjective()
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot change objective after loading problem to engine\n"));
   if (obj_) {
@@ -2301,6 +2433,7 @@ void Problem::removeObjective()
 
 QuadraticFunctionPtr Problem::removeQuadFromObj()
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot change objective after loading problem to engine\n"));
   if (obj_) {
@@ -2312,6 +2445,7 @@ QuadraticFunctionPtr Problem::removeQuadFromObj()
 
 NonlinearFunctionPtr Problem::removeNonlinFromObj()
 {
+  ++objVer_;
   assert(engine_ == 0 ||
          (!"Cannot change objective after loading problem to engine\n"));
   if (obj_) {
@@ -2354,6 +2488,7 @@ void Problem::resConTypCnt()
 
 void Problem::reverseSense(ConstraintPtr cons)
 {
+  ++structVer_;
   cons->reverseSense_();
   consModed_ = true;
 }
@@ -2376,6 +2511,7 @@ void Problem::setEngine(Engine* engine)
 
 void Problem::setHessian(HessianOfLagPtr hessian)
 {
+  ++structVer_;
   hessian_ = hessian;
 }
 
@@ -2423,13 +2559,26 @@ void Problem::setInitValByInd(UInt ind, double val)
 
 void Problem::setJacobian(JacobianPtr jacobian)
 {
+  ++structVer_;
   jacobian_ = jacobian;
 }
 
 void Problem::setNativeDer()
 {
+  ++structVer_;
+  ++linVer_;
   calculateSize();
   nativeDer_ = true;
+  // Keep the structures set up for this problem and update them. Only
+  // changes in nonlinear functions require the Hessian to be set up again.
+  if (jacobian_ && hessian_ && jacobian_->getCons() == &cons_ &&
+      hessian_->getProblem() == this) {
+    jacobian_->update(derVer_ != getNlStructVersion());
+    hessian_->update();
+    derVer_ = getNlStructVersion();
+    return;
+  }
+  derVer_ = getNlStructVersion();
   if (jacobian_) {
     delete jacobian_;
     jacobian_ = 0;
@@ -2444,6 +2593,8 @@ void Problem::setNativeDer()
 
 void Problem::setVarType(VariablePtr var, VariableType type)
 {
+  ++structVer_;
+  ++linVer_;
   assert(
       var == vars_[var->getIndex()] ||
       !"Problem: Type of variable that is not in problem can't be changed.");
@@ -2481,6 +2632,8 @@ void Problem::setVarType(VariablePtr var, VariableType type)
 
 void Problem::subst(VariablePtr out, VariablePtr in, double rat)
 {
+  ++structVer_;
+  ++objVer_;
   bool stayin;
   assert(engine_ == 0 ||
          (!"Cannot substitute variables after loading problem to engine\n"));
@@ -104,6 +104,28 @@ public:
   /// Change lower and upper bounds on the variable 'var'
   virtual void changeBound(VariablePtr var, double new_lb, double new_ub);
 
+  /**
+   * \brief Change bounds of all variables.
+   *
+   * \param[in] lb New lower bounds, one for each variable, in the order of
+   * indices.
+   * \param[in] ub New upper bounds.
+   *
+   * Only the variables whose bounds change are sent to the engine, in one
+   * call. Used with getBounds() to restore bounds after fixing variables.
+   */
+  virtual void changeBounds(const double *lb, const double *ub);
+
+  /**
+   * \brief Change bounds of some variables with one call to the engine.
+   *
+   * \param[in] vars The variables.
+   * \param[in] lb New lower bounds, lb[i] is for vars[i].
+   * \param[in] ub New upper bounds, ub[i] is for vars[i].
+   */
+  virtual void changeBounds(const VarVector &vars, const double *lb,
+                            const double *ub);
+
   /// Change a bound (lower or upper) on a constraint 'con'.
   virtual void changeBound(ConstraintPtr con, BoundType lu, double new_val);
 
@@ -206,6 +228,15 @@ public:
    */
   virtual ProblemType findType();
 
+  /**
+   * \brief Copy the bounds of all variables.
+   *
+   * \param[out] lb Lower bounds, in the order of indices. It must have
+   * space for getNumVars() values.
+   * \param[out] ub Upper bounds.
+   */
+  virtual void getBounds(double *lb, double *ub) const;
+
   /// Return a pointer to the constraint with a given index
   virtual ConstraintPtr getConstraint(UInt index) const;
 
@@ -217,6 +248,25 @@ public:
    */
   virtual DoubleVector* getDebugSol() const;
 
+  /// Return the engine that is updated when the problem is modified, or NULL.
+  Engine* getEngine() const { return engine_; };
+
+  /**
+   * \brief Return the point at which an engine should evaluate functions.
+   *
+   * Engines call this in each callback. If clip is false, x is returned.
+   * Otherwise, a copy of x pulled into the bounds of variables is returned.
+   * The copy is kept in a buffer of the problem along with x, and is made
+   * again if new_x is true or if x is not the point it was made from, so
+   * callbacks at the same point share it.
+   *
+   * \param[in] x The point given by the solver.
+   * \param[in] new_x False if the solver says that x is the same as in the
+   * last callback. Pass true if not known.
+   * \param[in] clip True if values outside bounds must be pulled in.
+   */
+  const double* getEvalPoint(const double* x, bool new_x, bool clip);
+
   /// Return the hessian of the lagrangean. Could be NULL.
   virtual HessianOfLagPtr getHessian() const;
 
@@ -276,6 +326,23 @@ public:
   /// Return a pointer to the objective Function
   virtual ObjectivePtr getObjective() const;
 
+  /**
+   * \brief Return a number that increases each time the objective is
+   * changed. Used to find if an engine that was loaded with the problem
+   * earlier needs a new objective.
+   */
+  UInt getObjVersion() const { return objVer_; };
+
+  /**
+   * \brief Return a number that increases each time the nonlinear part of
+   * the problem changes: nonlinear constraints are added, deleted or
+   * changed, or variables are deleted. Adding or deleting linear
+   * constraints and adding variables are not counted. The Hessian of the
+   * Lagrangean and the derivatives of nonlinear functions set up when the
+   * problem had the same number can be used again.
+   */
+  UInt getNlStructVersion() const { return structVer_ - linVer_; };
+
   /// Return the value of objective function at given point x.
   double getObjValue(const double* x, int* err) const;
 
@@ -285,6 +352,15 @@ public:
   /// Calculate and return a measure of the size of the problem.
   double getSizeEstimate();
 
+  /**
+   * \brief Return a number that increases each time variables or
+   * constraints are added, deleted or their functions or types changed.
+   * Changes in bounds and objective are not counted. An engine loaded with
+   * the problem when it had the same number can be used again after
+   * changing the bounds only.
+   */
+  UInt getStructVersion() const { return structVer_; };
+
   /// Return a pointer to the variable with a given index
   virtual VariablePtr getVariable(UInt index) const;
 
@@ -729,15 +805,27 @@ public:
    */
   DoubleVector* debugSol_;
 
+  /// getNlStructVersion() when the native derivatives were set up.
+  UInt derVer_;
+
   /// Engine that must be updated if problem is loaded to it, could be null
   Engine* engine_;
 
+  /// Point within bounds returned by getEvalPoint().
+  DoubleVector evalX_;
+
+  /// Point from which evalX_ was made.
+  DoubleVector evalIn_;
+
   /// Pointer to the hessian of the lagrangean. Could be NULL.
   HessianOfLagPtr hessian_;
 
   /// Pointer to the jacobian of constraints. Can be NULL.
   JacobianPtr jacobian_;
 
+  /// Number of structural changes that did not touch nonlinear functions.
+  UInt linVer_;
+
   /// Pointer to the log manager. All output messages are sent to it.
   LoggerPtr logger_;
 
@@ -765,6 +853,9 @@ public:
   /// Objective, could be NULL.
   ObjectivePtr obj_;
 
+  /// Number of changes to the objective. See getObjVersion().
+  UInt objVer_;
+
   /// Size statistics for this Problem.
   ProblemSizePtr size_;
 
@@ -774,6 +865,9 @@ public:
   /// SOS2 constraints.
   SOSVector sos2_;
 
+  /// Number of changes to the structure. See getStructVersion().
+  UInt structVer_;
+
   /// Vector of variables.
   VarVector vars_;
 
@@ -802,6 +896,9 @@ public:
    */
   virtual void findVarFunTypes_();
 
+  /// Return true if f is NULL or has no quadratic or nonlinear part.
+  bool isLinear_(ConstFunctionPtr f);
+
   bool isPolyp_();
 
   void setIndex_(VariablePtr v, UInt i);
@@ -23,6 +23,7 @@
 
 #include "CNode.h"
 #include "Constraint.h"
+#include "CutManager.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Function.h"
@@ -37,7 +38,6 @@
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
-#include "VarBoundMod.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -204,20 +204,22 @@ void QGHandler::cutIntSol_(ConstSolutionPtr sol, CutManager* cutMan,
 
 void QGHandler::fixInts_(const double* x)
 {
-  double xval;
   VariablePtr v;
-  VarBoundMod2* m = 0;
+
+  nlpLb_.resize(minlp_->getNumVars());
+  nlpUb_.resize(minlp_->getNumVars());
+  minlp_->getBounds(&nlpLb_[0], &nlpUb_[0]);
+  intVars_.clear();
+  intVals_.clear();
   for(VariableConstIterator vit = minlp_->varsBegin(); vit != minlp_->varsEnd();
       ++vit) {
     v = *vit;
     if(v->getType() == Binary || v->getType() == Integer) {
-      xval = x[v->getIndex()];
-      xval = floor(xval + 0.5);
-      m = new VarBoundMod2(v, xval, xval);
-      m->applyToProblem(minlp_);
-      nlpMods_.push(m);
+      intVars_.push_back(v);
+      intVals_.push_back(floor(x[v->getIndex()] + 0.5));
     }
   }
+  minlp_->changeBounds(intVars_, intVals_.data(), intVals_.data());
   return;
 }
 
@@ -409,7 +411,7 @@ void QGHandler::cutToCons_(const double* nlpx, const double* lpx,
   return;
 }
 
-void QGHandler::cutsAtLpSol_(const double* lpx, CutManager*,
+void QGHandler::cutsAtLpSol_(const double* lpx, CutManager* cutman,
                              SeparationStatus* status)
 {
   int error = 0;
@@ -438,8 +440,7 @@ void QGHandler::cutsAtLpSol_(const double* lpx, CutManager*,
             *status = SepaResolve;
             sstm << "_qgCut_" << stats_->cuts;
             f = (FunctionPtr) new Function(lf);
-            rel_->newConstraint(f, -INFINITY, cUb - c, sstm.str());
-            //newcon = rel_->newConstraint(f, -INFINITY, cUb-c, sstm.str());
+            newCut_(f, cUb - c, sstm.str(), cutman);
             return;
           } else {
             delete lf;
@@ -474,8 +475,7 @@ void QGHandler::cutsAtLpSol_(const double* lpx, CutManager*,
             lf->addTerm(objVar_, -1.0);
             f = (FunctionPtr) new Function(lf);
             sstm << "_qgObjCut_" << stats_->cuts;
-            rel_->newConstraint(f, -INFINITY, -1.0 * c, sstm.str());
-            //newcon = rel_->newConstraint(f, -INFINITY, -1.0*c, sstm.str());
+            newCut_(f, -1.0 * c, sstm.str(), cutman);
           } else {
             delete lf;
             lf = 0;
@@ -492,7 +492,7 @@ void QGHandler::cutsAtLpSol_(const double* lpx, CutManager*,
 }
 
 void QGHandler::addCut_(const double* nlpx, const double* lpx,
-                        ConstraintPtr con, CutManager*,
+                        ConstraintPtr con, CutManager* cutman,
                         SeparationStatus* status)
 {
   int error = 0;
@@ -514,8 +514,7 @@ void QGHandler::addCut_(const double* nlpx, const double* lpx,
         sstm << "_qgCut_" << stats_->cuts;
         *status = SepaResolve;
         f = (FunctionPtr) new Function(lf);
-        rel_->newConstraint(f, -INFINITY, cUb - c, sstm.str());
-        //newcon = rel_->newConstraint(f, -INFINITY, cUb-c, sstm.str());
+        newCut_(f, cUb - c, sstm.str(), cutman);
         return;
       } else {
         delete lf;
@@ -529,8 +528,8 @@ void QGHandler::addCut_(const double* nlpx, const double* lpx,
   return;
 }
 
-void QGHandler::cutToObj_(const double* nlpx, const double* lpx, CutManager*,
-                          SeparationStatus* status)
+void QGHandler::cutToObj_(const double* nlpx, const double* lpx,
+                          CutManager* cutman, SeparationStatus* status)
 {
   if(oNl_) {
     int error = 0;
@@ -559,8 +558,7 @@ void QGHandler::cutToObj_(const double* nlpx, const double* lpx, CutManager*,
               lf->addTerm(objVar_, -1.0);
               *status = SepaResolve;
               f = (FunctionPtr) new Function(lf);
-              //newcon = rel_->newConstraint(f, -INFINITY, -1.0*c, sstm.str());
-              rel_->newConstraint(f, -INFINITY, -1.0 * c, sstm.str());
+              newCut_(f, -1.0 * c, sstm.str(), cutman);
             } else {
               delete lf;
               lf = 0;
@@ -583,6 +581,16 @@ void QGHandler::cutToObj_(const double* nlpx, const double* lpx, CutManager*,
   return;
 }
 
+void QGHandler::newCut_(FunctionPtr f, double ub, std::string name,
+                        CutManager* cutman)
+{
+  if(cutman) {
+    cutman->addNamedCut(rel_, f, -INFINITY, ub, true, false, name);
+  } else {
+    rel_->newConstraint(f, -INFINITY, ub, name);
+  }
+}
+
 void QGHandler::relaxInitFull(RelaxationPtr, SolutionPool *, bool*)
 {
   //Does nothing
@@ -664,13 +672,8 @@ void QGHandler::solveNLP_()
 
 void QGHandler::unfixInts_()
 {
-  Modification* m = 0;
-
-  while(nlpMods_.empty() == false) {
-    m = nlpMods_.top();
-    m->undoToProblem(minlp_);
-    nlpMods_.pop();
-    delete m;
+  if(!nlpLb_.empty()) {
+    minlp_->changeBounds(&nlpLb_[0], &nlpUb_[0]);
   }
   return;
 }
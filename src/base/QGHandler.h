@@ -66,8 +66,12 @@ private:
   /// NLP/QP Engine used to solve the NLP/QP relaxations.
   EnginePtr nlpe_;
 
-  /// Modifications done to NLP before solving it.
-  std::stack<Modification *> nlpMods_;
+  /// Bounds of variables of the NLP before integers are fixed.
+  DoubleVector nlpLb_, nlpUb_;
+
+  /// Integer variables fixed in the NLP and their values.
+  VarVector intVars_;
+  DoubleVector intVals_;
 
   /// Status of the NLP/QP engine.
   EngineStatus nlpStatus_;
@@ -168,6 +172,13 @@ public:
   void relaxNodeInc(NodePtr node, RelaxationPtr rel, bool *is_inf);
 
  
+  /**
+   * Base class method. separate() changes the bounds of the original
+   * problem and solves the NLP engine that it shares with the rest of the
+   * solver, so it must not run with other handlers.
+   */
+  bool isSepThreadSafe() const { return false; };
+
   /// Base class method. Find cuts.
   void separate(ConstSolutionPtr sol, NodePtr node, RelaxationPtr rel, 
                 CutManager *cutman, SolutionPoolPtr s_pool, ModVector &p_mods,
@@ -246,6 +257,13 @@ private:
   void cutToObj_(const double *nlpx, const double *lpx, CutManager *,
                    SeparationStatus *status);
 
+  /**
+   * Add the cut f <= ub to the relaxation through cutman, or directly with
+   * the given name if cutman is NULL.
+   */
+  void newCut_(FunctionPtr f, double ub, std::string name,
+               CutManager* cutman);
+
   /**
    * Create the initial relaxation. It is called from relaxInitFull and
    * relaxInitInc functions.
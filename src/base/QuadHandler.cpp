@@ -77,6 +77,9 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem)
   doQT_ = false;
   simplexCut_ = 0;
   optCuts_.clear();
+  termsStale_ = true;
+  lastNodeId_ = 0;
+  hasLastNode_ = false;
 }
 
 QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem, ProblemPtr orig_p)
@@ -100,6 +103,9 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem, ProblemPtr orig_p)
   doQT_ = false;
   simplexCut_ = 0;
   optCuts_.clear();
+  termsStale_ = true;
+  lastNodeId_ = 0;
+  hasLastNode_ = false;
 }
 
 QuadHandler::~QuadHandler()
@@ -138,6 +144,7 @@ void QuadHandler::addConstraint(ConstraintPtr newcon)
 
   cons_.push_back(newcon);
   qf = newcon->getQuadraticFunction();
+  termsStale_ = true;
 
   if(qf) {
     lf = newcon->getLinearFunction();
@@ -1229,60 +1236,132 @@ void QuadHandler::simplePresolve(ProblemPtr p, SolutionPoolPtr,
   status = Finished;
 }
 
-bool QuadHandler::presolveNode(RelaxationPtr rel, NodePtr,
+void QuadHandler::indexTerms_()
+{
+  UInt n = 0;
+  UInt t = 0;
+  VariablePtr tv[3];
+  UInt ntv;
+
+  sqTerms_.clear();
+  bilTerms_.clear();
+  for(LinSqrMapIter it = x2Funs_.begin(); it != x2Funs_.end(); ++it) {
+    sqTerms_.push_back(it->second);
+  }
+  for(LinBilSetIter it = x0x1Funs_.begin(); it != x0x1Funs_.end(); ++it) {
+    bilTerms_.push_back(*it);
+  }
+
+  // count terms of each variable, then fill them in (compressed rows).
+  n = p_->getNumVars();
+  varTermBeg_.assign(n + 1, 0);
+  for(t = 0; t < sqTerms_.size() + bilTerms_.size(); ++t) {
+    termVarsOf_(t, tv, ntv);
+    for(UInt j = 0; j < ntv; ++j) {
+      ++varTermBeg_[tv[j]->getIndex() + 1];
+    }
+  }
+  termVars_.clear();
+  for(UInt i = 0; i < n; ++i) {
+    if(varTermBeg_[i + 1] > 0) {
+      termVars_.push_back(i);
+    }
+    varTermBeg_[i + 1] += varTermBeg_[i];
+  }
+  varTerms_.resize(varTermBeg_[n]);
+  {
+    UIntVector pos(varTermBeg_.begin(), varTermBeg_.end() - 1);
+    for(t = 0; t < sqTerms_.size() + bilTerms_.size(); ++t) {
+      termVarsOf_(t, tv, ntv);
+      for(UInt j = 0; j < ntv; ++j) {
+        varTerms_[pos[tv[j]->getIndex()]++] = t;
+      }
+    }
+  }
+
+  // NaN never equals a bound, so every variable is seen as changed.
+  lastLb_.assign(n, NAN);
+  lastUb_.assign(n, NAN);
+  lastRelLb_.assign(n, NAN);
+  lastRelUb_.assign(n, NAN);
+  inVarQ_.assign(n, false);
+  termMark_.assign(sqTerms_.size() + bilTerms_.size(), false);
+  varQ_.clear();
+  hasLastNode_ = false;
+  termsStale_ = false;
+}
+
+bool QuadHandler::presolveNode(RelaxationPtr rel, NodePtr node,
                                SolutionPoolPtr s_pool, ModVector& p_mods,
                                ModVector& r_mods)
 {
-  bool lchanged = true;
-  bool changed = true;
+  bool lchanged = false;
   bool is_inf = false;
+  bool all;
   double stime = timer_->query();
   double ub = s_pool->getBestSolutionValue();
+  VariablePtr v;
 
-  // visit each quadratic constraint and see if bounds can be improved.
+  if(termsStale_ || lastLb_.size() != p_->getNumVars()) {
+    indexTerms_();
+  }
+
+  // Propagate only the terms of variables whose bounds have changed since
+  // the last call, and then the terms of variables whose bounds change
+  // during propagation, until no bound changes.
   ++bStats_.niters;
-  while(true == changed) {
-    ++pStats_.iters;
-    changed = false;
-    for(LinSqrMapIter it = x2Funs_.begin(); it != x2Funs_.end(); ++it) {
-      is_inf = propSqrBnds_(it, rel, modRel_, &lchanged, p_mods, r_mods);
-      if(true == lchanged) {
-        changed = true;
-        lchanged = false;
-      }
-      if(is_inf) {
-        return true;
-      }
-    }
-    for(LinBilSetIter it = x0x1Funs_.begin(); it != x0x1Funs_.end(); ++it) {
-      is_inf = propBilBnds_(*it, rel, modRel_, &lchanged, p_mods, r_mods);
-      if(true == lchanged) {
-        changed = true;
-        lchanged = false;
-      }
-      if(is_inf) {
-        return true;
-      }
+  ++pStats_.iters;
+  for(UIntVector::iterator it = termVars_.begin(); it != termVars_.end();
+      ++it) {
+    v = p_->getVariable(*it);
+    if(v->getLb() != lastLb_[*it] || v->getUb() != lastUb_[*it]) {
+      varQ_.push_back(*it);
+      inVarQ_[*it] = true;
     }
   }
+  if(propQueue_(rel, p_mods, r_mods)) {
+    hasLastNode_ = false;
+    return true;
+  }
 
   if(doQT_ || bStats_.niters <= 1) {
+    DoubleVector qlb, qub;
+    for(UIntVector::iterator it = termVars_.begin(); it != termVars_.end();
+        ++it) {
+      qlb.push_back(p_->getVariable(*it)->getLb());
+      qub.push_back(p_->getVariable(*it)->getUb());
+    }
     lchanged = false;
     is_inf = tightenQuad_(rel, ub, &lchanged, p_mods, r_mods);
-    if(true == lchanged) {
-      changed = true;
-      lchanged = false;
+    if(!is_inf && lchanged) {
+      // propagate the terms again with the new bounds.
+      for(UInt i = 0; i < termVars_.size(); ++i) {
+        v = p_->getVariable(termVars_[i]);
+        if(v->getLb() != qlb[i] || v->getUb() != qub[i]) {
+          varQ_.push_back(termVars_[i]);
+          inVarQ_[termVars_[i]] = true;
+        }
+      }
+      is_inf = propQueue_(rel, p_mods, r_mods);
     }
     if(is_inf) {
+      hasLastNode_ = false;
       return true;
     }
   }
 
-  for(LinSqrMapIter it = x2Funs_.begin(); it != x2Funs_.end(); ++it) {
-    upSqCon_(it->second, rel, r_mods);
-  }
-  for(LinBilSetIter it = x0x1Funs_.begin(); it != x0x1Funs_.end(); ++it) {
-    upBilCon_(*it, rel, r_mods);
+  // The relaxation of a term needs to be updated only if bounds of its
+  // variables changed since the last node, which must be the parent of this
+  // node (or this node itself) so that the rows are the same.
+  all = !hasLastNode_ || !node ||
+        (node->getId() != lastNodeId_ &&
+         (!node->getParent() || node->getParent()->getId() != lastNodeId_));
+  refreshTerms_(rel, all, r_mods);
+  if(node) {
+    lastNodeId_ = node->getId();
+    hasLastNode_ = true;
+  } else {
+    hasLastNode_ = false;
   }
 
   if(modRel_) {
@@ -1386,14 +1465,14 @@ bool QuadHandler::propSqrBnds_(LinSqrMapIter lx2, bool* changed)
   return false;
 }
 
-bool QuadHandler::propSqrBnds_(LinSqrMapIter lx2, RelaxationPtr rel,
+bool QuadHandler::propSqrBnds_(LinSqrPtr lx2, RelaxationPtr rel,
                                bool mod_rel, bool* changed, ModVector& p_mods,
                                ModVector& r_mods)
 {
   double lb, ub;
 
-  VariablePtr x = lx2->first; // x and y are variables in p_
-  VariablePtr y = lx2->second->y;
+  VariablePtr x = lx2->x; // x and y are variables in p_
+  VariablePtr y = lx2->y;
 
   BoundsOnSquare(x, lb, ub);
   if(updatePBounds_(y, lb, ub, rel, mod_rel, changed, p_mods, r_mods) < 0) {
@@ -1422,6 +1501,82 @@ bool QuadHandler::propSqrBnds_(LinSqrMapIter lx2, RelaxationPtr rel,
   return false;
 }
 
+bool QuadHandler::propQueue_(RelaxationPtr rel, ModVector& p_mods,
+                              ModVector& r_mods)
+{
+  bool is_inf = false;
+  UInt vi;
+
+  while(!varQ_.empty() && false == is_inf) {
+    vi = varQ_.back();
+    varQ_.pop_back();
+    inVarQ_[vi] = false;
+    for(UInt k = varTermBeg_[vi]; k < varTermBeg_[vi + 1]; ++k) {
+      is_inf = propTerm_(varTerms_[k], rel, p_mods, r_mods);
+      if(is_inf) {
+        break;
+      }
+    }
+  }
+  if(is_inf) {
+    for(UIntVector::iterator it = varQ_.begin(); it != varQ_.end(); ++it) {
+      inVarQ_[*it] = false;
+    }
+    varQ_.clear();
+  }
+  return is_inf;
+}
+
+bool QuadHandler::propTerm_(UInt t, RelaxationPtr rel, ModVector& p_mods,
+                             ModVector& r_mods)
+{
+  bool changed = false;
+  bool is_inf;
+  VariablePtr tv[3];
+  double lb[3], ub[3];
+  UInt ntv, vi;
+
+  termVarsOf_(t, tv, ntv);
+  for(UInt j = 0; j < ntv; ++j) {
+    lb[j] = tv[j]->getLb();
+    ub[j] = tv[j]->getUb();
+  }
+  ++pStats_.nProps;
+  if(t < sqTerms_.size()) {
+    is_inf = propSqrBnds_(sqTerms_[t], rel, modRel_, &changed, p_mods,
+                          r_mods);
+  } else {
+    is_inf = propBilBnds_(bilTerms_[t - sqTerms_.size()], rel, modRel_,
+                          &changed, p_mods, r_mods);
+  }
+  if(changed && !is_inf) {
+    for(UInt j = 0; j < ntv; ++j) {
+      vi = tv[j]->getIndex();
+      if(!inVarQ_[vi] &&
+         (tv[j]->getLb() != lb[j] || tv[j]->getUb() != ub[j])) {
+        varQ_.push_back(vi);
+        inVarQ_[vi] = true;
+      }
+    }
+  }
+  return is_inf;
+}
+
+void QuadHandler::termVarsOf_(UInt t, VariablePtr* tv, UInt& ntv)
+{
+  if(t < sqTerms_.size()) {
+    tv[0] = sqTerms_[t]->x;
+    tv[1] = sqTerms_[t]->y;
+    ntv = 2;
+  } else {
+    LinBil* lb = bilTerms_[t - sqTerms_.size()];
+    tv[0] = lb->getX0();
+    tv[1] = lb->getX1();
+    tv[2] = lb->getY();
+    ntv = 3;
+  }
+}
+
 bool QuadHandler::postSolveRootNode(RelaxationPtr rel, SolutionPoolPtr s_pool,
                                     ConstSolutionPtr sol, ModVector& p_mods,
                                     ModVector& r_mods)
@@ -1582,6 +1737,9 @@ void QuadHandler::relax_(RelaxationPtr rel, bool*)
   FunctionPtr f;
   ConstraintVector cons(4);
 
+  // rows are created afresh. Update all of them in the next node.
+  hasLastNode_ = false;
+
   for(LinSqrMapIter it = x2Funs_.begin(); it != x2Funs_.end(); ++it) {
     x0 = rel->getRelaxationVar(it->second->x);
     y = rel->getRelaxationVar(it->second->y);
@@ -1664,6 +1822,45 @@ void QuadHandler::removeCut_(RelaxationPtr rel, ConstraintPtr c)
 #endif
 }
 
+void QuadHandler::refreshTerms_(RelaxationPtr rel, bool all,
+                                ModVector& r_mods)
+{
+  UInt nsq = sqTerms_.size();
+  VariablePtr v, rv;
+  bool vchanged;
+
+  for(UIntVector::iterator it = termVars_.begin(); it != termVars_.end();
+      ++it) {
+    v = p_->getVariable(*it);
+    rv = rel->getRelaxationVar(v);
+    vchanged = v->getLb() != lastLb_[*it] || v->getUb() != lastUb_[*it];
+    if(rv) {
+      vchanged = vchanged || rv->getLb() != lastRelLb_[*it] ||
+                 rv->getUb() != lastRelUb_[*it];
+      lastRelLb_[*it] = rv->getLb();
+      lastRelUb_[*it] = rv->getUb();
+    }
+    lastLb_[*it] = v->getLb();
+    lastUb_[*it] = v->getUb();
+    if(vchanged || all) {
+      for(UInt k = varTermBeg_[*it]; k < varTermBeg_[*it + 1]; ++k) {
+        termMark_[varTerms_[k]] = true;
+      }
+    }
+  }
+
+  for(UInt t = 0; t < termMark_.size(); ++t) {
+    if(termMark_[t]) {
+      termMark_[t] = false;
+      if(t < nsq) {
+        upSqCon_(sqTerms_[t], rel, r_mods);
+      } else {
+        upBilCon_(bilTerms_[t - nsq], rel, r_mods);
+      }
+    }
+  }
+}
+
 void QuadHandler::resetStats_()
 {
   pStats_.iters = 0;
@@ -1672,6 +1869,7 @@ void QuadHandler::resetStats_()
   pStats_.conDel = 0;
   pStats_.vBnd = 0;
   pStats_.nMods = 0;
+  pStats_.nProps = 0;
 
   sStats_.iters = 0;
   sStats_.tangentcuts = 0;
@@ -3689,6 +3887,9 @@ bool QuadHandler::varBndsFromCons_(bool* changed)
     delete *it;
     x0x1Funs_.erase(it);
   }
+  if(!lsqdel.empty() || !lbildel.empty()) {
+    termsStale_ = true;
+  }
   lsqdel.clear();
   lbildel.clear();
   return false;
@@ -3706,6 +3907,8 @@ void QuadHandler::writeStats(std::ostream& out) const
       << std::endl
       << me_ << "Times variables tightened      = " << pStats_.vBnd << std::endl
       << me_ << "Changes in nodes               = " << pStats_.nMods
+      << std::endl
+      << me_ << "Terms propagated in nodes      = " << pStats_.nProps
       << std::endl;
 
   out << me_ << "Statistics for separation by QuadHandler:" << std::endl
@@ -163,6 +163,7 @@ private:
     double timeN; ///> Total time used in presolveNode.
     int vBnd;     ///> Number of times variable-bounds were tightened.
     int nMods;    ///> Number of changes made in all nodes.
+    int nProps;   ///> Number of times a term was propagated in nodes.
   };
 
   struct NLPStats {
@@ -287,6 +288,54 @@ private:
    */
   LinSqrMap x2Funs_;
 
+  /**
+   * \brief Square terms of x2Funs_, followed by bilinear terms of x0x1Funs_
+   * in bilTerms_, for propagation in nodes. Term number t refers to
+   * sqTerms_[t] if t < sqTerms_.size() and to bilTerms_[t-sqTerms_.size()]
+   * otherwise.
+   */
+  LinSqrVec sqTerms_;
+
+  /// Bilinear terms. See sqTerms_.
+  std::vector<LinBil*> bilTerms_;
+
+  /// True if sqTerms_, bilTerms_ and varTerms_ must be rebuilt.
+  bool termsStale_;
+
+  /**
+   * \brief Terms in which the variable of p_ with index i appears are
+   * varTerms_[varTermBeg_[i]] ... varTerms_[varTermBeg_[i+1]-1].
+   */
+  UIntVector varTermBeg_;
+
+  /// Term numbers, indexed by varTermBeg_.
+  UIntVector varTerms_;
+
+  /// Indices of the variables that appear in some term.
+  UIntVector termVars_;
+
+  /**
+   * \brief Bounds of variables of p_ (lastLb_, lastUb_) and of the relaxation
+   * (lastRelLb_, lastRelUb_) at the end of the last call to presolveNode().
+   * Indexed by the index of the variable in p_.
+   */
+  DoubleVector lastLb_, lastUb_, lastRelLb_, lastRelUb_;
+
+  /// Id of the node that was presolved last. Valid only if hasLastNode_.
+  UInt lastNodeId_;
+
+  /// True if some node has been presolved since the terms were indexed.
+  bool hasLastNode_;
+
+  /// Queue of indices of variables whose bounds changed in presolveNode().
+  UIntVector varQ_;
+
+  /// True for variables that are in varQ_.
+  std::vector<bool> inVarQ_;
+
+  /// Marks terms whose relaxation must be updated in presolveNode().
+  std::vector<bool> termMark_;
+
   /**
    * \brief Add a gradient-based linearization inequality.
    * \param[in] x       The variable x in (y = x^2)
@@ -573,6 +622,24 @@ private:
    */
   bool propSqrBnds_(LinSqrMapIter lx2, bool* changed);
 
+  /// Put all square and bilinear terms in arrays and index them by variables.
+  void indexTerms_();
+
+  /**
+   * \brief Propagate the terms of variables in varQ_ until it is empty.
+   * Return true if bounds become inconsistent.
+   */
+  bool propQueue_(RelaxationPtr rel, ModVector& p_mods, ModVector& r_mods);
+
+  /**
+   * \brief Strengthen bounds of the variables of term number t (see
+   * sqTerms_), and add the variables whose bounds change to varQ_.
+   * Arguments are the same as in propSqrBnds_().
+   * Return true if the new bounds are inconsistent.
+   */
+  bool propTerm_(UInt t, RelaxationPtr rel, ModVector& p_mods,
+                 ModVector& r_mods);
+
   /**
    * \brief Strengthen bounds of variables in a square constraint y=x0^2,
    * and save the modifications if any.
@@ -587,7 +654,7 @@ private:
    * Return true if the new bounds are inconsistent (i.e., lb > ub for any of
    * the two variables)
    */
-  bool propSqrBnds_(LinSqrMapIter lx2, RelaxationPtr rel, bool mod_rel,
+  bool propSqrBnds_(LinSqrPtr lx2, RelaxationPtr rel, bool mod_rel,
                     bool* changed, ModVector& p_mods, ModVector& r_mods);
 
   /**
@@ -604,6 +671,17 @@ private:
   /// Remove the given cut
   void removeCut_(RelaxationPtr rel, ConstraintPtr c);
 
+  /// Fill tv with the ntv variables (x0, x1 and y) of term number t.
+  void termVarsOf_(UInt t, VariablePtr* tv, UInt& ntv);
+
+  /**
+   * \brief Update the relaxation of the terms whose variables have bounds
+   * different from those saved in lastLb_, lastUb_, lastRelLb_ and
+   * lastRelUb_. Update all terms if all is true. Then save the current
+   * bounds.
+   */
+  void refreshTerms_(RelaxationPtr rel, bool all, ModVector& r_mods);
+
   /**
    * \brief Resetting the bounds on original variables
    * \param[in] varlb the vector of original lb
@@ -10,6 +10,7 @@
  */
 
  
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -84,12 +85,14 @@ void RCHandler::separate(ConstSolutionPtr sol, NodePtr node,
     return;
   }
 
+  // reduced costs of the root are valid in the whole tree.
   int i=0;
   for (v_iter = rel->varsBegin(); v_iter != rel->varsEnd(); ++v_iter,++i) {
     v = *v_iter;
     rnode = p[i];
     xval = x[i];
-    rcfix_( rel, r_mods, bestobj, rel_obj, xval, rnode, v);
+    rcfix_( rel, r_mods, bestobj, rel_obj, xval, rnode, v,
+            node->getId() == 0);
     
   }
 
@@ -99,7 +102,7 @@ void RCHandler::separate(ConstSolutionPtr sol, NodePtr node,
       v = *v_iter;
       rroot = rootDuals_[v->getIndex()];
       xval = rootX_[v->getIndex()];
-      rcfix_(rel, r_mods, bestobj, rootObj_, xval, rroot, v);
+      rcfix_(rel, r_mods, bestobj, rootObj_, xval, rroot, v, true);
     } 
   }
 
@@ -110,7 +113,7 @@ void RCHandler::separate(ConstSolutionPtr sol, NodePtr node,
 void RCHandler::rcfix_(RelaxationPtr rel,
                        ModVector &r_mods, double bestobj,
                        const double rel_obj, double xval, 
-                       double r, VariablePtr v)
+                       double r, VariablePtr v, bool global)
 {
 
   double ZTOL = 1e-6; // tolerance for checking if the variable is already fixed.
@@ -126,10 +129,12 @@ void RCHandler::rcfix_(RelaxationPtr rel,
   double new_lb, lb;
   VarBoundModPtr m;
   VariableType v_type;
+  bool fixed;
   lb = v->getLb();
   ub = v->getUb();
 
-  if (ub - lb < ZTOL) {
+  fixed = (ub - lb < ZTOL);
+  if (fixed && !global) {
     return;
   }
 
@@ -140,7 +145,10 @@ void RCHandler::rcfix_(RelaxationPtr rel,
     if (v_type == Binary || v_type == Integer || v_type == ImplBin ||
         v_type == ImplInt){
       new_ub = floor(new_ub + MINIMP);
-      if (new_ub<ub-MINREL*abs(ub)) {
+      if (global) {
+        gub_[v->getIndex()] = std::min(gub_[v->getIndex()], new_ub);
+      }
+      if (!fixed && new_ub<ub-MINREL*abs(ub)) {
         m = (VarBoundModPtr) new VarBoundMod(v, Upper, new_ub);
         m->applyToProblem(rel);
         r_mods.push_back(m);
@@ -155,7 +163,10 @@ void RCHandler::rcfix_(RelaxationPtr rel,
         ++(stats_->nub);
       } 
     } else { // a continuous variable
-      if (new_ub<ub-MINIMP && new_ub<ub-MINREL*abs(ub)) {
+      if (global) {
+        gub_[v->getIndex()] = std::min(gub_[v->getIndex()], new_ub);
+      }
+      if (!fixed && new_ub<ub-MINIMP && new_ub<ub-MINREL*abs(ub)) {
         m = (VarBoundModPtr) new VarBoundMod(v, Upper, new_ub);
         m->applyToProblem(rel);
         r_mods.push_back(m);
@@ -173,7 +184,10 @@ void RCHandler::rcfix_(RelaxationPtr rel,
     if (v_type == Binary || v_type == Integer || v_type == ImplBin ||
         v_type == ImplInt){
       new_lb = ceil(new_lb - MINIMP);
-      if (new_lb > lb+MINREL*abs(lb)) {
+      if (global) {
+        glb_[v->getIndex()] = std::max(glb_[v->getIndex()], new_lb);
+      }
+      if (!fixed && new_lb > lb+MINREL*abs(lb)) {
         m = (VarBoundModPtr) new VarBoundMod(v, Lower, new_lb);
         m->applyToProblem(rel);
         r_mods.push_back(m);
@@ -190,7 +204,10 @@ void RCHandler::rcfix_(RelaxationPtr rel,
         ++(stats_->nlb);
       }
     } else { // continuous variable
-      if (new_lb > lb+MINIMP && new_lb > lb+MINREL*abs(lb)) {
+      if (global) {
+        glb_[v->getIndex()] = std::max(glb_[v->getIndex()], new_lb);
+      }
+      if (!fixed && new_lb > lb+MINIMP && new_lb > lb+MINREL*abs(lb)) {
         m = (VarBoundModPtr) new VarBoundMod(v, Lower, new_lb);
         m->applyToProblem(rel);
         r_mods.push_back(m);
@@ -208,6 +225,16 @@ void RCHandler::rcfix_(RelaxationPtr rel,
   return;
 }
 
+void RCHandler::getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const
+{
+  UInt n = std::min(glb_.size(), lb.size());
+
+  for (UInt i=0; i<n; ++i) {
+    lb[i] = std::max(lb[i], glb_[i]);
+    ub[i] = std::min(ub[i], gub_[i]);
+  }
+}
+
 std::string RCHandler::getName() const
 {
   return "RCHandler (Reduced Cost Strengthening)";
@@ -224,6 +251,8 @@ void RCHandler::copyRootDetails_(ConstSolutionPtr sol, RelaxationPtr rel)
     rootDuals_ = new double[n];
     rootX_     = new double[n];
     rootObj_   = sol->getObjValue();
+    glb_.assign(n, -INFINITY);
+    gub_.assign(n, INFINITY);
   }
 
   i=0;
@@ -68,6 +68,9 @@ public:
   { return ModificationPtr(); };
 
        
+  // Base class method. Bounds from reduced costs of the root.
+  void getGlobalBounds(DoubleVector &lb, DoubleVector &ub) const;
+
   // Base class method. 
   std::string getName() const;
 
@@ -109,6 +112,12 @@ public:
   void writeStats(std::ostream &) const;
   
 private:
+  /// Lower bounds found from the reduced costs of the root.
+  DoubleVector glb_;
+
+  /// Upper bounds found from the reduced costs of the root.
+  DoubleVector gub_;
+
   /// previous best known objective value (for root-node based Reduced Costs)
   double lastBest_;
 
@@ -147,9 +156,11 @@ private:
   // \param[in] x[v->getIndex] value
   // \param[in] reduced cost of variable
   // \param[in] variable pointer
+  // \param[in] true if the reduced cost is from the root, and the bound is
+  // also saved as a global bound
   void rcfix_(RelaxationPtr rel, ModVector &r_mods,
              double bestobj,  const double rel_obj, double xval, double r,
-             VariablePtr v);
+             VariablePtr v, bool global);
 };
   typedef RCHandler* RCHandlerPtr;
 }
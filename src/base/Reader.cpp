@@ -10,10 +10,17 @@
  * \author Ashutosh Mahajan, IIT Bombay
  */
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
 #include <iomanip>
+#include <iterator>
 #include <sstream>
-#include <fstream>
-#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "MinotaurConfig.h"
 #include "Environment.h"
@@ -22,6 +29,7 @@
 #include "Logger.h"
 #include "Operations.h"
 #include "Problem.h"
+#include "QuadraticFunction.h"
 #include "Reader.h"
 
 using namespace Minotaur;
@@ -40,27 +48,48 @@ Reader::~Reader()
 }
 
 
+namespace {
+  /// Move p past blanks and return the next word of the line in w.
+  bool nextWord(const char *&p, const char *eol, std::string_view &w)
+  {
+    const char *b;
+
+    while (p < eol && (' ' == *p || '\t' == *p || '\r' == *p)) {
+      ++p;
+    }
+    if (p == eol) {
+      return false;
+    }
+    b = p;
+    while (p < eol && ' ' != *p && '\t' != *p && '\r' != *p) {
+      ++p;
+    }
+    w = std::string_view(b, p - b);
+    return true;
+  }
+}
+
+
 ProblemPtr Reader::readMps(std::string fname, int &err)
 {
-  std::ifstream fs;
-  std::string line, word, word2, word3, word4;
-  std::string rhsid = "";
-  std::string rangeid = "";
-  std::string bndid = "";  // second word of all lines in BOUNDS section must
+  std::string_view word, word2, word3, word4;
+  std::string_view rhsid, rangeid;
+  std::string_view bndid;  // second word of all lines in BOUNDS section must
                            // be common across the file.
-  std::string qcname;  //name of the row for QCMatrix
-  std::string oldcol = "";
-  std::istringstream iss;
-  int lcnt, m, r;
+  std::string_view oldcol;
+  std::string fbuf;  // contents of the file if it could not be mapped
+  std::string sense;
+  const char *data = 0, *p, *eol, *end;
+  size_t fsize = 0;
+  void *mapped = MAP_FAILED;
+  int fd, lcnt, m, r;
+  struct stat st;
   VariableType vtype = Continuous;
   std::vector<LinearFunctionPtr> lfs;
   std::vector<QuadraticFunctionPtr> qfs;
   std::vector<char> rowtypes;
   std::vector<std::string> rownamesvec;
   std::vector<double> rowrhs, rowranges;
-  std::string objname;
-  std::map<std::string, VariablePtr> colnames;
-  std::map<std::string, VariablePtr>::iterator cnit;
   VariablePtr v = NULL, v2 = NULL;
   FunctionPtr f;
   double dval, lb, ub;
@@ -70,9 +99,7 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
   MpsSec section = MpsNone;
   ObjectiveType ot = Minimize;
   double tstrt = env_->getTime();
-
-  // std::ios_base::sync_with_stdio(false); 
-  // std::cin.tie(NULL);
+  double wstrt = env_->getWTime();
 
   if (p_) {
     logger_->errStream() << me_ 
@@ -82,14 +109,36 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
   }
 
   err = 0;
-  fs.open(fname.c_str());
-  if (!fs.is_open()) {
+  fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0 || 0 != fstat(fd, &st)) {
     logger_->errStream() << me_ << "could not open file " << fname
                          << " for reading" << std::endl;
+    if (fd >= 0) {
+      close(fd);
+    }
     err = 1;
     return 0;
   }
 
+  // map the file into memory and parse it in place. Words are kept as views
+  // into the mapped file and no string is created for them, except for
+  // names of rows and columns. If the file can not be mapped (e.g. a pipe),
+  // read it into a buffer instead.
+  fsize = st.st_size;
+  if (fsize > 0) {
+    mapped = mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  if (MAP_FAILED != mapped) {
+    madvise(mapped, fsize, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(mapped);
+  } else {
+    std::ifstream fs(fname.c_str(), std::ios::binary);
+    fbuf.assign(std::istreambuf_iterator<char>(fs),
+                std::istreambuf_iterator<char>());
+    data = fbuf.data();
+    fsize = fbuf.size();
+  }
+  close(fd);
 
   logger_->msgStream(LogInfo)
       << me_ << "reading MPS file " << fname << std::endl;
@@ -99,12 +148,17 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
   vtype = Continuous;
   m = 0;
   lcnt = 0;
-  while (0 == err && MpsEnd != section && std::getline(fs, line)) {
-    iss.clear();    // deletes only flags internal to iss
-    iss.str(line);  // convert line into ifstream
+  end = data + fsize;
+  for (p = data; 0 == err && MpsEnd != section && p < end; p = eol + 1) {
+    const char *line = p;
+
+    eol = static_cast<const char *>(memchr(p, '\n', end - p));
+    if (!eol) {
+      eol = end;
+    }
     ++lcnt;
 
-    if (!(iss >> word)) {
+    if (!nextWord(p, eol, word)) {
       continue;  // empty line
     }
 
@@ -113,20 +167,21 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
     }
 
     // check if a new section starts
-    if (line[0] == word[0]) {  // we have no white space in the beginning
+    if (line == word.data()) {  // we have no white space in the beginning
       if (word == "NAME") {
         section = MpsNone;  // back to new unknown section. This should not be
                             // set to MpsName
         continue;
       } else if (word == "OBJSENSE") {
-        if (!(iss >> word2)) {
+        if (!nextWord(p, eol, word2)) {
           section = MpsSense; // sense is not written the current line, check
                               // the next line
         } else {
-          toLowerCase(word2);
-          if (word2 == "max") {
+          sense = word2;
+          toLowerCase(sense);
+          if (sense == "max") {
             ot = Maximize;
-          } else if (word2 == "min") {
+          } else if (sense == "min") {
             ot = Minimize;
           } else {
             logger_->msgStream(LogError)
@@ -168,7 +223,7 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       } else if (word == "QCMATRIX") {
         section = MpsQC;
         // read the name of the quad constraint now
-        if (!(iss >> word2)) {
+        if (!nextWord(p, eol, word2)) {
           logger_->errStream() << me_ << "ERROR: Missing row name in line "
                                << lcnt << std::endl;
           err = 10;
@@ -176,16 +231,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           r = getMpsRow_(word2); 
           if (r < 0) {
             rmap_[word2] = m;
-            rownamesvec.push_back(word2);
+            rownamesvec.push_back(std::string(word2));
             lfs.push_back(new LinearFunction());
             qfc = new QuadraticFunction();
             qfs.push_back(qfc);
             ++m;
           } else {
-            r = getMpsRow_(word2);
             qfc = qfs[r];
           }
-          qcname = word2;
         }
         continue;
       } else if (word == "ENDATA") {
@@ -201,14 +254,15 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
     case (MpsNone):
       logger_->errStream() << me_ << "error parsing the MPS file in line "
         << lcnt << std::endl
-        << line << std::endl;
+        << std::string_view(line, eol - line) << std::endl;
       err = 10;
       break;
     case (MpsSense):
-      toLowerCase(word);
-      if ( word == "max") {
+      sense = word;
+      toLowerCase(sense);
+      if (sense == "max") {
         ot = Maximize;
-      } else if (word == "min") {
+      } else if (sense == "min") {
         ot = Minimize;
       } else {
         logger_->errStream() << me_ << "Unexpected word " << word
@@ -226,14 +280,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
         rowrhs.push_back(INFINITY);
         rowranges.push_back(INFINITY);
 
-        if (!(iss >> word)) {  // read the next word
+        if (!nextWord(p, eol, word)) {  // read the next word
           logger_->errStream() << me_ << "ERROR: Missing row name in line "
                                << lcnt << std::endl;
           err = 10;
           break;
         } 
         r = getMpsRow_(word);
-        if (r < -1) {
+        if (r >= 0) {
           logger_->errStream()
             << me_ << "ERROR: Row " << word
             << " seen more than once in the ROWS section of MPS file "
@@ -242,7 +296,7 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           break;
         } 
         rmap_[word] = m;
-        rownamesvec.push_back(word);
+        rownamesvec.push_back(std::string(word));
         lfs.push_back(new LinearFunction());
         qfs.push_back(new QuadraticFunction());
         if ('N' == rowtypes[m] && !qfo) {
@@ -257,7 +311,7 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       break;
     case (MpsCols):  // COLUMNS
       // Read the next two words. Every line must have 3 or 5 words
-      if (!(iss >> word2) || !(iss >> word3)) {
+      if (!nextWord(p, eol, word2) || !nextWord(p, eol, word3)) {
         logger_->errStream() << me_ << "ERROR: not enough fields in column "
                              << "line " << lcnt << std::endl;
         err = 10;
@@ -303,12 +357,17 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           v =  getMpsVar_(word, vtype);
           oldcol = word;
         }
-        dval = std::stod(word3);
-        lfs[r]->addTerm(v, dval);
+        if (!getMpsNum_(word3, lcnt, dval)) {
+          err = 10;
+          break;
+        }
+        // columns are listed one after the other, so v usually comes after
+        // all the variables already in the row.
+        lfs[r]->appendTerm(v, dval);
 
         // we may have two more terms (but not one)
-        if (iss >> word2) {
-          if (!(iss >> word3)) {
+        if (nextWord(p, eol, word2)) {
+          if (!nextWord(p, eol, word3)) {
             logger_->errStream()
               << me_ << "ERROR: not enough fields in column "
               << "line " << lcnt << std::endl;
@@ -316,27 +375,30 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
             break;
           } 
           r = getMpsRow_(word2);
-          if (r < -1) {
+          if (r < 0) {
             logger_->errStream()
               << me_ << "ERROR: rowname " << word2 << " in line " << lcnt
               << " undeclared " << std::endl;
             err = 10;
             break;
           }
-          dval = std::stod(word3);
-          lfs[r]->addTerm(v, dval);
+          if (!getMpsNum_(word3, lcnt, dval)) {
+            err = 10;
+            break;
+          }
+          lfs[r]->appendTerm(v, dval);
         }
       }
       break;
     case (MpsRhs):  // RHS
-      if (rhsid == "") {
+      if (rhsid.empty()) {
         rhsid = word;
       } else if (word != rhsid) {
         logger_->msgStream(LogError)
             << me_ << rhsid << " ignored in line " << lcnt << std::endl;
         break;
       }
-      if (!(iss >> word2) || !(iss >> word3)) {
+      if (!nextWord(p, eol, word2) || !nextWord(p, eol, word3)) {
         logger_->errStream() << me_ << "ERROR: not enough fields in column "
                              << "line " << lcnt << std::endl;
         err = 10;
@@ -350,7 +412,10 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           << " undeclared " << std::endl;
         break;
       } 
-      dval = std::stod(word3);
+      if (!getMpsNum_(word3, lcnt, dval)) {
+        err = 10;
+        break;
+      }
       if (rowrhs[r] != INFINITY) {  // if previously set, warn
         logger_->msgStream(LogExtraInfo)
           << me_ << "Warning: overwriting rhs for row " << word2
@@ -359,8 +424,8 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       rowrhs[r] = dval;
 
       // we may have two more terms (but not one)
-      if (iss >> word2) {
-        if (!(iss >> word3)) {
+      if (nextWord(p, eol, word2)) {
+        if (!nextWord(p, eol, word3)) {
           logger_->errStream() << me_ << "ERROR: not enough fields in rhs "
             << "line " << lcnt << std::endl;
           err = 10;
@@ -375,7 +440,10 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           err = 10;
           break;
         }
-        dval = std::stod(word3);
+        if (!getMpsNum_(word3, lcnt, dval)) {
+          err = 10;
+          break;
+        }
         if (rowrhs[r] != INFINITY) {  // if previously set, warn
           logger_->msgStream(LogExtraInfo)
             << me_ << "Warning: overwriting rhs for row " << word2
@@ -385,14 +453,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       }
       break;
     case (MpsRang):  // RANGES
-      if (rangeid == "") {
+      if (rangeid.empty()) {
         rangeid = word;
       } else if (word != rangeid) {
         logger_->msgStream(LogError)
             << me_ << rangeid << " ignored in line " << lcnt << std::endl;
         break;
       }
-      if (!(iss >> word2) || !(iss >> word3)) {
+      if (!nextWord(p, eol, word2) || !nextWord(p, eol, word3)) {
         logger_->errStream() << me_ << "ERROR: not enough fields in ranges "
                              << "line " << lcnt << std::endl;
         err = 10;
@@ -405,7 +473,10 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           << " undeclared " << std::endl;
         break;
       } 
-      dval = std::stod(word3);
+      if (!getMpsNum_(word3, lcnt, dval)) {
+        err = 10;
+        break;
+      }
       if (rowranges[r] != INFINITY) {  // warn
         logger_->msgStream(LogExtraInfo)
           << me_ << "Warning: overwriting range for row " << word2
@@ -414,8 +485,8 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       rowranges[r] = dval;
 
       // we may have two more terms (but not one)
-      if (iss >> word2) {
-        if (!(iss >> word3)) {
+      if (nextWord(p, eol, word2)) {
+        if (!nextWord(p, eol, word3)) {
           logger_->errStream() << me_ << "ERROR: not enough fields in ranges "
                                << "line " << lcnt << std::endl;
           err = 10;
@@ -430,7 +501,10 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
           break;
         }
         
-        dval = std::stod(word3);
+        if (!getMpsNum_(word3, lcnt, dval)) {
+          err = 10;
+          break;
+        }
         if (rowranges[r] != INFINITY) {  // warn
           logger_->msgStream(LogExtraInfo)
               << me_ << "Warning: overwriting range for row " << word2
@@ -446,14 +520,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       // UP BND x1 40
       // UP BND x1 50
       // then the ub of x1 is set to 50.
-      if (!(iss >> word2) || !(iss >> word3)) {
+      if (!nextWord(p, eol, word2) || !nextWord(p, eol, word3)) {
         logger_->errStream() << me_ << "ERROR: not enough fields in BOUNDS "
                              << "line " << lcnt << std::endl;
         err = 10;
         break;
       } 
       
-      if (bndid == "") {
+      if (bndid.empty()) {
         bndid = word2;
       } else if (word2 != bndid) {
         logger_->msgStream(LogError)
@@ -465,11 +539,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       v =  getMpsVar_(word3, Continuous);
 
       dval = INFINITY;
-      if (iss >> word4) {
-        dval = std::stod(word4);
-      } else if (word3 == "LO" || word3 == "UP" || word3 == "FX") {
+      if (nextWord(p, eol, word4)) {
+        if (!getMpsNum_(word4, lcnt, dval)) {
+          err = 10;
+          break;
+        }
+      } else if (word == "LO" || word == "UP" || word == "FX") {
         logger_->msgStream(LogError)
-            << me_ << "ERROR: " << word3 << " key requires a number in line "
+            << me_ << "ERROR: " << word << " key requires a number in line "
             << lcnt << std::endl;
         err = 10;
         break;
@@ -511,29 +588,39 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       }
       break;
     case (MpsQO):  // Quadratic Objective
-      if (!(iss >> word2) || !(iss >> word3)) {
-        logger_->errStream() << me_ << "ERROR: not enough fields in QUADOBJ "
-                             << "line " << lcnt << std::endl;
-        err = 10;
-        break;
-      }
-      v = colnames[word];
-      v2 = colnames[word2];
-      dval = std::stod(word3);
-      qfo->incTerm(v, v2, dval * 0.5);
-      break;
     case (MpsQC):  // Quadratic Constraint
       // We should have three words in this row (var1 var2 coeff)
-      if (!(iss >> word2) || !(iss >> word3)) {
-        logger_->errStream() << me_ << "ERROR: not enough fields in QCMATRIX "
-                             << "line " << lcnt << std::endl;
+      if (!nextWord(p, eol, word2) || !nextWord(p, eol, word3)) {
+        logger_->errStream() << me_ << "ERROR: not enough fields in "
+                             << (MpsQO == section ? "QUADOBJ" : "QCMATRIX")
+                             << " line " << lcnt << std::endl;
         err = 10;
         break;
       } 
-      v = colnames[word];
-      v2 = colnames[word2];
-      dval = std::stod(word3);
-      qfc->incTerm(v, v2, dval);
+      v = findMpsVar_(word);
+      v2 = findMpsVar_(word2);
+      if (MpsQO == section && !qfo) {
+        logger_->errStream() << me_ << "ERROR: QUADOBJ section without "
+                             << "an objective row, line " << lcnt
+                             << std::endl;
+        err = 10;
+        break;
+      }
+      if (!v || !v2) {
+        logger_->errStream() << me_ << "ERROR: undeclared column in line "
+                             << lcnt << std::endl;
+        err = 10;
+        break;
+      }
+      if (!getMpsNum_(word3, lcnt, dval)) {
+        err = 10;
+        break;
+      }
+      if (MpsQO == section) {
+        qfo->incTerm(v, v2, dval * 0.5);
+      } else {
+        qfc->incTerm(v, v2, dval);
+      }
       break;
     case (MpsEnd):
       break;  // out of the mps file
@@ -545,7 +632,12 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       break;
     }
   }
-  fs.close();
+  // names in the maps point into the file, which is released now.
+  rmap_.clear();
+  vmap_.clear();
+  if (MAP_FAILED != mapped) {
+    munmap(mapped, st.st_size);
+  }
   env_->getLogger()->msgStream(LogDebug) << me_ 
     << "File closed " <<  env_->getTime() << std::endl;
 
@@ -606,9 +698,13 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
     }
   }
 
+  wstrt = env_->getWTime() - wstrt;
   env_->getLogger()->msgStream(LogInfo) << me_ 
     << "time used in reading file = " << std::fixed 
     << std::setprecision(2) << env_->getTime()-tstrt << " seconds." 
+    << std::endl
+    << me_ << "read " << fsize / 1048576.0 << " MB at "
+    << (wstrt > 0 ? fsize / 1048576.0 / wstrt : 0.0) << " MB/s."
     << std::endl;
 
   //p_->write(std::cout);
@@ -690,28 +786,59 @@ int Reader::readSol(ProblemPtr p, std::string sname)
   return err;
 }
 
-Variable* Reader::getMpsVar_(const std::string &s, VariableType vtype)
+Variable* Reader::findMpsVar_(std::string_view s)
+{
+  std::unordered_map<std::string_view, Variable *>::iterator it =
+    vmap_.find(s);
+
+  if (it == vmap_.end()) {
+    return NULL;
+  }
+  return it->second;
+}
+
+
+bool Reader::getMpsNum_(std::string_view s, int lcnt, double &val)
+{
+  char buf[64];
+  char *end;
+
+  // s is not null-terminated, and may end at the end of the mapped file.
+  if (s.size() > 0 && s.size() < sizeof(buf)) {
+    memcpy(buf, s.data(), s.size());
+    buf[s.size()] = '\0';
+    val = strtod(buf, &end);
+    if (end == buf + s.size()) {
+      return true;
+    }
+  }
+  logger_->errStream() << me_ << "ERROR: " << s << " is not a number, line "
+                       << lcnt << std::endl;
+  return false;
+}
+
+
+Variable* Reader::getMpsVar_(std::string_view s, VariableType vtype)
 {
   Variable *v = NULL;
-  std::map<std::string, Variable *>::iterator it = vmap_.find(s);
+  std::unordered_map<std::string_view, Variable *>::iterator it =
+    vmap_.find(s);
 
   if (it != vmap_.end()) {
     v = it->second;
   } else {
-    v = p_->newVariable(0, INFINITY, vtype, s);
+    v = p_->newVariable(0, INFINITY, vtype, std::string(s));
     vmap_[s] = v;
   }
   return v;
 }
 
-int Reader::getMpsRow_(const std::string &s)
+int Reader::getMpsRow_(std::string_view s)
 {
-  std::map<std::string, int>::iterator it = rmap_.find(s);
+  std::unordered_map<std::string_view, int>::iterator it = rmap_.find(s);
 
   if (it == rmap_.end()) {
     return -1;
   } 
   return it->second;
 }
-
-
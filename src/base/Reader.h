@@ -15,6 +15,8 @@
 #define MINOTAURREADER_H
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "Types.h"
 #include "Variable.h"
 
@@ -28,7 +30,9 @@ namespace Minotaur {
   /**
    * \brief Read an LP or MILP instance from an MPS file
    *
-   * MPS files are read following the CPLEX 12.8 documentation
+   * MPS files are read following the CPLEX 12.8 documentation. The file is
+   * mapped into memory and parsed in place, so that large files can be read
+   * quickly.
    */
   class Reader {
   public:
@@ -68,22 +72,32 @@ namespace Minotaur {
       MpsEnd
     };
 
-    /// Map of row-names (constraints and objective) and the row number
-    std::map<std::string, int> rmap_;
+    /// Map of row-names (constraints and objective) and the row number.
+    /// Names point into the file being read.
+    std::unordered_map<std::string_view, int> rmap_;
 
-    /// Map of column-names (variable names) and pointer to variable
-    std::map<std::string, Variable *> vmap_;
+    /// Map of column-names (variable names) and pointer to variable. Names
+    /// point into the file being read.
+    std::unordered_map<std::string_view, Variable *> vmap_;
 
     /// Problem that is being constructed
     Problem *p_;
 
+    /// Get variable pointer for the given name. If the variable does not
+    /// exist, then NULL is returned.
+    Variable *findMpsVar_(std::string_view s);
+
+    /// Convert s into val. If s is not a number, report an error for line
+    /// lcnt and return false.
+    bool getMpsNum_(std::string_view s, int lcnt, double &val);
+
     /// Get variable pointer for the given name. If the variable does not
     /// exist, then it is created.
-    Variable *getMpsVar_(const std::string &s, VariableType vtype);
+    Variable *getMpsVar_(std::string_view s, VariableType vtype);
 
     /// Get row number (>= 0) for the given name. If the row does not exist,
     /// then it returns -1.
-    int getMpsRow_(const std::string &s);
+    int getMpsRow_(std::string_view s);
   };
 }
 
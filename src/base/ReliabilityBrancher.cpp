@@ -32,6 +32,7 @@
 #include "Solution.h"
 #include "SolutionPool.h"
 #include "Timer.h"
+#include "VarBoundMod.h"
 #include "Variable.h"
 
 //#define SPEW 1
@@ -201,6 +202,7 @@ Branches ReliabilityBrancher::findBranches(RelaxationPtr rel, NodePtr node,
         br_iter != branches->end(); ++br_iter) {
       (*br_iter)->setBrCand(br_can);
     }
+    setEstimates_(branches, br_can, sol->getObjValue());
 #if SPEW
     logger_->msgStream(LogDebug)
         << me_ << "best candidate = " << br_can->getName() << std::endl;
@@ -397,6 +399,67 @@ void ReliabilityBrancher::initialize(RelaxationPtr rel)
   x_.reserve(n);
 }
 
+void ReliabilityBrancher::setEstimates_(Branches branches, BrCandPtr br_can,
+                                        double objval)
+{
+  int index = br_can->getPCostIndex();
+  double avg_down = 0., avg_up = 0.;
+  UInt n_down = 0, n_up = 0;
+  double est = objval;
+  double pc_down, pc_up;
+  VarBoundModPtr mod;
+  bool is_down;
+
+  if(index < 0 || std::isinf(objval)) {
+    return;
+  }
+
+  for(UInt i = 0; i < pseudoDown_.size(); ++i) {
+    if(timesDown_[i] > 0) {
+      avg_down += pseudoDown_[i];
+      ++n_down;
+    }
+    if(timesUp_[i] > 0) {
+      avg_up += pseudoUp_[i];
+      ++n_up;
+    }
+  }
+  avg_down = (n_down > 0) ? avg_down / n_down : 0.;
+  avg_up = (n_up > 0) ? avg_up / n_up : 0.;
+
+  for(UInt k = 0; k < 2; ++k) {
+    BrCandVector& cands = (0 == k) ? relCands_ : unrelCands_;
+    for(BrCandVIter it = cands.begin(); it != cands.end(); ++it) {
+      int i = (*it)->getPCostIndex();
+      if(*it == br_can || i < 0) {
+        continue;
+      }
+      pc_down = (timesDown_[i] > 0) ? pseudoDown_[i] : avg_down;
+      pc_up = (timesUp_[i] > 0) ? pseudoUp_[i] : avg_up;
+      est += std::min((*it)->getDDist() * pc_down, (*it)->getUDist() * pc_up);
+    }
+  }
+
+  pc_down = (timesDown_[index] > 0) ? pseudoDown_[index] : avg_down;
+  pc_up = (timesUp_[index] > 0) ? pseudoUp_[index] : avg_up;
+  for(BranchConstIterator br_iter = branches->begin();
+      br_iter != branches->end(); ++br_iter) {
+    // the direction of a branch is that of its bound change.
+    mod = 0;
+    if((*br_iter)->rModsBegin() != (*br_iter)->rModsEnd()) {
+      mod = dynamic_cast<VarBoundModPtr>(*((*br_iter)->rModsBegin()));
+    } else if((*br_iter)->pModsBegin() != (*br_iter)->pModsEnd()) {
+      mod = dynamic_cast<VarBoundModPtr>(*((*br_iter)->pModsBegin()));
+    }
+    if(!mod) {
+      continue;
+    }
+    is_down = (Upper == mod->getLU());
+    (*br_iter)->setEstimate(est + (is_down ? br_can->getDDist() * pc_down
+                                           : br_can->getUDist() * pc_up));
+  }
+}
+
 void ReliabilityBrancher::setTrustCutoff(bool val)
 {
   trustCutoff_ = val;
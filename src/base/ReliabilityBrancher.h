@@ -161,6 +161,19 @@ private:
   void getPCScore_(BrCandPtr cand, double *ch_down, double *ch_up, 
                    double *score);
 
+  /**
+   * \brief Set the estimate of each branch for best-estimate search.
+   *
+   * The estimate of a child is objval plus, for each fractional candidate,
+   * the smaller of the changes predicted by its down and up pseudo costs,
+   * except that the change in the direction of the branch is used for
+   * br_can. Variables without pseudo costs get the average ones.
+   * \param[in] branches The branches created from br_can.
+   * \param[in] br_can The candidate that is branched on.
+   * \param[in] objval The objective value of the relaxation at the node.
+   */
+  void setEstimates_(Branches branches, BrCandPtr br_can, double objval);
+
   /**
    * \brief Calculate score from the up score and down score.
    *
@@ -72,6 +72,9 @@ public:
   bool isGUB(SOS *sos);
   bool isNeeded();
 
+  /// separate() only sets the status, so it can run with other handlers.
+  bool isSepThreadSafe() const { return true; };
+
   /// Presolve. Do not do any presolving.
   SolveStatus presolve(PreModQ *, bool *, Solution **) {return Finished;};
 
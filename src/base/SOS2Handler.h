@@ -71,6 +71,9 @@ public:
       
   bool isNeeded();
 
+  /// separate() only sets the status, so it can run with other handlers.
+  bool isSepThreadSafe() const { return true; };
+
   /// Presolve. Do not do any presolving.
   SolveStatus presolve(PreModQ *, bool *, Solution **) {return Finished;};
 
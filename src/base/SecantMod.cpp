@@ -18,6 +18,7 @@
 #include "MinotaurConfig.h"
 #include "Operations.h"
 #include "SecantMod.h"
+#include "SlabAlloc.h"
 #include "Variable.h"
 
 using namespace Minotaur;
@@ -51,6 +52,25 @@ SecantMod::~SecantMod()
 }
 
 
+static SlabAlloc *secantModAlloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("SecantMod", sizeof(SecantMod));
+  return a;
+}
+
+
+void *SecantMod::operator new(size_t size)
+{
+  return secantModAlloc_()->alloc(size);
+}
+
+
+void SecantMod::operator delete(void *p, size_t size)
+{
+  secantModAlloc_()->free(p, size);
+}
+
+
 VariablePtr SecantMod::getY()
 {
   return ymod_->getVar();
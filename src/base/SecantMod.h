@@ -43,6 +43,12 @@ namespace Minotaur {
     /// Destroy.
     ~SecantMod();
 
+    /// Allocate from a SlabAlloc shared by all objects of this class.
+    static void *operator new(size_t size);
+
+    /// Return memory allocated by operator new.
+    static void operator delete(void *p, size_t size);
+
     // Implement Modification::applyToProblem()
     void applyToProblem(ProblemPtr problem);
 
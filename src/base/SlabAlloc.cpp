@@ -0,0 +1,219 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file SlabAlloc.cpp
+ * \brief Define the SlabAlloc class that allocates small objects of one
+ * size from large slabs.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <new>
+
+#include "MinotaurConfig.h"
+#include "SlabAlloc.h"
+
+using namespace Minotaur;
+
+thread_local SlabAlloc::ThreadCaches SlabAlloc::caches_;
+
+namespace {
+  /// All allocators, created by SlabAlloc::get(). Never deleted.
+  std::vector<SlabAlloc *> *allocs_ = 0;
+  std::mutex allocsMtx_;
+}
+
+SlabAlloc::SlabAlloc(const std::string &name, size_t size, UInt id)
+  : id_(id),
+    name_(name),
+    size_(size),
+    slabs_(0)
+{
+  const size_t a = alignof(std::max_align_t);
+
+  step_ = (size < sizeof(void *)) ? sizeof(void *) : size;
+  step_ = ((step_ + a - 1) / a) * a;
+}
+
+
+void *SlabAlloc::alloc(size_t size)
+{
+  Cache *c;
+  void *p;
+
+  if (size != size_) {
+    return ::operator new(size);
+  }
+  c = cache_();
+  if (c->free) {
+    p = c->free;
+    c->free = *(static_cast<void **>(p));
+  } else {
+    if (c->next == c->end) {
+      newSlab_(c);
+    }
+    p = c->next;
+    c->next += step_;
+  }
+  c->allocs.store(c->allocs.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  return p;
+}
+
+
+SlabAlloc::Cache *SlabAlloc::cache_()
+{
+  Cache *c = caches_.c[id_];
+
+  if (!c) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (orphans_.empty()) {
+      c = new Cache();
+      c->free = 0;
+      c->next = 0;
+      c->end = 0;
+      c->allocs = 0;
+      c->frees = 0;
+      allCaches_.push_back(c);
+    } else {
+      c = orphans_.back();
+      orphans_.pop_back();
+    }
+    caches_.c[id_] = c;
+  }
+  return c;
+}
+
+
+void SlabAlloc::free(void *p, size_t size)
+{
+  Cache *c;
+
+  if (!p) {
+    return;
+  }
+  if (size != size_) {
+    ::operator delete(p);
+    return;
+  }
+  c = cache_();
+  *(static_cast<void **>(p)) = c->free;
+  c->free = p;
+  c->frees.store(c->frees.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+}
+
+
+SlabAlloc *SlabAlloc::get(const std::string &name, size_t size)
+{
+  std::lock_guard<std::mutex> lock(allocsMtx_);
+  SlabAlloc *a;
+
+  if (!allocs_) {
+    allocs_ = new std::vector<SlabAlloc *>();
+  }
+  for (std::vector<SlabAlloc *>::iterator it = allocs_->begin();
+       it != allocs_->end(); ++it) {
+    if ((*it)->name_ == name && (*it)->size_ == size) {
+      return *it;
+    }
+  }
+  assert(allocs_->size() < maxAllocs_);
+  a = new SlabAlloc(name, size, allocs_->size());
+  allocs_->push_back(a);
+  return a;
+}
+
+
+SlabAlloc *SlabAlloc::getById_(UInt id)
+{
+  std::lock_guard<std::mutex> lock(allocsMtx_);
+  return (*allocs_)[id];
+}
+
+
+UInt SlabAlloc::getNumAllocs() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  UInt n = 0;
+
+  for (std::vector<Cache *>::const_iterator it = allCaches_.begin();
+       it != allCaches_.end(); ++it) {
+    n += (*it)->allocs.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+
+UInt SlabAlloc::getNumLive() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  UInt allocs = 0;
+  UInt frees = 0;
+
+  // an object may be freed by another thread than the one that allocated it.
+  for (std::vector<Cache *>::const_iterator it = allCaches_.begin();
+       it != allCaches_.end(); ++it) {
+    allocs += (*it)->allocs.load(std::memory_order_relaxed);
+    frees += (*it)->frees.load(std::memory_order_relaxed);
+  }
+  return allocs - frees;
+}
+
+
+void SlabAlloc::newSlab_(Cache *c)
+{
+  c->next = static_cast<char *>(::operator new(step_ * slabObjs_));
+  c->end = c->next + step_ * slabObjs_;
+  std::lock_guard<std::mutex> lock(mtx_);
+  ++slabs_;
+}
+
+
+void SlabAlloc::writeStats(std::ostream &out)
+{
+  std::lock_guard<std::mutex> lock(allocsMtx_);
+  const std::string me = "SlabAlloc: ";
+  UInt slabs;
+
+  if (!allocs_) {
+    return;
+  }
+  for (std::vector<SlabAlloc *>::const_iterator it = allocs_->begin();
+       it != allocs_->end(); ++it) {
+    {
+      std::lock_guard<std::mutex> lock2((*it)->mtx_);
+      slabs = (*it)->slabs_;
+    }
+    out << me << (*it)->name_ << " allocated = " << (*it)->getNumAllocs()
+        << ", live = " << (*it)->getNumLive()
+        << ", slabs = " << slabs << std::endl;
+  }
+}
+
+
+SlabAlloc::ThreadCaches::ThreadCaches()
+{
+  std::fill(c, c + maxAllocs_, (Cache *)0);
+}
+
+
+SlabAlloc::ThreadCaches::~ThreadCaches()
+{
+  SlabAlloc *a;
+
+  for (UInt i = 0; i < maxAllocs_; ++i) {
+    if (c[i]) {
+      a = getById_(i);
+      std::lock_guard<std::mutex> lock(a->mtx_);
+      a->orphans_.push_back(c[i]);
+      c[i] = 0;
+    }
+  }
+}
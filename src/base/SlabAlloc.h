@@ -0,0 +1,144 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file SlabAlloc.h
+ * \brief Declare the SlabAlloc class that allocates small objects of one
+ * size from large slabs.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURSLABALLOC_H
+#define MINOTAURSLABALLOC_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Allocate objects of one size from slabs instead of calling the
+   * global operator new for each of them.
+   *
+   * The tree search creates a modification (VarBoundMod, LinConMod etc.)
+   * for every change in a bound or a coefficient, and a Node and Branch for
+   * every child. These are small and deleted soon after, when the subtree
+   * is pruned. A class declares its own operator new and delete that call
+   * alloc() and free() of one SlabAlloc of its size.
+   *
+   * Each thread has its own list of free objects and its own slab, so that
+   * no lock is taken except when a thread gets a new slab. An object freed
+   * by a thread goes to the list of that thread and is reused there. When a
+   * thread exits, its lists are kept for the next new thread. Slabs
+   * are never returned to the system: the memory of a pruned subtree is
+   * reused by the next nodes. Objects of other sizes (of derived classes)
+   * are passed to the global operator new.
+   *
+   * Allocators are created by get() and are never deleted, so that objects
+   * can be deleted at any time, even while static objects are destroyed.
+   */
+  class SlabAlloc {
+  public:
+    /**
+     * \brief Return the allocator for objects of a given size. Allocators
+     * are created on the first call for each name.
+     *
+     * \param[in] name Name of the class, used in writeStats().
+     * \param[in] size Size of the objects, i.e., sizeof(class).
+     */
+    static SlabAlloc *get(const std::string &name, size_t size);
+
+    /// Return memory for an object of given size.
+    void *alloc(size_t size);
+
+    /// Free memory returned by alloc() with the same size.
+    void free(void *p, size_t size);
+
+    /// Return the number of objects allocated by all threads so far.
+    UInt getNumAllocs() const;
+
+    /// Return the number of objects not yet freed.
+    UInt getNumLive() const;
+
+    /// Write the statistics of all allocators.
+    static void writeStats(std::ostream &out);
+
+  private:
+    /// Free list, slab and counts of one thread for one allocator.
+    struct Cache {
+      void *free;                  /// First free object, or NULL.
+      char *next;                  /// Next unused object in the slab.
+      char *end;                   /// End of the slab.
+      std::atomic<UInt> allocs;    /// Objects allocated by this thread.
+      std::atomic<UInt> frees;     /// Objects freed by this thread.
+    };
+
+    /// Maximum number of allocators.
+    static const UInt maxAllocs_ = 16;
+
+    /// Number of objects in a slab.
+    static const UInt slabObjs_ = 1024;
+
+    /// Caches of a thread, one for each allocator.
+    struct ThreadCaches {
+      Cache *c[maxAllocs_];        /// Cache for each allocator, or NULL.
+      ThreadCaches();
+      /// Give the caches to their allocators when the thread exits.
+      ~ThreadCaches();
+    };
+
+    /// Caches of the calling thread.
+    static thread_local ThreadCaches caches_;
+
+    /// Caches of all threads.
+    std::vector<Cache *> allCaches_;
+
+    /// Caches of threads that have exited, to be used by new threads.
+    std::vector<Cache *> orphans_;
+
+    /// Index of this allocator in caches_.
+    UInt id_;
+
+    /// Lock for allCaches_ and slabs_.
+    mutable std::mutex mtx_;
+
+    /// Name of the class.
+    std::string name_;
+
+    /// Size of the objects asked for.
+    size_t size_;
+
+    /// Size of the objects given, a multiple of the alignment.
+    size_t step_;
+
+    /// Number of slabs allocated.
+    UInt slabs_;
+
+    /// Constructor.
+    SlabAlloc(const std::string &name, size_t size, UInt id);
+
+    /// Return the cache of the calling thread.
+    Cache *cache_();
+
+    /// Return the allocator with a given index.
+    static SlabAlloc *getById_(UInt id);
+
+    /// Get a new slab for the cache c.
+    void newSlab_(Cache *c);
+
+    /// Copy constructor is not allowed.
+    SlabAlloc(const SlabAlloc &);
+
+    /// Copy by assignment is not allowed.
+    SlabAlloc &operator=(const SlabAlloc &);
+  };
+}
+#endif
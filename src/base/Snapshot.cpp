@@ -0,0 +1,679 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Snapshot.cpp
+ * \brief Define the Snapshot class that saves a presolved problem in a
+ * binary file and loads it back.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Objective.h"
+#include "PreAuxVars.h"
+#include "PreDelVars.h"
+#include "PreSubstVars.h"
+#include "Presolver.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "Snapshot.h"
+#include "SOS.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string Snapshot::me_ = "Snapshot: ";
+
+namespace {
+  /// First bytes of every snapshot.
+  const char snapMagic[8] = {'M', 'N', 'T', 'R', 'S', 'N', 'A', 'P'};
+
+  /// Incremented whenever the format changes.
+  const UInt snapVersion = 1;
+
+  /// Written as an integer to detect files from machines of other byte
+  /// order.
+  const UInt snapEndian = 0x01020304;
+
+  /// Kinds of post-solve modifications.
+  enum SnapMod { SnapDelVars = 1, SnapSubstVars, SnapAuxVars };
+
+  /// Parts of a function that are present.
+  enum SnapFun { SnapLin = 1, SnapQuad = 2, SnapNl = 4 };
+
+  template <class T> void put(std::ostream &out, const T &v)
+  {
+    out.write(reinterpret_cast<const char *>(&v), sizeof(T));
+  }
+
+  void putString(std::ostream &out, const std::string &s)
+  {
+    put(out, (UInt)s.size());
+    out.write(s.data(), s.size());
+  }
+}
+
+
+Snapshot::Snapshot(EnvPtr env)
+  : cur_(0),
+    end_(0),
+    env_(env)
+{
+}
+
+
+Snapshot::~Snapshot()
+{
+  vars_.clear();
+}
+
+
+bool Snapshot::get_(void *dst, size_t n)
+{
+  if ((size_t)(end_ - cur_) < n) {
+    return false;
+  }
+  memcpy(dst, cur_, n);
+  cur_ += n;
+  return true;
+}
+
+
+CGraph* Snapshot::getCGraph_(bool &ok)
+{
+  CGraph *cg = new CGraph();
+  std::vector<CNode *> nodes;
+  std::vector<CNode *> childr;
+  UInt nnodes, nchild, j;
+  int op;
+  double d;
+
+  ok = getUInt_(UINT_MAX, nnodes);
+  nodes.reserve(nnodes);
+  for (UInt i = 0; ok && i < nnodes; ++i) {
+    ok = get_(&op, sizeof(int)) && getUInt_(UINT_MAX, nchild);
+    if (!ok) {
+      break;
+    }
+    switch (op) {
+    case OpNum:
+      ok = get_(&d, sizeof(double));
+      nodes.push_back(cg->newNode(d));
+      break;
+    case OpInt:
+      ok = get_(&d, sizeof(double));
+      nodes.push_back(cg->newNode((int)d));
+      break;
+    case OpVar:
+      ok = getUInt_(vars_.size(), j);
+      nodes.push_back(ok ? cg->newNode(vars_[j]) : 0);
+      break;
+    default:
+      // children are written before their parents.
+      childr.clear();
+      for (UInt k = 0; ok && k < nchild; ++k) {
+        ok = getUInt_(i, j);
+        childr.push_back(ok ? nodes[j] : 0);
+      }
+      if (!ok || (OpNone == op || op > OpVar)) {
+        ok = false;
+      } else if (nchild > 2 || OpSumList == op) {
+        nodes.push_back(cg->newNode((OpCode)op, childr.data(), nchild));
+      } else if (nchild > 0) {
+        nodes.push_back(cg->newNode((OpCode)op, childr[0],
+                                    (nchild > 1) ? childr[1] : 0));
+      } else {
+        ok = false;
+      }
+      break;
+    }
+  }
+  if (ok && nnodes > 0) {
+    cg->setOut(nodes.back());
+    cg->finalize();
+  } else {
+    ok = false;
+    delete cg;
+    cg = 0;
+  }
+  return cg;
+}
+
+
+FunctionPtr Snapshot::getFunction_(bool &ok)
+{
+  LinearFunctionPtr lf = 0;
+  QuadraticFunctionPtr qf = 0;
+  CGraph *cg = 0;
+  UInt flags = 0, n, j, k;
+  double a;
+
+  ok = getUInt_(8, flags);
+  if (ok && (flags & SnapLin)) {
+    lf = new LinearFunction();
+    ok = getUInt_(UINT_MAX, n);
+    for (UInt i = 0; ok && i < n; ++i) {
+      ok = getUInt_(vars_.size(), j) && get_(&a, sizeof(double));
+      if (ok) {
+        lf->appendTerm(vars_[j], a);
+      }
+    }
+  }
+  if (ok && (flags & SnapQuad)) {
+    qf = new QuadraticFunction();
+    ok = getUInt_(UINT_MAX, n);
+    for (UInt i = 0; ok && i < n; ++i) {
+      ok = getUInt_(vars_.size(), j) && getUInt_(vars_.size(), k) &&
+           get_(&a, sizeof(double));
+      if (ok) {
+        qf->addTerm(vars_[j], vars_[k], a);
+      }
+    }
+  }
+  if (ok && (flags & SnapNl)) {
+    cg = getCGraph_(ok);
+  }
+  if (!ok) {
+    delete lf;
+    delete qf;
+    delete cg;
+    return 0;
+  }
+  return new Function(lf, qf, cg);
+}
+
+
+bool Snapshot::getMods_(PreModQ &mods)
+{
+  UInt nmods, kind, n, j;
+  bool ok = getUInt_(UINT_MAX, nmods);
+
+  for (UInt i = 0; ok && i < nmods; ++i) {
+    ok = getUInt_(SnapAuxVars + 1, kind) && getUInt_(UINT_MAX, n);
+    if (!ok) {
+      break;
+    }
+    if (SnapDelVars == kind) {
+      PreDelVarsPtr m = new PreDelVars();
+      mods.push_back(m);
+      // written from the front of the queue, and insert() pushes to the
+      // front.
+      std::vector<std::pair<UInt, double> > data(n);
+      for (UInt l = 0; ok && l < n; ++l) {
+        ok = getUInt_(UINT_MAX, data[l].first) &&
+             get_(&data[l].second, sizeof(double));
+      }
+      for (UInt l = n; ok && l > 0; --l) {
+        m->insert(data[l - 1].first, data[l - 1].second);
+      }
+    } else if (SnapSubstVars == kind) {
+      PreSubstVarsPtr m = new PreSubstVars();
+      mods.push_back(m);
+      std::vector<std::pair<UInt, UInt> > inds(n);
+      DoubleVector rats(n);
+      for (UInt l = 0; ok && l < n; ++l) {
+        ok = getUInt_(UINT_MAX, inds[l].first) &&
+             getUInt_(UINT_MAX, inds[l].second) &&
+             get_(&rats[l], sizeof(double));
+      }
+      for (UInt l = n; ok && l > 0; --l) {
+        m->insert(inds[l - 1].first, inds[l - 1].second, rats[l - 1]);
+      }
+    } else if (SnapAuxVars == kind) {
+      PreAuxVarsPtr m = new PreAuxVars();
+      mods.push_back(m);
+      for (UInt l = 0; ok && l < n; ++l) {
+        ok = getUInt_(vars_.size(), j);
+        if (ok) {
+          m->insert(vars_[j]);
+        }
+      }
+    } else {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+
+bool Snapshot::getString_(std::string &s)
+{
+  UInt n;
+
+  if (!get_(&n, sizeof(UInt)) || (size_t)(end_ - cur_) < n) {
+    return false;
+  }
+  s.assign(cur_, n);
+  cur_ += n;
+  return true;
+}
+
+
+bool Snapshot::getUInt_(UInt lim, UInt &i)
+{
+  return get_(&i, sizeof(UInt)) && i < lim;
+}
+
+
+int Snapshot::putCGraph_(std::ostream &out, CGraph *cg)
+{
+  std::unordered_map<const CNode *, UInt> ids;
+  std::vector<std::pair<const CNode *, bool> > st;
+  std::vector<const CNode *> order;
+  std::vector<const CNode *> ch;
+  const CNode *n;
+
+  if (!cg->getOut()) {
+    return 1;
+  }
+
+  // post-order traversal, so that children are written before parents and
+  // shared nodes are written once.
+  st.push_back(std::make_pair(cg->getOut(), false));
+  while (!st.empty()) {
+    n = st.back().first;
+    if (ids.count(n)) {
+      st.pop_back();
+      continue;
+    }
+    if (st.back().second) {
+      st.pop_back();
+      ids[n] = order.size();
+      order.push_back(n);
+      continue;
+    }
+    st.back().second = true;
+    if (n->getListL()) {
+      for (CNode **c = n->getListL(); c != n->getListR(); ++c) {
+        st.push_back(std::make_pair(*c, false));
+      }
+    } else {
+      if (n->getR()) {
+        st.push_back(std::make_pair(n->getR(), false));
+      }
+      if (n->getL()) {
+        st.push_back(std::make_pair(n->getL(), false));
+      }
+    }
+  }
+
+  put(out, (UInt)order.size());
+  for (std::vector<const CNode *>::iterator it = order.begin();
+       it != order.end(); ++it) {
+    n = *it;
+    ch.clear();
+    if (n->getListL()) {
+      ch.assign(n->getListL(), n->getListR());
+    } else {
+      if (n->getL()) {
+        ch.push_back(n->getL());
+      }
+      if (n->getR()) {
+        ch.push_back(n->getR());
+      }
+    }
+    put(out, (int)n->getOp());
+    put(out, (UInt)ch.size());
+    switch (n->getOp()) {
+    case OpNum:
+      put(out, n->getDouble());
+      break;
+    case OpInt:
+      put(out, n->getVal());
+      break;
+    case OpVar:
+      put(out, (UInt)n->getV()->getIndex());
+      break;
+    default:
+      for (UInt i = 0; i < ch.size(); ++i) {
+        put(out, ids[ch[i]]);
+      }
+      break;
+    }
+  }
+  return 0;
+}
+
+
+int Snapshot::putFunction_(std::ostream &out, FunctionPtr f)
+{
+  LinearFunctionPtr lf = f ? f->getLinearFunction() : 0;
+  QuadraticFunctionPtr qf = f ? f->getQuadraticFunction() : 0;
+  NonlinearFunctionPtr nlf = f ? f->getNonlinearFunction() : 0;
+  CGraph *cg = dynamic_cast<CGraph *>(nlf);
+  UInt flags = 0;
+
+  if (nlf && !cg) {
+    return 1;
+  }
+  if (lf) {
+    flags |= SnapLin;
+  }
+  if (qf) {
+    flags |= SnapQuad;
+  }
+  if (cg) {
+    flags |= SnapNl;
+  }
+  put(out, flags);
+  if (lf) {
+    put(out, (UInt)lf->getNumTerms());
+    for (VariableGroupConstIterator it = lf->termsBegin();
+         it != lf->termsEnd(); ++it) {
+      put(out, (UInt)it->first->getIndex());
+      put(out, it->second);
+    }
+  }
+  if (qf) {
+    put(out, (UInt)qf->getNumTerms());
+    for (VariablePairGroupConstIterator it = qf->begin(); it != qf->end();
+         ++it) {
+      put(out, (UInt)it->first.first->getIndex());
+      put(out, (UInt)it->first.second->getIndex());
+      put(out, it->second);
+    }
+  }
+  if (cg) {
+    return putCGraph_(out, cg);
+  }
+  return 0;
+}
+
+
+int Snapshot::putMods_(std::ostream &out, const PreModQ &mods)
+{
+  PreDelVarsPtr dmod;
+  PreSubstVarsPtr smod;
+  PreAuxVarsPtr amod;
+
+  put(out, (UInt)mods.size());
+  for (PreModQConstIter m = mods.begin(); m != mods.end(); ++m) {
+    if ((dmod = dynamic_cast<PreDelVarsPtr>(*m))) {
+      put(out, (UInt)SnapDelVars);
+      put(out, (UInt)std::distance(dmod->varsBegin(), dmod->varsEnd()));
+      for (VarQueueConstIter it = dmod->varsBegin(); it != dmod->varsEnd();
+           ++it) {
+        put(out, (UInt)(*it)->getIndex());
+        put(out, (*it)->getLb());
+      }
+    } else if ((smod = dynamic_cast<PreSubstVarsPtr>(*m))) {
+      put(out, (UInt)SnapSubstVars);
+      put(out, (UInt)std::distance(smod->begin(), smod->end()));
+      for (std::deque<PreSubstVarData *>::const_iterator it = smod->begin();
+           it != smod->end(); ++it) {
+        put(out, (UInt)(*it)->vout->getIndex());
+        put(out, (*it)->vinInd);
+        put(out, (*it)->rat);
+      }
+    } else if ((amod = dynamic_cast<PreAuxVarsPtr>(*m))) {
+      put(out, (UInt)SnapAuxVars);
+      put(out, (UInt)std::distance(amod->varsBegin(), amod->varsEnd()));
+      for (std::deque<VariablePtr>::const_iterator it = amod->varsBegin();
+           it != amod->varsEnd(); ++it) {
+        put(out, (UInt)(*it)->getIndex());
+      }
+    } else {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+ProblemPtr Snapshot::read(std::string fname, UInt norig, UInt morig,
+                          PreModQ &mods, int &err)
+{
+  std::string fbuf;  // contents of the file if it could not be mapped
+  void *mapped = MAP_FAILED;
+  struct stat st;
+  size_t fsize = 0;
+  char magic[8];
+  UInt version, endian, nsnap, msnap, n, type, stype, prio;
+  double lb, ub, cb;
+  std::string name;
+  ProblemPtr p = 0;
+  FunctionPtr f;
+  ConstraintPtr c;
+  VarVector svars;
+  DoubleVector weights;
+  bool ok;
+  int fd;
+  double tstrt = env_->getTime();
+
+  err = 0;
+  fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0 || 0 != fstat(fd, &st)) {
+    env_->getLogger()->errStream() << me_ << "could not open file " << fname
+                                   << " for reading" << std::endl;
+    if (fd >= 0) {
+      close(fd);
+    }
+    err = 1;
+    return 0;
+  }
+  fsize = st.st_size;
+  if (fsize > 0) {
+    mapped = mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  if (MAP_FAILED != mapped) {
+    madvise(mapped, fsize, MADV_SEQUENTIAL);
+    cur_ = static_cast<const char *>(mapped);
+  } else {
+    std::ifstream fs(fname.c_str(), std::ios::binary);
+    fbuf.assign(std::istreambuf_iterator<char>(fs),
+                std::istreambuf_iterator<char>());
+    cur_ = fbuf.data();
+    fsize = fbuf.size();
+  }
+  close(fd);
+  end_ = cur_ + fsize;
+
+  ok = get_(magic, sizeof(magic)) &&
+       0 == memcmp(magic, snapMagic, sizeof(magic)) &&
+       get_(&version, sizeof(UInt)) && get_(&endian, sizeof(UInt));
+  if (!ok || snapVersion != version || snapEndian != endian) {
+    env_->getLogger()->errStream() << me_ << fname << " is not a snapshot "
+      << "of version " << snapVersion << " written on this machine"
+      << std::endl;
+    err = 2;
+  } else if (!get_(&nsnap, sizeof(UInt)) || !get_(&msnap, sizeof(UInt)) ||
+             nsnap != norig || msnap != morig) {
+    env_->getLogger()->errStream() << me_ << fname << " was saved for a "
+      << "different problem" << std::endl;
+    err = 3;
+  }
+
+  if (0 == err) {
+    p = new Problem(env_);
+    ok = getUInt_(UINT_MAX, n);
+    vars_.clear();
+    vars_.reserve(n);
+    for (UInt i = 0; ok && i < n; ++i) {
+      ok = get_(&lb, sizeof(double)) && get_(&ub, sizeof(double)) &&
+           getUInt_(UINT_MAX, type) && getUInt_(UINT_MAX, stype) &&
+           getString_(name);
+      if (ok) {
+        vars_.push_back(p->newVariable(lb, ub, (VariableType)type, name,
+                                       (VarSrcType)stype));
+      }
+    }
+
+    ok = ok && getUInt_(UINT_MAX, n);
+    for (UInt i = 0; ok && i < n; ++i) {
+      ok = get_(&lb, sizeof(double)) && get_(&ub, sizeof(double)) &&
+           getUInt_(UINT_MAX, stype) && getString_(name);
+      f = ok ? getFunction_(ok) : 0;
+      if (ok) {
+        c = p->newConstraint(f, lb, ub, name);
+        c->setSrcType((ConsSrcType)stype);
+      }
+    }
+
+    ok = ok && getUInt_(2, n);
+    if (ok && 1 == n) {
+      ok = getUInt_(UINT_MAX, type) && get_(&cb, sizeof(double)) &&
+           getString_(name);
+      f = ok ? getFunction_(ok) : 0;
+      if (ok) {
+        p->newObjective(f, cb, (ObjectiveType)type, name);
+      }
+    }
+
+    ok = ok && getUInt_(UINT_MAX, n);
+    for (UInt i = 0; ok && i < n; ++i) {
+      UInt nz, j;
+      ok = getUInt_(UINT_MAX, type) && getUInt_(UINT_MAX, prio) &&
+           getString_(name) && getUInt_(UINT_MAX, nz);
+      svars.clear();
+      weights.clear();
+      for (UInt k = 0; ok && k < nz; ++k) {
+        ok = getUInt_(vars_.size(), j) && get_(&lb, sizeof(double));
+        if (ok) {
+          svars.push_back(vars_[j]);
+          weights.push_back(lb);
+        }
+      }
+      if (ok) {
+        p->newSOS(nz, (SOSType)type, weights.data(), svars, (int)prio, name);
+      }
+    }
+
+    ok = ok && getMods_(mods);
+    if (!ok) {
+      env_->getLogger()->errStream() << me_ << fname << " is damaged"
+                                     << std::endl;
+      for (PreModQIter m = mods.begin(); m != mods.end(); ++m) {
+        delete *m;
+      }
+      mods.clear();
+      delete p;
+      p = 0;
+      err = 4;
+    }
+  }
+
+  if (MAP_FAILED != mapped) {
+    munmap(mapped, st.st_size);
+  }
+  cur_ = end_ = 0;
+  vars_.clear();
+
+  if (p) {
+    p->setNativeDer();
+    p->calculateSize();
+    env_->getLogger()->msgStream(LogInfo) << me_ << "loaded " << fname
+      << " in " << env_->getTime() - tstrt << " seconds" << std::endl;
+  }
+  return p;
+}
+
+
+int Snapshot::write(ProblemPtr p, UInt norig, UInt morig,
+                    const PreModQ &mods, std::string fname)
+{
+  std::ofstream out(fname.c_str(), std::ios::binary);
+  VariablePtr v;
+  ConstraintPtr c;
+  ObjectivePtr o = p->getObjective();
+  SOSPtr s;
+  int err = 0;
+
+  if (!out.is_open()) {
+    env_->getLogger()->errStream() << me_ << "could not open file " << fname
+                                   << " for writing" << std::endl;
+    return 1;
+  }
+
+  out.write(snapMagic, sizeof(snapMagic));
+  put(out, snapVersion);
+  put(out, snapEndian);
+  put(out, norig);
+  put(out, morig);
+
+  put(out, (UInt)p->getNumVars());
+  for (VariableConstIterator it = p->varsBegin(); it != p->varsEnd(); ++it) {
+    v = *it;
+    put(out, v->getLb());
+    put(out, v->getUb());
+    put(out, (UInt)v->getType());
+    put(out, (UInt)v->getSrcType());
+    putString(out, v->getName());
+  }
+
+  put(out, (UInt)p->getNumCons());
+  for (ConstraintConstIterator it = p->consBegin();
+       0 == err && it != p->consEnd(); ++it) {
+    c = *it;
+    put(out, c->getLb());
+    put(out, c->getUb());
+    put(out, (UInt)c->getSrcType());
+    putString(out, c->getName());
+    err = putFunction_(out, c->getFunction());
+  }
+
+  if (0 == err && o) {
+    put(out, (UInt)1);
+    put(out, (UInt)o->getObjectiveType());
+    put(out, o->getConstant());
+    putString(out, o->getName());
+    err = putFunction_(out, o->getFunction());
+  } else {
+    put(out, (UInt)0);
+  }
+
+  put(out, (UInt)(p->getNumSOS1() + p->getNumSOS2()));
+  for (UInt t = 0; t < 2; ++t) {
+    for (SOSConstIterator it = (0 == t) ? p->sos1Begin() : p->sos2Begin();
+         it != ((0 == t) ? p->sos1End() : p->sos2End()); ++it) {
+      s = *it;
+      put(out, (UInt)s->getType());
+      put(out, (UInt)s->getPriority());
+      putString(out, s->getName());
+      put(out, (UInt)s->getNz());
+      const double *w = s->getWeights();
+      UInt k = 0;
+      for (VariableConstIterator vit = s->varsBegin(); vit != s->varsEnd();
+           ++vit, ++k) {
+        put(out, (UInt)(*vit)->getIndex());
+        put(out, w[k]);
+      }
+    }
+  }
+
+  if (0 == err) {
+    err = putMods_(out, mods);
+  }
+  out.close();
+  if (err || out.fail()) {
+    env_->getLogger()->errStream() << me_ << "could not save problem in "
+      << fname << ". Nonlinear functions must be stored as cgraph."
+      << std::endl;
+    unlink(fname.c_str());
+    return 1;
+  }
+  env_->getLogger()->msgStream(LogInfo) << me_ << "saved problem in "
+                                        << fname << std::endl;
+  return 0;
+}
+
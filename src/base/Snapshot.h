@@ -0,0 +1,123 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Snapshot.h
+ * \brief Declare the Snapshot class that saves a presolved problem in a
+ * binary file and loads it back.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURSNAPSHOT_H
+#define MINOTAURSNAPSHOT_H
+
+#include <deque>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class CGraph;
+  class PreMod;
+  typedef PreMod* PreModPtr;
+  typedef std::deque<PreModPtr> PreModQ;
+
+  /**
+   * \brief Save a problem, usually one that has been presolved, together
+   * with the modifications needed to post-solve its solutions, and load it
+   * back.
+   *
+   * The file is binary, in the byte order of the machine that wrote it, and
+   * starts with a version number. It has variables, constraints (linear and
+   * quadratic coefficients and computational graphs), the objective, SOS
+   * constraints and the post-solve modifications (PreDelVars, PreSubstVars
+   * and PreAuxVars). The numbers of variables and constraints of the
+   * original problem are saved too, so that a snapshot is not used with a
+   * different instance. Nonlinear functions must be stored as CGraph.
+   *
+   * A snapshot is read by mapping the file into memory.
+   */
+  class Snapshot {
+  public:
+    /// Constructor.
+    Snapshot(EnvPtr env);
+
+    /// Destroy.
+    ~Snapshot();
+
+    /**
+     * \brief Load a problem saved by write().
+     *
+     * \param[in] fname The file.
+     * \param[in] norig Number of variables in the original problem.
+     * \param[in] morig Number of constraints in the original problem. These
+     * are used only to check that the snapshot was saved for the same
+     * instance.
+     * \param[out] mods Post-solve modifications, in the order they were
+     * made. The caller owns them.
+     * \param[out] err 0 if the problem was loaded, positive otherwise.
+     * \returns The problem, or NULL.
+     */
+    ProblemPtr read(std::string fname, UInt norig, UInt morig, PreModQ &mods,
+                    int &err);
+
+    /**
+     * \brief Save the problem p and post-solve modifications in a file.
+     *
+     * \param[in] p The problem, e.g. after presolve.
+     * \param[in] norig Number of variables in the original problem.
+     * \param[in] morig Number of constraints in the original problem.
+     * \param[in] mods Post-solve modifications of the presolver.
+     * \param[in] fname The file.
+     * \returns 0 if saved, positive if the file could not be written or p
+     * has a nonlinear function that is not a CGraph.
+     */
+    int write(ProblemPtr p, UInt norig, UInt morig, const PreModQ &mods,
+              std::string fname);
+
+  private:
+    /// Position in the file being read, and its end.
+    const char *cur_, *end_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Variables of the problem being read.
+    VarVector vars_;
+
+    /// Read n bytes into dst. Return false if the file is too short.
+    bool get_(void *dst, size_t n);
+
+    /// Read a computational graph.
+    CGraph *getCGraph_(bool &ok);
+
+    /// Read a function.
+    FunctionPtr getFunction_(bool &ok);
+
+    /// Read post-solve modifications.
+    bool getMods_(PreModQ &mods);
+
+    /// Read a string.
+    bool getString_(std::string &s);
+
+    /// Read an unsigned integer that must be less than lim.
+    bool getUInt_(UInt lim, UInt &i);
+
+    /// Write a computational graph.
+    int putCGraph_(std::ostream &out, CGraph *cg);
+
+    /// Write a function.
+    int putFunction_(std::ostream &out, FunctionPtr f);
+
+    /// Write post-solve modifications.
+    int putMods_(std::ostream &out, const PreModQ &mods);
+  };
+}
+#endif
+
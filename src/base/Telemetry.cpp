@@ -0,0 +1,376 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Telemetry.cpp
+ * \brief Define the Telemetry class that streams the progress of the tree
+ * search to a file or a socket.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "Option.h"
+#include "Telemetry.h"
+
+using namespace Minotaur;
+
+const std::string Telemetry::me_ = "Telemetry: ";
+std::atomic<uint64_t> Telemetry::lpIters_(0);
+std::atomic<uint64_t> Telemetry::nlpIters_(0);
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+  /// Write a number, or null (JSON) or an empty field (CSV) if not finite.
+  void writeNum(std::ostream &out, double d, bool csv)
+  {
+    if (std::isfinite(d)) {
+      out << d;
+    } else if (!csv) {
+      out << "null";
+    }
+  }
+}
+
+
+TelemetryRec::TelemetryRec()
+  : cpu(0.0),
+    wall(0.0),
+    lb(-INFINITY),
+    ub(INFINITY),
+    gap(INFINITY),
+    nodesProc(0),
+    nodesLeft(0),
+    sols(0)
+{
+}
+
+
+Telemetry::Telemetry(EnvPtr env, UInt nthreads, int rank)
+  : busy_(0),
+    cuts_(0),
+    fd_(-1),
+    csv_(false),
+    interval_(0),
+    lastBusy_(0),
+    lastLp_(0),
+    lastNlp_(0),
+    lastNodes_(0),
+    lastT_(0),
+    logger_(env->getLogger()),
+    next_(0),
+    nThreads_(nthreads > 0 ? nthreads : 1),
+    on_(false),
+    rank_(rank),
+    t0_(std::chrono::steady_clock::now()),
+    writing_(false)
+{
+  OptionDBPtr options = env->getOptions();
+  std::string fname = options->findString("telemetry_file")->getValue();
+  std::string fmt = options->findString("telemetry_format")->getValue();
+  double secs = options->findDouble("telemetry_interval")->getValue();
+
+  if (fname == "") {
+    return;
+  }
+  if (fmt == "csv") {
+    csv_ = true;
+  } else if (fmt != "json") {
+    logger_->msgStream(LogError) << me_ << "unknown telemetry_format "
+                                 << fmt << ". Using json." << std::endl;
+  }
+  interval_ = (uint64_t)(1e9 * (secs > 0 ? secs : 0));
+
+  if (0 == fname.compare(0, 5, "unix:")) {
+    on_.store(connect_(fname.substr(5)));
+  } else {
+    if (rank_ > 0) {
+      std::ostringstream s;
+      s << fname << "." << rank_;
+      fname = s.str();
+    }
+    file_.open(fname.c_str());
+    on_.store(file_.is_open());
+    if (!on_) {
+      logger_->msgStream(LogError) << me_ << "can not open " << fname
+                                   << " for writing." << std::endl;
+    }
+  }
+  if (!on_) {
+    return;
+  }
+
+  busy_ = new std::atomic<uint64_t>[nThreads_];
+  cuts_ = new std::atomic<size_t>[nThreads_];
+  lastBusy_ = new uint64_t[nThreads_];
+  for (UInt i = 0; i < nThreads_; ++i) {
+    busy_[i] = 0;
+    cuts_[i] = 0;
+    lastBusy_[i] = 0;
+  }
+  lastLp_ = lpIters_.load();
+  lastNlp_ = nlpIters_.load();
+
+  if (csv_) {
+    std::ostringstream s;
+    s << "time,wall";
+    if (rank_ >= 0) {
+      s << ",rank";
+    }
+    s << ",nodes,open,lb,ub,gap,sols,nodes_per_sec,lp_iters_per_sec,"
+      << "nlp_iters_per_sec,cuts,mem_mb";
+    for (UInt i = 0; i < nThreads_; ++i) {
+      s << ",util" << i;
+    }
+    s << "\n";
+    put_(s.str());
+  }
+  logger_->msgStream(LogInfo) << me_ << "writing progress to " << fname
+                              << std::endl;
+}
+
+
+Telemetry::~Telemetry()
+{
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  if (file_.is_open()) {
+    file_.close();
+  }
+  delete[] busy_;
+  delete[] cuts_;
+  delete[] lastBusy_;
+}
+
+
+void Telemetry::addBusy(UInt t, double secs)
+{
+  if (on_ && t < nThreads_) {
+    busy_[t].fetch_add((uint64_t)(1e9 * secs), std::memory_order_relaxed);
+  }
+}
+
+
+bool Telemetry::connect_(const std::string &path)
+{
+  struct sockaddr_un addr;
+
+  if (path.size() >= sizeof(addr.sun_path)) {
+    logger_->msgStream(LogError) << me_ << "socket path " << path
+                                 << " is too long." << std::endl;
+    return false;
+  }
+  fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd_ < 0) {
+    logger_->msgStream(LogError) << me_ << "can not create socket: "
+                                 << strerror(errno) << std::endl;
+    return false;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(fd_, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    logger_->msgStream(LogError) << me_ << "can not connect to " << path
+                                 << ": " << strerror(errno) << std::endl;
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+
+double Telemetry::memory_()
+{
+  long pages = 0, rss = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+
+  if (f) {
+    if (2 == fscanf(f, "%ld %ld", &pages, &rss)) {
+      fclose(f);
+      return (double)rss * sysconf(_SC_PAGESIZE) / 1048576.0;
+    }
+    fclose(f);
+  }
+
+  // peak, not current, memory where /proc is not there.
+  struct rusage usage;
+  if (0 == getrusage(RUSAGE_SELF, &usage)) {
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1048576.0;
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+  }
+  return 0.0;
+}
+
+
+void Telemetry::put_(const std::string &line)
+{
+  if (fd_ >= 0) {
+    // Never block the search: a line that does not fit in the socket
+    // buffer is dropped. Once a part of a line is sent, the rest must
+    // follow, or the reader would see a broken line.
+    size_t sent = 0;
+    ssize_t n;
+    while (sent < line.size()) {
+      n = send(fd_, line.c_str() + sent, line.size() - sent,
+               (sent > 0 ? 0 : MSG_DONTWAIT) | MSG_NOSIGNAL);
+      if (n > 0) {
+        sent += n;
+      } else if (n < 0 && EINTR == errno) {
+        continue;
+      } else if (n < 0 && 0 == sent &&
+                 (EAGAIN == errno || EWOULDBLOCK == errno)) {
+        break;
+      } else {
+        logger_->msgStream(LogInfo) << me_ << "reader has gone: "
+                                    << strerror(errno) << std::endl;
+        close(fd_);
+        fd_ = -1;
+        on_.store(false);
+        break;
+      }
+    }
+  } else {
+    file_ << line;
+    file_.flush();
+  }
+}
+
+
+void Telemetry::setCuts(UInt t, size_t n)
+{
+  if (on_ && t < nThreads_) {
+    cuts_[t].store(n, std::memory_order_relaxed);
+  }
+}
+
+
+void Telemetry::write(const TelemetryRec &rec, bool force)
+{
+  uint64_t now, due;
+  double dt, nodes;
+  size_t cuts = 0;
+  uint64_t lp, nlp, b;
+  std::ostringstream s;
+
+  if (!on_) {
+    return;
+  }
+  now = elapsed_();
+  due = next_.load(std::memory_order_relaxed);
+  if (!force && now < due) {
+    return;
+  }
+  // only one thread writes. The others go back to work. The time of the
+  // next line does not stop two threads from writing when the interval is
+  // zero or a line takes longer than the interval, so take a lock too.
+  if (!force && !next_.compare_exchange_strong(due, now + interval_)) {
+    return;
+  }
+  while (writing_.exchange(true, std::memory_order_acquire)) {
+    if (!force) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  if (force) {
+    now = elapsed_();
+    next_.store(now + interval_, std::memory_order_relaxed);
+  }
+  if (!on_) {
+    writing_.store(false, std::memory_order_release);
+    return;
+  }
+
+  dt = (now - lastT_) * 1e-9;
+  if (dt <= 0.0) {
+    dt = 1e-9;
+  }
+  // the count of nodes may go back, e.g. after a restart of the search.
+  nodes = std::max(0.0, (double)rec.nodesProc - (double)lastNodes_);
+  lp = lpIters_.load(std::memory_order_relaxed);
+  nlp = nlpIters_.load(std::memory_order_relaxed);
+  for (UInt i = 0; i < nThreads_; ++i) {
+    cuts += cuts_[i].load(std::memory_order_relaxed);
+  }
+
+  s << std::setprecision(10);
+  if (csv_) {
+    s << rec.cpu << "," << rec.wall;
+    if (rank_ >= 0) {
+      s << "," << rank_;
+    }
+    s << "," << rec.nodesProc << "," << rec.nodesLeft << ",";
+    writeNum(s, rec.lb, csv_);
+    s << ",";
+    writeNum(s, rec.ub, csv_);
+    s << ",";
+    writeNum(s, rec.gap, csv_);
+    s << "," << rec.sols << std::setprecision(4)
+      << "," << nodes / dt
+      << "," << (lp - lastLp_) / dt << "," << (nlp - lastNlp_) / dt
+      << "," << cuts << "," << memory_();
+    for (UInt i = 0; i < nThreads_; ++i) {
+      b = busy_[i].load(std::memory_order_relaxed);
+      s << "," << std::min(1.0, (b - lastBusy_[i]) * 1e-9 / dt);
+      lastBusy_[i] = b;
+    }
+    s << "\n";
+  } else {
+    s << "{\"time\":" << rec.cpu << ",\"wall\":" << rec.wall;
+    if (rank_ >= 0) {
+      s << ",\"rank\":" << rank_;
+    }
+    s << ",\"nodes\":" << rec.nodesProc << ",\"open\":" << rec.nodesLeft
+      << ",\"lb\":";
+    writeNum(s, rec.lb, csv_);
+    s << ",\"ub\":";
+    writeNum(s, rec.ub, csv_);
+    s << ",\"gap\":";
+    writeNum(s, rec.gap, csv_);
+    s << ",\"sols\":" << rec.sols << std::setprecision(4)
+      << ",\"nodes_per_sec\":" << nodes / dt
+      << ",\"lp_iters_per_sec\":" << (lp - lastLp_) / dt
+      << ",\"nlp_iters_per_sec\":" << (nlp - lastNlp_) / dt
+      << ",\"cuts\":" << cuts << ",\"mem_mb\":" << memory_() << ",\"util\":[";
+    for (UInt i = 0; i < nThreads_; ++i) {
+      b = busy_[i].load(std::memory_order_relaxed);
+      s << (i > 0 ? "," : "")
+        << std::min(1.0, (b - lastBusy_[i]) * 1e-9 / dt);
+      lastBusy_[i] = b;
+    }
+    s << "]}\n";
+  }
+  put_(s.str());
+
+  lastLp_ = lp;
+  lastNlp_ = nlp;
+  lastNodes_ = rec.nodesProc;
+  lastT_ = now;
+  writing_.store(false, std::memory_order_release);
+}
+
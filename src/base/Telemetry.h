@@ -0,0 +1,224 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Telemetry.h
+ * \brief Declare the Telemetry class that streams the progress of the tree
+ * search to a file or a socket.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURTELEMETRY_H
+#define MINOTAURTELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /// Progress of the tree search at one time, filled by branch-and-bound.
+  struct TelemetryRec {
+    /// Constructor. Bounds are infinite, all else zero.
+    TelemetryRec();
+
+    double cpu;       /// CPU time in seconds.
+    double wall;      /// Wall time in seconds.
+    double lb;        /// Lower bound.
+    double ub;        /// Upper bound.
+    double gap;       /// Percentage gap.
+    UInt nodesProc;   /// Nodes processed.
+    UInt nodesLeft;   /// Open nodes.
+    UInt sols;        /// Solutions found.
+  };
+
+  /**
+   * \brief Write one line about the progress of the tree search every few
+   * seconds, for monitoring long runs while they go on.
+   *
+   * Lines are written in JSON (one object per line) or CSV to the file
+   * given in option telemetry_file, or to a UNIX domain socket if the name
+   * starts with "unix:". Each line has time, nodes processed and open,
+   * bounds, gap, nodes per second, utilization of each thread since the
+   * last line, LP and NLP iterations per second, number of cuts in the cut
+   * managers and the resident memory of the process.
+   *
+   * Counters are kept in atomic variables that threads update without
+   * locks. Engines add their iterations through addIters(). When several
+   * threads call write() at the same time, only one writes the line and the
+   * others return at once, so that no thread waits for a slow reader. Only
+   * a forced write waits for the line being written to finish.
+   */
+  class Telemetry {
+  public:
+    /**
+     * \brief Constructor. Opens the output if option telemetry_file is set.
+     *
+     * \param[in] env The environment.
+     * \param[in] nthreads Number of threads doing the tree search.
+     * \param[in] rank Rank of the process in a distributed run, or -1. A
+     * file name is suffixed with ".rank" for ranks other than 0.
+     */
+    Telemetry(EnvPtr env, UInt nthreads = 1, int rank = -1);
+
+    /// Destroy. Closes the output.
+    ~Telemetry();
+
+    /// Add time in seconds that thread t spent processing nodes.
+    void addBusy(UInt t, double secs);
+
+    /**
+     * \brief Add n iterations of an LP engine (nlp = false) or of an NLP
+     * or QP engine (nlp = true). Called by engines after each solve.
+     */
+    static void addIters(bool nlp, UInt n)
+    {
+      (nlp ? nlpIters_ : lpIters_).fetch_add(n, std::memory_order_relaxed);
+    };
+
+    /// Return true if the next line is due. Cheap, call it often.
+    bool isDue() const
+    {
+      return on_ && elapsed_() >= next_.load(std::memory_order_relaxed);
+    };
+
+    /// Return true if lines are being written.
+    bool isOn() const { return on_; };
+
+    /// Seconds since construction, from the monotonic clock.
+    double now() const { return elapsed_() * 1e-9; };
+
+    /// Set the number of cuts in the cut manager of thread t.
+    void setCuts(UInt t, size_t n);
+
+    /**
+     * \brief Write a line if it is due or if force is true.
+     *
+     * \param[in] rec Values from the tree search.
+     * \param[in] force If true, write even if the interval has not passed.
+     * Used for the last line.
+     */
+    void write(const TelemetryRec &rec, bool force = false);
+
+  private:
+    /// Time spent processing nodes by each thread, in nanoseconds.
+    std::atomic<uint64_t> *busy_;
+
+    /// Number of cuts in the cut manager of each thread.
+    std::atomic<size_t> *cuts_;
+
+    /// Socket descriptor, or -1 if writing to a file.
+    int fd_;
+
+    /// Output file, if not writing to a socket.
+    std::ofstream file_;
+
+    /// Write CSV if true, JSON otherwise.
+    bool csv_;
+
+    /// Nanoseconds between two lines.
+    uint64_t interval_;
+
+    /// Values at the last line written, for computing rates.
+    uint64_t *lastBusy_;
+    uint64_t lastLp_, lastNlp_;
+    UInt lastNodes_;
+    uint64_t lastT_;
+
+    /// Iterations of all LP and NLP engines.
+    static std::atomic<uint64_t> lpIters_, nlpIters_;
+
+    /// Log manager.
+    LoggerPtr logger_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Time (in nanoseconds since t0_) when the next line is due.
+    std::atomic<uint64_t> next_;
+
+    /// Number of threads.
+    UInt nThreads_;
+
+    /// True if the output is open.
+    std::atomic<bool> on_;
+
+    /// Rank of the process, or -1.
+    int rank_;
+
+    /// Time of construction.
+    std::chrono::steady_clock::time_point t0_;
+
+    /// True while a thread is writing a line. Guards the output and last*.
+    std::atomic<bool> writing_;
+
+    /// Nanoseconds since construction.
+    uint64_t elapsed_() const
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now() - t0_)
+          .count();
+    };
+
+    /// Connect to the UNIX socket at path. Return true if connected.
+    bool connect_(const std::string &path);
+
+    /// Resident memory of this process in megabytes.
+    double memory_();
+
+    /**
+     * Send one line to the output. A line is sent whole or, if the socket
+     * is full, not at all. Stop writing if the reader is gone.
+     */
+    void put_(const std::string &line);
+
+    /// Copy constructor is not allowed.
+    Telemetry(const Telemetry &);
+
+    /// Copy by assignment is not allowed.
+    Telemetry &operator=(const Telemetry &);
+  };
+
+
+  /**
+   * \brief Add the time between construction and destruction to the busy
+   * time of a thread, if telemetry is on.
+   */
+  class TelemetryBusy {
+  public:
+    /// Start timing thread t. tel may be NULL.
+    TelemetryBusy(Telemetry *tel, UInt t)
+      : start_(0.0),
+        t_(t),
+        tel_((tel && tel->isOn()) ? tel : 0)
+    {
+      if (tel_) {
+        start_ = tel_->now();
+      }
+    };
+
+    /// Stop timing.
+    ~TelemetryBusy()
+    {
+      if (tel_) {
+        tel_->addBusy(t_, tel_->now() - start_);
+      }
+    };
+
+  private:
+    double start_;
+    UInt t_;
+    Telemetry *tel_;
+
+    TelemetryBusy(const TelemetryBusy &);
+    TelemetryBusy &operator=(const TelemetryBusy &);
+  };
+}
+#endif
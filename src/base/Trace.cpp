@@ -0,0 +1,208 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Trace.cpp
+ * \brief Implement the Tracer class.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <csignal>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "MinotaurConfig.h"
+#include "Trace.h"
+
+using namespace Minotaur;
+
+namespace {
+  /// Ring buffer of events of one thread.
+  struct TraceBuf {
+    std::vector<TraceRec> recs;
+    size_t next;
+    bool wrapped;
+    int tid;
+    std::mutex m;  // held by the owner while recording, and while dumping.
+  };
+
+  /// Buffers of all threads. Threads keep pointers to their own buffers, so
+  /// the buffers are freed only when the program exits.
+  struct TraceBufs {
+    std::vector<TraceBuf *> bufs;
+
+    ~TraceBufs()
+    {
+      for (std::vector<TraceBuf *>::iterator it = bufs.begin();
+           it != bufs.end(); ++it) {
+        delete *it;
+      }
+    };
+  };
+
+  std::mutex trMutex;
+  TraceBufs trBufs;
+  std::set<std::string> trNames;
+  std::string trFile;
+  size_t trCap = 0;
+  thread_local TraceBuf *trMyBuf = 0;
+
+  /// Write str as a JSON string.
+  void writeJsonStr(std::ofstream &out, const char *str)
+  {
+    out << '"';
+    for (const char *c = str; *c; ++c) {
+      if ('"' == *c || '\\' == *c) {
+        out << '\\';
+      }
+      out << *c;
+    }
+    out << '"';
+  }
+
+  /// Write one event in Chrome's "complete event" format.
+  void writeRec(std::ofstream &out, const TraceRec &r, int tid, bool &first)
+  {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+    out << "{\"name\":";
+    writeJsonStr(out, r.name);
+    out << ",\"cat\":\"minotaur\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+        << ",\"ts\":" << r.start / 1000 << "." << (r.start % 1000) / 100
+        << ",\"dur\":" << r.dur / 1000 << "." << (r.dur % 1000) / 100;
+    if (r.arg) {
+      out << ",\"args\":{\"detail\":";
+      writeJsonStr(out, r.arg);
+      out << "}";
+    }
+    out << "}";
+  }
+}
+
+std::atomic<bool> Tracer::dumpReq_(false);
+std::atomic<bool> Tracer::on_(false);
+std::chrono::steady_clock::time_point Tracer::t0_ =
+    std::chrono::steady_clock::now();
+
+
+const char *Tracer::intern(const std::string &str)
+{
+  std::lock_guard<std::mutex> lock(trMutex);
+  return trNames.insert(str).first->c_str();
+}
+
+
+void Tracer::onSignal_(int)
+{
+  // only set a flag here. The next thread that records an event writes the
+  // file, once it has released its own buffer.
+  dumpReq_.store(true, std::memory_order_relaxed);
+}
+
+
+void Tracer::record(const char *name, const char *arg, uint64_t start)
+{
+  TraceBuf *b = trMyBuf;
+  TraceRec *r;
+
+  if (!b) {
+    b = new TraceBuf();
+    b->next = 0;
+    b->wrapped = false;
+    {
+      std::lock_guard<std::mutex> lock(trMutex);
+      b->recs.resize(trCap > 0 ? trCap : 1);
+      b->tid = trBufs.bufs.size();
+      trBufs.bufs.push_back(b);
+    }
+    trMyBuf = b;
+  }
+  {
+    std::lock_guard<std::mutex> lock(b->m);
+    r = &(b->recs[b->next]);
+    r->name = name;
+    r->arg = arg;
+    r->start = start;
+    r->dur = now() - start;
+    ++(b->next);
+    if (b->next == b->recs.size()) {
+      b->next = 0;
+      b->wrapped = true;
+    }
+  }
+  if (dumpReq_.load(std::memory_order_relaxed) &&
+      dumpReq_.exchange(false)) {
+    write();
+  }
+}
+
+
+void Tracer::start(const std::string &fname, size_t cap)
+{
+  std::lock_guard<std::mutex> lock(trMutex);
+  trFile = fname;
+  trCap = cap;
+  t0_ = std::chrono::steady_clock::now();
+  for (std::vector<TraceBuf *>::iterator it = trBufs.bufs.begin();
+       it != trBufs.bufs.end(); ++it) {
+    std::lock_guard<std::mutex> block((*it)->m);
+    (*it)->recs.assign(trCap > 0 ? trCap : 1, TraceRec());
+    (*it)->next = 0;
+    (*it)->wrapped = false;
+  }
+  signal(SIGUSR1, Tracer::onSignal_);
+  on_.store(true);
+}
+
+
+void Tracer::stop()
+{
+  if (!on_.load()) {
+    return;
+  }
+  on_.store(false);
+  write();
+  std::lock_guard<std::mutex> lock(trMutex);
+  for (std::vector<TraceBuf *>::iterator it = trBufs.bufs.begin();
+       it != trBufs.bufs.end(); ++it) {
+    std::lock_guard<std::mutex> block((*it)->m);
+    (*it)->next = 0;
+    (*it)->wrapped = false;
+  }
+}
+
+
+void Tracer::write()
+{
+  std::lock_guard<std::mutex> lock(trMutex);
+  std::ofstream out(trFile.c_str());
+  bool first = true;
+
+  if (!out.is_open()) {
+    return;
+  }
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (std::vector<TraceBuf *>::iterator it = trBufs.bufs.begin();
+       it != trBufs.bufs.end(); ++it) {
+    TraceBuf *b = *it;
+    std::lock_guard<std::mutex> block(b->m);
+    if (b->wrapped) {
+      for (size_t i = b->next; i < b->recs.size(); ++i) {
+        writeRec(out, b->recs[i], b->tid, first);
+      }
+    }
+    for (size_t i = 0; i < b->next; ++i) {
+      writeRec(out, b->recs[i], b->tid, first);
+    }
+  }
+  out << "\n]}\n";
+  out.close();
+}
+
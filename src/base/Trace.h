@@ -0,0 +1,156 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file Trace.h
+ * \brief Declare the Tracer class that records timed events of the solver
+ * and the TraceScope helper.
+ * \author Ashutosh Mahajan, IIT Bombay
+ *
+ * Events are recorded only if Minotaur is compiled with MNTR_TRACE=1 (cmake
+ * option TRACE_FLAG) and the option trace_file is set. Otherwise the
+ * MNTR_TRACE_SCOPE macros expand to nothing.
+ */
+
+#ifndef MINOTAURTRACE_H
+#define MINOTAURTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Minotaur {
+
+  /// One event of the trace: a named interval on one thread.
+  struct TraceRec {
+    const char *name;  /// Name of the event. Must be a static string.
+    const char *arg;   /// Optional detail (e.g. handler name), or NULL.
+    uint64_t start;    /// Start time in nanoseconds since trace start.
+    uint64_t dur;      /// Duration in nanoseconds.
+  };
+
+  /**
+   * \brief Record begin and end times of events in hot parts of the code.
+   *
+   * Each thread writes into its own ring buffer. Every call of record()
+   * takes the lock of that buffer, so that the buffer can be written to the
+   * trace file meanwhile. The lock is not contended otherwise, but it is
+   * not free either. If a buffer is full, the oldest events of that thread
+   * are overwritten. Time is taken from the monotonic steady clock, which is
+   * much cheaper than getrusage() used by the Timer classes. All buffers are
+   * written as a Chrome trace (JSON) that can be opened in chrome://tracing
+   * or ui.perfetto.dev, when stop() is called, or when the process receives
+   * SIGUSR1.
+   */
+  class Tracer {
+  public:
+    /**
+     * \brief Return a pointer to a copy of str that remains valid until the
+     * program exits. Useful for names that are known only at run time, e.g.
+     * names of handlers. Not meant to be called in hot paths.
+     */
+    static const char *intern(const std::string &str);
+
+    /// Return true if events are being recorded.
+    static bool isOn()
+    {
+      return on_.load(std::memory_order_relaxed);
+    };
+
+    /// Current time in nanoseconds since start().
+    static uint64_t now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now() - t0_)
+          .count();
+    };
+
+    /// Record an event that began at time start and ends now.
+    static void record(const char *name, const char *arg, uint64_t start);
+
+    /**
+     * \brief Start recording. Events recorded earlier are discarded, and
+     * the buffers of threads that recorded them get the new capacity.
+     *
+     * \param[in] fname Name of the file where the trace is written.
+     * \param[in] cap Number of events kept for each thread.
+     */
+    static void start(const std::string &fname, size_t cap);
+
+    /// Stop recording and write the trace file.
+    static void stop();
+
+    /// Write all events recorded so far to the trace file.
+    static void write();
+
+  private:
+    /// Set by the signal handler when a dump has been requested.
+    static std::atomic<bool> dumpReq_;
+
+    /// True if recording.
+    static std::atomic<bool> on_;
+
+    /// Time at which recording started.
+    static std::chrono::steady_clock::time_point t0_;
+
+    /// Signal handler for SIGUSR1.
+    static void onSignal_(int);
+  };
+
+
+  /**
+   * \brief Record the time between construction and destruction as one
+   * event. Use it through the MNTR_TRACE_SCOPE macros.
+   */
+  class TraceScope {
+  public:
+    /// Begin an event.
+    TraceScope(const char *name, const char *arg = 0)
+      : arg_(arg),
+        name_(name),
+        on_(Tracer::isOn()),
+        start_(0)
+    {
+      if (on_) {
+        start_ = Tracer::now();
+      }
+    };
+
+    /// End the event.
+    ~TraceScope()
+    {
+      if (on_) {
+        Tracer::record(name_, arg_, start_);
+      }
+    };
+
+  private:
+    const char *arg_;
+    const char *name_;
+    bool on_;
+    uint64_t start_;
+
+    TraceScope(const TraceScope &);
+    TraceScope &operator=(const TraceScope &);
+  };
+}
+
+#define MNTR_TRACE_CAT2_(a, b) a##b
+#define MNTR_TRACE_CAT_(a, b) MNTR_TRACE_CAT2_(a, b)
+
+#if defined(MNTR_TRACE) && MNTR_TRACE
+#define MNTR_TRACE_SCOPE(name)                                                \
+  Minotaur::TraceScope MNTR_TRACE_CAT_(mntr_trace_, __LINE__)(name)
+#define MNTR_TRACE_SCOPE2(name, arg)                                          \
+  Minotaur::TraceScope MNTR_TRACE_CAT_(mntr_trace_, __LINE__)(name, arg)
+#else
+#define MNTR_TRACE_SCOPE(name)
+#define MNTR_TRACE_SCOPE2(name, arg)
+#endif
+
+#endif
+
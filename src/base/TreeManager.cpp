@@ -10,6 +10,7 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "MinotaurConfig.h"
@@ -28,6 +29,17 @@ TreeManager::TreeManager(EnvPtr env)
   cutOff_(INFINITY),
   doVbc_(false),
   etol_(1e-6),
+  adaptFreq_(100),
+  baseQuot_(0.25),
+  jumpTime_(0.0),
+  jumps_(0),
+  lastPlunge_(false),
+  lastSel_(0.0),
+  maxOpen_(100000),
+  plungeQuot_(0.25),
+  plungeTime_(0.0),
+  plunges_(0),
+  selTimer_(0),
   size_(0),
   timer_(0)
 {
@@ -38,6 +50,8 @@ TreeManager::TreeManager(EnvPtr env)
     searchType_ = BestFirst;
   } else if ("bthend"==s) {
     searchType_ = BestThenDive;
+  } else if ("bestest"==s) {
+    searchType_ = BestEstimate;
   } else {
      assert (!"search strategy must be defined!");
   }
@@ -50,6 +64,14 @@ TreeManager::TreeManager(EnvPtr env)
    case (BestThenDive):
      activeNodes_ = (NodeHeapPtr) new NodeHeap(NodeHeap::Value);
      break;
+   case (BestEstimate):
+     activeNodes_ = (NodeHeapPtr) new NodeHeap(NodeHeap::Estimate);
+     baseQuot_ = env->getOptions()->findDouble("plunge_quot")->getValue();
+     plungeQuot_ = baseQuot_;
+     maxOpen_ = env->getOptions()->findInt("plunge_max_open")->getValue();
+     selTimer_ = env->getNewTimer();
+     selTimer_->start();
+     break;
    default:
      assert (!"search strategy must be defined!");
   }
@@ -79,6 +101,9 @@ TreeManager::~TreeManager()
 {
   clearAll();
   delete activeNodes_;
+  if (selTimer_) {
+    delete selTimer_;
+  }
   if (doVbc_) {
     vbcFile_.close();
     delete timer_;
@@ -98,6 +123,8 @@ NodePtr TreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
   NodePtr new_cand = NodePtr(); // NULL
   NodePtr child;
   bool is_first = false;
+  NodePtrVector children;
+  double est;
 
   if (searchType_ == DepthFirst || searchType_ == BestThenDive) {
     is_first = true;
@@ -110,7 +137,15 @@ NodePtr TreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
     child->setTbScore(node->getTbScore());
     child->setDepth(node->getDepth()+1);
     node->addChild(child);
-    if (is_first) {
+    if (searchType_ == BestEstimate) {
+      est = branch_p->getEstimate();
+      if (est <= -INFINITY) {
+        est = node->getEstimate();
+      }
+      child->setEstimate(std::max(est, child->getLb()));
+      child->setWarmStart(ws);
+      children.push_back(child);
+    } else if (is_first) {
       child->setWarmStart(ws);
       insertCandidate_(child, true);
       is_first = false;
@@ -122,6 +157,26 @@ NodePtr TreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
       insertCandidate_(child);
     }
   }
+
+  if (searchType_ == BestEstimate) {
+    // plunge into the child with the best estimate if it is good enough
+    // compared to the open nodes.
+    for (NodePtrIterator it=children.begin(); it!=children.end(); ++it) {
+      if (!new_cand || (*it)->getEstimate() < new_cand->getEstimate()) {
+        new_cand = *it;
+      }
+    }
+    if (new_cand && !shouldPlunge_(new_cand)) {
+      new_cand = 0;
+    }
+    for (NodePtrIterator it=children.begin(); it!=children.end(); ++it) {
+      insertCandidate_(*it, (*it == new_cand));
+    }
+    if (new_cand) {
+      recordSelection_(true);
+    }
+  }
+
   if (doVbc_) {
     vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1 << " "
              << VbcSolved << std::endl;
@@ -174,6 +229,9 @@ NodePtr TreeManager::getCandidate()
         vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1
                  << " " << VbcSolving << std::endl;
       }
+      if (selTimer_) {
+        recordSelection_(false);
+      }
       break;
     }
   } 
@@ -253,7 +311,6 @@ void TreeManager::insertCandidate_(NodePtr node, bool pop_now)
 
 void TreeManager::insertRoot(NodePtr node)
 {
-  assert(size_==0);
   assert(activeNodes_->getSize()==0);
 
   node->setId(0);
@@ -275,6 +332,29 @@ void TreeManager::pruneNode(NodePtr node)
 }
 
 
+void TreeManager::recordSelection_(bool plunge)
+{
+  double now = selTimer_->query();
+  double ratio;
+
+  if (lastPlunge_) {
+    plungeTime_ += now - lastSel_;
+    ++plunges_;
+  } else {
+    jumpTime_ += now - lastSel_;
+    ++jumps_;
+  }
+  lastSel_ = now;
+  lastPlunge_ = plunge;
+
+  if (0 == (plunges_ + jumps_) % adaptFreq_ && plunges_ > 0 && jumps_ > 0 &&
+      plungeTime_ > 0.0) {
+    ratio = (jumpTime_ / jumps_) / (plungeTime_ / plunges_);
+    plungeQuot_ = baseQuot_ * std::min(std::max(ratio, 1.0), 4.0);
+  }
+}
+
+
 void TreeManager::removeActiveNode(NodePtr node)
 {
   if (doVbc_) {
@@ -292,6 +372,12 @@ void TreeManager::removeActiveNode(NodePtr node)
 }
 
 
+void TreeManager::restart()
+{
+  clearAll();
+}
+
+
 void TreeManager::removeNode_(NodePtr node) 
 {
   NodePtr cNode = 0;
@@ -357,22 +443,50 @@ void TreeManager::setCutOff(double value)
 
 void TreeManager::setUb(double value)
 {
+  NodePtrVector pruned;
+
   bestUpperBound_ = value;
   if (value < cutOff_) {
     cutOff_ = value;
   }
+
+  // prune the active nodes that can not be better, so that they do not
+  // stay in the store until they come to the top.
+  activeNodes_->removeAbove(cutOff_ - etol_, pruned);
+  for (NodePtrIterator it = pruned.begin(); it != pruned.end(); ++it) {
+    (*it)->setStatus(NodeHitUb);
+    pruneNode(*it);
+  }
 }
 
 
 bool TreeManager::shouldDive()
 {
-  if (searchType_ == DepthFirst || searchType_ == BestThenDive) {
+  if (searchType_ == DepthFirst || searchType_ == BestThenDive ||
+      searchType_ == BestEstimate) {
     return true;
   } 
   return false;
 }
 
 
+bool TreeManager::shouldPlunge_(NodePtr child)
+{
+  double lb, est, ref;
+
+  // plunging keeps the number of open nodes from growing.
+  if (activeNodes_->isEmpty() || activeNodes_->getSize() > maxOpen_) {
+    return true;
+  }
+  lb = std::min(activeNodes_->getBestLB(), child->getLb());
+  est = std::max(activeNodes_->top()->getEstimate(),
+                 activeNodes_->top()->getLb());
+  ref = (bestUpperBound_ < INFINITY) ? bestUpperBound_ : est;
+  return (child->getEstimate() <=
+          std::max(lb + plungeQuot_ * (ref - lb), est) + etol_);
+}
+
+
 bool TreeManager::shouldPrune_(NodePtr node)
 {
   double lb = node->getLb();
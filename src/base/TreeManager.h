@@ -118,6 +118,14 @@ namespace Minotaur {
      */
     void removeActiveNode(NodePtr node);
 
+    /**
+     * \brief Delete all nodes so that a new root can be inserted.
+     *
+     * The bounds and the count of nodes created are kept. The relaxation
+     * must be reset before, since the modifications of the nodes are lost.
+     */
+    void restart();
+
     /**
      * \brief Set the cut off value for the objective function.
      *
@@ -136,7 +144,14 @@ namespace Minotaur {
      */
     void setUb(double value);
 
-    /// Return true if the tree-manager recommends diving. False otherwise.
+    /**
+     * \brief Return true if the tree-manager may dive into a child after
+     * branching. False otherwise.
+     *
+     * In best-estimate search, branch() decides whether to plunge into
+     * a child. It returns NULL if the next node is to be picked from the
+     * open nodes.
+     */
     bool shouldDive();
 
     /** 
@@ -176,6 +191,39 @@ namespace Minotaur {
     /// Tolerance for pruning nodes on the basis of bounds.
     const double etol_;
 
+    /// Number of selections after which plungeQuot_ is adapted.
+    const UInt adaptFreq_;
+
+    /// Value of plunge_quot option. plungeQuot_ is adapted from it.
+    double baseQuot_;
+
+    /// Time spent processing nodes reached by jumping to an open node.
+    double jumpTime_;
+
+    /// Number of nodes reached by jumping to an open node.
+    UInt jumps_;
+
+    /// True if the last node selected was a child of the previous one.
+    bool lastPlunge_;
+
+    /// Time when the last node was selected, from selTimer_.
+    double lastSel_;
+
+    /// Always plunge if more nodes than this are open.
+    UInt maxOpen_;
+
+    /// Plunge into a child within this fraction of the gap. See branch().
+    double plungeQuot_;
+
+    /// Time spent processing nodes reached by plunging.
+    double plungeTime_;
+
+    /// Number of nodes reached by plunging.
+    UInt plunges_;
+
+    /// Timer for node throughput in best-estimate search, or NULL.
+    Timer *selTimer_;
+
     /// The search order: depth first, best first or something else.
     TreeSearchOrder searchType_;
 
@@ -191,9 +239,23 @@ namespace Minotaur {
     /// File name to store tree information for vbc.
     std::ofstream vbcFile_;
 
+    /**
+     * \brief Record the time spent on the last node and adapt plungeQuot_.
+     *
+     * Resetting the relaxation after a jump costs more than changing it
+     * after a plunge. Every adaptFreq_ selections, plungeQuot_ is set to
+     * baseQuot_ times the ratio of the time per node after a jump to that
+     * after a plunge, between 1 and 4.
+     * \param[in] plunge True if the next node is a child of the last one.
+     */
+    void recordSelection_(bool plunge);
+
     /// Check if the node can be pruned because of its bound.
     bool shouldPrune_(NodePtr node);
 
+    /// Return true if we should plunge into child in best-estimate search.
+    bool shouldPlunge_(NodePtr child);
+
     /**
      * \brief Insert a candidate (that is not root) into the tree.
      *
@@ -237,7 +237,8 @@ typedef enum {
 typedef enum {
   DepthFirst,
   BestFirst,
-  BestThenDive /// First find the best bound, then dive until pruned.
+  BestThenDive, /// First find the best bound, then dive until pruned.
+  BestEstimate  /// Best estimate, plunge while children are promising.
 } TreeSearchOrder;
 
 /// Convexity of a function or a constraint.
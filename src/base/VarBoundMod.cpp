@@ -17,6 +17,7 @@
 #include "Engine.h"
 #include "Problem.h"
 #include "Relaxation.h"
+#include "SlabAlloc.h"
 #include "VarBoundMod.h"
 #include "Variable.h"
 
@@ -49,6 +50,25 @@ VarBoundMod::~VarBoundMod()
 }
 
 
+static SlabAlloc *varBoundModAlloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("VarBoundMod", sizeof(VarBoundMod));
+  return a;
+}
+
+
+void *VarBoundMod::operator new(size_t size)
+{
+  return varBoundModAlloc_()->alloc(size);
+}
+
+
+void VarBoundMod::operator delete(void *p, size_t size)
+{
+  varBoundModAlloc_()->free(p, size);
+}
+
+
 ModificationPtr VarBoundMod::fromRel(RelaxationPtr rel, ProblemPtr) const
 {
   VarBoundModPtr mod = (VarBoundModPtr) new VarBoundMod(
@@ -132,6 +152,25 @@ VarBoundMod2::~VarBoundMod2()
 }
 
 
+static SlabAlloc *varBoundMod2Alloc_()
+{
+  static SlabAlloc *a = SlabAlloc::get("VarBoundMod2", sizeof(VarBoundMod2));
+  return a;
+}
+
+
+void *VarBoundMod2::operator new(size_t size)
+{
+  return varBoundMod2Alloc_()->alloc(size);
+}
+
+
+void VarBoundMod2::operator delete(void *p, size_t size)
+{
+  varBoundMod2Alloc_()->free(p, size);
+}
+
+
 ModificationPtr VarBoundMod2::fromRel(RelaxationPtr rel, ProblemPtr) const
 {
   VarBoundMod2Ptr mod = (VarBoundMod2Ptr) new VarBoundMod2(
@@ -35,6 +35,12 @@ class VarBoundMod : public Modification {
   /// Destroy.
   ~VarBoundMod();
 
+  /// Allocate from a SlabAlloc shared by all objects of this class.
+  static void *operator new(size_t size);
+
+  /// Return memory allocated by operator new.
+  static void operator delete(void *p, size_t size);
+
   // base class method.
   ModificationPtr fromRel(RelaxationPtr, ProblemPtr) const;
 
@@ -89,6 +95,12 @@ class VarBoundMod2 : public Modification {
   /// Destroy.
   ~VarBoundMod2();
 
+  /// Allocate from a SlabAlloc shared by all objects of this class.
+  static void *operator new(size_t size);
+
+  /// Return memory allocated by operator new.
+  static void operator delete(void *p, size_t size);
+
   // Implement Modification::applyToProblem().
   void applyToProblem(ProblemPtr problem);
 
@@ -26,6 +26,7 @@
 #include "Function.h"
 #include "Logger.h"
 #include "LinearFunction.h"
+#include "NlReader.h"
 #include "Option.h"
 #include "PolynomialFunction.h"
 #include "Problem.h"
@@ -204,6 +205,11 @@ void AMPLInterface::addOptions_()
      true, false);
   options->insert(b_option);
 
+  b_option = (Minotaur::BoolOptionPtr) new Minotaur::Option<bool>
+    ("read_nl_native", 
+     "If true, read .nl files without ASL when use_native_cgraph is true and the file does not have defined variables or other features not supported by Minotaur: <0/1>", 
+     true, true);
+  options->insert(b_option);
 }
 
 
@@ -2034,8 +2040,9 @@ Minotaur::ProblemPtr AMPLInterface::readInstance(std::string fname)
     << fname << std::endl;
   if (false==env_->getOptions()->findBool("use_native_cgraph")->getValue()) {
     p = readInstanceASL_(fname);
-  } 
-  p = readInstanceCG_(fname);
+  } else {
+    p = readInstanceCG_(fname);
+  }
 
   env_->getLogger()->msgStream(Minotaur::LogInfo) << me_ 
     << "time used in reading file = " << std::fixed 
@@ -2140,22 +2147,22 @@ Minotaur::ProblemPtr AMPLInterface::readInstanceASL_(std::string fname)
 
 Minotaur::ProblemPtr AMPLInterface::readInstanceCG_(std::string fname) 
 {
-  Minotaur::ProblemPtr instance;
+  Minotaur::ProblemPtr instance = 0;
   std::vector<std::set<int> > vars;
 
-  // We will read the stub using AMPL upto 2 times. In the first pass, read
-  // the stub and find the problem type. In the next pass, we actually save
-  // the data. If the problem is quadratic or polynomial, we save in native
-  // format, otherwise the problem just keeps a pointer to ampl solver library
-  // and uses information from there. 
+  if (env_->getOptions()->findBool("read_nl_native")->getValue()) {
+    instance = readInstanceNative_(fname);
+  }
 
-  // ask AMPL to read the stub 
-  readFile_(&fname, FGReader);
+  if (!instance) {
+    // ask AMPL to read the stub 
+    readFile_(&fname, FGReader);
 
-  // Load the array of ASL opcodes
-  createFunctionMap_();
+    // Load the array of ASL opcodes
+    createFunctionMap_();
 
-  instance = copyInstanceFromASL2_();
+    instance = copyInstanceFromASL2_();
+  }
 
   env_->getLogger()->msgStream(Minotaur::LogInfo) << me_ << "problem type is "
     << getProblemTypeString(instance->findType()) << std::endl;
@@ -2163,6 +2170,50 @@ Minotaur::ProblemPtr AMPLInterface::readInstanceCG_(std::string fname)
   return instance;
 }
 
+// Read the whole file with NlReader. ASL is only asked to read the header,
+// because the solution file is written by ASL.
+Minotaur::ProblemPtr AMPLInterface::readInstanceNative_(std::string fname)
+{
+  Minotaur::NlReader reader(env_);
+  Minotaur::ProblemPtr instance;
+  char *fname_chars;
+  FILE *nl = NULL;
+  int err = 0;
+
+  instance = reader.readInstance(fname, err);
+  if (!instance) {
+    if (2 == err) {
+      logger_->msgStream(Minotaur::LogInfo) << me_ 
+        << "using ASL to read the file because it has " 
+        << reader.getReason() << std::endl;
+    }
+    return 0;
+  }
+
+  fname_chars = (char *)malloc((fname.length()+1)*sizeof(char));
+  strcpy(fname_chars, fname.c_str());
+  readerType_ = FGReader;
+  myAsl_ = ASL_alloc(ASL_read_fg); 
+  nl = jac0dim_ASL(myAsl_, fname_chars, (fint) (fname.length()));
+  free(fname_chars);
+  if (nl) {
+    fclose(nl);
+  }
+
+  nVars_ = instance->getNumVars();
+  nCons_ = instance->getNumCons();
+  nDefVarsBco_ = 0;
+  nDefVarsCo1_ = 0;
+  nDefVars_ = 0;
+  vars_.assign(instance->varsBegin(), instance->varsEnd());
+
+  myAsl_->i.X0_ = (real *)mymalloc_ASL(nVars_*sizeof(real));
+  std::copy(reader.getInitialPoint().begin(), reader.getInitialPoint().end(),
+            myAsl_->i.X0_);
+  return instance;
+}
+
+
 void AMPLInterface::saveNlVars_(std::vector<std::set<int> > &vars)
 {
   std::set<int> vset;
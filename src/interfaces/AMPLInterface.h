@@ -311,6 +311,13 @@ private:
   Minotaur::ProblemPtr readInstanceASL_(std::string fname);
   Minotaur::ProblemPtr readInstanceCG_(std::string fname);
 
+  /**
+   * \brief Read the stub with Minotaur's own reader (NlReader), without
+   * ASL.
+   * \return The problem, or NULL if the reader does not support the file.
+   */
+  Minotaur::ProblemPtr readInstanceNative_(std::string fname);
+
   void saveNlVars_(std::vector<std::set<int> > &vars);
 
   /**
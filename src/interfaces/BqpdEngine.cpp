@@ -36,6 +36,7 @@
 #include "Problem.h"
 #include "ProblemSize.h"
 #include "Solution.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -491,6 +492,7 @@ void BqpdEngine::solve_(int mode, double &f)
   stats_->calls += 1;
   stats_->time  += timer_->query();
   stats_->iters += fStart_->info[0];
+  Telemetry::addIters(true, fStart_->info[0]);
 
   timer_->stop();
   //writewsc();
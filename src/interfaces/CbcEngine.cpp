@@ -11,11 +11,15 @@
  */
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 #include "coin/CoinPragma.hpp"
+#include "coin/CbcEventHandler.hpp"
 #include "coin/CbcModel.hpp"
+#include "coin/CbcSolver.hpp"
 #include "coin/OsiClpSolverInterface.hpp"
 
 #include "MinotaurConfig.h"
@@ -27,6 +31,7 @@
 #include "Logger.h"
 #include "Objective.h"
 #include "Option.h"
+#include "OsiLPEngine.h"
 #include "Problem.h"
 #include "Solution.h"
 #include "Timer.h"
@@ -38,19 +43,70 @@ using namespace Minotaur;
 
 const std::string CbcEngine::me_ = "CbcEngine: ";
 
+namespace Minotaur {
+  /**
+   * Cbc calls event() of a copy of this handler each time it finds a new
+   * incumbent. We put the incumbent in the pool of the engine, because Cbc
+   * does not copy its own saved solutions back from the model that it
+   * solves to the model that we pass.
+   */
+  class CbcPoolHandler : public CbcEventHandler {
+  public:
+    CbcPoolHandler(CbcEngine *engine)
+    : CbcEventHandler(),
+      engine_(engine)
+    {
+    }
+
+    CbcEventHandler *clone() const
+    {
+      return new CbcPoolHandler(*this);
+    }
+
+    CbcAction event(CbcEvent which)
+    {
+      if ((solution == which || heuristicSolution == which) && model_ &&
+          model_->bestSolution()) {
+        engine_->addToPool_(model_->bestSolution(), model_->getObjValue());
+      }
+      return noAction;
+    }
+
+  private:
+    CbcEngine *engine_;
+  };
+}
+
 // ----------------------------------------------------------------------- //
 // ----------------------------------------------------------------------- //
 
 CbcEngine::CbcEngine(EnvPtr env)
-: env_(env),
-  sol_(0)
+: bndChanged_(false),
+  consChanged_(false),
+  env_(env),
+  maxIterLimit_(0),
+  model_(0),
+  objChanged_(false),
+  osilp_(0),
+  problem_(0),
+  sol_(0),
+  timeLimit_(INFINITY),
+  upperCutoff_(INFINITY),
+  ws_(0)
 {
+  OptionDBPtr options = env_->getOptions();
+  int psize = options->findInt("cbc_pool_size")->getValue();
+
   logger_ = env_->getLogger();
   timer_  = env->getNewTimer();
-  osilp_  = 0;
   stats_  = new CbcStats();
   stats_->calls    = 0;
+  stats_->lpInf    = 0;
+  stats_->poolSols = 0;
+  stats_->starts   = 0;
   stats_->time     = 0;
+  poolSize_ = (psize > 0) ? psize : 1;
+  useMipStarts_ = options->findBool("oa_use_mip_starts")->getValue();
 }
 
 
@@ -66,38 +122,135 @@ CbcEngine::~CbcEngine()
     problem_->unsetEngine();
     problem_ = 0;
   }
+  clearPool_();
   if (osilp_) {
     delete osilp_;
   }
   if (sol_) {
     delete sol_;
   }
+  if (ws_) {
+    delete ws_;
+  }
 }
 
 
-void CbcEngine::addConstraint(ConstraintPtr )
+void CbcEngine::addConstraint(ConstraintPtr con)
 {
+  // Before the first solve, load_() reads all constraints from problem_.
+  if (!osilp_) {
+    return;
+  }
+
+  LinearFunctionPtr lf = con->getLinearFunction();
+  int nz = (lf) ? lf->getNumTerms() : 0;
+  int *cols = new int[nz];
+  double *elems = new double[nz];
+  int i = 0;
+
+  if (lf) {
+    for (VariableGroupConstIterator it = lf->termsBegin();
+         it != lf->termsEnd(); ++it, ++i) {
+      cols[i] = it->first->getIndex();
+      elems[i] = it->second;
+    }
+  }
+
+  // The basis of the other rows is kept. The slack of the new row is basic.
+  osilp_->addRow(nz, cols, elems, con->getLb(), con->getUb());
+  delete [] cols;
+  delete [] elems;
+  consChanged_ = true;
 }
 
 
-void CbcEngine::changeBound(ConstraintPtr , BoundType , double )
+void CbcEngine::addToPool_(const double *x, double obj)
 {
+  SolutionPtr sol;
+
+  if (pool_.size() >= poolSize_) {
+    delete pool_.front();
+    pool_.erase(pool_.begin());
+  }
+  sol = (SolutionPtr) new Solution(obj + 
+                                   problem_->getObjective()->getConstant(),
+                                   x, problem_);
+  pool_.push_back(sol);
+  ++(stats_->poolSols);
 }
 
 
-void CbcEngine::changeBound(VariablePtr , BoundType , double )
+void CbcEngine::changeBound(ConstraintPtr cons, BoundType lu, double new_val)
 {
+  if (!osilp_) {
+    return;
+  }
+  if (Upper == lu) {
+    osilp_->setRowUpper(cons->getIndex(), new_val);
+  } else {
+    osilp_->setRowLower(cons->getIndex(), new_val);
+  }
+  bndChanged_ = true;
 }
 
 
-void CbcEngine::changeBound(VariablePtr , double , double )
+void CbcEngine::changeBound(VariablePtr var, BoundType lu, double new_val)
 {
+  if (!osilp_) {
+    return;
+  }
+  switch (lu) {
+   case Lower:
+     osilp_->setColLower(var->getIndex(), new_val);
+     break;
+   case Upper:
+     osilp_->setColUpper(var->getIndex(), new_val);
+     break;
+   default:
+     break;
+  }
+  bndChanged_ = true;
 }
 
 
-void CbcEngine::changeConstraint(ConstraintPtr , LinearFunctionPtr , 
-                                   double , double )
+void CbcEngine::changeBound(VariablePtr var, double new_lb, double new_ub)
 {
+  if (!osilp_) {
+    return;
+  }
+  osilp_->setColBounds(var->getIndex(), new_lb, new_ub);
+  bndChanged_ = true;
+}
+
+
+void CbcEngine::changeConstraint(ConstraintPtr c, LinearFunctionPtr lf, 
+                                 double lb, double ub)
+{
+  if (!osilp_) {
+    return;
+  }
+
+  OsiClpSolverInterface *osiclp =
+    dynamic_cast<OsiClpSolverInterface *>(osilp_);
+  ConstLinearFunctionPtr clf = c->getFunction()->getLinearFunction();
+  int row = c->getIndex();
+
+  assert(osiclp);
+  // first zero out all the existing coefficients in the row.
+  if (clf) {
+    for (VariableGroupConstIterator it = clf->termsBegin();
+         it != clf->termsEnd(); ++it) {
+      osiclp->modifyCoefficient(row, it->first->getIndex(), 0.0);
+    }
+  }
+  if (lf) {
+    for (VariableGroupConstIterator it = lf->termsBegin();
+         it != lf->termsEnd(); ++it) {
+      osiclp->modifyCoefficient(row, it->first->getIndex(), it->second);
+    }
+  }
+  osiclp->setRowBounds(row, lb, ub);
+  consChanged_ = true;
 }
 
 
@@ -107,13 +260,28 @@ void CbcEngine::changeConstraint(ConstraintPtr, NonlinearFunctionPtr)
 }
 
 
-void CbcEngine::changeObj(FunctionPtr , double)
+void CbcEngine::changeObj(FunctionPtr f, double)
 {
+  if (!osilp_) {
+    return;
+  }
+  setObj_(f);
+  objChanged_ = true;
 }
 
 
 void CbcEngine::clear()
 {
+  clearPool_();
+  if (osilp_) {
+    delete osilp_;
+    osilp_ = 0;
+  }
+  if (ws_) {
+    delete ws_;
+    ws_ = 0;
+  }
+  mipStart_.clear();
   if (problem_) {
     problem_->unsetEngine();
     problem_ = 0;
@@ -121,6 +289,20 @@ void CbcEngine::clear()
 }
 
 
+void CbcEngine::clearPool_()
+{
+  for (std::vector<SolutionPtr>::iterator it = pool_.begin();
+       it != pool_.end(); ++it) {
+    delete *it;
+  }
+  pool_.clear();
+  if (model_) {
+    delete model_;
+    model_ = 0;
+  }
+}
+
+
 EnginePtr CbcEngine::emptyCopy()
 {
   return new CbcEngine(env_);
@@ -133,6 +315,12 @@ std::string CbcEngine::getName() const
 }
 
 
+UInt CbcEngine::getNumSols()
+{
+  return pool_.size();
+}
+
+
 double CbcEngine::getSolutionValue() 
 {
   return sol_->getObjValue();
@@ -145,14 +333,47 @@ ConstSolutionPtr CbcEngine::getSolution()
 }
 
 
+ConstSolutionPtr CbcEngine::getSolutionFromPool(int index)
+{
+  // The incumbent is the last one in pool_.
+  if (index < 0) {
+    return (pool_.empty()) ? 0 : pool_.back();
+  } else if (index + 1 < (int) pool_.size()) {
+    return pool_[pool_.size() - 2 - index];
+  }
+  return 0;
+}
+
+
 EngineStatus CbcEngine::getStatus() 
 {
   return status_;
 }
 
 
+ConstWarmStartPtr CbcEngine::getWarmStart()
+{
+  return ws_;
+}
+
+
+WarmStartPtr CbcEngine::getWarmStartCopy()
+{
+  OsiLPWarmStartPtr ws;
+
+  if (!osilp_) {
+    return WarmStartPtr();
+  }
+  ws = new OsiLPWarmStart();
+  ws->setCoinWarmStart(osilp_->getWarmStart(), true);
+  return ws;
+}
+
+
 void CbcEngine::load(ProblemPtr problem)
 {
+  // osilp_ is created from the problem in the first solve.
+  clear();
   objChanged_ = true;
   bndChanged_ = true;
   consChanged_ = true;
@@ -166,7 +387,6 @@ void CbcEngine::load_()
   int numvars = problem_->getNumVars();
   int numcons = problem_->getNumCons();
   int i,j;
-  double obj_sense = 1.;
 
   CoinPackedMatrix *r_mat;
   double *conlb, *conub, *varlb, *varub, *obj;
@@ -225,21 +445,8 @@ void CbcEngine::load_()
     varub[i] = (*v_iter)->getUb();
   }
 
-  // XXX: check if linear function is NULL
-  lin = problem_->getObjective()->getLinearFunction();
-  if (problem_->getObjective()->getObjectiveType() == Minotaur::Maximize) {
-    obj_sense = -1.;
-  }
   obj = new double[numvars];
-  i = 0;
-  if (lin) {
-    for (v_iter=problem_->varsBegin(); v_iter!=problem_->varsEnd(); ++v_iter, 
-         ++i) {
-      obj[i]   = obj_sense*lin->getWeight(*v_iter);
-    }
-  } else {
-    memset(obj, 0, numvars * sizeof(double));
-  }
+  memset(obj, 0, numvars * sizeof(double));
 
   r_mat = new CoinPackedMatrix(false, numvars, numcons, nnz, value, index, 
                                start, NULL);
@@ -252,8 +459,8 @@ void CbcEngine::load_()
   osilp_->messageHandler()->setLogLevel(0); 
 
   osilp_->loadProblem(*r_mat, varlb, varub, obj, conlb, conub);
-  for (v_iter=problem_->varsBegin(); v_iter!=problem_->varsEnd(); ++v_iter, 
-       ++i) {
+  setObj_(problem_->getObjective()->getFunction());
+  for (v_iter=problem_->varsBegin(); v_iter!=problem_->varsEnd(); ++v_iter) {
     if (Binary==(*v_iter)->getType() || Integer==(*v_iter)->getType()) {
       osilp_->setInteger((*v_iter)->getIndex());
     }
@@ -264,11 +471,6 @@ void CbcEngine::load_()
   }
   sol_ = (SolutionPtr) new Solution(1E20, 0, problem_);
 
-  objChanged_ = true;
-  bndChanged_ = true;
-  consChanged_ = true;
-
-  osilp_->writeLp("foo");
   delete r_mat;
   delete [] index;
   delete [] value;
@@ -278,20 +480,54 @@ void CbcEngine::load_()
   delete [] varlb;
   delete [] varub;
   delete [] obj;
-
-  // osilp_->writeLp("stub");
-  // exit(0);
 }
 
 
+void CbcEngine::loadFromWarmStart(const WarmStartPtr ws)
+{
+  ConstOsiLPWarmStartPtr ws2 = dynamic_cast<const OsiLPWarmStart *>(ws);
+
+  assert(ws2);
+  if (!osilp_) {
+    load_();
+  }
+  osilp_->setWarmStart(ws2->getCoinWarmStart());
+}
+
 
 void CbcEngine::negateObj()
 {
+  if (!osilp_) {
+    return;
+  }
+
+  int n = osilp_->getNumCols();
+  double *obj = new double[n];
+  const double *old_obj = osilp_->getObjCoefficients();
+
+  for (int i = 0; i < n; ++i) {
+    obj[i] = -old_obj[i];
+  }
+  osilp_->setObjective(obj);
+  objChanged_ = true;
+  delete [] obj;
 }
 
 
-void CbcEngine::removeCons(std::vector<ConstraintPtr> &)
+void CbcEngine::removeCons(std::vector<ConstraintPtr> &delcons)
 {
+  if (!osilp_ || delcons.empty()) {
+    return;
+  }
+
+  int num = delcons.size();
+  int *inds = new int[num];
+
+  for (int i = 0; i < num; ++i) {
+    inds[i] = delcons[i]->getIndex();
+  }
+  osilp_->deleteRows(num, inds);
+  delete [] inds;
   consChanged_ = true;
 }
 
@@ -306,82 +542,170 @@ void CbcEngine::setIterationLimit(int )
 }
   
 
-void CbcEngine::setTimeLimit(double )
+void CbcEngine::setObj_(FunctionPtr f)
+{
+  int n = osilp_->getNumCols();
+  double obj_sense = 1.;
+  LinearFunctionPtr lf = (f) ? f->getLinearFunction() : 0;
+  double *obj = new double[n];
+
+  if (problem_->getObjective()->getObjectiveType() == Minotaur::Maximize) {
+    obj_sense = -1.;
+  }
+  std::fill(obj, obj + n, 0.0);
+  if (lf) {
+    for (VariableGroupConstIterator it = lf->termsBegin();
+         it != lf->termsEnd(); ++it) {
+      obj[it->first->getIndex()] = obj_sense * it->second;
+    }
+  }
+  osilp_->setObjective(obj);
+  delete [] obj;
+}
+
+
+void CbcEngine::setTimeLimit(double t)
 {
+  timeLimit_ = t;
 }
 
 
-void CbcEngine::setUpperCutoff(double)
+void CbcEngine::setUpperCutoff(double cutoff)
 {
+  upperCutoff_ = cutoff;
 }
 
 
 EngineStatus CbcEngine::solve()
 {
-  CbcModel *model = 0;
-  std::string params = "-loglevel 0 -solve ";
+  std::ostringstream params;
+  const double *x = 0;
+  double obj_cb = problem_->getObjective()->getConstant();
+  int n;
+  CbcPoolHandler handler(this);
 
   timer_->start();
-  if (true==objChanged_ || true==bndChanged_ || true==consChanged_) {
+  clearPool_();
+  if (!osilp_) {
     load_();
   }
+  n = osilp_->getNumCols();
 
   stats_->calls += 1;
 #if SPEW
   logger_->msgStream(LogDebug) << me_ << "in call number " << stats_->calls
                                << std::endl;
 #endif
-  
-  model = new CbcModel(*osilp_);    
-  callCbc(params, *model);
-
-  if (model->isProvenOptimal()) {
-    status_ = ProvenOptimal;  
-    sol_->setPrimal(osilp_->getColSolution());
-    sol_->setObjValue(model->getObjValue()*model->getObjSense() + 
-                      problem_->getObjective()->getConstant());
-  } else if (model->isProvenInfeasible()) {
+
+  // Resolve the LP relaxation from the basis of the previous solve. Cuts
+  // added since then only need a few dual pivots. If the LP is infeasible,
+  // so is the MILP and Cbc need not be called.
+  osilp_->resolve();
+  if (osilp_->isProvenPrimalInfeasible()) {
+    ++(stats_->lpInf);
     status_ = ProvenInfeasible;
     sol_->setObjValue(INFINITY);
-  } else if(model->isContinuousUnbounded()) {
-    status_ = ProvenUnbounded;    // or it could be infeasible
-    sol_->setObjValue(-INFINITY);
-  } else if(model->isProvenDualInfeasible()) {
-    status_ = ProvenUnbounded;    // primal is not infeasible but dual is.
-    sol_->setObjValue(-INFINITY);
-  } else if (model->isNodeLimitReached() || model->isSecondsLimitReached() ||
-             model->isSolutionLimitReached()) {
-    status_ = EngineIterationLimit;
-    sol_->setPrimal(osilp_->getStrictColSolution());
-    sol_->setObjValue(osilp_->getObjValue()
-        +problem_->getObjective()->getConstant());
-  } else if(model->isAbandoned()) {
-    status_ = EngineError;
-    sol_->setObjValue(INFINITY);
   } else {
-    status_ = EngineUnknownStatus;
-    sol_->setObjValue(INFINITY);
+    // The copy in model_ starts from the optimal basis of osilp_.
+    model_ = new CbcModel(*osilp_);
+    model_->passInEventHandler(&handler);
+    if (useMipStarts_ && (int) mipStart_.size() == n) {
+      // Cbc fixes the integer variables and solves for the others, so the
+      // previous incumbent is accepted if it is still feasible after the
+      // new cuts in that sense.
+      model_->setBestSolution(&mipStart_[0], n, COIN_DBL_MAX, true);
+      if (model_->bestSolution()) {
+        ++(stats_->starts);
+        addToPool_(model_->bestSolution(), model_->getObjValue());
+      }
+    }
+
+    // Preprocessing is turned off so that the solutions found by Cbc are
+    // in the space of our variables.
+    params << std::setprecision(15) << "-loglevel 0 -preprocess off ";
+    if (timeLimit_ < INFINITY) {
+      params << "-sec " << (timeLimit_ > 0 ? timeLimit_ : 0) << " ";
+    }
+    if (upperCutoff_ < INFINITY) {
+      params << "-cutoff " << upperCutoff_ - obj_cb << " ";
+    }
+    params << "-solve ";
+    callCbc(params.str(), *model_);
+
+    if (!pool_.empty()) {
+      x = pool_.back()->getPrimal();
+    } else if (model_->bestSolution()) {
+      x = model_->bestSolution();
+      addToPool_(x, model_->getObjValue());
+    }
+
+    if (model_->isProvenOptimal() && x) {
+      status_ = ProvenOptimal;  
+      sol_->setPrimal(x);
+      sol_->setObjValue(pool_.back()->getObjValue());
+    } else if (model_->isProvenInfeasible() ||
+               (model_->isProvenOptimal() && !x)) {
+      status_ = ProvenInfeasible;
+      sol_->setObjValue(INFINITY);
+    } else if(model_->isContinuousUnbounded()) {
+      status_ = ProvenUnbounded;    // or it could be infeasible
+      sol_->setObjValue(-INFINITY);
+    } else if(model_->isProvenDualInfeasible()) {
+      status_ = ProvenUnbounded;    // primal is not infeasible but dual is.
+      sol_->setObjValue(-INFINITY);
+    } else if (model_->isNodeLimitReached() ||
+               model_->isSecondsLimitReached() ||
+               model_->isSolutionLimitReached()) {
+      status_ = EngineIterationLimit;
+      if (x) {
+        sol_->setPrimal(x);
+        sol_->setObjValue(pool_.back()->getObjValue());
+      } else {
+        sol_->setObjValue(INFINITY);
+      }
+    } else if(model_->isAbandoned()) {
+      status_ = EngineError;
+      sol_->setObjValue(INFINITY);
+    } else {
+      status_ = EngineUnknownStatus;
+      sol_->setObjValue(INFINITY);
+    }
+
+    if (x) {
+      mipStart_.assign(x, x + n);
+    }
   }
 
+  // basis of the LP relaxation, for getWarmStart().
+  if (ws_) {
+    delete ws_;
+  }
+  ws_ = new OsiLPWarmStart();
+  ws_->setCoinWarmStart(osilp_->getWarmStart(), true);
+
   stats_->time  += timer_->query();
 
 #if SPEW
   logger_->msgStream(LogDebug) << me_ << "status = " << status_ << std::endl
                                << me_ << "solution value = " 
-                               << sol_->getObjValue() << std::endl;
+                               << sol_->getObjValue() << std::endl
+                               << me_ << "solutions in pool = "
+                               << pool_.size() << std::endl;
 #endif
   timer_->stop();
   bndChanged_ = false;
   consChanged_ = false;
   objChanged_ = false;
 
-  delete model;
   return status_;
 }
 
 
-void CbcEngine::writeLP(const char *) const 
+void CbcEngine::writeLP(const char *filename) const 
 { 
+  if (osilp_) {
+    osilp_->writeLp(filename);
+  }
 }
 
 
@@ -389,6 +713,9 @@ void CbcEngine::writeStats(std::ostream &out) const
 {
   if (stats_) {
     out << me_ << "total calls            = " << stats_->calls << std::endl
+      << me_ << "infeasible LP calls    = " << stats_->lpInf << std::endl
+      << me_ << "calls with MIP start   = " << stats_->starts << std::endl
+      << me_ << "solutions in pools     = " << stats_->poolSols << std::endl
       << me_ << "total time in solving  = " << stats_->time  << std::endl;
   }
 }
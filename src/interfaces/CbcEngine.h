@@ -13,8 +13,11 @@
 #ifndef MINOTAURCBCENGINE_H
 #define MINOTAURCBCENGINE_H
 
+#include <vector>
+
 #include "MILPEngine.h"
 
+class CbcModel;
 class OsiSolverInterface;
 
 namespace Minotaur {
@@ -23,6 +26,7 @@ namespace Minotaur {
   class   Environment;
   class   Problem;
   class   Solution;
+  class   OsiLPWarmStart;
   class   WarmStart;
   typedef Environment* EnvPtr;
   typedef Problem* ProblemPtr;
@@ -32,10 +36,22 @@ namespace Minotaur {
   /// Statistics
   struct CbcStats {
     UInt calls;     /// Total number of calls to solve.
+    UInt lpInf;     /// Calls where the warm-started LP was infeasible.
+    UInt poolSols;  /// Solutions put in the pool in all calls.
+    UInt starts;    /// Calls where the previous incumbent was a MIP start.
     double time;    /// Sum of time taken in all calls to solve.
   };
 
-  /// The CbcEngine class can be called to solve MILP problems
+  /**
+   * \brief The CbcEngine class can be called to solve MILP problems.
+   *
+   * The problem is loaded in an OsiClp interface once. Later changes to
+   * constraints, bounds and objective are made in this interface directly,
+   * so that the LP basis from the previous solve is kept. Before each
+   * solve, the LP relaxation is resolved from this basis, and the Cbc model
+   * is started from it and from the previous incumbent. Solutions found by
+   * Cbc in a solve are kept in a pool until the next solve.
+   */
   class CbcEngine : public MILPEngine {
   public:
     /// Constructor with an environment.
@@ -77,7 +93,7 @@ namespace Minotaur {
     void enableStrBrSetup() {};
 
     /// Get the number of solutions in the solution pool of Cbc.
-    UInt getNumSols() {};
+    UInt getNumSols();
 
     /// Return the solution value of the objective after solving the LP.
     double getSolutionValue();
@@ -85,8 +101,15 @@ namespace Minotaur {
     // Implement Engine::getSolution().
     ConstSolutionPtr getSolution();
 
-    // Get a particular solution from solution pool.
-    ConstSolutionPtr getSolutionFromPool(int ) {};
+    /**
+     * \brief Get a particular solution from solution pool.
+     *
+     * \param[in] index -1 for the incumbent. Otherwise 0 to getNumSols()-2
+     * for the other solutions, most recently found first.
+     * \return The solution. It is owned by the engine and is valid until
+     * the next solve.
+     */
+    ConstSolutionPtr getSolutionFromPool(int index);
 
     // Implement Engine::getStatus().
     EngineStatus getStatus();
@@ -94,9 +117,11 @@ namespace Minotaur {
     // get name.
     std::string getName() const;
 
-    ConstWarmStartPtr getWarmStart() {return WarmStartPtr();};
+    // Implement Engine::getWarmStart(). The LP basis at the last solve.
+    ConstWarmStartPtr getWarmStart();
 
-    WarmStartPtr getWarmStartCopy()  {return WarmStartPtr();};
+    // Implement Engine::getWarmStartCopy().
+    WarmStartPtr getWarmStartCopy();
 
     /** 
      * Load the problem into the engine. We create arrays of variables and
@@ -105,7 +130,8 @@ namespace Minotaur {
      */
     void load(ProblemPtr problem);
 
-    void loadFromWarmStart(const WarmStartPtr ) {};
+    // Implement Engine::loadFromWarmStart(). Sets the LP basis.
+    void loadFromWarmStart(const WarmStartPtr ws);
 
     // Convert 'min f' to 'min -f'.
     void negateObj();
@@ -129,9 +155,10 @@ namespace Minotaur {
     void setUpperCutoff(double);
 
     /** 
-     * Solve the problem that was loaded. Calls resolve() function of Osi.
-     * The resolve() function ``smartly'' decides what method of clp should
-     * be called.
+     * Solve the problem that was loaded. The LP relaxation is resolved
+     * first by Osi from the previous basis. If it is infeasible, so is the
+     * MILP. Otherwise Cbc is called with this basis and the previous
+     * incumbent as a MIP start.
      */
     EngineStatus solve();
 
@@ -142,6 +169,8 @@ namespace Minotaur {
     void writeStats(std::ostream &out) const;
 
   private:
+    friend class CbcPoolHandler;
+
     /// True if any bound on variable on constraint was changed after 
     /// previous solve.
     bool bndChanged_;
@@ -155,6 +184,12 @@ namespace Minotaur {
     /// The maximum limit that can be set on Osi solver. 
     int maxIterLimit_;
 
+    /// Incumbent of the previous solve, used as a MIP start. Empty if none.
+    std::vector<double> mipStart_;
+
+    /// Cbc model of the last solve. Kept for its pool of solutions.
+    CbcModel *model_;
+
     /// String name used in log messages.
     static const std::string me_;
 
@@ -166,6 +201,12 @@ namespace Minotaur {
      */
     OsiSolverInterface *osilp_;
 
+    /// Solutions found in the last solve, in the order they were found.
+    std::vector<SolutionPtr> pool_;
+
+    /// Maximum number of solutions in pool_.
+    UInt poolSize_;
+
     /// Problem that is loaded, if any.
     ProblemPtr problem_;
 
@@ -175,11 +216,32 @@ namespace Minotaur {
     /// Statistics.
     CbcStats *stats_;
 
+    /// Time limit for a solve, in seconds.
+    double timeLimit_;
+
     /// Timer for solves. 
     Timer *timer_;
 
-    /// Actually load the problem. Called before _every_ solve.
+    /// Cutoff on the objective value for a solve.
+    double upperCutoff_;
+
+    /// If true, the incumbent of the previous solve is used as a MIP start.
+    bool useMipStarts_;
+
+    /// LP basis at the last solve, returned by getWarmStart().
+    OsiLPWarmStart *ws_;
+
+    /// Add a solution found by Cbc to the pool. Called by CbcPoolHandler.
+    void addToPool_(const double *x, double obj);
+
+    /// Delete the solutions in the pool and the Cbc model.
+    void clearPool_();
+
+    /// Load the problem in osilp_. Called at the first solve after load().
     void load_();
+
+    /// Objective coefficients of f in osilp_, with the sense of the problem.
+    void setObj_(FunctionPtr f);
   };
   
   typedef CbcEngine* CbcEnginePtr;
@@ -27,6 +27,7 @@
 #include "Problem.h"
 #include "Relaxation.h"
 #include "Solution.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -808,6 +809,7 @@ EngineStatus CplexLPEngine::solve()
   }
 
   stats_->iters += CPXXgetitcnt(cpxenv_, cpxlp_);
+  Telemetry::addIters(false, CPXXgetitcnt(cpxenv_, cpxlp_));
   stats_->time  += timer_->query();
 
   if (strBr_) {
@@ -29,6 +29,7 @@
 #include "Option.h"
 #include "Problem.h"
 #include "Solution.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -307,6 +308,18 @@ void FilterSQPEngine::changeBound(VariablePtr v, double lb, double ub)
 }
 
 
+void FilterSQPEngine::changeBounds(const VarVector &vars, const double *lb,
+                                   const double *ub)
+{
+  if (bl_) {
+    for (UInt i = 0; i < vars.size(); ++i) {
+      bl_[vars[i]->getIndex()] = lb[i];
+      bu_[vars[i]->getIndex()] = ub[i];
+    }
+  }
+}
+
+
 void FilterSQPEngine::changeConstraint(ConstraintPtr, LinearFunctionPtr, 
                                        double , double)
 {
@@ -1032,6 +1045,7 @@ EngineStatus FilterSQPEngine::solve()
   stats_->calls += 1;
   stats_->time  += timer_->query();
   stats_->iters += istat_[1];
+  Telemetry::addIters(true, istat_[1]);
   timer_->stop();
 
   // store the solution
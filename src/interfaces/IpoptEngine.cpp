@@ -34,6 +34,7 @@
 #include "Option.h"
 #include "Problem.h"
 #include "ProblemSize.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -321,6 +322,12 @@ void IpoptEngine::changeBound(VariablePtr, double, double)
   bndChanged_ = true;
 }
 
+void IpoptEngine::changeBounds(const VarVector &, const double *,
+                               const double *)
+{
+  bndChanged_ = true;
+}
+
 void IpoptEngine::changeConstraint(ConstraintPtr, LinearFunctionPtr, double,
                                    double)
 {
@@ -773,6 +780,7 @@ EngineStatus IpoptEngine::solve()
   }
   stats_->time += timer_->query();
   stats_->iters += iters;
+  Telemetry::addIters(true, iters);
   timer_->stop();
 
   bndChanged_ = false;
@@ -982,42 +990,28 @@ bool IpoptFunInterface::get_starting_point(Index n, bool init_x, Number* x,
   return true;
 }
 
-bool IpoptFunInterface::eval_f(Index n, const Number* x, bool,
+bool IpoptFunInterface::eval_f(Index, const Number* x, bool new_x,
                                Number& obj_value)
 {
   int error = 0;
-  double* ex = 0; // it will be assigned to xx if evalWithinBnds_ is true,
-                  // otherwise to x.
-  double* xx = 0;
+  // values of x are pulled within bounds if evalWithinBnds_ is true.
+  const double* ex = problem_->getEvalPoint(x, new_x, evalWithinBnds_);
 
-  if(evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double*)x;
-  }
   // return the value of the objective function
   obj_value = problem_->getObjValue(ex, &error);
   return (0 == error);
 }
 
-bool IpoptFunInterface::eval_g(Index n, const Number* x, bool, Index, Number* g)
+bool IpoptFunInterface::eval_g(Index, const Number* x, bool new_x, Index,
+                               Number* g)
 {
   // return the value (activity) of the constraints: g(x)
   Minotaur::ConstraintConstIterator cIter;
   Minotaur::ConstraintPtr cPtr;
   Minotaur::UInt i = 0;
   int error = 0, e = 0;
-  double* ex = 0; // it will be assigned to xx if evalWithinBnds_ is true,
-                  // otherwise to x.
-  double* xx = 0;
+  const double* ex = problem_->getEvalPoint(x, new_x, evalWithinBnds_);
 
-  if(evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double*)x;
-  }
   for(cIter = problem_->consBegin(); cIter != problem_->consEnd(); ++cIter) {
     cPtr = *cIter;
     e = 0;
@@ -1033,68 +1027,44 @@ bool IpoptFunInterface::eval_g(Index n, const Number* x, bool, Index, Number* g)
     ++i;
   }
 
-  if(xx) {
-    delete[] xx;
-  }
-
   return (0 == error);
 }
 
-bool IpoptFunInterface::eval_grad_f(Index n, const Number* x, bool,
+bool IpoptFunInterface::eval_grad_f(Index n, const Number* x, bool new_x,
                                     Number* grad_f)
 {
   // return the gradient of the objective function grad_{x} f(x)
 
   int error = 0;
   Minotaur::ObjectivePtr o;
-  double* ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double* xx = NULL;
+  const double* ex = problem_->getEvalPoint(x, new_x, evalWithinBnds_);
 
   std::fill(grad_f, grad_f + n, 0);
 
-  if(evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double*)x;
-  }
-
   o = problem_->getObjective();
   if(o) {
     o->evalGradient(ex, (double*)grad_f, &error);
   }
 
-  if(xx) {
-    delete[] xx;
-  }
-
   //for (int i=0; i<n; ++i) {
   //  std::cout << "grad obj [" << i << "] = " << grad_f[i] << std::endl;
   //}
   return (0 == error);
 }
 
-bool IpoptFunInterface::eval_h(Index n, const Number* x, bool,
+bool IpoptFunInterface::eval_h(Index, const Number* x, bool new_x,
                                Number obj_factor, Index, const Number* lambda,
                                bool, Index, Index* iRow, Index* jCol,
                                Number* values)
 {
   int error = 0;
-  double* ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double* xx = NULL;
+  const double* ex = NULL;
 
   if(x == 0 && lambda == 0 && values == 0) {
     problem_->getHessian()->fillRowColIndices((Minotaur::UInt*)iRow,
                                               (Minotaur::UInt*)jCol);
   } else if(x != 0 && lambda != 0 && values != 0) {
-    if(evalWithinBnds_) {
-      xx = pullXToBnds_(x, n);
-      ex = xx;
-    } else {
-      ex = (double*)x;
-    }
+    ex = problem_->getEvalPoint(x, new_x, evalWithinBnds_);
     problem_->getHessian()->fillRowColValues(
         ex, (double)obj_factor, (double*)lambda, (double*)values, &error);
     //std::cout << "error = " << error << std::endl;
@@ -1104,40 +1074,27 @@ bool IpoptFunInterface::eval_h(Index n, const Number* x, bool,
     //for (int i=0; i<problem_->getHessian()->getNumNz(); ++i) {
     //  std::cout << std::setprecision(8) << "h["<<i<<"] = "<<values[i] << std::endl;
     //}
-    if(xx) {
-      delete[] xx;
-    }
   } else {
     assert(!"one of x, lambda and values is NULL!");
   }
   return (0 == error);
 }
 
-bool IpoptFunInterface::eval_jac_g(Index n, const Number* x, bool, Index, Index,
-                                   Index* iRow, Index* jCol, Number* values)
+bool IpoptFunInterface::eval_jac_g(Index, const Number* x, bool new_x, Index,
+                                   Index, Index* iRow, Index* jCol,
+                                   Number* values)
 {
   int error = 0;
-  double* ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double* xx = NULL;
+  const double* ex = NULL;
 
   if(values == 0) {
     // return the structure of the jacobian of the constraints
     problem_->getJacobian()->fillRowColIndices((Minotaur::UInt*)iRow,
                                                (Minotaur::UInt*)jCol);
   } else {
-    if(evalWithinBnds_) {
-      xx = pullXToBnds_(x, n);
-      ex = xx;
-    } else {
-      ex = (double*)x;
-    }
+    ex = problem_->getEvalPoint(x, new_x, evalWithinBnds_);
     // return the values of the jacobian of the constraints
-    problem_->getJacobian()->fillRowColValues((double*)ex, (double*)values,
-                                              &error);
-    if(xx) {
-      delete[] xx;
-    }
+    problem_->getJacobian()->fillRowColValues(ex, (double*)values, &error);
   }
   if(error != 0) {
     logger_->msgStream(Minotaur::LogError)
@@ -1169,20 +1126,5 @@ double IpoptFunInterface::getSolutionValue() const
   return sol_->getObjValue();
 }
 
-double* IpoptFunInterface::pullXToBnds_(const Number* x, Index n)
-{
-  double* xx = new double[n];
-  for(int ii = 0; ii < n; ++ii) {
-    if(x[ii] < problem_->getVariable(ii)->getLb()) {
-      xx[ii] = problem_->getVariable(ii)->getLb();
-    } else if(x[ii] > problem_->getVariable(ii)->getUb()) {
-      xx[ii] = problem_->getVariable(ii)->getUb();
-    } else {
-      xx[ii] = x[ii];
-    }
-  }
-  return xx;
-}
-
 } // namespace Ipopt
 
@@ -173,6 +173,11 @@ namespace Minotaur {
     // Implement Engine::changeBound(VariablePtr, double, double).
     void changeBound(VariablePtr var, double new_lb, double new_ub);
 
+    // Implement Engine::changeBounds(). Bounds are read from the problem
+    // when solving.
+    void changeBounds(const VarVector &vars, const double *lb,
+                      const double *ub);
+
     // Implement Engine::changeConstraint().
     void changeConstraint(ConstraintPtr con, LinearFunctionPtr lf, 
                           double lb, double ub);
@@ -119,7 +119,8 @@ namespace Ipopt {
     double bTol_;
 
     /// Pull values of a variable to its bounds if it is not within bounds for
-    /// function and derivative evaluations
+    /// function and derivative evaluations. If x violates the bounds, then
+    /// evaluations may give an error (e.g. (x1)^1.852).
     bool evalWithinBnds_;
 
     /// Where to put logs.
@@ -135,18 +136,6 @@ namespace Ipopt {
      * changed within IpoptFunInterface
      */
     Minotaur::IpoptSolPtr sol_;
-
-    /**
-     * If x violates the lower or upperbounds on the variables, then function
-     * evaluation or derivatives may give error (e.g. (x1)^1.852). It may be
-     * desirable to first change x so that it is within the bounds. This
-     * function does this. 
-     * \param[in] x array of coordinates of the currect point.
-     * \param[in] n size of x.
-     * \param[out] A new array of size n with values same as x if it is in
-     * bounds and bounds if any is violated.
-     */
-    double *pullXToBnds_(const Number* x, Index n);
   };
 }
 #endif
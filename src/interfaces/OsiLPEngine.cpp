@@ -40,6 +40,7 @@
 #include "OsiLPEngine.h"
 #include "Problem.h"
 #include "Solution.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -224,6 +225,23 @@ void OsiLPEngine::changeBound(VariablePtr var, double new_lb, double new_ub)
   bndChanged_ = true;
 }
 
+void OsiLPEngine::changeBounds(const VarVector &vars, const double *lb,
+                               const double *ub)
+{
+  std::vector<int> cols(vars.size());
+  DoubleVector bnds(2 * vars.size());
+
+  for (UInt i = 0; i < vars.size(); ++i) {
+    cols[i] = vars[i]->getIndex();
+    bnds[2 * i] = lb[i];
+    bnds[2 * i + 1] = ub[i];
+  }
+  if (!cols.empty()) {
+    osilp_->setColSetBounds(&cols[0], &cols[0] + cols.size(), &bnds[0]);
+    bndChanged_ = true;
+  }
+}
+
 #if MNTROSICLP
 void OsiLPEngine::changeConstraint(ConstraintPtr c, LinearFunctionPtr lf,
                                    double lb, double ub)
@@ -734,6 +752,7 @@ EngineStatus OsiLPEngine::solve()
   }
 
   stats_->iters += osilp_->getIterationCount();
+  Telemetry::addIters(false, osilp_->getIterationCount());
   stats_->time += timer_->query();
   if (strBr_) {
     ++(stats_->strCalls);
@@ -119,6 +119,10 @@ class OsiLPEngine : public LPEngine {
   // Implement Engine::changeBound(VariablePtr, double, double).
   void changeBound(VariablePtr var, double new_lb, double new_ub);
 
+  // Implement Engine::changeBounds(). Uses one call to setColSetBounds.
+  void changeBounds(const VarVector &vars, const double *lb,
+                    const double *ub);
+
   // Implement Engine::changeConstraint().
   void changeConstraint(ConstraintPtr con, LinearFunctionPtr lf, double lb,
                         double ub);
@@ -687,21 +687,6 @@ zero
         return true;  // Return true if all elements are zero
 }
 */
-double* UnoModel::pullXToBnds_(const Vector<double>& x, size_t n) const
-{
-  double* xx = new double[n];
-  for (int ii = 0; ii < n; ++ii) {
-    if (x[ii] < p_->getVariable(ii)->getLb()) {
-      xx[ii] = p_->getVariable(ii)->getLb();
-    } else if (x[ii] > p_->getVariable(ii)->getUb()) {
-      xx[ii] = p_->getVariable(ii)->getUb();
-    } else {
-      xx[ii] = x[ii];
-    }
-  }
-  return xx;
-}
-
 void UnoModel::evaluate_lagrangian_hessian(
     const Vector<double>& x, double objective_multiplier,
     const Vector<double>& multipliers,
@@ -711,9 +696,7 @@ void UnoModel::evaluate_lagrangian_hessian(
   // std::cout << "\n=========evaluate_lagrangian_hessian starts=========\n";
   //  Scale the objective multiplier based on the problem's objective sign
   int error = 0;
-  double* ex = NULL;  // it will be assigned to xx if evalWithinBnds_ is true,
-                      // otherwise to x.
-  double* xx = NULL;
+  const double* ex = NULL;
   size_t nnz_h_lag = p_->getNumHessNnzs();
   static std::vector<Minotaur::UInt> iRow(nnz_h_lag), jCol(nnz_h_lag);
   p_->getHessian()->fillRowColIndices(jCol.data(), iRow.data());
@@ -727,12 +710,8 @@ void UnoModel::evaluate_lagrangian_hessian(
   //} else
   if (!x.empty())  // && hessian != nullptr)
   {
-    if (evalWithinBnds_) {
-      xx = pullXToBnds_(x, x.size());
-      ex = xx;
-    } else {
-      ex = const_cast<double*>(x.data());
-    }
+    // values of x are pulled within bounds if evalWithinBnds_ is true.
+    ex = p_->getEvalPoint(x.data(), true, evalWithinBnds_);
 
     // Create a vector to hold Hessian values
     static std::vector<double> values(nnz_h_lag);
@@ -791,10 +770,6 @@ void UnoModel::evaluate_lagrangian_hessian(
     // }
     // std::cout << hessian.capacity << "capacity \n";
     // hessian.print(std::cout);
-    //  Free memory if `pullXToBnds_` created a new array
-    if (evalWithinBnds_ && ex != x.data()) {
-      delete[] ex;
-    }
     // //std::cout << "error = " << error << std::endl;
     // for (int i=0; i<problem_->getNumVars(); ++i) {
     //   //std::cout << std::setprecision(8) << "x["<<i<<"] = "<<x[i] <<
@@ -804,9 +779,6 @@ void UnoModel::evaluate_lagrangian_hessian(
     //   //std::cout << std::setprecision(8) << "h["<<i<<"] = "<<values[i]
     //   << std::endl;
     // }
-    if (xx) {
-      delete[] xx;
-    }
   } else {
     // assert(!"one of x, lambda and values is NULL!");
   }
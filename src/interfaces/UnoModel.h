@@ -131,7 +131,6 @@ private:
                                      const Vector<double>& multipliers,
                                      size_t row, size_t col,
                                      double objective_multiplier) const;
-  double* pullXToBnds_(const Vector<double>& x, size_t n) const;
   bool evalWithinBnds_ = false;
 };
 
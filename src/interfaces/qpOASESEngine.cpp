@@ -36,6 +36,7 @@
 #include "Problem.h"
 #include "ProblemSize.h"
 #include "Solution.h"
+#include "Telemetry.h"
 #include "Timer.h"
 #include "Variable.h"
 
@@ -473,6 +474,7 @@ void qpOASESEngine::solve_ (int mode, double *f)
   stats_.calls += 1;
   stats_.time  += cputime;
   stats_.iters += nWSR;
+  Telemetry::addIters(true, nWSR);
 
   *f = data_->qp->getObjVal ();
 
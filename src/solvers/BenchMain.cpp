@@ -0,0 +1,659 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file BenchMain.cpp
+ * \brief The main function of mntr-bench, which runs a solver on a list of
+ * instances and records its performance.
+ * \author Ashutosh Mahajan, IIT Bombay
+ *
+ * Each instance is solved in a separate child process, so that a crash or
+ * a hang does not stop the benchmark, and the peak memory of every run can
+ * be measured. The output of the solver is written to a log file, which is
+ * then parsed for the solution value, status and statistics. The results are
+ * written as a CSV file. In compare mode, two such files are read and runs
+ * that have become slower, or that fail to verify, are reported.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "MinotaurConfig.h"
+#include "Bnb.h"
+#include "BnbPar.h"
+#include "Environment.h"
+#include "Glob.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QG.h"
+#include "Types.h"
+
+using namespace Minotaur;
+
+namespace {
+  /// Result of solving one instance.
+  struct BenchRec {
+    std::string name;    /// Name of the instance.
+    std::string solver;  /// Name of the solver.
+    std::string status;  /// Status reported by the solver.
+    std::string check;   /// Result of verification against .solu file.
+    double obj;          /// Best solution value found.
+    double ref;          /// Reference value from the .solu file.
+    double wall;         /// Wall clock time in seconds.
+    double cpu;          /// CPU time (user + system) in seconds.
+    long nodes;          /// Nodes processed.
+    double nodesPerSec;  /// Nodes processed per second of wall time.
+    long lpCalls;        /// Calls to LP engines.
+    long nlpCalls;       /// Calls to NLP and QP engines.
+    long peakRss;        /// Peak resident memory in KB.
+    int exitCode;        /// Exit code, or negative signal number.
+  };
+
+  /// Options of the benchmark itself.
+  struct BenchOpts {
+    std::string solver;
+    std::string list;
+    std::string dir;
+    std::string solu;
+    std::string out;
+    std::string logDir;
+    double timeLimit;
+    double tol;
+    std::vector<std::string> fwd;  /// Options passed on to the solver.
+  };
+
+  /// Reference value of one instance in a .solu file.
+  struct SoluRef {
+    std::string type;  /// opt, best, bestdual, inf or unkn.
+    double val;
+  };
+
+  typedef std::map<std::string, SoluRef> SoluMap;
+  typedef std::map<std::string, BenchRec> RecMap;
+
+  const char *csvHeader = "instance,solver,status,check,obj,ref,wall,cpu,"
+                          "nodes,nodes_per_sec,lp_calls,nlp_calls,"
+                          "peak_rss_kb,exit";
+
+  void showHelp()
+  {
+    std::cout
+        << "Usage:" << std::endl
+        << "  mntr-bench [-s solver] [-l list] [-d dir] [-u solu] [-t sec]"
+        << std::endl
+        << "             [-o out.csv] [-g logdir] [-- solver options]"
+        << std::endl
+        << "  mntr-bench -c base.csv new.csv [-r tol]" << std::endl
+        << std::endl
+        << "  -s  solver to run: bnb, qg, glob or bnbpar (default bnb)"
+        << std::endl
+        << "  -l  file with one instance name in the first column of each"
+        << " line" << std::endl
+        << "  -d  directory with the instances (.nl or .mps)" << std::endl
+        << "  -u  .solu file with reference values" << std::endl
+        << "  -t  time limit for each instance in seconds (default 60)"
+        << std::endl
+        << "  -o  file where results are written (default bench.csv)"
+        << std::endl
+        << "  -g  directory where the log of each run is kept" << std::endl
+        << "  -c  compare two result files and flag regressions"
+        << std::endl
+        << "  -r  relative slow down flagged as regression (default 0.1)"
+        << std::endl
+        << "Options after -- are passed on to the solver." << std::endl;
+  }
+
+
+  /// Time since epoch in seconds.
+  double wallTime()
+  {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1e-6 * (double)tv.tv_usec;
+  }
+
+
+  /// Read the first word of each line of a list of instances.
+  int readList(const std::string &fname, std::vector<std::string> &names)
+  {
+    std::ifstream in(fname.c_str());
+    std::string line, name;
+
+    if (!in.is_open()) {
+      std::cerr << "mntr-bench: cannot open list " << fname << std::endl;
+      return 1;
+    }
+    while (std::getline(in, line)) {
+      std::istringstream iss(line);
+      if ((iss >> name) && name[0] != '#') {
+        names.push_back(name);
+      }
+    }
+    return 0;
+  }
+
+
+  /// Read a .solu file with lines like "=opt=  name  value".
+  int readSolu(const std::string &fname, SoluMap &solu)
+  {
+    std::ifstream in(fname.c_str());
+    std::string line, tag, name;
+    SoluRef r;
+
+    if (!in.is_open()) {
+      std::cerr << "mntr-bench: cannot open " << fname << std::endl;
+      return 1;
+    }
+    while (std::getline(in, line)) {
+      std::istringstream iss(line);
+      if (!(iss >> tag >> name) || tag.size() < 3 || tag[0] != '=') {
+        continue;
+      }
+      r.type = tag.substr(1, tag.size() - 2);
+      r.val = INFINITY;
+      iss >> r.val;
+      if ("bestdual" == r.type && solu.find(name) != solu.end()) {
+        // do not overwrite the primal value.
+        continue;
+      }
+      solu[name] = r;
+    }
+    return 0;
+  }
+
+
+  /// Return the path of the instance, trying .nl and .mps extensions.
+  std::string findInstance(const std::string &dir, const std::string &name)
+  {
+    const char *exts[] = {"", ".nl", ".mps"};
+    struct stat st;
+    std::string path;
+
+    for (int i = 0; i < 3; ++i) {
+      path = dir.empty() ? name + exts[i] : dir + "/" + name + exts[i];
+      if (0 == stat(path.c_str(), &st) && S_ISREG(st.st_mode)) {
+        return path;
+      }
+    }
+    return "";
+  }
+
+
+  /// Solve one instance with solver T. Called in the child process.
+  template <class T>
+  int runSolver(std::vector<std::string> &args, const char *sname)
+  {
+    EnvPtr env = (EnvPtr) new Environment();
+    std::vector<char *> argv;
+    std::string dname, fname;
+    ProblemPtr p = 0;
+    int err = 0;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+      argv.push_back(&(args[i][0]));
+    }
+    argv.push_back(0);
+    {
+      T s(env);
+      s.doSetup();
+      env->readOptions((int)args.size(), &(argv[0]));
+      dname = env->getOptions()->findString("debug_sol")->getValue();
+      fname = env->getOptions()->findString("problem_file")->getValue();
+      p = s.readProblem(fname, dname, sname, err);
+      if (0 == err) {
+        err = s.solve(p);
+      }
+      if (p) {
+        delete p;
+      }
+    }
+    delete env;
+    return err;
+  }
+
+
+  int runChild(const BenchOpts &opts, const std::string &path)
+  {
+    std::vector<std::string> args;
+    std::ostringstream tl;
+
+    tl << opts.timeLimit;
+    args.push_back("mntr-bench");
+    // raise the log level so that statistics are printed. The user may
+    // override it, but then nodes and engine calls are not recorded.
+    args.push_back("--log_level");
+    args.push_back("4");
+    args.insert(args.end(), opts.fwd.begin(), opts.fwd.end());
+    args.push_back("--time_limit");
+    args.push_back(tl.str());
+    args.push_back(path);
+
+    if ("qg" == opts.solver) {
+      return runSolver<QG>(args, "mqg");
+    } else if ("glob" == opts.solver) {
+      return runSolver<Glob>(args, "mglob");
+    } else if ("bnbpar" == opts.solver) {
+      return runSolver<BnbPar>(args, "bnbpar");
+    }
+    return runSolver<Bnb>(args, "mbnb");
+  }
+
+
+  /// Return the value after '=' or ':' that follows key in line.
+  bool valueAfter(const std::string &line, const std::string &key,
+                  std::string &val)
+  {
+    size_t pos = line.find(key);
+
+    if (std::string::npos == pos) {
+      return false;
+    }
+    pos += key.size();
+    while (pos < line.size() &&
+           (' ' == line[pos] || '=' == line[pos] || ':' == line[pos])) {
+      ++pos;
+    }
+    val = line.substr(pos);
+    while (!val.empty() && isspace(val[val.size() - 1])) {
+      val.erase(val.size() - 1);
+    }
+    return !val.empty();
+  }
+
+
+  /// Extract solution value, status, nodes and engine calls from a log.
+  void parseLog(const std::string &fname, BenchRec &rec)
+  {
+    std::ifstream in(fname.c_str());
+    std::string line, val;
+    size_t pos;
+
+    while (std::getline(in, line)) {
+      if (valueAfter(line, "best solution value", val)) {
+        rec.obj = atof(val.c_str());
+        if (val.find("inf") != std::string::npos) {
+          rec.obj = ('-' == val[0]) ? -INFINITY : INFINITY;
+        }
+      } else if (valueAfter(line, "status of branch-and-bound", val)) {
+        rec.status = val;
+      } else if (valueAfter(line, ": nodes processed", val)) {
+        rec.nodes = atol(val.c_str());
+      } else if (valueAfter(line, "total calls", val)) {
+        pos = line.find(':');
+        if (std::string::npos == pos) {
+          continue;
+        }
+        // engines print their short name before the colon.
+        if (line.substr(0, pos).find("LP") != std::string::npos) {
+          rec.lpCalls += atol(val.c_str());
+        } else {
+          rec.nlpCalls += atol(val.c_str());
+        }
+      }
+    }
+  }
+
+
+  /// Compare the solution value of a run with the reference value.
+  void verify(const SoluMap &solu, double tol, BenchRec &rec)
+  {
+    SoluMap::const_iterator it = solu.find(rec.name);
+    bool found = std::isfinite(rec.obj);
+    bool match;
+
+    if (it == solu.end()) {
+      rec.check = "nosolu";
+      return;
+    }
+    rec.ref = it->second.val;
+    match = found &&
+            fabs(rec.obj - rec.ref) <= tol * std::max(1.0, fabs(rec.ref));
+    if ("inf" == it->second.type) {
+      rec.check = found ? "wrong" : "ok";
+    } else if (match) {
+      rec.check = "ok";
+    } else if ("opt" == it->second.type &&
+               rec.status.find("Optimal") != std::string::npos) {
+      // claimed optimality but disagrees with the known optimum.
+      rec.check = "wrong";
+    } else if (!found) {
+      rec.check = "nosol";
+    } else {
+      rec.check = "diff";
+    }
+  }
+
+
+  /// Run one instance in a child process and fill rec.
+  void runOne(const BenchOpts &opts, const std::string &path, BenchRec &rec)
+  {
+    std::string logname;
+    char tmpname[] = "/tmp/mntr-bench-XXXXXX";
+    struct rusage ru;
+    double t0, hard_limit;
+    int fd, status = 0;
+    pid_t pid, w;
+
+    if (opts.logDir.empty()) {
+      fd = mkstemp(tmpname);
+      logname = tmpname;
+    } else {
+      logname = opts.logDir + "/" + rec.name + ".log";
+      fd = open(logname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd < 0) {
+      rec.status = "NoLog";
+      return;
+    }
+
+    std::cout.flush();
+    t0 = wallTime();
+    pid = fork();
+    if (0 == pid) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+      status = runChild(opts, path);
+      std::cout.flush();
+      _exit(status);
+    }
+    close(fd);
+    if (pid < 0) {
+      rec.status = "ForkFailed";
+      return;
+    }
+
+    // kill runs that do not respect the time limit.
+    hard_limit = 2.0 * opts.timeLimit + 60.0;
+    memset(&ru, 0, sizeof(ru));
+    for (;;) {
+      w = wait4(pid, &status, WNOHANG, &ru);
+      if (w == pid || w < 0) {
+        break;
+      }
+      if (wallTime() - t0 > hard_limit) {
+        kill(pid, SIGKILL);
+        w = wait4(pid, &status, 0, &ru);
+        rec.status = "Killed";
+        break;
+      }
+      usleep(10000);
+    }
+    rec.wall = wallTime() - t0;
+    rec.cpu = (double)ru.ru_utime.tv_sec + 1e-6 * ru.ru_utime.tv_usec +
+              (double)ru.ru_stime.tv_sec + 1e-6 * ru.ru_stime.tv_usec;
+    rec.peakRss = ru.ru_maxrss;
+    if (WIFEXITED(status)) {
+      rec.exitCode = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+      rec.exitCode = -WTERMSIG(status);
+    }
+
+    parseLog(logname, rec);
+    if (rec.status.empty()) {
+      rec.status = (rec.exitCode < 0) ? "Crashed" : "Unknown";
+    }
+    rec.nodesPerSec = (rec.wall > 0) ? rec.nodes / rec.wall : 0.0;
+    if (opts.logDir.empty()) {
+      unlink(logname.c_str());
+    }
+  }
+
+
+  void writeRec(std::ostream &out, const BenchRec &r)
+  {
+    out << r.name << "," << r.solver << "," << r.status << "," << r.check
+        << "," << std::setprecision(10) << r.obj << "," << r.ref << ","
+        << std::fixed << std::setprecision(3) << r.wall << "," << r.cpu
+        << "," << r.nodes << "," << std::setprecision(1) << r.nodesPerSec
+        << "," << r.lpCalls << "," << r.nlpCalls << "," << r.peakRss << ","
+        << r.exitCode << std::endl;
+    out.unsetf(std::ios_base::floatfield);
+  }
+
+
+  int runBench(const BenchOpts &opts)
+  {
+    std::vector<std::string> names;
+    SoluMap solu;
+    std::ofstream out;
+    std::string path;
+    BenchRec rec;
+    UInt n_ok = 0, n_wrong = 0;
+
+    if (opts.list.empty() || readList(opts.list, names)) {
+      showHelp();
+      return 1;
+    }
+    if (!opts.solu.empty() && readSolu(opts.solu, solu)) {
+      return 1;
+    }
+    out.open(opts.out.c_str());
+    if (!out.is_open()) {
+      std::cerr << "mntr-bench: cannot write " << opts.out << std::endl;
+      return 1;
+    }
+    out << csvHeader << std::endl;
+
+    for (size_t i = 0; i < names.size(); ++i) {
+      rec = BenchRec();
+      rec.name = names[i];
+      rec.solver = opts.solver;
+      rec.obj = INFINITY;
+      rec.ref = INFINITY;
+      path = findInstance(opts.dir, names[i]);
+      if (path.empty()) {
+        rec.status = "NoFile";
+        rec.check = "nosol";
+      } else {
+        runOne(opts, path, rec);
+        verify(solu, opts.tol, rec);
+      }
+      if ("ok" == rec.check) {
+        ++n_ok;
+      } else if ("wrong" == rec.check) {
+        ++n_wrong;
+      }
+      // write each row at once so that partial results are kept.
+      writeRec(out, rec);
+      std::cout << std::left << std::setw(32) << rec.name << std::right
+                << std::setw(16) << rec.status << std::setw(8) << rec.check
+                << std::fixed << std::setprecision(2) << std::setw(10)
+                << rec.wall << std::setw(12) << rec.nodes << std::endl;
+    }
+    out.close();
+    std::cout << "mntr-bench: instances = " << names.size()
+              << ", verified = " << n_ok << ", wrong = " << n_wrong
+              << std::endl;
+    return (n_wrong > 0) ? 1 : 0;
+  }
+
+
+  /// Split one line of a CSV file without quoted fields.
+  void splitCsv(const std::string &line, std::vector<std::string> &fields)
+  {
+    std::istringstream iss(line);
+    std::string f;
+
+    fields.clear();
+    while (std::getline(iss, f, ',')) {
+      fields.push_back(f);
+    }
+  }
+
+
+  int readRecs(const std::string &fname, RecMap &recs)
+  {
+    std::ifstream in(fname.c_str());
+    std::vector<std::string> f;
+    std::string line;
+    BenchRec r;
+
+    if (!in.is_open() || !std::getline(in, line)) {
+      std::cerr << "mntr-bench: cannot read " << fname << std::endl;
+      return 1;
+    }
+    while (std::getline(in, line)) {
+      splitCsv(line, f);
+      if (f.size() < 14) {
+        continue;
+      }
+      r.name = f[0];
+      r.solver = f[1];
+      r.status = f[2];
+      r.check = f[3];
+      r.obj = atof(f[4].c_str());
+      r.ref = atof(f[5].c_str());
+      r.wall = atof(f[6].c_str());
+      r.cpu = atof(f[7].c_str());
+      r.nodes = atol(f[8].c_str());
+      r.nodesPerSec = atof(f[9].c_str());
+      r.lpCalls = atol(f[10].c_str());
+      r.nlpCalls = atol(f[11].c_str());
+      r.peakRss = atol(f[12].c_str());
+      r.exitCode = atoi(f[13].c_str());
+      recs[r.name] = r;
+    }
+    return 0;
+  }
+
+
+  /**
+   * Compare two result files. A run regresses if it no longer verifies, or
+   * if it is slower by more than the factor 1+tol and by more than one
+   * second. Returns 1 if some run regressed.
+   */
+  int compare(const std::string &base, const std::string &cur, double tol)
+  {
+    RecMap b_recs, c_recs;
+    RecMap::iterator bit, cit;
+    double lsum = 0.0, ratio;
+    UInt n = 0, n_reg = 0;
+    std::string flag;
+
+    if (readRecs(base, b_recs) || readRecs(cur, c_recs)) {
+      return 1;
+    }
+    std::cout << std::left << std::setw(32) << "instance" << std::right
+              << std::setw(10) << "base" << std::setw(10) << "new"
+              << std::setw(12) << "base nodes" << std::setw(12)
+              << "new nodes" << "  flag" << std::endl;
+    for (cit = c_recs.begin(); cit != c_recs.end(); ++cit) {
+      bit = b_recs.find(cit->first);
+      if (bit == b_recs.end()) {
+        continue;
+      }
+      const BenchRec &b = bit->second;
+      const BenchRec &c = cit->second;
+      flag = "";
+      if ("ok" == b.check && "ok" != c.check) {
+        flag = "FAIL";
+      } else if ("wrong" == c.check) {
+        flag = "WRONG";
+      } else if (c.wall > (1.0 + tol) * b.wall && c.wall - b.wall > 1.0) {
+        flag = "SLOWER";
+      } else if (b.wall > (1.0 + tol) * c.wall && b.wall - c.wall > 1.0) {
+        flag = "faster";
+      }
+      if ("" != flag && "faster" != flag) {
+        ++n_reg;
+      }
+      // shifted geometric mean with a shift of one second.
+      ratio = (c.wall + 1.0) / (b.wall + 1.0);
+      lsum += log(ratio);
+      ++n;
+      std::cout << std::left << std::setw(32) << c.name << std::right
+                << std::fixed << std::setprecision(2) << std::setw(10)
+                << b.wall << std::setw(10) << c.wall << std::setw(12)
+                << b.nodes << std::setw(12) << c.nodes << "  " << flag
+                << std::endl;
+    }
+    std::cout << "mntr-bench: common instances = " << n
+              << ", regressions = " << n_reg << std::endl;
+    if (n > 0) {
+      std::cout << "mntr-bench: shifted geometric mean of time ratio = "
+                << std::setprecision(4) << exp(lsum / n) << std::endl;
+    }
+    return (n_reg > 0) ? 1 : 0;
+  }
+}
+
+
+int main(int argc, char** argv)
+{
+  BenchOpts opts;
+  std::string base, cur, arg;
+  bool cmp = false;
+  double reg_tol = 0.1;
+
+  opts.solver = "bnb";
+  opts.out = "bench.csv";
+  opts.timeLimit = 60.0;
+  opts.tol = 1e-5;
+
+  for (int i = 1; i < argc; ++i) {
+    arg = argv[i];
+    if ("--" == arg) {
+      opts.fwd.assign(argv + i + 1, argv + argc);
+      break;
+    } else if ("-h" == arg || "--help" == arg) {
+      showHelp();
+      return 0;
+    } else if ("-c" == arg && i + 2 < argc) {
+      cmp = true;
+      base = argv[++i];
+      cur = argv[++i];
+    } else if (i + 1 >= argc) {
+      showHelp();
+      return 1;
+    } else if ("-s" == arg) {
+      opts.solver = argv[++i];
+    } else if ("-l" == arg) {
+      opts.list = argv[++i];
+    } else if ("-d" == arg) {
+      opts.dir = argv[++i];
+    } else if ("-u" == arg) {
+      opts.solu = argv[++i];
+    } else if ("-t" == arg) {
+      opts.timeLimit = atof(argv[++i]);
+    } else if ("-o" == arg) {
+      opts.out = argv[++i];
+    } else if ("-g" == arg) {
+      opts.logDir = argv[++i];
+    } else if ("-r" == arg) {
+      reg_tol = atof(argv[++i]);
+    } else {
+      showHelp();
+      return 1;
+    }
+  }
+
+  if (cmp) {
+    return compare(base, cur, reg_tol);
+  }
+  if ("bnb" != opts.solver && "qg" != opts.solver &&
+      "glob" != opts.solver && "bnbpar" != opts.solver) {
+    std::cerr << "mntr-bench: unknown solver " << opts.solver << std::endl;
+    return 1;
+  }
+  return runBench(opts);
+}
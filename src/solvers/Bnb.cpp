@@ -11,6 +11,7 @@
  * \author Ashutosh Mahajan, IIT Bombay
  */
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -20,12 +21,14 @@
 #include "SppHeur.h"
 
 #include "EngineFactory.h"
+#include "EnginePool.h"
 #include "NlWriter.h"
 #include "Reader.h"
 
 #include "Bnb.h"
 #include "BndProcessor.h"
 #include "BranchAndBound.h"
+#include "ConflictPool.h"
 #include "LexicoBrancher.h"
 #include "LinFeasPump.h"
 #include "MINLPDiving.h"
@@ -35,11 +38,14 @@
 #include "NodeIncRelaxer.h"
 #include "PCBProcessor.h"
 #include "Presolver.h"
+#include "Prober.h"
 #include "RandomBrancher.h"
 #include "ReliabilityBrancher.h"
 #include "TreeManager.h"
 
 #include "FixVarsHeur.h"
+#include "ImplGraph.h"
+#include "ImplHandler.h"
 #include "IntVarHandler.h"
 #include "LinearHandler.h"
 #include "NlPresHandler.h"
@@ -56,7 +62,9 @@ using namespace Minotaur;
 const std::string Bnb::me_ = "mbnb: ";
 
 Bnb::Bnb(EnvPtr env)
-  : objSense_(1.0),
+  : epool_(0),
+    graph_(0),
+    objSense_(1.0),
     status_(NotStarted)
 {
   env_ = env;
@@ -78,6 +86,7 @@ BranchAndBound* Bnb::getBab_(Engine* engine, HandlerVector& handlers)
   OptionDBPtr options = env_->getOptions();
   SOS2HandlerPtr s2_hand;
   RCHandlerPtr rc_hand;
+  ImplHandlerPtr i_hand;
   SppHeur* sp = 0;
 
   SOS1HandlerPtr s_hand = (SOS1HandlerPtr) new SOS1Handler(env_, oinst_);
@@ -96,6 +105,13 @@ BranchAndBound* Bnb::getBab_(Engine* engine, HandlerVector& handlers)
     assert(rc_hand);
   }
 
+  // propagate what probing found.
+  if(graph_ && (graph_->getNumImpls() > 0 || graph_->getNumCliques() > 0)) {
+    i_hand = (ImplHandlerPtr) new ImplHandler(env_, graph_);
+    i_hand->setModFlags(false, true);
+    handlers.push_back(i_hand);
+  }
+
   // add SOS2 handler here.
   s2_hand = (SOS2HandlerPtr) new SOS2Handler(env_, oinst_);
   if(s2_hand->isNeeded()) {
@@ -127,6 +143,9 @@ BranchAndBound* Bnb::getBab_(Engine* engine, HandlerVector& handlers)
   }
   br = getBrancher_(handlers, engine);
   nproc->setBrancher(br);
+  if(options->findBool("conflicts")->getValue()) {
+    nproc->setConflictPool(new ConflictPool(env_));
+  }
   bab->setNodeProcessor(nproc);
 
   nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
@@ -156,6 +175,12 @@ BranchAndBound* Bnb::getBab_(Engine* engine, HandlerVector& handlers)
       oinst_->setNativeDer();
     }
     div_heur = (MINLPDivingPtr) new MINLPDiving(env_, oinst_, e2);
+    if(true == options->findBool("engine_pool")->getValue()) {
+      if(!epool_) {
+        epool_ = new EnginePool(env_);
+      }
+      div_heur->setEnginePool(epool_);
+    }
     bab->addPreRootHeur(div_heur);
   }
 
@@ -182,6 +207,13 @@ BranchAndBound* Bnb::getBab_(Engine* engine, HandlerVector& handlers)
     EnginePtr nlpe = engine->emptyCopy();
     LinFeasPumpPtr lin_feas_pump =
         (LinFeasPumpPtr) new LinFeasPump(env_, oinst_, nlpe, lpe);
+    // share the pool with diving, which leaves oinst_ loaded.
+    if(true == options->findBool("engine_pool")->getValue()) {
+      if(!epool_) {
+        epool_ = new EnginePool(env_);
+      }
+      lin_feas_pump->setEnginePool(epool_);
+    }
     bab->addPreRootHeur(lin_feas_pump);
   }
   return bab;
@@ -455,6 +487,10 @@ int Bnb::solve(ProblemPtr p)
   PresolverPtr pres = 0;
   VarVector* orig_v = 0;
   HandlerVector handlers;
+  Decomposer* dec = 0;
+  Prober* prober = 0;
+  ProblemPtr snap = 0;   // presolved problem loaded from a file
+  UInt ncons;
   int err = 0;
   OptionDBPtr options = env_->getOptions();
 
@@ -524,7 +560,14 @@ int Bnb::solve(ProblemPtr p)
   // First store all original variables in a vector, then presolve.
   // Keep a pointer to presolver for postsolving after the main solve.
   orig_v = new VarVector(oinst_->varsBegin(), oinst_->varsEnd());
-  pres = presolve_(handlers);
+  pres = loadPresolved_(oinst_, snap);
+  if(pres) {
+    oinst_ = snap;
+  } else {
+    ncons = oinst_->getNumCons();
+    pres = presolve_(handlers);
+    savePresolved_(oinst_, orig_v->size(), ncons, pres);
+  }
   for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
       ++it) {
     delete(*it);
@@ -549,6 +592,20 @@ int Bnb::solve(ProblemPtr p)
     return 0;
   }
 
+  if(options->findBool("probe")->getValue() == true) {
+    prober = new Prober(env_, oinst_);
+    if(SolvedInfeasible == prober->solve()) {
+      status_ = SolvedInfeasible;
+      env_->getLogger()->msgStream(LogInfo)
+          << me_ << "status of probing: "
+          << getSolveStatusString(status_) << std::endl;
+      writeSol_(env_, orig_v, pres, 0, status_, iface_);
+      goto CLEANUP;
+    }
+    prober->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+    graph_ = prober->getGraph();
+  }
+
   if (options->findBool("solve")->getValue() == false) {
     env_->getLogger()->msgStream(LogInfo)
         << me_ << "Solve option is set to 0, Stopping further processing."
@@ -556,6 +613,25 @@ int Bnb::solve(ProblemPtr p)
     goto CLEANUP; // Return early to stop processing.
   } 
 
+  // Solve independent components separately. Nonlinear functions can be
+  // copied into components only if they are stored in native cgraph.
+  if(options->findBool("decompose")->getValue() == true &&
+     (options->findBool("use_native_cgraph")->getValue() == true ||
+      oinst_->isQuadratic() || oinst_->isLinear())) {
+    dec = new Decomposer(env_, oinst_);
+    if(dec->findComponents() > 1) {
+      status_ = dec->solve([](EnvPtr cenv, ProblemPtr cp, SolutionPtr& sol,
+                              double& lb) {
+        Bnb sub(cenv);
+        return sub.solveComponent(cp, sol, lb);
+      });
+      dec->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+      writeSol_(env_, orig_v, pres, dec->getSolution(), status_, iface_);
+      writeDecStatus_(dec, status_);
+      goto CLEANUP;
+    }
+  }
+
   err = getEngine_(&engine);
   if(err) {
     goto CLEANUP;
@@ -566,6 +642,9 @@ int Bnb::solve(ProblemPtr p)
   bab->solve();
   bab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
   engine->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  if(epool_) {
+    epool_->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  }
   for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
       ++it) {
     (*it)->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
@@ -588,6 +667,16 @@ CLEANUP:
   if(orig_v) {
     delete orig_v;
   }
+  if(dec) {
+    delete dec;
+  }
+  if(prober) {
+    graph_ = 0;
+    delete prober;
+  }
+  if(snap) {
+    delete snap;
+  }
   if(bab) {
     if(bab->getNodeRelaxer()) {
       delete bab->getNodeRelaxer();
@@ -597,10 +686,86 @@ CLEANUP:
     }
     delete bab;
   }
+  if(epool_) {
+    delete epool_;
+    epool_ = 0;
+  }
   oinst_ = 0;
   return 0;
 }
 
+SolveStatus Bnb::solveComponent(ProblemPtr p, SolutionPtr& sol, double& lb)
+{
+  BranchAndBound* bab = 0;
+  EnginePtr engine = 0;
+  HandlerVector handlers;
+  SolveStatus status = SolveError;
+
+  oinst_ = p;
+  sol = 0;
+  lb = -INFINITY;
+  oinst_->calculateSize();
+  if(0 != getEngine_(&engine)) {
+    oinst_ = 0;
+    return status;
+  }
+
+  if(0 == oinst_->getSize()->ints + oinst_->getSize()->bins) {
+    // relaxation is the problem itself, no tree is needed.
+    status = Decomposer::solveContinuous(engine, oinst_, sol, lb);
+  } else {
+    bab = getBab_(engine, handlers);
+    bab->solve();
+    status = bab->getStatus();
+    lb = bab->getLb();
+    if(bab->getSolution()) {
+      sol = new Solution(bab->getSolution());
+    }
+    bab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  }
+
+  for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
+      ++it) {
+    delete(*it);
+  }
+  delete engine;
+  if(bab) {
+    if(bab->getNodeRelaxer()) {
+      delete bab->getNodeRelaxer();
+    }
+    if(bab->getNodeProcessor()) {
+      delete bab->getNodeProcessor();
+    }
+    delete bab;
+  }
+  if(epool_) {
+    delete epool_;
+    epool_ = 0;
+  }
+  oinst_ = 0;
+  return status;
+}
+
+void Bnb::writeDecStatus_(Decomposer* dec, SolveStatus status)
+{
+  double ub = dec->getSolution() ? dec->getSolution()->getObjValue()
+                                 : INFINITY;
+
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << std::fixed << std::setprecision(4)
+      << "best solution value = " << objSense_ * ub << std::endl
+      << me_ << std::fixed << std::setprecision(4)
+      << "best bound estimate from remaining nodes = "
+      << objSense_ * dec->getLb() << std::endl
+      << me_ << "gap = " << std::max(0.0, ub - dec->getLb()) << std::endl
+      << me_ << "cpu time used (s) = " << std::fixed << std::setprecision(2)
+      << env_->getTime() << std::endl
+      << me_ << "wall time used (s) = " << std::fixed << std::setprecision(2)
+      << env_->getWTime() << std::endl
+      << me_ << "status of branch-and-bound = "
+      << getSolveStatusString(status) << std::endl;
+}
+
 void Bnb::writeBnbStatus_(BranchAndBound* bab)
 {
   if(bab) {
@@ -17,11 +17,15 @@
 #include "AMPLInterface.h"
 #include "BranchAndBound.h"
 #include "Brancher.h"
+#include "Decomposer.h"
 #include "Presolver.h"
 #include "Problem.h"
 #include "Solver.h"
 
 namespace Minotaur {
+class EnginePool;
+class ImplGraph;
+
 /**
  * The Bnb class sets up methods for solving a convex MINLP instance using
  * the NLP based Branch-and-Bound
@@ -59,8 +63,24 @@ public:
   /// Return the lower bound for the optimal value
   double getLb();
 
+  /**
+   * Solve a component found by the Decomposer. Components without integer
+   * variables are solved by one call to the engine, others by
+   * branch-and-bound. The solution and bound are returned in sol and lb.
+   */
+  SolveStatus solveComponent(ProblemPtr p, SolutionPtr &sol, double &lb);
+
 private:
   const static std::string me_;
+
+  /// Engines of heuristics that are loaded with oinst_, if option
+  /// engine_pool is on.
+  EnginePool *epool_;
+
+  /// Implications and cliques found by probing oinst_, or NULL. Owned by
+  /// the Prober.
+  ImplGraph *graph_;
+
   double objSense_;
   ProblemPtr oinst_;
   SolveStatus status_;
@@ -70,6 +90,7 @@ private:
   int getEngine_(Engine **e);
   PresolverPtr presolve_(HandlerVector &handlers);
   void writeBnbStatus_(BranchAndBound *bab);
+  void writeDecStatus_(Decomposer *dec, SolveStatus status);
   void setInitialOptions_();
 };
 }
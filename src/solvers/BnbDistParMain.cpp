@@ -23,8 +23,9 @@ using namespace Minotaur;
 
 int main(int argc, char** argv)
 {
-  MPI_Init(&argc, &argv);
-  int nprocs, proc_rank;
+  int nprocs, proc_rank, provided;
+  // incumbents and bounds are exchanged by a separate thread if allowed.
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
   MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank);
 
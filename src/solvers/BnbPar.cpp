@@ -337,7 +337,14 @@ ParBranchAndBound* BnbPar::createParBab_(UInt numThreads, EnginePtr e,
   if (env_->getOptions()->findBool("prerootheur")->getValue() == true) {
     if (env_->getOptions()->findBool("samplingheur")->getValue() == true) {
       SamplingHeurPtr s_heur = (SamplingHeurPtr) new SamplingHeur(env_, oinst_);
-      bab->addPreRootHeur(s_heur);
+      // it only evaluates functions of oinst_. The root works on copies of
+      // them unless they are evaluated through the ampl interface.
+      if (numThreads > 1 &&
+         env_->getOptions()->findBool("use_native_cgraph")->getValue()) {
+        bab->addConcHeur(s_heur);
+      } else {
+        bab->addPreRootHeur(s_heur);
+      }
     }
 
     if (env_->getOptions()->findBool("fixvarsheur")->getValue() == true) {
@@ -19,6 +19,7 @@
 #include "AMPLInterface.h"
 #include "Bnb.h"
 #include "BranchAndBound.h"
+#include "Decomposer.h"
 #include "Engine.h"
 #include "EngineFactory.h"
 #include "Environment.h"
@@ -51,6 +52,7 @@
 #include "Solver.h"
 #include "Transformer.h"
 #include "TreeManager.h"
+#include "Variable.h"
 #include "WeakBrancher.h"
 
 using namespace Minotaur;
@@ -332,6 +334,9 @@ int Glob::solve(ProblemPtr inst)
   int err = 0;
   ProblemPtr newp = 0;
   BranchAndBound* bab = 0;
+  Decomposer* dec = 0;
+  ProblemPtr snap = 0;   // presolved problem loaded from a file
+  UInt ncons;
   OptionDBPtr options = env_->getOptions();
 
   env_->initRand();
@@ -382,9 +387,16 @@ int Glob::solve(ProblemPtr inst)
   // get presolver.
   handlers.clear();
   orig_v = new VarVector(inst_->varsBegin(), inst_->varsEnd());
-  pres = createPres_(handlers);
-  if(env_->getOptions()->findBool("presolve")->getValue() == true) {
-    pres->solve();
+  pres = loadPresolved_(inst_, snap);
+  if(pres) {
+    inst_ = snap;
+  } else {
+    ncons = inst_->getNumCons();
+    pres = createPres_(handlers);
+    if(env_->getOptions()->findBool("presolve")->getValue() == true) {
+      pres->solve();
+    }
+    savePresolved_(inst_, orig_v->size(), ncons, pres);
   }
   for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
       ++it) {
@@ -402,6 +414,25 @@ int Glob::solve(ProblemPtr inst)
     goto CLEANUP;
   }
 
+  // Solve independent components separately. Each one is reformulated and
+  // presolved again on its own.
+  if(options->findBool("decompose")->getValue() == true &&
+     (options->findBool("use_native_cgraph")->getValue() == true ||
+      inst_->isQuadratic() || inst_->isLinear())) {
+    dec = new Decomposer(env_, inst_);
+    if(dec->findComponents() > 1) {
+      status_ = dec->solve([](EnvPtr cenv, ProblemPtr cp, SolutionPtr& sol,
+                              double& lb) {
+        Glob sub(cenv);
+        return sub.solveComponent(cp, sol, lb);
+      });
+      dec->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+      writeSol_(env_, orig_v, pres, dec->getSolution(), status_, iface_);
+      writeDecStatus_(dec);
+      goto CLEANUP;
+    }
+  }
+
   inst_->setNativeDer();
   err = transform_(newp, handlers, engine);
   assert(0 == err || 2 == err); // return status 2 means problem is convex
@@ -489,10 +520,95 @@ CLEANUP:
   if(orig_v) {
     delete orig_v;
   }
+  if(dec) {
+    delete dec;
+  }
+  if(snap) {
+    delete snap;
+  }
   inst_ = 0;
   return 0;
 }
 
+SolveStatus Glob::solveComponent(ProblemPtr p, SolutionPtr& sol, double& lb)
+{
+  LPEnginePtr engine = getEngine_();
+  HandlerVector handlers;
+  PresolverPtr pres2 = 0;
+  BranchAndBound* bab = 0;
+  ProblemPtr newp = 0;
+  SolveStatus status = SolveError;
+  int err = 0;
+
+  inst_ = p;
+  sol = 0;
+  lb = -INFINITY;
+  inst_->calculateSize();
+  if(inst_->isLinear() &&
+     0 == inst_->getSize()->ints + inst_->getSize()->bins) {
+    status = Decomposer::solveContinuous(engine, inst_, sol, lb);
+  } else {
+    err = transform_(newp, handlers, engine);
+    if(2 == err) {
+      // convex component: use the convex solvers without changing options.
+      if(inst_->isQP()) {
+        Bnb bnb(env_);
+        status = bnb.solveComponent(inst_, sol, lb);
+      } else {
+        QG qg(env_);
+        status = qg.solveComponent(inst_, sol, lb);
+      }
+    } else {
+      env_->getOptions()->findInt("pres_freq")->setValue(1);
+      newp_ = newp;
+      pres2 = (PresolverPtr) new Presolver(newp_, env_, handlers);
+      pres2->solve();
+      bab = createBab_(engine, handlers);
+      bab->solve();
+      status = bab->getStatus();
+      lb = bab->getLb();
+      if(bab->getSolution()) {
+        DoubleVector x, cx(inst_->getNumVars(), 0.0);
+
+        // undo the presolve of the reformulation. The transformer copies the
+        // variables of the component first, so variable i of the
+        // reformulation is variable i of the component.
+        pres2->getX(bab->getSolution()->getPrimal(), &x);
+        for(VariableConstIterator vit = inst_->varsBegin();
+            vit != inst_->varsEnd(); ++vit) {
+          cx[(*vit)->getIndex()] = x[(*vit)->getIndex()];
+        }
+        sol = new Solution(bab->getUb(), &cx[0], inst_);
+      }
+      bab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+    }
+  }
+
+  for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
+      ++it) {
+    delete(*it);
+  }
+  delete engine;
+  if(pres2) {
+    delete pres2;
+  }
+  if(bab) {
+    if(bab->getNodeRelaxer()) {
+      delete bab->getNodeRelaxer();
+    }
+    if(bab->getNodeProcessor()) {
+      delete bab->getNodeProcessor();
+    }
+    delete bab;
+  }
+  if(newp) {
+    delete newp;
+  }
+  newp_ = 0;
+  inst_ = 0;
+  return status;
+}
+
 void Glob::showHelp() const
 {
   std::cout << "global optimization for general QCQP" << std::endl
@@ -541,6 +657,25 @@ int Glob::showInfo()
   return 0;
 }
 
+void Glob::writeDecStatus_(Decomposer* dec)
+{
+  double ub = dec->getSolution() ? dec->getSolution()->getObjValue()
+                                 : INFINITY;
+
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << std::fixed << std::setprecision(4)
+      << "best solution value = " << objSense_ * ub << std::endl
+      << me_ << std::fixed << std::setprecision(4)
+      << "best bound estimate from remaining nodes = "
+      << objSense_ * dec->getLb() << std::endl
+      << me_ << "gap = " << std::max(0.0, ub - dec->getLb()) << std::endl
+      << me_ << "time used = " << std::fixed << std::setprecision(2)
+      << env_->getTime() << std::endl
+      << me_
+      << "status of branch-and-bound: " << getSolveStatusString(status_)
+      << std::endl;
+}
+
 void Glob::writeStatus_(BranchAndBound* bab)
 {
   if(bab) {
@@ -16,6 +16,7 @@
 #include "AMPLInterface.h"
 #include "BranchAndBound.h"
 #include "Brancher.h"
+#include "Decomposer.h"
 #include "NLPEngine.h"
 #include "Presolver.h"
 #include "Solver.h"
@@ -60,6 +61,14 @@ public:
   /// Return the lower bound for the optimal value
   double getLb();
 
+  /**
+   * Solve a component found by the Decomposer. Continuous linear components
+   * are solved by one call to the LP engine, convex ones by Bnb or QG, and
+   * others by reformulating and branching. The solution and bound are
+   * returned in sol and lb.
+   */
+  SolveStatus solveComponent(ProblemPtr p, SolutionPtr& sol, double& lb);
+
 private:
   const static std::string me_;
   double objSense_;
@@ -76,6 +85,7 @@ private:
   NLPEnginePtr getNLPEngine_();
   void setInitialOptions_();
   int transform_(ProblemPtr& newp, HandlerVector& handlers, LPEnginePtr engine);
+  void writeDecStatus_(Decomposer* dec);
   void writeStatus_(BranchAndBound* bab);
 };
 } // namespace Minotaur
@@ -21,6 +21,8 @@
 #include "AMPLInterface.h"
 #include "AMPLJacobian.h"
 #include "EngineFactory.h"
+#include "ConflictPool.h"
+#include "Decomposer.h"
 #include "Environment.h"
 #include "FixVarsHeur.h"
 #include "Handler.h"
@@ -45,6 +47,7 @@
 #include "RCHandler.h"
 #include "Reader.h"
 #include "ReliabilityBrancher.h"
+#include "Solution.h"
 #include "SamplingHeur.h"
 #include "TransSep.h"
 #include "Types.h"
@@ -93,6 +96,112 @@ int QG::getEngines_(Engine** nlp_e, LPEngine** lp_e)
   return 0;
 }
 
+BranchAndBound* QG::getBab_(EnginePtr nlp_e, LPEnginePtr lp_e,
+                            HandlerVector& handlers)
+{
+  BranchAndBound* bab = 0;
+  BrancherPtr br = BrancherPtr(); // NULL
+  PCBProcessorPtr nproc;
+  NodeIncRelaxerPtr nr;
+  IntVarHandlerPtr v_hand;
+  LinearHandlerPtr l_hand;
+  QGHandlerPtr qg_hand;
+  RCHandlerPtr rc_hand;
+
+  if(env_->getOptions()->findBool("rc_fix")->getValue() && 0) {
+    rc_hand = (RCHandlerPtr) new RCHandler(env_);
+    rc_hand->setModFlags(false, true);
+    handlers.push_back(rc_hand);
+    assert(rc_hand);
+  }
+  // Initialize the handlers for branch-and-cut
+  l_hand = (LinearHandlerPtr) new LinearHandler(env_, oinst_);
+  l_hand->setModFlags(false, true);
+  handlers.push_back(l_hand);
+  assert(l_hand);
+
+  v_hand = (IntVarHandlerPtr) new IntVarHandler(env_, oinst_);
+  v_hand->setModFlags(false, true);
+  handlers.push_back(v_hand);
+  assert(v_hand);
+
+  qg_hand = (QGHandlerPtr) new QGHandler(env_, oinst_, nlp_e);
+  qg_hand->setModFlags(false, true);
+
+  handlers.push_back(qg_hand);
+  assert(qg_hand);
+
+  // report name
+  env_->getLogger()->msgStream(LogExtraInfo)
+      << me_ << "handlers used:" << std::endl;
+  for(HandlerIterator h = handlers.begin(); h != handlers.end(); ++h) {
+    env_->getLogger()->msgStream(LogExtraInfo)
+        << me_ << (*h)->getName() << std::endl;
+  }
+
+  // Only store bound-changes of relaxation (not problem)
+  nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
+  nr->setModFlag(false);
+  nr->setEngine(lp_e);
+  nproc = (PCBProcessorPtr) new PCBProcessor(env_, lp_e, handlers);
+  if(env_->getOptions()->findString("brancher")->getValue() == "rel" ||
+     env_->getOptions()->findString("brancher")->getValue() == "weak" ||
+     env_->getOptions()->findString("brancher")->getValue() == "hybrid") {
+    ReliabilityBrancherPtr rel_br =
+        (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
+    rel_br->setEngine(lp_e);
+    nproc->setBrancher(rel_br);
+    br = rel_br;
+  } else if(env_->getOptions()->findString("brancher")->getValue() ==
+            "maxvio") {
+    MaxVioBrancherPtr mbr =
+        (MaxVioBrancherPtr) new MaxVioBrancher(env_, handlers);
+    nproc->setBrancher(mbr);
+    br = mbr;
+  } else if(env_->getOptions()->findString("brancher")->getValue() == "lex") {
+    LexicoBrancherPtr lbr =
+        (LexicoBrancherPtr) new LexicoBrancher(env_, handlers);
+    br = lbr;
+  } else if(env_->getOptions()
+                ->findString("brancher")
+                ->getValue()
+                .find("strong") != std::string::npos) {
+    HybridBrancherPtr hyb_br =
+        (HybridBrancherPtr) new HybridBrancher(env_, handlers);
+    hyb_br->setEngine(lp_e);
+    if(env_->getOptions()->findString("brancher")->getValue() == "btstrong") {
+      hyb_br->doStronger();
+      hyb_br->setProblem(oinst_);
+    }
+    br = hyb_br;
+  }
+  nproc->setBrancher(br);
+  env_->getLogger()->msgStream(LogExtraInfo)
+      << me_ << "brancher used = " << br->getName() << std::endl;
+  if(env_->getOptions()->findBool("conflicts")->getValue()) {
+    nproc->setConflictPool(new ConflictPool(env_));
+  }
+
+  bab = new BranchAndBound(env_, oinst_);
+  bab->setNodeRelaxer(nr);
+  bab->setNodeProcessor(nproc);
+  bab->shouldCreateRoot(true);
+
+  if(env_->getOptions()->findBool("prerootheur")->getValue() == true) {
+    if(env_->getOptions()->findBool("samplingheur")->getValue() == true) {
+      SamplingHeurPtr s_heur = (SamplingHeurPtr) new SamplingHeur(env_, oinst_);
+      bab->addPreRootHeur(s_heur);
+    }
+
+    if(env_->getOptions()->findBool("fixvarsheur")->getValue() == true) {
+      FixVarsHeurPtr f_heur = (FixVarsHeurPtr) new FixVarsHeur(env_, oinst_);
+      f_heur->setHandlers(handlers);
+      bab->addPreRootHeur(f_heur);
+    }
+  }
+  return bab;
+}
+
 PresolverPtr QG::presolve_(HandlerVector& handlers)
 {
   PresolverPtr pres = 0;
@@ -236,16 +345,12 @@ int QG::solve(ProblemPtr p)
   VarVector* orig_v = 0;
   BranchAndBound* bab = 0;
   PresolverPtr pres = 0;
-  BrancherPtr br = BrancherPtr(); // NULL
-  PCBProcessorPtr nproc;
-  NodeIncRelaxerPtr nr;
+  Decomposer* dec = 0;
+  ProblemPtr snap = 0;   // presolved problem loaded from a file
+  UInt ncons;
 
   // handlers
   HandlerVector handlers;
-  IntVarHandlerPtr v_hand;
-  LinearHandlerPtr l_hand;
-  QGHandlerPtr qg_hand;
-  RCHandlerPtr rc_hand;
   int err = 0;
 
   oinst_ = p;
@@ -302,7 +407,14 @@ int QG::solve(ProblemPtr p)
 
   // get presolver.
   orig_v = new VarVector(oinst_->varsBegin(), oinst_->varsEnd());
-  pres = presolve_(handlers);
+  pres = loadPresolved_(oinst_, snap);
+  if(pres) {
+    oinst_ = snap;
+  } else {
+    ncons = oinst_->getNumCons();
+    pres = presolve_(handlers);
+    savePresolved_(oinst_, orig_v->size(), ncons, pres);
+  }
   for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
       ++it) {
     delete(*it);
@@ -317,6 +429,28 @@ int QG::solve(ProblemPtr p)
     goto CLEANUP;
   }
 
+  // Solve independent components separately. Nonlinear functions can be
+  // copied into components only if they are stored in native cgraph.
+  if(options->findBool("decompose")->getValue() == true &&
+     (options->findBool("use_native_cgraph")->getValue() == true ||
+      oinst_->isQuadratic() || oinst_->isLinear())) {
+    dec = new Decomposer(env_, oinst_);
+    if(dec->findComponents() > 1) {
+      status_ = dec->solve([](EnvPtr cenv, ProblemPtr cp, SolutionPtr& sol,
+                              double& lb) {
+        QG sub(cenv);
+        return sub.solveComponent(cp, sol, lb);
+      });
+      lb_ = dec->getLb();
+      ub_ = dec->getSolution() ? dec->getSolution()->getObjValue() : INFINITY;
+      dec->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+      err = writeSol_(env_, orig_v, pres, dec->getSolution(), status_,
+                      iface_);
+      writeDecStatus_();
+      goto CLEANUP;
+    }
+  }
+
   // transform to exploit separability
   sepDetection();
 
@@ -330,94 +464,7 @@ int QG::solve(ProblemPtr p)
     oinst_->setNativeDer();
   }
 
-  if(options->findBool("rc_fix")->getValue() && 0) {
-    rc_hand = (RCHandlerPtr) new RCHandler(env_);
-    rc_hand->setModFlags(false, true);
-    handlers.push_back(rc_hand);
-    assert(rc_hand);
-  }
-  // Initialize the handlers for branch-and-cut
-  l_hand = (LinearHandlerPtr) new LinearHandler(env_, oinst_);
-  l_hand->setModFlags(false, true);
-  handlers.push_back(l_hand);
-  assert(l_hand);
-
-  v_hand = (IntVarHandlerPtr) new IntVarHandler(env_, oinst_);
-  v_hand->setModFlags(false, true);
-  handlers.push_back(v_hand);
-  assert(v_hand);
-
-  qg_hand = (QGHandlerPtr) new QGHandler(env_, oinst_, nlp_e);
-  qg_hand->setModFlags(false, true);
-
-  handlers.push_back(qg_hand);
-  assert(qg_hand);
-
-  // report name
-  env_->getLogger()->msgStream(LogExtraInfo)
-      << me_ << "handlers used:" << std::endl;
-  for(HandlerIterator h = handlers.begin(); h != handlers.end(); ++h) {
-    env_->getLogger()->msgStream(LogExtraInfo)
-        << me_ << (*h)->getName() << std::endl;
-  }
-
-  // Only store bound-changes of relaxation (not problem)
-  nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
-  nr->setModFlag(false);
-  nr->setEngine(lp_e);
-  nproc = (PCBProcessorPtr) new PCBProcessor(env_, lp_e, handlers);
-  if(env_->getOptions()->findString("brancher")->getValue() == "rel" ||
-     env_->getOptions()->findString("brancher")->getValue() == "weak" ||
-     env_->getOptions()->findString("brancher")->getValue() == "hybrid") {
-    ReliabilityBrancherPtr rel_br =
-        (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
-    rel_br->setEngine(lp_e);
-    nproc->setBrancher(rel_br);
-    br = rel_br;
-  } else if(env_->getOptions()->findString("brancher")->getValue() ==
-            "maxvio") {
-    MaxVioBrancherPtr mbr =
-        (MaxVioBrancherPtr) new MaxVioBrancher(env_, handlers);
-    nproc->setBrancher(mbr);
-    br = mbr;
-  } else if(env_->getOptions()->findString("brancher")->getValue() == "lex") {
-    LexicoBrancherPtr lbr =
-        (LexicoBrancherPtr) new LexicoBrancher(env_, handlers);
-    br = lbr;
-  } else if(env_->getOptions()
-                ->findString("brancher")
-                ->getValue()
-                .find("strong") != std::string::npos) {
-    HybridBrancherPtr hyb_br =
-        (HybridBrancherPtr) new HybridBrancher(env_, handlers);
-    hyb_br->setEngine(lp_e);
-    if(env_->getOptions()->findString("brancher")->getValue() == "btstrong") {
-      hyb_br->doStronger();
-      hyb_br->setProblem(oinst_);
-    }
-    br = hyb_br;
-  }
-  nproc->setBrancher(br);
-  env_->getLogger()->msgStream(LogExtraInfo)
-      << me_ << "brancher used = " << br->getName() << std::endl;
-
-  bab = new BranchAndBound(env_, oinst_);
-  bab->setNodeRelaxer(nr);
-  bab->setNodeProcessor(nproc);
-  bab->shouldCreateRoot(true);
-
-  if(env_->getOptions()->findBool("prerootheur")->getValue() == true) {
-    if(env_->getOptions()->findBool("samplingheur")->getValue() == true) {
-      SamplingHeurPtr s_heur = (SamplingHeurPtr) new SamplingHeur(env_, oinst_);
-      bab->addPreRootHeur(s_heur);
-    }
-
-    if(env_->getOptions()->findBool("fixvarsheur")->getValue() == true) {
-      FixVarsHeurPtr f_heur = (FixVarsHeurPtr) new FixVarsHeur(env_, oinst_);
-      f_heur->setHandlers(handlers);
-      bab->addPreRootHeur(f_heur);
-    }
-  }
+  bab = getBab_(nlp_e, lp_e, handlers);
 
   // start solving
   bab->solve();
@@ -472,10 +519,84 @@ CLEANUP:
   if(orig_v) {
     delete orig_v;
   }
+  if(dec) {
+    delete dec;
+  }
+  if(snap) {
+    delete snap;
+  }
   oinst_ = 0;
   return err;
 }
 
+SolveStatus QG::solveComponent(ProblemPtr p, SolutionPtr& sol, double& lb)
+{
+  EnginePtr nlp_e = 0;
+  LPEnginePtr lp_e = 0;
+  BranchAndBound* bab = 0;
+  HandlerVector handlers;
+  SolveStatus status = SolveError;
+
+  oinst_ = p;
+  sol = 0;
+  lb = -INFINITY;
+  getEngines_(&nlp_e, &lp_e);
+  if(!nlp_e || !lp_e) {
+    env_->getLogger()->errStream()
+        << me_ << "No engine available for a component." << std::endl;
+  } else if(0 == oinst_->getSize()->ints + oinst_->getSize()->bins) {
+    // continuous and convex, one call to the NLP engine is enough.
+    status = Decomposer::solveContinuous(nlp_e, oinst_, sol, lb);
+  } else {
+    bab = getBab_(nlp_e, lp_e, handlers);
+    bab->solve();
+    status = bab->getStatus();
+    lb = bab->getLb();
+    if(bab->getSolution()) {
+      sol = new Solution(bab->getSolution());
+    }
+    bab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  }
+
+  for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
+      ++it) {
+    delete(*it);
+  }
+  if(lp_e) {
+    delete lp_e;
+  }
+  if(nlp_e) {
+    delete nlp_e;
+  }
+  if(bab) {
+    if(bab->getNodeRelaxer()) {
+      delete bab->getNodeRelaxer();
+    }
+    if(bab->getNodeProcessor()) {
+      delete bab->getNodeProcessor();
+    }
+    delete bab;
+  }
+  oinst_ = 0;
+  return status;
+}
+
+void QG::writeDecStatus_()
+{
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << std::fixed << std::setprecision(4)
+      << "best solution value = " << objSense_ * ub_ << std::endl
+      << me_ << std::fixed << std::setprecision(4)
+      << "best bound estimate from remaining nodes = " << objSense_ * lb_
+      << std::endl
+      << me_ << "gap = " << std::max(0.0, ub_ - lb_) << std::endl
+      << me_ << "time used (s) = " << std::fixed << std::setprecision(2)
+      << env_->getTime() << std::endl
+      << me_
+      << "status of branch-and-bound = " << getSolveStatusString(status_)
+      << std::endl;
+}
+
 int QG::writeBnbStatus_(BranchAndBound* bab)
 {
   int err = 0;
@@ -58,6 +58,14 @@ namespace Minotaur {
       /// Return the lower bound for the optimal value
       double getLb() {return lb_;};
 
+      /**
+       * Solve a component found by the Decomposer. Components without
+       * integer variables are solved by one call to the NLP engine, others
+       * by the QG algorithm. The solution and bound are returned in sol and
+       * lb.
+       */
+      SolveStatus solveComponent(ProblemPtr p, SolutionPtr &sol, double &lb);
+
     private:
       const static std::string me_;
       double objSense_;
@@ -66,10 +74,13 @@ namespace Minotaur {
       ProblemPtr oinst_;
       SolveStatus status_;
 
+      BranchAndBound* getBab_(Engine *nlp_e, LPEngine *lp_e,
+                              HandlerVector &handlers);
       int getEngines_(Engine **nlp_e, LPEngine **lp_e);
       PresolverPtr presolve_(HandlerVector &handlers);
       void setInitialOptions_();
       int writeBnbStatus_(BranchAndBound *bab);
+      void writeDecStatus_();
   };
 }
 #endif
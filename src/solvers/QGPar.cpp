@@ -316,7 +316,14 @@ ParQGBranchAndBound* QGPar::createParBab_(UInt numThreads, NodePtr &node,
   if (env_->getOptions()->findBool("prerootheur")->getValue() == true) {
     if(env_->getOptions()->findBool("samplingheur")->getValue() == true) {
       SamplingHeurPtr s_heur = (SamplingHeurPtr) new SamplingHeur(env_, oinst_);
-      bab->addPreRootHeur(s_heur);
+      // it only evaluates functions of oinst_. The root works on copies of
+      // them unless they are evaluated through the ampl interface.
+      if(numThreads > 1 &&
+         env_->getOptions()->findBool("use_native_cgraph")->getValue()) {
+        bab->addConcHeur(s_heur);
+      } else {
+        bab->addPreRootHeur(s_heur);
+      }
     }
 
     if(env_->getOptions()->findBool("fixvarsheur")->getValue() == true) {
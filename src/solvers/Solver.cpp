@@ -17,6 +17,7 @@
 #include "Option.h"
 #include "Problem.h"
 #include "Reader.h"
+#include "Snapshot.h"
 #include "Solver.h"
 #include "Solution.h"
 #include "Timer.h"
@@ -115,6 +116,47 @@ ProblemPtr Solver::readProblem(std::string fname, std::string dname,
 }
 
 
+PresolverPtr Solver::loadPresolved_(ProblemPtr orig, ProblemPtr &p)
+{
+  std::string fname = env_->getOptions()->findString("load_presolved")
+    ->getValue();
+  PresolverPtr pres = 0;
+  PreModQ mods;
+  int err = 0;
+
+  p = 0;
+  if (fname.empty()) {
+    return 0;
+  }
+
+  Snapshot snap(env_);
+  p = snap.read(fname, orig->getNumVars(), orig->getNumCons(), mods, err);
+  if (err) {
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "presolved problem not loaded, presolving again." << std::endl;
+    return 0;
+  }
+
+  pres = (PresolverPtr) new Presolver(p, env_, HandlerVector());
+  pres->addMods(mods);
+  return pres;
+}
+
+
+void Solver::savePresolved_(ProblemPtr p, UInt norig, UInt morig,
+                            PresolverPtr pres)
+{
+  std::string fname = env_->getOptions()->findString("save_presolved")
+    ->getValue();
+
+  if (!fname.empty() && (Finished == pres->getStatus() ||
+                         NotStarted == pres->getStatus())) {
+    Snapshot snap(env_);
+    snap.write(p, norig, morig, pres->getMods(), fname);
+  }
+}
+
+
 void Solver::setIface(MINOTAUR_AMPL::AMPLInterface* iface)
 {
   iface_ = iface;
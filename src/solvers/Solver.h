@@ -58,6 +58,30 @@ namespace Minotaur {
     /// calling function.
     bool ownIface_;
 
+    /**
+     * \brief Load a presolved problem from the file given in option
+     * "load_presolved", if any.
+     *
+     * \param[in] orig The original problem, before presolve.
+     * \param[out] p The loaded problem, owned by the caller. NULL if no
+     * problem was loaded.
+     * \returns A presolver for postsolving solutions of p, or NULL if no
+     * problem was loaded.
+     */
+    virtual PresolverPtr loadPresolved_(ProblemPtr orig, ProblemPtr &p);
+
+    /**
+     * \brief Save the presolved problem in the file given in option
+     * "save_presolved", if any.
+     *
+     * \param[in] p The presolved problem.
+     * \param[in] norig Number of variables before presolve.
+     * \param[in] morig Number of constraints before presolve.
+     * \param[in] pres The presolver that was used.
+     */
+    virtual void savePresolved_(ProblemPtr p, UInt norig, UInt morig,
+                                PresolverPtr pres);
+
     virtual int writeSol_(EnvPtr env, VarVector *orig_v, PresolverPtr pres,
                           SolutionPtr sol, SolveStatus status,
                           MINOTAUR_AMPL::AMPLInterface* iface);
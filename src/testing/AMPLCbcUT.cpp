@@ -12,6 +12,8 @@
 #include "LinearFunction.h"
 #include "Option.h"
 #include "Problem.h"
+#include "Solution.h"
+#include "Variable.h"
 
 #include "AMPLInterface.h"
 
@@ -68,3 +70,27 @@ void AMPLCbcUT::testCbc()
 }
 
 
+void AMPLCbcUT::testPool()
+{
+  char file_name[] = "instances/milp";
+  ProblemPtr p = iface_->readInstance(file_name);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  ConstSolutionPtr sol;
+
+  e_->load(p);
+  CPPUNIT_ASSERT(e_->solve() == ProvenOptimal);
+  CPPUNIT_ASSERT(e_->getNumSols() >= 1);
+  sol = e_->getSolutionFromPool(-1);
+  CPPUNIT_ASSERT(sol);
+  CPPUNIT_ASSERT(fabs(sol->getObjValue() - 1.0) < 1e-5);
+  CPPUNIT_ASSERT(e_->getSolutionFromPool(e_->getNumSols() - 1) == 0);
+  CPPUNIT_ASSERT(e_->getWarmStart());
+
+  // a cut added after the solve is in the next solve, without a reload.
+  lf->addTerm(p->getVariable(4), 1.0);
+  p->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 0.0);
+  CPPUNIT_ASSERT(e_->solve() == ProvenInfeasible);
+  CPPUNIT_ASSERT(e_->getNumSols() == 0);
+
+  delete p;
+}
@@ -26,11 +26,13 @@ public:
   AMPLCbcUT() {}
 
   void testCbc();
+  void testPool();
   void setUp();
   void tearDown();
 
   CPPUNIT_TEST_SUITE(AMPLCbcUT);
   CPPUNIT_TEST(testCbc);
+  CPPUNIT_TEST(testPool);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -17,6 +17,53 @@ CPPUNIT_TEST_SUITE_REGISTRATION(CGraphUT);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CGraphUT, "CGraphUT");
 using namespace Minotaur;
 
+void CGraphUT::testEvalCache()
+{
+  CNode *n0, *n1, *n2;
+  CGraph cgraph;
+  int error = 0;
+
+  VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
+  VariablePtr v1 = new Variable(1, 1, 0.0, 10.0, Continuous, "x1");
+
+  double x[2] = {1.0, 2.0};
+  double g[2] = {0.0, 0.0};
+
+  n0 = cgraph.newNode(v0);
+  n1 = cgraph.newNode(v1);
+  n2 = cgraph.newNode(OpMult, n0, n1);
+  n0 = cgraph.newNode(OpSqr, n0, 0);
+  n0 = cgraph.newNode(OpPlus, n0, n2); // n0 = x0^2 + x0*x1
+  cgraph.setOut(n0);
+  cgraph.finalize();
+
+  // same point again: stored values are used.
+  CPPUNIT_ASSERT(fabs(cgraph.eval(x, &error) - 3.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(cgraph.eval(x, &error) - 3.0) < 1e-10);
+  cgraph.evalGradient(x, g, &error);
+  CPPUNIT_ASSERT(0 == error);
+  CPPUNIT_ASSERT(fabs(g[0] - 4.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(g[1] - 1.0) < 1e-10);
+
+  // new point in the same array.
+  x[1] = 3.0;
+  g[0] = g[1] = 0.0;
+  cgraph.evalGradient(x, g, &error);
+  CPPUNIT_ASSERT(fabs(g[0] - 5.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(g[1] - 1.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(cgraph.eval(x, &error) - 4.0) < 1e-10);
+
+  // changing the graph invalidates stored values.
+  cgraph.removeVar(v1, 1.0);
+  cgraph.finalize();
+  CPPUNIT_ASSERT(fabs(cgraph.eval(x, &error) - 2.0) < 1e-10);
+  CPPUNIT_ASSERT(0 == error);
+
+  delete v0;
+  delete v1;
+}
+
+
 void CGraphUT::testIdentical()
 {
   VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
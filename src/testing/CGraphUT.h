@@ -24,11 +24,13 @@ public:
 
   void setUp() { }      // need not implement
   void tearDown() { }   // need not implement
+  void testEvalCache();
   void testIdentical();
   void testLin();
   void testQuad();
 
   CPPUNIT_TEST_SUITE(CGraphUT);
+  CPPUNIT_TEST(testEvalCache);
   CPPUNIT_TEST(testIdentical);
   CPPUNIT_TEST(testLin);
   CPPUNIT_TEST(testQuad);
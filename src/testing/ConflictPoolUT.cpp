@@ -0,0 +1,214 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "ConflictPool.h"
+#include "ConflictPoolUT.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Node.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ConflictPoolUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ConflictPoolUT, "ConflictPoolUT");
+using namespace Minotaur;
+
+
+void ConflictPoolUT::setUp()
+{
+  LinearFunctionPtr lf;
+
+  // x0, x1 binary, z integer, y continuous. Minimize y.
+  env_ = new Environment();
+  p_ = new Problem(env_);
+  p_->newVariable(0.0, 1.0, Binary);
+  p_->newVariable(0.0, 1.0, Binary);
+  p_->newVariable(0.0, 10.0, Integer);
+  p_->newVariable(0.0, 10.0, Continuous);
+  lf = new LinearFunction();
+  lf->addTerm(p_->getVariable(3), 1.0);
+  p_->newObjective(new Function(lf), 0.0, Minimize);
+
+  rel_ = new Relaxation(p_, env_);
+  cp_ = new ConflictPool(env_);
+  cp_->setRootBounds(rel_);
+  nodes_.push_back(new Node());
+}
+
+
+void ConflictPoolUT::tearDown()
+{
+  while (!nodes_.empty()) {
+    delete nodes_.back();
+    nodes_.pop_back();
+  }
+  delete cp_;
+  delete rel_;
+  delete p_;
+  delete env_;
+}
+
+
+Node *ConflictPoolUT::branch_(Node *parent, UInt i, BoundType lu,
+                              double val)
+{
+  BranchPtr br = new Branch();
+  Node *node;
+
+  br->addRMod(new VarBoundMod(rel_->getVariable(i), lu, val));
+  node = new Node(parent, br);
+  node->setDepth(parent->getDepth() + 1);
+  nodes_.push_back(node);
+  return node;
+}
+
+
+void ConflictPoolUT::resetBounds_()
+{
+  for (UInt i = 0; i < p_->getNumVars(); ++i) {
+    rel_->changeBound(rel_->getVariable(i), p_->getVariable(i)->getLb(),
+                      p_->getVariable(i)->getUb());
+  }
+}
+
+
+void ConflictPoolUT::testNegate()
+{
+  ConflictPool::Lit l;
+
+  // bounds of integer variables are negated to the next integer.
+  l.var = 2;
+  l.lu = Lower;
+  l.val = 4.0;
+  CPPUNIT_ASSERT(3.0 == cp_->negate_(l));
+  l.lu = Upper;
+  CPPUNIT_ASSERT(5.0 == cp_->negate_(l));
+  l.var = 0;
+  l.val = 0.0;
+  CPPUNIT_ASSERT(1.0 == cp_->negate_(l));
+
+  // those of continuous variables are not.
+  l.var = 3;
+  l.lu = Lower;
+  l.val = 2.5;
+  CPPUNIT_ASSERT(2.5 == cp_->negate_(l));
+  l.lu = Upper;
+  CPPUNIT_ASSERT(2.5 == cp_->negate_(l));
+}
+
+
+void ConflictPoolUT::testPrune()
+{
+  Node *n1 = branch_(nodes_[0], 0, Lower, 1.0);
+  Node *n2 = branch_(n1, 1, Upper, 0.0);
+  Node *other = branch_(nodes_[0], 2, Upper, 5.0);
+
+  // x0 >= 1 and x1 <= 0 make n2 infeasible.
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  rel_->changeBound(rel_->getVariable(1), Upper, 0.0);
+  cp_->analyze(n2, rel_, 0, INFINITY);
+  CPPUNIT_ASSERT(1 == cp_->conflicts_.size());
+  CPPUNIT_ASSERT(2 == cp_->conflicts_[0].size());
+
+  // a node with both bounds is pruned, whatever its other bounds.
+  rel_->changeBound(rel_->getVariable(2), Upper, 5.0);
+  CPPUNIT_ASSERT(true == cp_->propagate(other, rel_));
+  CPPUNIT_ASSERT(1 == cp_->stats_.pruned);
+  CPPUNIT_ASSERT(0 == (other->modsrEnd() - other->modsrBegin()));
+
+  // a node with neither bound is not changed.
+  resetBounds_();
+  CPPUNIT_ASSERT(false == cp_->propagate(other, rel_));
+  CPPUNIT_ASSERT(0 == cp_->stats_.tightened);
+  CPPUNIT_ASSERT(0.0 == rel_->getVariable(1)->getLb());
+  CPPUNIT_ASSERT(0 == (other->modsrEnd() - other->modsrBegin()));
+}
+
+
+void ConflictPoolUT::testReverse()
+{
+  Node *n1 = branch_(nodes_[0], 0, Lower, 1.0);
+  Node *n2 = branch_(n1, 2, Upper, 3.0);
+  Node *n3 = branch_(n1, 3, Upper, 5.0);
+  Node *other = branch_(nodes_[0], 1, Lower, 1.0);
+
+  // x0 >= 1 and z <= 3, and x0 >= 1 and y <= 5, are infeasible.
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  rel_->changeBound(rel_->getVariable(2), Upper, 3.0);
+  cp_->analyze(n2, rel_, 0, INFINITY);
+  resetBounds_();
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  rel_->changeBound(rel_->getVariable(3), Upper, 5.0);
+  cp_->analyze(n3, rel_, 0, INFINITY);
+  CPPUNIT_ASSERT(2 == cp_->conflicts_.size());
+  resetBounds_();
+
+  // with x0 >= 1, the other bound is reversed: to z >= 4 for the integer
+  // variable, and to y >= 5 for the continuous one.
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  CPPUNIT_ASSERT(false == cp_->propagate(other, rel_));
+  CPPUNIT_ASSERT(4.0 == rel_->getVariable(2)->getLb());
+  CPPUNIT_ASSERT(5.0 == rel_->getVariable(3)->getLb());
+  CPPUNIT_ASSERT(2 == (other->modsrEnd() - other->modsrBegin()));
+  CPPUNIT_ASSERT(2 == cp_->stats_.tightened);
+
+  // the reversed bound conflicts with z <= 3: pruned.
+  resetBounds_();
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  rel_->changeBound(rel_->getVariable(2), Upper, 3.5);
+  CPPUNIT_ASSERT(true == cp_->propagate(other, rel_));
+
+  // the remaining bound is violated, so nothing is left to tighten.
+  resetBounds_();
+  rel_->changeBound(rel_->getVariable(2), Lower, 4.0);
+  rel_->changeBound(rel_->getVariable(3), Lower, 6.0);
+  CPPUNIT_ASSERT(false == cp_->propagate(other, rel_));
+  CPPUNIT_ASSERT(0.0 == rel_->getVariable(0)->getLb());
+  CPPUNIT_ASSERT(1.0 == rel_->getVariable(0)->getUb());
+}
+
+
+void ConflictPoolUT::testStats()
+{
+  Node *n1 = branch_(nodes_[0], 0, Lower, 1.0);
+  Node *n2 = branch_(n1, 3, Upper, 5.0);
+  double x[4] = {1.0, 0.0, 0.0, 5.0};
+  double rc[4] = {2.0, 0.0, 0.0, 0.1};
+  Solution *sol;
+
+  rel_->changeBound(rel_->getVariable(0), Lower, 1.0);
+  rel_->changeBound(rel_->getVariable(3), Upper, 5.0);
+
+  // infeasible node.
+  cp_->analyze(n2, rel_, 0, INFINITY);
+  CPPUNIT_ASSERT(1 == cp_->stats_.inf);
+
+  // pruned by bound, but the solution has no duals: the branches are used.
+  sol = new Solution(10.0, x, rel_);
+  cp_->analyze(n2, rel_, sol, 9.0);
+  CPPUNIT_ASSERT(1 == cp_->stats_.nodual);
+  CPPUNIT_ASSERT(0 == cp_->stats_.cut);
+  CPPUNIT_ASSERT(2 == cp_->conflicts_.back().size());
+
+  // with duals: y <= 5 costs 0.5 of the slack of 1 and is left out.
+  sol->setDualOfVars(rc);
+  cp_->analyze(n2, rel_, sol, 9.0);
+  CPPUNIT_ASSERT(1 == cp_->stats_.cut);
+  CPPUNIT_ASSERT(1 == cp_->stats_.inf);
+  CPPUNIT_ASSERT(1 == cp_->stats_.nodual);
+  CPPUNIT_ASSERT(1 == cp_->conflicts_.back().size());
+  CPPUNIT_ASSERT(0 == cp_->conflicts_.back()[0].var);
+  CPPUNIT_ASSERT(5 == cp_->stats_.lits);
+  delete sol;
+}
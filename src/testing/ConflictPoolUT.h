@@ -0,0 +1,62 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#ifndef CONFLICTPOOLUT_H
+#define CONFLICTPOOLUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+namespace Minotaur {
+  class ConflictPool;
+  class Node;
+  class Relaxation;
+}
+
+using namespace Minotaur;
+
+class ConflictPoolUT : public CppUnit::TestCase {
+
+public:
+  ConflictPoolUT(std::string name) : TestCase(name) {}
+  ConflictPoolUT() {}
+
+  void setUp();
+  void tearDown();
+  void testNegate();
+  void testPrune();
+  void testReverse();
+  void testStats();
+
+  CPPUNIT_TEST_SUITE(ConflictPoolUT);
+  CPPUNIT_TEST(testNegate);
+  CPPUNIT_TEST(testPrune);
+  CPPUNIT_TEST(testReverse);
+  CPPUNIT_TEST(testStats);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  ConflictPool *cp_;
+  EnvPtr env_;
+
+  /// Nodes created by branch_(), deepest last.
+  std::vector<Node *> nodes_;
+  ProblemPtr p_;
+  Relaxation *rel_;
+
+  /// Create a child of parent with the bound lu of variable i set to val.
+  Node *branch_(Node *parent, UInt i, BoundType lu, double val);
+
+  /// Set the bounds of the relaxation to those of the problem.
+  void resetBounds_();
+};
+
+#endif     // #define CONFLICTPOOLUT_H
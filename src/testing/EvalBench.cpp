@@ -0,0 +1,405 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+//
+
+/**
+ * \file EvalBench.cpp
+ * \brief Measure the time taken to evaluate functions and derivatives.
+ *
+ * Usage: evalbench [-t seconds] stub1 [stub2 ...]
+ *
+ * Each .nl stub is read twice: once with Minotaur's computational graph
+ * (CGraph) and once with nonlinear functions evaluated by ASL
+ * (AMPLNonlinearFunction). Every kernel evaluates all functions of the
+ * problem that it applies to, and is called repeatedly at random points
+ * within the bounds of variables until it has run for the given time. The
+ * time per nonzero is reported in nanoseconds.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "MinotaurConfig.h"
+#include "AMPLHessian.h"
+#include "AMPLInterface.h"
+#include "AMPLJacobian.h"
+#include "AMPLNonlinearFunction.h"
+#include "CGraph.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "HessianOfLag.h"
+#include "Jacobian.h"
+#include "LinearFunction.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "Timer.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+using namespace MINOTAUR_AMPL;
+
+namespace {
+  /// Number of random points at which kernels are evaluated.
+  const UInt numPts = 16;
+
+  /// Total work done by one kernel.
+  struct KernelStat {
+    double time;  /// Seconds.
+    double nnz;   /// Nonzeros processed, summed over all calls.
+    double calls;
+  };
+
+  typedef std::map<std::string, KernelStat> StatMap;
+
+  /// Random points within bounds. Infinite bounds are clipped to [-10, 10].
+  void fillPoints(ProblemPtr p, std::vector<DoubleVector> &pts)
+  {
+    UInt n = p->getNumVars();
+    double lb, ub;
+
+    srand(1);
+    pts.assign(numPts, DoubleVector(n, 0.0));
+    for (UInt i = 0; i < n; ++i) {
+      lb = std::max(p->getVariable(i)->getLb(), -10.0);
+      ub = std::min(p->getVariable(i)->getUb(), 10.0);
+      if (ub < lb) {
+        ub = lb;
+      }
+      for (UInt k = 0; k < numPts; ++k) {
+        pts[k][i] = lb + (ub - lb) * ((double)rand() / RAND_MAX);
+      }
+    }
+  }
+
+  /**
+   * Call the kernel on all points in batches until tlimit seconds are used.
+   * The kernel is called with the index of the point and returns the number
+   * of nonzeros it processed.
+   */
+  template <class F>
+  void timeKernel(EnvPtr env, double tlimit, const std::string &name,
+                  StatMap &stats, F kernel)
+  {
+    Timer *timer = env->getNewTimer();
+    KernelStat &s = stats[name];
+    double nnz = 0, calls = 0, t = 0;
+    UInt reps = 1;
+
+    timer->start();
+    while (t < tlimit) {
+      for (UInt r = 0; r < reps; ++r) {
+        for (UInt k = 0; k < numPts; ++k) {
+          nnz += kernel(k);
+        }
+      }
+      calls += reps * numPts;
+      reps *= 2;
+      t = timer->query();
+    }
+    timer->stop();
+    s.time += t;
+    s.nnz += nnz;
+    s.calls += calls;
+    delete timer;
+  }
+
+  /// A function of the problem and its parts.
+  struct FunParts {
+    FunctionPtr f;
+    LinearFunctionPtr lf;
+    QuadraticFunctionPtr qf;
+    NonlinearFunctionPtr nlf;
+    std::string kind;  /// Type of nlf.
+    double nlnz;       /// Nonzeros in the gradient of nlf.
+    double nz;         /// Nonzeros in all parts.
+  };
+
+  typedef std::vector<FunParts> FunPartsVec;
+
+  /**
+   * Time the parts of all functions of p. Each kernel is timed once, and
+   * evaluates the part in every function that has it.
+   */
+  void benchFunctions(EnvPtr env, ProblemPtr p, double tlimit,
+                      StatMap &stats)
+  {
+    std::vector<FunctionPtr> funs;
+    std::vector<DoubleVector> pts;
+    FunPartsVec parts;
+    std::set<std::string> kinds;
+    DoubleVector grad(p->getNumVars(), 0.0);
+    double *g = grad.empty() ? 0 : &grad[0];
+    double sink = 0.0;
+    bool has_lf = false, has_qf = false;
+    int err = 0;
+
+    fillPoints(p, pts);
+    if (p->getObjective() && p->getObjective()->getFunction()) {
+      funs.push_back(p->getObjective()->getFunction());
+    }
+    for (ConstraintConstIterator it = p->consBegin(); it != p->consEnd();
+         ++it) {
+      funs.push_back((*it)->getFunction());
+    }
+
+    for (std::vector<FunctionPtr>::iterator it = funs.begin();
+         it != funs.end(); ++it) {
+      FunParts fp;
+      fp.f = *it;
+      fp.lf = fp.f->getLinearFunction();
+      fp.qf = fp.f->getQuadraticFunction();
+      fp.nlf = fp.f->getNonlinearFunction();
+      fp.nlnz = 0;
+      fp.nz = 0;
+      if (fp.lf && fp.lf->getNumTerms() > 0) {
+        fp.nz += fp.lf->getNumTerms();
+        has_lf = true;
+      } else {
+        fp.lf = 0;
+      }
+      if (fp.qf && fp.qf->getNumTerms() > 0) {
+        fp.nz += fp.qf->getNumTerms();
+        has_qf = true;
+      } else {
+        fp.qf = 0;
+      }
+      if (fp.nlf) {
+        // ASL evaluates the gradient with respect to all variables.
+        fp.nlnz = fp.nlf->numVars() > 0 ? fp.nlf->numVars()
+                                        : p->getNumVars();
+        if (dynamic_cast<CGraph *>(fp.nlf)) {
+          fp.kind = "CGraph";
+        } else if (dynamic_cast<AMPLNonlinearFunction *>(fp.nlf)) {
+          fp.kind = "AMPLNonlinearFunction";
+        } else {
+          fp.kind = "NonlinearFunction";
+        }
+        fp.nz += fp.nlnz;
+        kinds.insert(fp.kind);
+      }
+      if (fp.nz > 0) {
+        parts.push_back(fp);
+      }
+    }
+    if (parts.empty()) {
+      return;
+    }
+
+    if (has_lf) {
+      timeKernel(env, tlimit, "LinearFunction eval", stats, [&](UInt k) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->lf) {
+            sink += it->lf->eval(&pts[k][0]);
+            nnz += it->lf->getNumTerms();
+          }
+        }
+        return nnz;
+      });
+      timeKernel(env, tlimit, "LinearFunction evalGradient", stats,
+                 [&](UInt) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->lf) {
+            it->lf->evalGradient(g);
+            nnz += it->lf->getNumTerms();
+          }
+        }
+        return nnz;
+      });
+    }
+    if (has_qf) {
+      timeKernel(env, tlimit, "QuadraticFunction eval", stats, [&](UInt k) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->qf) {
+            sink += it->qf->eval(&pts[k][0]);
+            nnz += it->qf->getNumTerms();
+          }
+        }
+        return nnz;
+      });
+      timeKernel(env, tlimit, "QuadraticFunction evalGradient", stats,
+                 [&](UInt k) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->qf) {
+            it->qf->evalGradient(&pts[k][0], g);
+            nnz += it->qf->getNumTerms();
+          }
+        }
+        return nnz;
+      });
+    }
+    for (std::set<std::string>::const_iterator kit = kinds.begin();
+         kit != kinds.end(); ++kit) {
+      const std::string &kind = *kit;
+      timeKernel(env, tlimit, kind + " eval", stats, [&](UInt k) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->nlf && it->kind == kind) {
+            sink += it->nlf->eval(&pts[k][0], &err);
+            nnz += it->nlnz;
+          }
+        }
+        return nnz;
+      });
+      timeKernel(env, tlimit, kind + " evalGradient", stats, [&](UInt k) {
+        double nnz = 0;
+        for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+             ++it) {
+          if (it->nlf && it->kind == kind) {
+            it->nlf->evalGradient(&pts[k][0], g, &err);
+            nnz += it->nlnz;
+          }
+        }
+        return nnz;
+      });
+    }
+    timeKernel(env, tlimit, "Function eval", stats, [&](UInt k) {
+      double nnz = 0;
+      for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+           ++it) {
+        sink += it->f->eval(&pts[k][0], &err);
+        nnz += it->nz;
+      }
+      return nnz;
+    });
+    timeKernel(env, tlimit, "Function evalGradient", stats, [&](UInt k) {
+      double nnz = 0;
+      for (FunPartsVec::iterator it = parts.begin(); it != parts.end();
+           ++it) {
+        it->f->evalGradient(&pts[k][0], g, &err);
+        nnz += it->nz;
+      }
+      return nnz;
+    });
+    // keep the compiler from removing the evaluations.
+    if (std::isnan(sink)) {
+      std::cout << "evalbench: nan in evaluations" << std::endl;
+    }
+  }
+
+  /// Time the evaluation of Jacobian and Hessian of Lagrangian of p.
+  void benchDerivatives(EnvPtr env, ProblemPtr p, double tlimit,
+                        const std::string &kind, StatMap &stats)
+  {
+    std::vector<DoubleVector> pts;
+    JacobianPtr jac = p->getJacobian();
+    HessianOfLagPtr hess = p->getHessian();
+    DoubleVector vals, mult(p->getNumCons(), 1.0);
+    int err = 0;
+
+    fillPoints(p, pts);
+    if (jac && jac->getNumNz() > 0) {
+      vals.resize(jac->getNumNz());
+      timeKernel(env, tlimit, kind + " Jacobian::fillRowColValues", stats,
+                 [&](UInt k) {
+                   jac->fillRowColValues(&pts[k][0], &vals[0], &err);
+                   return (double)jac->getNumNz();
+                 });
+    }
+    if (hess && hess->getNumNz() > 0) {
+      vals.resize(hess->getNumNz());
+      timeKernel(env, tlimit, kind + " HessianOfLag::fillRowColValues", stats,
+                 [&](UInt k) {
+                   hess->fillRowColValues(&pts[k][0], 1.0,
+                                          mult.empty() ? 0 : &mult[0],
+                                          &vals[0], &err);
+                   return (double)hess->getNumNz();
+                 });
+    }
+  }
+
+  /// Read the stub with or without native computational graph and time it.
+  int benchStub(const std::string &stub, bool native, double tlimit,
+                StatMap &stats)
+  {
+    EnvPtr env = new Environment();
+    AMPLInterfacePtr iface;
+    ProblemPtr p;
+
+    env->setLogLevel(LogError);
+    env->getOptions()->findBool("use_native_cgraph")->setValue(native);
+    iface = new AMPLInterface(env);
+    p = iface->readInstance(stub);
+    if (!p) {
+      delete iface;
+      delete env;
+      return 1;
+    }
+    if (native) {
+      p->setNativeDer();
+    } else {
+      p->setJacobian(new AMPLJacobian(iface));
+      p->setHessian(new AMPLHessian(iface));
+    }
+    p->prepareForSolve();
+
+    benchFunctions(env, p, tlimit, stats);
+    if (p->getNumVars() > 0) {
+      benchDerivatives(env, p, tlimit, native ? "native" : "ASL", stats);
+    }
+
+    delete p;
+    delete iface;
+    delete env;
+    return 0;
+  }
+}
+
+
+int main(int argc, char** argv)
+{
+  StatMap stats;
+  double tlimit = 0.05;
+  int first = 1;
+
+  if (argc > 2 && 0 == strcmp(argv[1], "-t")) {
+    tlimit = atof(argv[2]);
+    first = 3;
+  }
+  if (first >= argc) {
+    std::cout << "Usage: " << argv[0] << " [-t seconds] stub1 [stub2 ...]"
+              << std::endl;
+    return 1;
+  }
+
+  for (int i = first; i < argc; ++i) {
+    if (benchStub(argv[i], true, tlimit, stats) ||
+        benchStub(argv[i], false, tlimit, stats)) {
+      std::cerr << "evalbench: could not read " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << std::left << std::setw(48) << "kernel" << std::right
+            << std::setw(14) << "calls" << std::setw(16) << "nonzeros"
+            << std::setw(12) << "ns/nz" << std::endl;
+  for (StatMap::iterator it = stats.begin(); it != stats.end(); ++it) {
+    const KernelStat &s = it->second;
+    std::cout << std::left << std::setw(48) << it->first << std::right
+              << std::fixed << std::setprecision(0) << std::setw(14)
+              << s.calls << std::setw(16) << s.nnz << std::setprecision(2)
+              << std::setw(12) << (s.nnz > 0 ? 1e9 * s.time / s.nnz : 0.0)
+              << std::endl;
+  }
+  return 0;
+}
@@ -10,6 +10,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "HessianOfLagUT.h"
+#include "Jacobian.h"
 #include "LinearFunction.h"
 #include "QuadraticFunction.h"
 
@@ -173,3 +174,57 @@ void HessianOfLagUT::testQuadEval()
 }
 
 
+
+
+void HessianOfLagUT::testUpdate()
+{
+  HessianOfLagPtr hess;
+  JacobianPtr jac;
+  ConstraintPtr c;
+  UInt ver;
+
+  // x_2^2 + x_2x_3 <= 10
+  qf_ = (QuadraticFunctionPtr) new QuadraticFunction();
+  qf_->addTerm(vars_[2], vars_[2], 1.0);
+  qf_->addTerm(vars_[2], vars_[3], 1.0);
+  lf_ = LinearFunctionPtr();
+  f_ = (FunctionPtr) new Function(lf_, qf_);
+  instance_->newConstraint(f_, -INFINITY, 10.0, "cons2");
+  instance_->setNativeDer();
+  hess = instance_->getHessian();
+  jac = instance_->getJacobian();
+  ver = instance_->getNlStructVersion();
+  CPPUNIT_ASSERT(hess->getNumNz() == 2);
+  CPPUNIT_ASSERT(jac->getNumNz() == 6);
+
+  // adding and deleting a linear constraint keeps the hessian.
+  lf_ = (LinearFunctionPtr) new LinearFunction();
+  lf_->addTerm(vars_[4], 1.0);
+  lf_->addTerm(vars_[5], 1.0);
+  lf_->addTerm(vars_[0], 1.0);
+  f_ = (FunctionPtr) new Function(lf_);
+  c = instance_->newConstraint(f_, -INFINITY, 4.0, "cons3");
+  CPPUNIT_ASSERT(instance_->getNlStructVersion() == ver);
+  instance_->prepareForSolve();
+  CPPUNIT_ASSERT(instance_->getHessian() == hess);
+  CPPUNIT_ASSERT(instance_->getJacobian() == jac);
+  CPPUNIT_ASSERT(hess->getNumNz() == 2);
+  CPPUNIT_ASSERT(jac->getNumNz() == 9);
+
+  instance_->markDelete(c);
+  instance_->delMarkedCons();
+  instance_->prepareForSolve();
+  CPPUNIT_ASSERT(instance_->getNlStructVersion() == ver);
+  CPPUNIT_ASSERT(jac->getNumNz() == 6);
+
+  // a new quadratic constraint changes the hessian.
+  qf_ = (QuadraticFunctionPtr) new QuadraticFunction();
+  qf_->addTerm(vars_[5], vars_[5], 1.0);
+  lf_ = LinearFunctionPtr();
+  f_ = (FunctionPtr) new Function(lf_, qf_);
+  instance_->newConstraint(f_, -INFINITY, 10.0, "cons4");
+  CPPUNIT_ASSERT(instance_->getNlStructVersion() != ver);
+  instance_->prepareForSolve();
+  CPPUNIT_ASSERT(instance_->getHessian()->getNumNz() == 3);
+  CPPUNIT_ASSERT(instance_->getJacobian()->getNumNz() == 7);
+}
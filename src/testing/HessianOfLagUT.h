@@ -38,11 +38,13 @@ class HessianOfLagUT : public CppUnit::TestCase {
     CPPUNIT_TEST(testEmpty);
     CPPUNIT_TEST(testLinearEval);
     CPPUNIT_TEST(testQuadEval);
+    CPPUNIT_TEST(testUpdate);
     CPPUNIT_TEST_SUITE_END();
 
     void testEmpty();
     void testLinearEval();
     void testQuadEval();
+    void testUpdate();
 
   private:
     EnvPtr env_;
@@ -0,0 +1,179 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Node.h"
+#include "NodeHeapUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(NodeHeapUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(NodeHeapUT, "NodeHeapUT");
+using namespace Minotaur;
+
+// bound, estimate and depth of the nodes. The three orders differ. Depth
+// ordering takes the shallowest node first.
+static const double lbs[] = {4.0, 1.0, 3.0, 2.0, 5.0};
+static const double ests[] = {4.5, 6.0, 3.5, 2.5, 5.0};
+static const UInt depths[] = {1, 3, 2, 4, 0};
+static const UInt numNodes = 5;
+
+
+void NodeHeapUT::setUp()
+{
+  NodePtr n;
+
+  for (UInt i = 0; i < numNodes; ++i) {
+    n = new Node();
+    n->setId(i);
+    n->setLb(lbs[i]);
+    n->setEstimate(ests[i]);
+    n->setDepth(depths[i]);
+    nodes_.push_back(n);
+  }
+}
+
+
+void NodeHeapUT::tearDown()
+{
+  for (NodePtrIterator it = nodes_.begin(); it != nodes_.end(); ++it) {
+    delete *it;
+  }
+  nodes_.clear();
+}
+
+
+void NodeHeapUT::checkOrder_(NodeHeap &heap, const UInt *ids, UInt n)
+{
+  CPPUNIT_ASSERT(heap.getSize() == n);
+  for (UInt i = 0; i < n; ++i) {
+    CPPUNIT_ASSERT(heap.top()->getId() == ids[i]);
+    heap.pop();
+  }
+  CPPUNIT_ASSERT(heap.isEmpty());
+}
+
+
+void NodeHeapUT::pushAll_(NodeHeap &heap)
+{
+  for (NodePtrIterator it = nodes_.begin(); it != nodes_.end(); ++it) {
+    heap.push(*it);
+  }
+}
+
+
+void NodeHeapUT::testDepth()
+{
+  NodeHeap heap(NodeHeap::Depth);
+  UInt ids[] = {4, 0, 2, 1, 3};
+
+  pushAll_(heap);
+  checkOrder_(heap, ids, numNodes);
+}
+
+
+void NodeHeapUT::testErase()
+{
+  NodeHeap heap(NodeHeap::Value);
+  NodePtrVector removed;
+
+  CPPUNIT_ASSERT(INFINITY == heap.getBestLB());
+  CPPUNIT_ASSERT(0 == heap.getDeepestLevel());
+  pushAll_(heap);
+  CPPUNIT_ASSERT(fabs(heap.getBestLB() - 1.0) < 1e-9);
+  CPPUNIT_ASSERT(4 == heap.getDeepestLevel());
+
+  // removes nodes 1 and 3, which have the best bound and the deepest.
+  heap.pop();
+  heap.pop();
+  CPPUNIT_ASSERT(fabs(heap.getBestLB() - 3.0) < 1e-9);
+  CPPUNIT_ASSERT(2 == heap.getDeepestLevel());
+
+  // removes nodes 0 and 4.
+  heap.removeAbove(3.5, removed);
+  CPPUNIT_ASSERT(2 == removed.size());
+  CPPUNIT_ASSERT(1 == heap.getSize());
+  CPPUNIT_ASSERT(2 == heap.top()->getId());
+  CPPUNIT_ASSERT(fabs(heap.getBestLB() - 3.0) < 1e-9);
+  CPPUNIT_ASSERT(2 == heap.getDeepestLevel());
+
+  heap.pop();
+  CPPUNIT_ASSERT(INFINITY == heap.getBestLB());
+  CPPUNIT_ASSERT(0 == heap.getDeepestLevel());
+
+  // freed entries are used again.
+  pushAll_(heap);
+  CPPUNIT_ASSERT(5 == heap.getSize());
+  CPPUNIT_ASSERT(fabs(heap.getBestLB() - 1.0) < 1e-9);
+  CPPUNIT_ASSERT(4 == heap.getDeepestLevel());
+}
+
+
+void NodeHeapUT::testEstimate()
+{
+  NodeHeap heap(NodeHeap::Estimate);
+  UInt ids[] = {3, 2, 0, 4, 1};
+
+  pushAll_(heap);
+  checkOrder_(heap, ids, numNodes);
+}
+
+
+void NodeHeapUT::testRemoveAbove()
+{
+  NodeHeap heap(NodeHeap::Depth);
+  NodePtrVector removed;
+  UInt ids[] = {4, 1};
+
+  // node 4 is on top and above the cutoff, but it is kept.
+  pushAll_(heap);
+  heap.removeAbove(1.5, removed);
+  CPPUNIT_ASSERT(3 == removed.size());
+  for (NodePtrIterator it = removed.begin(); it != removed.end(); ++it) {
+    CPPUNIT_ASSERT((*it)->getLb() > 1.5);
+    CPPUNIT_ASSERT((*it)->getId() != 4);
+  }
+  CPPUNIT_ASSERT(fabs(heap.getBestLB() - 1.0) < 1e-9);
+  CPPUNIT_ASSERT(3 == heap.getDeepestLevel());
+  checkOrder_(heap, ids, 2);
+
+  // nothing is above the cutoff.
+  removed.clear();
+  pushAll_(heap);
+  heap.removeAbove(10.0, removed);
+  CPPUNIT_ASSERT(removed.empty());
+  CPPUNIT_ASSERT(5 == heap.getSize());
+}
+
+
+void NodeHeapUT::testSetType()
+{
+  NodeHeap heap(NodeHeap::Value);
+  UInt dids[] = {4, 0, 2, 1, 3};
+  UInt eids[] = {3, 2, 0, 1};
+
+  pushAll_(heap);
+  CPPUNIT_ASSERT(1 == heap.top()->getId());
+  heap.setType(NodeHeap::Depth);
+  checkOrder_(heap, dids, numNodes);
+
+  pushAll_(heap);
+  heap.setType(NodeHeap::Depth);
+  CPPUNIT_ASSERT(4 == heap.top()->getId());
+  heap.pop();
+  heap.setType(NodeHeap::Estimate);
+  checkOrder_(heap, eids, 4);
+}
+
+
+void NodeHeapUT::testValue()
+{
+  NodeHeap heap(NodeHeap::Value);
+  UInt ids[] = {1, 3, 2, 0, 4};
+
+  pushAll_(heap);
+  checkOrder_(heap, ids, numNodes);
+}
@@ -0,0 +1,55 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#ifndef NODEHEAPUT_H
+#define NODEHEAPUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "NodeHeap.h"
+
+using namespace Minotaur;
+
+class NodeHeapUT : public CppUnit::TestCase {
+
+public:
+  NodeHeapUT(std::string name) : TestCase(name) {}
+  NodeHeapUT() {}
+
+  void setUp();
+  void tearDown();
+  void testDepth();
+  void testErase();
+  void testEstimate();
+  void testRemoveAbove();
+  void testSetType();
+  void testValue();
+
+  CPPUNIT_TEST_SUITE(NodeHeapUT);
+  CPPUNIT_TEST(testDepth);
+  CPPUNIT_TEST(testErase);
+  CPPUNIT_TEST(testEstimate);
+  CPPUNIT_TEST(testRemoveAbove);
+  CPPUNIT_TEST(testSetType);
+  CPPUNIT_TEST(testValue);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /// Nodes pushed in the heaps. The i-th node has ID i.
+  NodePtrVector nodes_;
+
+  /// Pop all nodes of the heap and check their IDs against ids.
+  void checkOrder_(NodeHeap &heap, const UInt *ids, UInt n);
+
+  /// Push all nodes in the heap.
+  void pushAll_(NodeHeap &heap);
+};
+
+#endif     // #define NODEHEAPUT_H
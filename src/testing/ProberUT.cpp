@@ -0,0 +1,263 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#include <algorithm>
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Function.h"
+#include "ImplGraph.h"
+#include "ImplHandler.h"
+#include "LinearFunction.h"
+#include "Modification.h"
+#include "Node.h"
+#include "Option.h"
+#include "Problem.h"
+#include "Prober.h"
+#include "ProberUT.h"
+#include "Relaxation.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ProberUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ProberUT, "ProberUT");
+using namespace Minotaur;
+
+
+void ProberUT::setUp()
+{
+  env_ = new Environment();
+  p_ = createProblem_();
+}
+
+
+void ProberUT::tearDown()
+{
+  delete p_;
+  delete env_;
+}
+
+
+ProblemPtr ProberUT::createProblem_()
+{
+  ProblemPtr p = new Problem(env_);
+  LinearFunctionPtr lf;
+  VariablePtr y;
+
+  for (UInt i = 0; i < 6; ++i) {
+    p->newVariable(0.0, 1.0, Binary);
+  }
+  y = p->newVariable(0.0, 10.0, Continuous);
+
+  // x0 + x1 + x2 <= 1 is a clique.
+  lf = new LinearFunction();
+  for (UInt i = 0; i < 3; ++i) {
+    lf->addTerm(p->getVariable(i), 1.0);
+  }
+  p->newConstraint(new Function(lf), -INFINITY, 1.0);
+
+  // y <= 10 x3 and y >= 2 fix x3 to 1.
+  lf = new LinearFunction();
+  lf->addTerm(y, 1.0);
+  lf->addTerm(p->getVariable(3), -10.0);
+  p->newConstraint(new Function(lf), -INFINITY, 0.0);
+  lf = new LinearFunction();
+  lf->addTerm(y, 1.0);
+  p->newConstraint(new Function(lf), 2.0, INFINITY);
+
+  // x4 <= x5 gives x4 = 1 => x5 = 1.
+  lf = new LinearFunction();
+  lf->addTerm(p->getVariable(4), 1.0);
+  lf->addTerm(p->getVariable(5), -1.0);
+  p->newConstraint(new Function(lf), -INFINITY, 0.0);
+
+  // y <= 5 + 5 x4.
+  lf = new LinearFunction();
+  lf->addTerm(y, 1.0);
+  lf->addTerm(p->getVariable(4), -5.0);
+  p->newConstraint(new Function(lf), -INFINITY, 5.0);
+
+  lf = new LinearFunction();
+  lf->addTerm(y, 1.0);
+  p->newObjective(new Function(lf), 0.0, Minimize);
+  return p;
+}
+
+
+void ProberUT::testApply()
+{
+  Prober prober(env_, p_);
+  Prober::ProbeRes res[2];
+  Prober::BndChg chg;
+  UIntVector changed;
+
+  CPPUNIT_ASSERT(Finished == prober.solve());
+
+  // both values are infeasible.
+  res[0].inf = res[1].inf = true;
+  CPPUNIT_ASSERT(true == prober.apply_(4, res, changed));
+
+  // x4 = 0 is infeasible: x4 is fixed to 1, and so is x5.
+  res[0].inf = true;
+  res[1].inf = false;
+  chg.var = 5;
+  chg.lb = chg.ub = 1.0;
+  res[1].chgs.push_back(chg);
+  CPPUNIT_ASSERT(false == prober.apply_(4, res, changed));
+  CPPUNIT_ASSERT(2 == changed.size());
+  CPPUNIT_ASSERT(1.0 == prober.lb_[4] && 1.0 == prober.lb_[5]);
+
+  // both values bound y: the weaker bounds hold.
+  changed.clear();
+  res[0].inf = res[1].inf = false;
+  res[0].chgs.clear();
+  res[1].chgs.clear();
+  chg.var = 6;
+  chg.lb = 2.0;
+  chg.ub = 4.0;
+  res[0].chgs.push_back(chg);
+  chg.lb = 3.0;
+  chg.ub = 6.0;
+  res[1].chgs.push_back(chg);
+  CPPUNIT_ASSERT(false == prober.apply_(0, res, changed));
+  CPPUNIT_ASSERT(1 == changed.size() && 6 == changed[0]);
+  CPPUNIT_ASSERT(2.0 == prober.lb_[6] && 6.0 == prober.ub_[6]);
+
+  // a bound implied by one value only is not applied.
+  changed.clear();
+  res[1].chgs.clear();
+  res[0].chgs[0].ub = 3.0;
+  CPPUNIT_ASSERT(false == prober.apply_(1, res, changed));
+  CPPUNIT_ASSERT(changed.empty());
+  CPPUNIT_ASSERT(6.0 == prober.ub_[6]);
+}
+
+
+void ProberUT::testImplHandler()
+{
+  Prober prober(env_, p_);
+  RelaxationPtr rel;
+  ImplHandler *handler;
+  NodePtr node = new Node();
+  ModVector p_mods, r_mods;
+
+  CPPUNIT_ASSERT(Finished == prober.solve());
+  rel = new Relaxation(p_, env_);
+  handler = new ImplHandler(env_, prober.getGraph());
+
+  // x4 = 1 implies x5 = 1, and x0 = 1 leaves x1 and x2 at 0.
+  rel->changeBound(rel->getVariable(4), 1.0, 1.0);
+  rel->changeBound(rel->getVariable(0), 1.0, 1.0);
+  CPPUNIT_ASSERT(false == handler->presolveNode(rel, node, 0, p_mods,
+                                                r_mods));
+  CPPUNIT_ASSERT(3 == r_mods.size());
+  CPPUNIT_ASSERT(1.0 == rel->getVariable(5)->getLb());
+  CPPUNIT_ASSERT(0.0 == rel->getVariable(1)->getUb());
+  CPPUNIT_ASSERT(0.0 == rel->getVariable(2)->getUb());
+  for (ModificationConstIterator it = r_mods.begin(); it != r_mods.end();
+       ++it) {
+    (*it)->undoToProblem(rel);
+    delete *it;
+  }
+  r_mods.clear();
+
+  // x4 = 1 and x5 = 0 can not both hold.
+  rel->changeBound(rel->getVariable(5), 0.0, 0.0);
+  CPPUNIT_ASSERT(true == handler->presolveNode(rel, node, 0, p_mods,
+                                               r_mods));
+
+  for (ModificationConstIterator it = r_mods.begin(); it != r_mods.end();
+       ++it) {
+    delete *it;
+  }
+  delete handler;
+  delete rel;
+  delete node;
+}
+
+
+void ProberUT::testProbe()
+{
+  Prober prober(env_, p_);
+  Prober::Scratch s;
+  Prober::ProbeRes res;
+
+  CPPUNIT_ASSERT(Finished == prober.solve());
+  s.lb = prober.lb_;
+  s.ub = prober.ub_;
+  s.inQ.assign(prober.rows_.size(), 0);
+  s.touched.assign(p_->getNumVars(), 0);
+
+  // x0 = 1 fixes x1 and x2 to 0, and nothing else.
+  prober.probe_(0, 1.0, s, res);
+  CPPUNIT_ASSERT(false == res.inf);
+  CPPUNIT_ASSERT(2 == res.chgs.size());
+  CPPUNIT_ASSERT(1 == res.chgs[0].var && 0.0 == res.chgs[0].ub);
+  CPPUNIT_ASSERT(2 == res.chgs[1].var && 0.0 == res.chgs[1].ub);
+
+  // x4 = 1 fixes x5 to 1.
+  prober.probe_(4, 1.0, s, res);
+  CPPUNIT_ASSERT(false == res.inf);
+  CPPUNIT_ASSERT(1 == res.chgs.size());
+  CPPUNIT_ASSERT(5 == res.chgs[0].var && 1.0 == res.chgs[0].lb);
+
+  // x4 = 0 leaves y <= 5.
+  prober.probe_(4, 0.0, s, res);
+  CPPUNIT_ASSERT(false == res.inf);
+  CPPUNIT_ASSERT(1 == res.chgs.size());
+  CPPUNIT_ASSERT(6 == res.chgs[0].var && 5.0 == res.chgs[0].ub);
+
+  // x3 is fixed to 1 by probing.
+  prober.probe_(3, 0.0, s, res);
+  CPPUNIT_ASSERT(true == res.inf);
+  CPPUNIT_ASSERT(res.chgs.empty());
+
+  // the bounds of the scratch are restored.
+  for (UInt i = 0; i < p_->getNumVars(); ++i) {
+    CPPUNIT_ASSERT(s.lb[i] == prober.lb_[i] && s.ub[i] == prober.ub_[i]);
+    CPPUNIT_ASSERT(0 == s.touched[i]);
+  }
+  for (UInt r = 0; r < s.inQ.size(); ++r) {
+    CPPUNIT_ASSERT(0 == s.inQ[r]);
+  }
+}
+
+
+void ProberUT::testSolve()
+{
+  ProblemPtr p2;
+  Prober prober(env_, p_);
+  const ImplGraph *graph;
+  UInt nimpls;
+
+  CPPUNIT_ASSERT(Finished == prober.solve());
+  CPPUNIT_ASSERT(1.0 == p_->getVariable(3)->getLb());
+  for (UInt i = 0; i < p_->getNumVars(); ++i) {
+    if (3 != i) {
+      CPPUNIT_ASSERT(p_->getVariable(i)->getUb() -
+                     p_->getVariable(i)->getLb() > 0.5);
+    }
+  }
+  graph = prober.getGraph();
+  CPPUNIT_ASSERT(2 == graph->getNumCliques());
+  nimpls = graph->getNumImpls();
+  CPPUNIT_ASSERT(nimpls > 0);
+  const UIntVector &impls = graph->getImpls(ImplGraph::lit(4, true));
+  CPPUNIT_ASSERT(impls.end() != std::find(impls.begin(), impls.end(),
+                                          ImplGraph::lit(5, true)));
+
+  // the same is found with more threads.
+  env_->getOptions()->findInt("threads")->setValue(4);
+  p2 = createProblem_();
+  Prober prober2(env_, p2);
+  CPPUNIT_ASSERT(Finished == prober2.solve());
+  CPPUNIT_ASSERT(nimpls == prober2.getGraph()->getNumImpls());
+  for (UInt i = 0; i < p_->getNumVars(); ++i) {
+    CPPUNIT_ASSERT(p_->getVariable(i)->getLb() == p2->getVariable(i)->getLb());
+    CPPUNIT_ASSERT(p_->getVariable(i)->getUb() == p2->getVariable(i)->getUb());
+  }
+  delete p2;
+}
@@ -0,0 +1,48 @@
+// 
+//     Minotaur -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2025 The Minotaur Team.
+// 
+
+#ifndef PROBERUT_H
+#define PROBERUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+class ProberUT : public CppUnit::TestCase {
+
+public:
+  ProberUT(std::string name) : TestCase(name) {}
+  ProberUT() {}
+
+  void setUp();
+  void tearDown();
+  void testApply();
+  void testImplHandler();
+  void testProbe();
+  void testSolve();
+
+  CPPUNIT_TEST_SUITE(ProberUT);
+  CPPUNIT_TEST(testApply);
+  CPPUNIT_TEST(testImplHandler);
+  CPPUNIT_TEST(testProbe);
+  CPPUNIT_TEST(testSolve);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  EnvPtr env_;
+  ProblemPtr p_;
+
+  /// Create a small problem with six binary variables and one continuous.
+  ProblemPtr createProblem_();
+};
+
+#endif     // #define PROBERUT_H
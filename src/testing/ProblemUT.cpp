@@ -149,3 +149,27 @@ void ProblemTest::testaddToObj()
   CPPUNIT_ASSERT(instance_->getSize()->objLinTerms == 3);
 }
 
+
+void ProblemTest::testVersions()
+{
+  UInt sver = instance_->getStructVersion();
+  UInt over = instance_->getObjVersion();
+  VariablePtr v = instance_->getVariable(0);
+  LinearFunctionPtr lf = LinearFunctionPtr(new LinearFunction());
+
+  // bounds change neither.
+  instance_->changeBound(v, Upper, 10.0);
+  instance_->changeBound(instance_->getConstraint(0), Upper, 12.0);
+  CPPUNIT_ASSERT(instance_->getStructVersion() == sver);
+  CPPUNIT_ASSERT(instance_->getObjVersion() == over);
+
+  lf->addTerm(v, 1.0);
+  instance_->changeObj(FunctionPtr(new Function(lf)), 0.0);
+  CPPUNIT_ASSERT(instance_->getStructVersion() == sver);
+  CPPUNIT_ASSERT(instance_->getObjVersion() > over);
+
+  lf = LinearFunctionPtr(new LinearFunction());
+  lf->addTerm(v, 1.0);
+  instance_->newConstraint(FunctionPtr(new Function(lf)), -INFINITY, 5.0);
+  CPPUNIT_ASSERT(instance_->getStructVersion() > sver);
+}
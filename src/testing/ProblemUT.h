@@ -35,6 +35,7 @@ class ProblemTest : public CppUnit::TestCase {
     void testDeleteVar(); 
     void testChangeBound(); 
     void testaddToObj(); 
+    void testVersions(); 
  
     CPPUNIT_TEST_SUITE(ProblemTest);
     CPPUNIT_TEST(testevalCon);
@@ -45,6 +46,7 @@ class ProblemTest : public CppUnit::TestCase {
     CPPUNIT_TEST(testDeleteVar);
     CPPUNIT_TEST(testChangeBound); 
     CPPUNIT_TEST(testaddToObj);  
+    CPPUNIT_TEST(testVersions);  
     CPPUNIT_TEST_SUITE_END();
 
     //void testgetCons();